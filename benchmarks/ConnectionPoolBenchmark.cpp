@@ -0,0 +1,117 @@
+//
+// ConnectionPoolBenchmark.cpp
+// Acquire/release cost of the connection pool as the number of threads grows.
+// Compares the previous provider (mutex + condition_variable + heap wrapper + dynamic_cast)
+// with ConnectionPool in shared and affinity mode, over a fake IDbConnection.
+//
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "persistence/configuration/ConnectionPool.hpp"
+
+namespace {
+
+struct FakeConnection final : IDbConnection {
+    long long uses = 0;
+};
+
+// What PostgresConnectionProvider did before: one lock for every checkout, a new wrapper per
+// checkout and a dynamic_cast on return.
+class LegacyQueuePool {
+public:
+    struct Wrapper final : IDbConnection {
+        std::unique_ptr<FakeConnection> connection;
+        explicit Wrapper(std::unique_ptr<FakeConnection> c) : connection(std::move(c)) {}
+    };
+
+private:
+    std::queue<std::unique_ptr<FakeConnection>> pool;
+    std::mutex mutex;
+    std::condition_variable condition;
+
+public:
+    explicit LegacyQueuePool(std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) pool.push(std::make_unique<FakeConnection>());
+    }
+
+    std::unique_ptr<IDbConnection, std::function<void(IDbConnection*)>> Acquire() {
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [this] { return !pool.empty(); });
+        auto conn = std::move(pool.front());
+        pool.pop();
+        return {new Wrapper(std::move(conn)), [this](IDbConnection* dbc) {
+            auto* w = dynamic_cast<Wrapper*>(dbc);
+            {
+                std::lock_guard guard(mutex);
+                pool.push(std::move(w->connection));
+            }
+            delete w;
+            condition.notify_one();
+        }};
+    }
+};
+
+constexpr int kIterations = 200000;
+
+template<class Body>
+double nsPerOp(std::size_t threads, Body body) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (int i = 0; i < kIterations; ++i) body();
+        });
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) w.join();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / kIterations;
+}
+
+double runPool(std::size_t threads, PoolMode mode) {
+    ConnectionPoolSettings settings;
+    settings.minSize = threads;
+    settings.maxSize = threads;
+    settings.mode = mode;
+    ConnectionPool pool(settings,
+        [] { return std::unique_ptr<IDbConnection>(std::make_unique<FakeConnection>()); },
+        [](IDbConnection&) { return true; });
+    return nsPerOp(threads, [&pool] {
+        auto c = pool.Acquire();
+        ++c.As<FakeConnection>().uses;
+    });
+}
+
+double runLegacy(std::size_t threads) {
+    LegacyQueuePool pool(threads);
+    return nsPerOp(threads, [&pool] {
+        auto c = pool.Acquire();
+        ++dynamic_cast<LegacyQueuePool::Wrapper*>(&*c)->connection->uses;
+    });
+}
+
+}
+
+int main(int argc, char** argv) {
+    const std::size_t maxThreads = argc > 1 ? std::stoul(argv[1]) : std::max(1u, std::thread::hardware_concurrency()) * 2;
+
+    std::printf("ns per acquire+release (wall clock / iterations per thread), pool size = threads\n");
+    std::printf("%8s %14s %14s %14s\n", "threads", "legacy", "shared", "affinity");
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        std::printf("%8zu %14.1f %14.1f %14.1f\n",
+                    threads, runLegacy(threads), runPool(threads, PoolMode::Shared), runPool(threads, PoolMode::Affinity));
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+//
+// EventCodecBenchmark.cpp
+// TeamAddEvent and ScoreUpdateEvent on the wire: JSON (nlohmann object built then dumped / parsed then
+// read field by field, as GroupDelegate, MatchController and the listeners do) against event_codec
+// binary-v1 (Encode / Decode into the view, then ToEvent for the strings the delegates take).
+// Prints time, heap bytes and body size per event. Heap bytes are counted with a replaced operator new.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "event/EventCodec.hpp"
+
+namespace {
+std::size_t allocatedBytes = 0;
+}
+
+void* operator new(std::size_t size) {
+    allocatedBytes += size;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr int kIterations = 500000;
+
+struct Result {
+    double ns;
+    double bytes;
+};
+
+template<class Body>
+Result measure(Body body) {
+    const std::size_t bytesBefore = allocatedBytes;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) body();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return Result{
+        std::chrono::duration<double, std::nano>(elapsed).count() / kIterations,
+        static_cast<double>(allocatedBytes - bytesBefore) / kIterations,
+    };
+}
+
+void report(const char* what, Result json, Result binary) {
+    std::printf("%-20s %10.1f %10.1f %12.1f %12.1f   %.1fx\n",
+                what, json.ns, binary.ns, json.bytes, binary.bytes, json.ns / binary.ns);
+}
+
+std::string teamAddJson(const TeamAddEvent& e) {
+    nlohmann::json evt;
+    evt["type"]         = "tournament.team.added";
+    evt["tournamentId"] = e.tournamentId;
+    evt["groupId"]      = e.groupId;
+    evt["teamId"]       = e.teamId;
+    evt["occurredAt"]   = 1760700000000LL;
+    return evt.dump();
+}
+
+std::string scoreJson(const ScoreUpdateEvent& e) {
+    return nlohmann::json{
+        {"type", "match.score-recorded"},
+        {"tournamentId", e.tournamentId},
+        {"matchId", e.matchId}
+    }.dump();
+}
+
+}
+
+int main() {
+    const TeamAddEvent teamAdd{"0b0e2f6c-3c1f-4d8e-9f50-8a6f0f5c2d11",
+                               "7c6b5a49-3827-4160-9f8e-7d6c5b4a3921",
+                               "5a3c8d4e-1f2b-4a6c-8e9d-0f1a2b3c4d5e"};
+    const ScoreUpdateEvent score{"0b0e2f6c-3c1f-4d8e-9f50-8a6f0f5c2d11",
+                                 "3f2e1d0c-9b8a-4f7e-6d5c-100000000001"};
+
+    const std::string teamAddText = teamAddJson(teamAdd);
+    const std::string teamAddBinary = *event_codec::Encode(teamAdd);
+    const std::string scoreText = scoreJson(score);
+    const std::string scoreBinary = *event_codec::Encode(score);
+    std::size_t sink = 0;
+
+    std::printf("body bytes            %10s %10s\n", "json", "binary");
+    std::printf("%-20s %10zu %10zu\n", "team add", teamAddText.size(), teamAddBinary.size());
+    std::printf("%-20s %10zu %10zu\n\n", "score update", scoreText.size(), scoreBinary.size());
+
+    std::printf("per event (%d iterations)\n", kIterations);
+    std::printf("%-20s %10s %10s %12s %12s\n", "", "json ns", "binary ns", "json bytes", "binary bytes");
+
+    report("team add encode",
+           measure([&] { sink += teamAddJson(teamAdd).size(); }),
+           measure([&] { sink += event_codec::Encode(teamAdd)->size(); }));
+    report("team add decode",
+           measure([&] {
+               const auto json = nlohmann::json::parse(teamAddText);
+               const TeamAddEvent e{json.at("tournamentId").get<std::string>(), json.at("groupId").get<std::string>(),
+                                    json.at("teamId").get<std::string>()};
+               sink += e.teamId.size();
+           }),
+           measure([&] {
+               event_codec::TeamAddView view;
+               event_codec::Decode(teamAddBinary, view);
+               sink += event_codec::ToEvent(view).teamId.size();
+           }));
+    report("team add view only",
+           measure([&] { sink += nlohmann::json::parse(teamAddText).size(); }),
+           measure([&] {
+               event_codec::TeamAddView view;
+               sink += event_codec::Decode(teamAddBinary, view) ? view.teamId[0] : 0;
+           }));
+    report("score encode",
+           measure([&] { sink += scoreJson(score).size(); }),
+           measure([&] { sink += event_codec::Encode(score)->size(); }));
+    report("score decode",
+           measure([&] {
+               const auto json = nlohmann::json::parse(scoreText);
+               const ScoreUpdateEvent e{json.at("tournamentId").get<std::string>(), json.at("matchId").get<std::string>()};
+               sink += e.matchId.size();
+           }),
+           measure([&] {
+               event_codec::ScoreUpdateView view;
+               event_codec::Decode(scoreBinary, view);
+               sink += event_codec::ToEvent(view).matchId.size();
+           }));
+
+    std::printf("(sink %zu)\n", sink);
+    return 0;
+}
@@ -0,0 +1,120 @@
+//
+// JsonCodecBenchmark.cpp
+// Encode/decode of one played Match and one Tournament: nlohmann (DOM built then dumped / parsed
+// then mapped by from_json) against json_codec (written straight into the output string / pulled
+// field by field into the domain object). Heap bytes are counted with a replaced global operator new.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "domain/DomainJson.hpp"
+
+namespace {
+std::size_t allocatedBytes = 0;
+}
+
+void* operator new(std::size_t size) {
+    allocatedBytes += size;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr int kIterations = 200000;
+
+struct Result {
+    double ns;
+    double bytes;
+};
+
+template<class Body>
+Result measure(Body body) {
+    const std::size_t bytesBefore = allocatedBytes;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) body();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return Result{
+        std::chrono::duration<double, std::nano>(elapsed).count() / kIterations,
+        static_cast<double>(allocatedBytes - bytesBefore) / kIterations,
+    };
+}
+
+void report(const char* what, Result dom, Result codec) {
+    std::printf("%-18s %10.1f %10.1f %12.1f %12.1f   %.1fx\n",
+                what, dom.ns, codec.ns, dom.bytes, codec.bytes, dom.ns / codec.ns);
+}
+
+// Tournament has no nlohmann mapping any more; this is what the removed one did.
+nlohmann::json tournamentDom(const domain::Tournament& t) {
+    return {
+        {"id", t.Id()},
+        {"name", t.Name()},
+        {"format", {
+            {"numberOfGroups", t.Format().NumberOfGroups()},
+            {"maxTeamsPerGroup", t.Format().MaxTeamsPerGroup()},
+            {"type", t.Format().Type() == domain::TournamentType::NFL ? "NFL" : "ROUND_ROBIN"},
+        }},
+    };
+}
+
+domain::Tournament tournamentFromDom(const nlohmann::json& j) {
+    domain::Tournament t{j.at("name").get<std::string>()};
+    t.Id() = j.value("id", "");
+    if (const auto f = j.find("format"); f != j.end()) {
+        t.Format().NumberOfGroups() = f->value("numberOfGroups", 8);
+        t.Format().MaxTeamsPerGroup() = f->value("maxTeamsPerGroup", 4);
+        t.Format().Type() = f->value("type", "") == "NFL" ? domain::TournamentType::NFL
+                                                         : domain::TournamentType::ROUND_ROBIN;
+    }
+    return t;
+}
+
+}
+
+int main() {
+    domain::Match match;
+    match.Id() = "3f2e1d0c-9b8a-4f7e-6d5c-100000000001";
+    match.TournamentId() = "0b0e2f6c-3c1f-4d8e-9f50-8a6f0f5c2d11";
+    match.Round() = "group";
+    match.Home() = domain::TeamRef{"5a3c8d4e-1f2b-4a6c-8e9d-0f1a2b3c4d5e", "México"};
+    match.Visitor() = domain::TeamRef{"9e8d7c6b-5a4f-4e3d-2c1b-0a9f8e7d6c5b", "Argentina"};
+    match.SetStatus("played");
+    match.SetScore(2, 1);
+    match.SetWinnerTeamId("5a3c8d4e-1f2b-4a6c-8e9d-0f1a2b3c4d5e");
+    match.SetDecidedBy("regularTime");
+
+    domain::Tournament tournament{"Copa \"Mundial\" 2026", domain::TournamentFormat{8, 4}};
+    tournament.Id() = "0b0e2f6c-3c1f-4d8e-9f50-8a6f0f5c2d11";
+
+    const std::string matchText = json_codec::Write(match);
+    const std::string tournamentText = json_codec::Write(tournament);
+    std::size_t sink = 0;
+
+    std::printf("per document (%d iterations)\n", kIterations);
+    std::printf("%-18s %10s %10s %12s %12s\n", "", "dom ns", "codec ns", "dom bytes", "codec bytes");
+
+    report("match write",
+           measure([&] { sink += nlohmann::json(match).dump().size(); }),
+           measure([&] { sink += json_codec::Write(match).size(); }));
+    report("match read",
+           measure([&] { sink += nlohmann::json::parse(matchText).get<domain::Match>().Id().size(); }),
+           measure([&] { sink += json_codec::Read<domain::Match>(matchText)->Id().size(); }));
+    report("tournament write",
+           measure([&] { sink += tournamentDom(tournament).dump().size(); }),
+           measure([&] { sink += json_codec::Write(tournament).size(); }));
+    report("tournament read",
+           measure([&] { sink += tournamentFromDom(nlohmann::json::parse(tournamentText)).Name().size(); }),
+           measure([&] { sink += json_codec::Read<domain::Tournament>(tournamentText)->Name().size(); }));
+
+    std::printf("(sink %zu)\n", sink);
+    return 0;
+}
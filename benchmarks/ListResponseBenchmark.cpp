@@ -0,0 +1,135 @@
+//
+// ListResponseBenchmark.cpp
+// Cost of building the body of one GET /tournaments/{id}/matches page (50 rows): the domain path
+// (decode typed columns -> domain::Match -> nlohmann DOM -> dump) against the pass-through path
+// (Postgres renders each row's JSON, page_cursor::JsonArrayFromRows only concatenates them).
+// Rows are held in memory, so this measures the service side only, not the query. Heap bytes are
+// counted with a replaced global operator new.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "persistence/repository/MatchRowDecoder.hpp"
+#include "persistence/repository/Page.hpp"
+
+namespace {
+std::size_t allocatedBytes = 0;
+}
+
+void* operator new(std::size_t size) {
+    allocatedBytes += size;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Just enough of the pqxx::field / pqxx::row surface for match_columns::Decode.
+struct FakeField {
+    std::optional<std::string> value;
+    bool is_null() const { return !value.has_value(); }
+    const char* c_str() const { return value ? value->c_str() : ""; }
+    std::size_t size() const { return value ? value->size() : 0; }
+    template<typename T> T as() const { return static_cast<T>(std::stol(*value)); }
+};
+
+struct TypedRow {
+    std::vector<FakeField> fields;
+    const FakeField& operator[](std::size_t i) const { return fields[i]; }
+};
+
+// Row of the *JsonPage statements: id, created_at, body.
+struct JsonRow {
+    FakeField id, createdAt, body;
+    const FakeField& operator[](const char* column) const {
+        const std::string_view name{column};
+        return name == "body" ? body : name == "id" ? id : createdAt;
+    }
+};
+
+constexpr int kPages = 20000;
+constexpr std::size_t kPageSize = PageRequest::DefaultLimit;
+
+TypedRow typedRow(int i) {
+    return TypedRow{{
+        {"3f2e1d0c-9b8a-4f7e-6d5c-" + std::to_string(100000000000 + i)},
+        {"0b0e2f6c-3c1f-4d8e-9f50-8a6f0f5c2d11"},
+        {"group"},
+        {"played"},
+        {"5a3c8d4e-1f2b-4a6c-8e9d-0f1a2b3c4d5e"},
+        {"Mexico"},
+        {"9e8d7c6b-5a4f-4e3d-2c1b-0a9f8e7d6c5b"},
+        {"Argentina"},
+        {"2"},
+        {"1"},
+        {"5a3c8d4e-1f2b-4a6c-8e9d-0f1a2b3c4d5e"},
+        {"regularTime"},
+        {std::nullopt},
+        {std::nullopt},
+    }};
+}
+
+struct Result {
+    double nsPerPage;
+    double bytesPerPage;
+};
+
+template<class Body>
+Result measure(Body body) {
+    const std::size_t bytesBefore = allocatedBytes;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kPages; ++i) body();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return Result{
+        std::chrono::duration<double, std::nano>(elapsed).count() / kPages,
+        static_cast<double>(allocatedBytes - bytesBefore) / kPages,
+    };
+}
+
+}
+
+int main() {
+    std::vector<TypedRow> typedRows;
+    std::vector<JsonRow> jsonRows;
+    for (std::size_t i = 0; i < kPageSize; ++i) {
+        typedRows.push_back(typedRow(static_cast<int>(i)));
+        // What the *JsonPage statements return for the same row.
+        const nlohmann::json rendered = match_columns::Decode(typedRows.back());
+        jsonRows.push_back(JsonRow{{typedRows.back()[0].value}, {"2025-10-01 10:00:00"}, {rendered.dump()}});
+    }
+    const PageRequest request;
+    std::size_t sink = 0;
+
+    const Result domain = measure([&] {
+        std::vector<std::shared_ptr<domain::Match>> items;
+        items.reserve(typedRows.size());
+        for (const auto& row : typedRows) {
+            items.push_back(std::make_shared<domain::Match>(match_columns::Decode(row)));
+        }
+        nlohmann::json body = nlohmann::json::array();
+        for (const auto& m : items) body.push_back(*m);
+        sink += body.dump().size();
+    });
+    const Result passThrough = measure([&] {
+        sink += page_cursor::JsonArrayFromRows(jsonRows, request).body.size();
+    });
+
+    std::printf("per page of %zu matches (%d pages)\n", kPageSize, kPages);
+    std::printf("%-22s %12s %14s\n", "", "ns", "heap bytes");
+    std::printf("%-22s %12.1f %14.1f\n", "domain + nlohmann", domain.nsPerPage, domain.bytesPerPage);
+    std::printf("%-22s %12.1f %14.1f\n", "pass-through", passThrough.nsPerPage, passThrough.bytesPerPage);
+    std::printf("speedup %.1fx, %.1fx fewer bytes (sink %zu)\n",
+                domain.nsPerPage / passThrough.nsPerPage, domain.bytesPerPage / passThrough.bytesPerPage, sink);
+    return 0;
+}
@@ -0,0 +1,131 @@
+//
+// ListenerLatencyBenchmark.cpp
+// End-to-end latency of one event, from the producer's send to QueueMessageListener::processMessage,
+// for the receive loop (poll, one at a time and batched) and for push mode (cms::MessageListener).
+// Also how long Stop() takes to return Start(). Needs a broker:
+//   listener_latency_bench [broker-url]   (default tcp://localhost:61616)
+//
+
+#include <activemq/library/ActiveMQCPP.h>
+#include <cms/DeliveryMode.h>
+#include <cms/MessageProducer.h>
+#include <cms/TextMessage.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cms/ConnectionManager.hpp"
+#include "cms/QueueMessageListener.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kMessages = 2000;
+constexpr auto kSendInterval = std::chrono::microseconds(500);
+
+// The message body is its send time; processMessage records how long ago that was.
+class LatencyListener : public QueueMessageListener {
+public:
+    using QueueMessageListener::QueueMessageListener;
+
+    std::mutex mutex;
+    std::vector<double> latenciesUs;
+    std::atomic<int> received{0};
+
+private:
+    void processMessage(const std::string& message) override {
+        const auto sent = Clock::time_point(Clock::duration(std::stoll(message)));
+        const double us = std::chrono::duration<double, std::micro>(Clock::now() - sent).count();
+        {
+            std::lock_guard lock(mutex);
+            latenciesUs.push_back(us);
+        }
+        ++received;
+    }
+};
+
+double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) return 0;
+    const auto index = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index];
+}
+
+void run(const char* mode, const std::shared_ptr<ConnectionManager>& connection, const ReceiveSettings& settings) {
+    const std::string queue = std::string("bench.listener-latency.") + mode;
+    auto listener = std::make_shared<LatencyListener>(connection);
+    listener->UseReceiveSettings(settings);
+    std::thread receiver([&] { listener->Start(queue); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));   // consumer registered
+
+    auto session = connection->CreateSession();
+    std::unique_ptr<cms::Destination> destination(session->createQueue(queue));
+    std::unique_ptr<cms::MessageProducer> producer(session->createProducer(destination.get()));
+    producer->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+    for (int i = 0; i < kMessages; ++i) {
+        std::unique_ptr<cms::TextMessage> message(
+            session->createTextMessage(std::to_string(Clock::now().time_since_epoch().count())));
+        producer->send(message.get());
+        std::this_thread::sleep_for(kSendInterval);
+    }
+
+    const auto deadline = Clock::now() + std::chrono::seconds(10);
+    while (listener->received < kMessages && Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    // Idle for a moment so a poll loop is parked in receive() when Stop() comes.
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    const auto stopStart = Clock::now();
+    listener->Stop();
+    receiver.join();
+    const double stopMs = std::chrono::duration<double, std::milli>(Clock::now() - stopStart).count();
+
+    producer->close();
+    session->close();
+
+    std::vector<double> latencies;
+    {
+        std::lock_guard lock(listener->mutex);
+        latencies = listener->latenciesUs;
+    }
+    std::printf("%-14s %8d %10.1f %10.1f %10.1f %10.1f\n", mode, listener->received.load(),
+                percentile(latencies, 0.50), percentile(latencies, 0.99), percentile(latencies, 1.0), stopMs);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string broker = argc > 1 ? argv[1] : "tcp://localhost:61616";
+    activemq::library::ActiveMQCPP::initializeLibrary();
+    {
+        auto connection = std::make_shared<ConnectionManager>();
+        connection->initialize(broker);
+
+        std::printf("%d messages, one every %lld us\n", kMessages, static_cast<long long>(kSendInterval.count()));
+        std::printf("%-14s %8s %10s %10s %10s %10s\n", "mode", "received", "p50 us", "p99 us", "max us", "stop ms");
+
+        ReceiveSettings poll;
+        run("poll", connection, poll);
+
+        ReceiveSettings batched;
+        batched.batchSize = 64;
+        run("poll-batch64", connection, batched);
+
+        ReceiveSettings push;
+        push.push = true;
+        run("push", connection, push);
+
+        connection->shutdown();
+    }
+    activemq::library::ActiveMQCPP::shutdownLibrary();
+    return 0;
+}
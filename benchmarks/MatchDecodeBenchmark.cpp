@@ -0,0 +1,92 @@
+//
+// MatchDecodeBenchmark.cpp
+// Cost of turning one MATCHES row into a domain::Match: the previous path (parse the JSONB
+// document with nlohmann) against decoding the typed columns (match_columns::Decode).
+// Rows are held in memory, so this measures client-side decode only, not the query.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "persistence/repository/MatchRowDecoder.hpp"
+
+namespace {
+
+// Just enough of the pqxx::field / pqxx::row surface for match_columns::Decode.
+struct FakeField {
+    std::optional<std::string> value;
+    bool is_null() const { return !value.has_value(); }
+    const char* c_str() const { return value ? value->c_str() : ""; }
+    template<typename T> T as() const { return static_cast<T>(std::stol(*value)); }
+};
+
+struct FakeRow {
+    std::vector<FakeField> fields;
+    const FakeField& operator[](std::size_t i) const { return fields[i]; }
+};
+
+constexpr int kRows = 200000;
+
+const char* kDocument =
+    R"({"tournamentId":"0b0e2f6c-3c1f-4d8e-9f50-8a6f0f5c2d11","round":"group",)"
+    R"("home":{"id":"5a3c8d4e-1f2b-4a6c-8e9d-0f1a2b3c4d5e","name":"Mexico"},)"
+    R"("visitor":{"id":"9e8d7c6b-5a4f-4e3d-2c1b-0a9f8e7d6c5b","name":"Argentina"},)"
+    R"("status":"played","score":{"home":2,"visitor":1},)"
+    R"("winnerTeamId":"5a3c8d4e-1f2b-4a6c-8e9d-0f1a2b3c4d5e","decidedBy":"regularTime"})";
+
+FakeRow typedRow() {
+    return FakeRow{{
+        {"3f2e1d0c-9b8a-4f7e-6d5c-4b3a2f1e0d9c"},
+        {"0b0e2f6c-3c1f-4d8e-9f50-8a6f0f5c2d11"},
+        {"group"},
+        {"played"},
+        {"5a3c8d4e-1f2b-4a6c-8e9d-0f1a2b3c4d5e"},
+        {"Mexico"},
+        {"9e8d7c6b-5a4f-4e3d-2c1b-0a9f8e7d6c5b"},
+        {"Argentina"},
+        {"2"},
+        {"1"},
+        {"5a3c8d4e-1f2b-4a6c-8e9d-0f1a2b3c4d5e"},
+        {"regularTime"},
+        {std::nullopt},
+        {std::nullopt},
+    }};
+}
+
+template<class Body>
+double nsPerRow(Body body) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRows; ++i) body();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / kRows;
+}
+
+}
+
+int main() {
+    const std::string id = "3f2e1d0c-9b8a-4f7e-6d5c-4b3a2f1e0d9c";
+    const std::string document = kDocument;
+    const FakeRow row = typedRow();
+    std::size_t sink = 0;
+
+    const double json = nsPerRow([&] {
+        domain::Match m = nlohmann::json::parse(document).get<domain::Match>();
+        m.Id() = id;
+        sink += m.Home().Name().size();
+    });
+    const double typed = nsPerRow([&] {
+        const domain::Match m = match_columns::Decode(row);
+        sink += m.Home().Name().size();
+    });
+
+    std::printf("ns per decoded match row (%d rows)\n", kRows);
+    std::printf("%-22s %10.1f\n", "jsonb document", json);
+    std::printf("%-22s %10.1f\n", "typed columns", typed);
+    std::printf("speedup %.1fx (sink %zu)\n", json / typed, sink);
+    return 0;
+}
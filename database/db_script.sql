@@ -27,17 +27,30 @@ CREATE TABLE TEAMS (
     id UUID DEFAULT uuid_generate_v4() PRIMARY KEY,
     document JSONB NOT NULL,
     last_update_date TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
-    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+    created_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP
 );
 CREATE UNIQUE INDEX team_unique_name_idx ON teams ((document->>'name'));
+-- Keyset pagination order for GET /teams (see database/migrations/003_keyset_pagination.sql).
+CREATE INDEX team_created_at_id_idx ON TEAMS (created_at, id);
 
 CREATE TABLE TOURNAMENTS (
     id UUID DEFAULT uuid_generate_v4() PRIMARY KEY,
     document JSONB NOT NULL,
     last_update_date TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
-    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+    created_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP
 );
 CREATE UNIQUE INDEX tournament_unique_name_idx ON TOURNAMENTS ((document->>'name'));
+CREATE INDEX tournament_created_at_id_idx ON TOURNAMENTS (created_at, id);
+-- Cache invalidation feed of the service instances (see database/migrations/004_tournament_change_notify.sql).
+CREATE FUNCTION notify_tournament_changed() RETURNS trigger AS $$
+BEGIN
+    PERFORM pg_notify('tournament_changed', OLD.id::text);
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+CREATE TRIGGER tournament_changed_notify
+    AFTER UPDATE OR DELETE ON TOURNAMENTS
+    FOR EACH ROW EXECUTE FUNCTION notify_tournament_changed();
 
 CREATE TABLE GROUPS (
     id UUID DEFAULT uuid_generate_v4() PRIMARY KEY,
@@ -48,28 +61,63 @@ CREATE TABLE GROUPS (
 );
 CREATE UNIQUE INDEX tournament_group_unique_name_idx ON GROUPS (tournament_id,(document->>'name'));
 
--- Matches table: stores per-match JSON document and links to its tournament
+-- Which group each team plays in, kept by GroupRepository next to groups.document->'teams'.
+-- A team can only be in one group per tournament (enforced here, not by a read-then-write check).
+CREATE TABLE GROUP_TEAMS (
+    tournament_id UUID NOT NULL REFERENCES TOURNAMENTS(id) ON DELETE CASCADE,
+    group_id UUID NOT NULL REFERENCES GROUPS(id) ON DELETE CASCADE,
+    team_id UUID NOT NULL REFERENCES TEAMS(id) ON DELETE CASCADE,
+    PRIMARY KEY (group_id, team_id)
+);
+CREATE UNIQUE INDEX group_teams_unique_team_idx ON GROUP_TEAMS (tournament_id, team_id);
+
+-- Group tables, updated by every group score in the same transaction (see database/migrations/005_standings.sql).
+CREATE TABLE STANDINGS (
+    tournament_id UUID NOT NULL,
+    group_id UUID NOT NULL,
+    team_id UUID NOT NULL,
+    played INT NOT NULL DEFAULT 0,
+    won INT NOT NULL DEFAULT 0,
+    lost INT NOT NULL DEFAULT 0,
+    goals_for INT NOT NULL DEFAULT 0,
+    goals_against INT NOT NULL DEFAULT 0,
+    points INT NOT NULL DEFAULT 0,
+    last_update_date TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    PRIMARY KEY (tournament_id, team_id),
+    FOREIGN KEY (group_id, team_id) REFERENCES GROUP_TEAMS(group_id, team_id) ON DELETE CASCADE
+);
+
+-- Matches table: stores per-match JSON document and links to its tournament.
+-- The document is the source of truth; typed columns are generated from it so reads
+-- never need to parse JSON (see database/migrations/001_match_typed_columns.sql).
 CREATE TABLE MATCHES (
                          id UUID DEFAULT uuid_generate_v4() PRIMARY KEY,
                          tournament_id UUID NOT NULL REFERENCES TOURNAMENTS(id) ON DELETE CASCADE,
                          document JSONB NOT NULL,
+                         round_key TEXT GENERATED ALWAYS AS (document->>'round') STORED,
+                         status TEXT GENERATED ALWAYS AS (document->>'status') STORED,
+                         home_id_key UUID GENERATED ALWAYS AS (NULLIF(document->'home'->>'id', '')::uuid) STORED,
+                         home_name TEXT GENERATED ALWAYS AS (document->'home'->>'name') STORED,
+                         visitor_id_key UUID GENERATED ALWAYS AS (NULLIF(document->'visitor'->>'id', '')::uuid) STORED,
+                         visitor_name TEXT GENERATED ALWAYS AS (document->'visitor'->>'name') STORED,
+                         score_home INT GENERATED ALWAYS AS ((document->'score'->>'home')::int) STORED,
+                         score_visitor INT GENERATED ALWAYS AS ((document->'score'->>'visitor')::int) STORED,
+                         winner_team_id UUID GENERATED ALWAYS AS (NULLIF(document->>'winnerTeamId', '')::uuid) STORED,
+                         decided_by TEXT GENERATED ALWAYS AS (document->>'decidedBy') STORED,
+                         next_match_id UUID GENERATED ALWAYS AS (NULLIF(document->>'nextMatchId', '')::uuid) STORED,
+                         next_match_winner_slot TEXT GENERATED ALWAYS AS (document->>'nextMatchWinnerSlot') STORED,
                          last_update_date TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
-                         created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+                         created_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP
 );
 
--- Fast listing/filtering by tournament
-CREATE INDEX idx_matches_tournament ON MATCHES (tournament_id);
+-- Fast listing/filtering by tournament, in keyset pagination order
+CREATE INDEX match_tournament_created_at_id_idx ON MATCHES (tournament_id, created_at, id);
 
--- Prevent exact duplicates for the same tournament/round/home/visitor
+-- Prevent exact duplicates for the same tournament/round/home/visitor (target of ON CONFLICT).
 -- (Note: this forbids A(home)-B(visitor) duplicates; if you want to also
 -- forbid B(home)-A(visitor) as the "same" game, we can add a trigger later.)
 CREATE UNIQUE INDEX match_unique_per_round_idx
-    ON MATCHES (
-                tournament_id,
-        (document->>'round'),
-        (document->'home'->>'id'),
-        (document->'visitor'->>'id')
-        );
+    ON MATCHES (tournament_id, round_key, home_id_key, visitor_id_key);
 
 -- Keep JSON document consistent with the relational FK (helps catch bugs early)
 ALTER TABLE MATCHES
@@ -77,7 +125,21 @@ ALTER TABLE MATCHES
         CHECK ( (document->>'tournamentId')::uuid = tournament_id );
 
 
+-- Events written in the same transaction as the change they announce; published by the services'
+-- relay (see database/migrations/006_outbox.sql).
+CREATE TABLE OUTBOX (
+    id BIGSERIAL PRIMARY KEY,
+    queue TEXT NOT NULL,
+    payload TEXT NOT NULL,
+    created_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,
+    published_at TIMESTAMP
+);
+
+CREATE INDEX outbox_pending_idx ON OUTBOX (id) WHERE published_at IS NULL;
+
+
 GRANT SELECT ON ALL TABLES IN SCHEMA public TO tournament_svc;
 GRANT DELETE ON ALL TABLES IN SCHEMA public TO tournament_svc;
 GRANT UPDATE ON ALL TABLES IN SCHEMA public TO tournament_svc;
 GRANT INSERT ON ALL TABLES IN SCHEMA public TO tournament_svc;
+GRANT USAGE, SELECT ON ALL SEQUENCES IN SCHEMA public TO tournament_svc;
@@ -0,0 +1,29 @@
+-- Promotes the match fields the repository reads into typed generated columns and moves the
+-- natural-key unique index onto them (ON CONFLICT (tournament_id, round_key, home_id_key, visitor_id_key)).
+-- Existing rows are filled in by the table rewrite of ADD COLUMN ... STORED; the document stays the
+-- source of truth, so writes are unchanged.
+--
+-- podman exec -i tournament_db psql -U tournament_admin -d tournament_db < database/migrations/001_match_typed_columns.sql
+
+BEGIN;
+
+ALTER TABLE MATCHES
+    ADD COLUMN IF NOT EXISTS round_key TEXT GENERATED ALWAYS AS (document->>'round') STORED,
+    ADD COLUMN IF NOT EXISTS status TEXT GENERATED ALWAYS AS (document->>'status') STORED,
+    ADD COLUMN IF NOT EXISTS home_id_key UUID GENERATED ALWAYS AS (NULLIF(document->'home'->>'id', '')::uuid) STORED,
+    ADD COLUMN IF NOT EXISTS home_name TEXT GENERATED ALWAYS AS (document->'home'->>'name') STORED,
+    ADD COLUMN IF NOT EXISTS visitor_id_key UUID GENERATED ALWAYS AS (NULLIF(document->'visitor'->>'id', '')::uuid) STORED,
+    ADD COLUMN IF NOT EXISTS visitor_name TEXT GENERATED ALWAYS AS (document->'visitor'->>'name') STORED,
+    ADD COLUMN IF NOT EXISTS score_home INT GENERATED ALWAYS AS ((document->'score'->>'home')::int) STORED,
+    ADD COLUMN IF NOT EXISTS score_visitor INT GENERATED ALWAYS AS ((document->'score'->>'visitor')::int) STORED,
+    ADD COLUMN IF NOT EXISTS winner_team_id UUID GENERATED ALWAYS AS (NULLIF(document->>'winnerTeamId', '')::uuid) STORED,
+    ADD COLUMN IF NOT EXISTS decided_by TEXT GENERATED ALWAYS AS (document->>'decidedBy') STORED,
+    ADD COLUMN IF NOT EXISTS next_match_id UUID GENERATED ALWAYS AS (NULLIF(document->>'nextMatchId', '')::uuid) STORED,
+    ADD COLUMN IF NOT EXISTS next_match_winner_slot TEXT GENERATED ALWAYS AS (document->>'nextMatchWinnerSlot') STORED;
+
+-- Same key as before, now over plain columns.
+DROP INDEX IF EXISTS match_unique_per_round_idx;
+CREATE UNIQUE INDEX match_unique_per_round_idx
+    ON MATCHES (tournament_id, round_key, home_id_key, visitor_id_key);
+
+COMMIT;
@@ -0,0 +1,34 @@
+-- Normalized team membership: replaces the JSONB containment scan behind "which group is this
+-- team in" with an index probe, and makes "one group per team per tournament" a database rule.
+-- Backfills from groups.document->'teams'; if existing data already has a team in two groups of
+-- the same tournament, the first group (by creation) keeps it and the rest are reported below.
+--
+-- podman exec -i tournament_db psql -U tournament_admin -d tournament_db < database/migrations/002_group_teams.sql
+
+BEGIN;
+
+CREATE TABLE IF NOT EXISTS GROUP_TEAMS (
+    tournament_id UUID NOT NULL REFERENCES TOURNAMENTS(id) ON DELETE CASCADE,
+    group_id UUID NOT NULL REFERENCES GROUPS(id) ON DELETE CASCADE,
+    team_id UUID NOT NULL REFERENCES TEAMS(id) ON DELETE CASCADE,
+    PRIMARY KEY (group_id, team_id)
+);
+CREATE UNIQUE INDEX IF NOT EXISTS group_teams_unique_team_idx ON GROUP_TEAMS (tournament_id, team_id);
+
+INSERT INTO GROUP_TEAMS (tournament_id, group_id, team_id)
+SELECT g.tournament_id, g.id, (t->>'id')::uuid
+FROM GROUPS g
+CROSS JOIN LATERAL jsonb_array_elements(COALESCE(g.document->'teams', '[]'::jsonb)) AS t
+WHERE (t->>'id') IN (SELECT id::text FROM TEAMS)
+ORDER BY g.created_at
+ON CONFLICT DO NOTHING;
+
+-- Teams listed in a group document but without a membership row (duplicates or unknown ids).
+SELECT g.tournament_id, g.id AS group_id, t->>'id' AS team_id
+FROM GROUPS g
+CROSS JOIN LATERAL jsonb_array_elements(COALESCE(g.document->'teams', '[]'::jsonb)) AS t
+WHERE NOT EXISTS (SELECT 1 FROM GROUP_TEAMS gt WHERE gt.group_id = g.id AND gt.team_id::text = t->>'id');
+
+GRANT SELECT, INSERT, UPDATE, DELETE ON GROUP_TEAMS TO tournament_svc;
+
+COMMIT;
@@ -0,0 +1,24 @@
+-- Keyset pagination for GET /teams, GET /tournaments and GET /tournaments/{id}/matches.
+-- Pages are read with WHERE (created_at, id) > (cursor) ORDER BY created_at, id LIMIT n, so each
+-- listing needs an index in exactly that order; created_at must be non-null for the row
+-- comparison to include every row.
+--
+-- podman exec -i tournament_db psql -U tournament_admin -d tournament_db < database/migrations/003_keyset_pagination.sql
+
+BEGIN;
+
+UPDATE TEAMS SET created_at = CURRENT_TIMESTAMP WHERE created_at IS NULL;
+UPDATE TOURNAMENTS SET created_at = CURRENT_TIMESTAMP WHERE created_at IS NULL;
+UPDATE MATCHES SET created_at = CURRENT_TIMESTAMP WHERE created_at IS NULL;
+
+ALTER TABLE TEAMS ALTER COLUMN created_at SET NOT NULL;
+ALTER TABLE TOURNAMENTS ALTER COLUMN created_at SET NOT NULL;
+ALTER TABLE MATCHES ALTER COLUMN created_at SET NOT NULL;
+
+CREATE INDEX IF NOT EXISTS team_created_at_id_idx ON TEAMS (created_at, id);
+CREATE INDEX IF NOT EXISTS tournament_created_at_id_idx ON TOURNAMENTS (created_at, id);
+-- Leads with tournament_id, so it also serves every lookup idx_matches_tournament did.
+CREATE INDEX IF NOT EXISTS match_tournament_created_at_id_idx ON MATCHES (tournament_id, created_at, id);
+DROP INDEX IF EXISTS idx_matches_tournament;
+
+COMMIT;
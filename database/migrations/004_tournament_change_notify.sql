@@ -0,0 +1,24 @@
+-- Invalidation feed of the tournament cache: every committed UPDATE or DELETE of a tournament sends
+-- NOTIFY tournament_changed with its id (delivered at commit, nothing is sent on rollback). Each
+-- service instance LISTENs on that channel (TournamentChangeListener) and drops the id from its
+-- cache, so a tournament changed through one instance behind haproxy is not served stale by the others.
+-- A trigger rather than a statement in the repository: writes made outside the services
+-- (psql, migrations) invalidate the caches as well.
+--
+-- podman exec -i tournament_db psql -U tournament_admin -d tournament_db < database/migrations/004_tournament_change_notify.sql
+
+BEGIN;
+
+CREATE OR REPLACE FUNCTION notify_tournament_changed() RETURNS trigger AS $$
+BEGIN
+    PERFORM pg_notify('tournament_changed', OLD.id::text);
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+DROP TRIGGER IF EXISTS tournament_changed_notify ON TOURNAMENTS;
+CREATE TRIGGER tournament_changed_notify
+    AFTER UPDATE OR DELETE ON TOURNAMENTS
+    FOR EACH ROW EXECUTE FUNCTION notify_tournament_changed();
+
+COMMIT;
@@ -0,0 +1,45 @@
+-- Materialized group tables. MatchDelegate::UpdateScore adds the difference between the old and the new
+-- score of a group match to the two teams' rows, in the same transaction as the match update, so
+-- GET /tournaments/{id}/standings and the knockout bracket read the table instead of replaying every
+-- match. A row is created by the first score of its team; teams without one show as zeros.
+-- Rows follow their membership (GROUP_TEAMS): a team leaving a group takes its row with it.
+-- Backfills from the group matches already played.
+--
+-- podman exec -i tournament_db psql -U tournament_admin -d tournament_db < database/migrations/005_standings.sql
+
+BEGIN;
+
+CREATE TABLE IF NOT EXISTS STANDINGS (
+    tournament_id UUID NOT NULL,
+    group_id UUID NOT NULL,
+    team_id UUID NOT NULL,
+    played INT NOT NULL DEFAULT 0,
+    won INT NOT NULL DEFAULT 0,
+    lost INT NOT NULL DEFAULT 0,
+    goals_for INT NOT NULL DEFAULT 0,
+    goals_against INT NOT NULL DEFAULT 0,
+    points INT NOT NULL DEFAULT 0,
+    last_update_date TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    PRIMARY KEY (tournament_id, team_id),
+    FOREIGN KEY (group_id, team_id) REFERENCES GROUP_TEAMS(group_id, team_id) ON DELETE CASCADE
+);
+
+-- Same counting as the service: 3 points a win, a draw only adds the match and the goals.
+INSERT INTO STANDINGS (tournament_id, group_id, team_id, played, won, lost, goals_for, goals_against, points)
+SELECT gt.tournament_id, gt.group_id, gt.team_id,
+       count(*), count(*) FILTER (WHERE r.gf > r.ga), count(*) FILTER (WHERE r.gf < r.ga),
+       sum(r.gf), sum(r.ga), 3 * count(*) FILTER (WHERE r.gf > r.ga)
+FROM (
+    SELECT tournament_id, home_id_key AS team_id, score_home AS gf, score_visitor AS ga
+    FROM MATCHES WHERE round_key = 'group' AND score_home IS NOT NULL AND score_visitor IS NOT NULL
+    UNION ALL
+    SELECT tournament_id, visitor_id_key, score_visitor, score_home
+    FROM MATCHES WHERE round_key = 'group' AND score_home IS NOT NULL AND score_visitor IS NOT NULL
+) r
+JOIN GROUP_TEAMS gt ON gt.tournament_id = r.tournament_id AND gt.team_id = r.team_id
+GROUP BY gt.tournament_id, gt.group_id, gt.team_id
+ON CONFLICT (tournament_id, team_id) DO NOTHING;
+
+GRANT SELECT, INSERT, UPDATE, DELETE ON STANDINGS TO tournament_svc;
+
+COMMIT;
@@ -0,0 +1,25 @@
+-- Transactional outbox. GroupDelegate::AddTeamToGroup writes its event (tournament.team-add) here in the
+-- same transaction as the group change, so the event exists exactly when the change does and the HTTP
+-- request does no broker I/O. The relay of each tournament_services instance (cms/OutboxRelay.hpp) claims
+-- the oldest unpublished rows with FOR UPDATE SKIP LOCKED, publishes them and stamps published_at; rows
+-- claimed by one instance are skipped by the others. Published rows are purged after a retention period.
+--
+-- podman exec -i tournament_db psql -U tournament_admin -d tournament_db < database/migrations/006_outbox.sql
+
+BEGIN;
+
+CREATE TABLE IF NOT EXISTS OUTBOX (
+    id BIGSERIAL PRIMARY KEY,
+    queue TEXT NOT NULL,
+    payload TEXT NOT NULL,
+    created_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,
+    published_at TIMESTAMP
+);
+
+-- What the relay scans: only the pending rows, in id order.
+CREATE INDEX IF NOT EXISTS outbox_pending_idx ON OUTBOX (id) WHERE published_at IS NULL;
+
+GRANT SELECT, INSERT, UPDATE, DELETE ON OUTBOX TO tournament_svc;
+GRANT USAGE, SELECT ON SEQUENCE outbox_id_seq TO tournament_svc;
+
+COMMIT;
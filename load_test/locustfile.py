@@ -1,13 +1,33 @@
 from typing import Any
-from locust import HttpUser, task
+from locust import HttpUser, events, task
+import random
 import uuid
 
 NUMBER_OF_GROUPS = 8
 TEAMS_PER_GROUP = 4
 TOTAL_TEAMS = NUMBER_OF_GROUPS * TEAMS_PER_GROUP
+# Scores sent per record_scores run (PATCH throughput benchmark)
+SCORES_PER_TASK = 8
+
+# Conditional GET results of the polling task, per endpoint: {"304": n, "200": n}
+POLL_RESULTS: dict[str, dict[str, int]] = {}
+
+
+@events.test_stop.add_listener
+def report_not_modified(environment, **kwargs):
+    for name, counts in sorted(POLL_RESULTS.items()):
+        total = counts["200"] + counts["304"]
+        if total:
+            print(f"[poll] {name}: {counts['304']}/{total} answered 304 "
+                  f"({100.0 * counts['304'] / total:.1f}%), {counts['200']} full bodies")
 
 class TournamentUser(HttpUser):
 
+    def on_start(self):
+        self.tournament_ids: list[str] = []
+        # url -> last ETag seen, sent back in If-None-Match like a polling client would
+        self.etags: dict[str, str] = {}
+
     def _extract_id_from_location(self, location: str | None) -> str | None:
         if not location:
             return None
@@ -97,6 +117,7 @@ class TournamentUser(HttpUser):
         tournament_id = self.create_tournament()
         if not tournament_id:
             return
+        self.tournament_ids.append(tournament_id)
 
         groups = self.create_groups(tournament_id)
         if len(groups) != NUMBER_OF_GROUPS:
@@ -107,3 +128,53 @@ class TournamentUser(HttpUser):
             start = i * TEAMS_PER_GROUP
             end = start + TEAMS_PER_GROUP
             self.add_teams_to_group(tournament_id, group_id, teams[start:end])
+
+    def poll(self, url: str, name: str):
+        headers = {"If-None-Match": self.etags[url]} if url in self.etags else {}
+        with self.client.get(url, headers=headers, catch_response=True, name=name) as response:
+            if response.status_code not in (200, 304):
+                response.failure(f"Poll failed: {response.status_code}")
+                return
+            counts = POLL_RESULTS.setdefault(name, {"200": 0, "304": 0})
+            counts[str(response.status_code)] += 1
+            etag = response.headers.get("ETag")
+            if etag:
+                self.etags[url] = etag
+            response.success()
+
+    @task(5)
+    def poll_tournament(self):
+        if not self.tournament_ids:
+            return
+        tournament_id = self.tournament_ids[-1]
+        self.poll(f"/tournaments/{tournament_id}", "GET /tournaments/{tournament_id}")
+        self.poll(f"/tournaments/{tournament_id}/matches", "GET /tournaments/{tournament_id}/matches")
+
+    @task(3)
+    def record_scores(self):
+        if not self.tournament_ids:
+            return
+        tournament_id = self.tournament_ids[-1]
+        with self.client.get(
+                f"/tournaments/{tournament_id}/matches?showMatches=pending",
+                catch_response=True,
+                name="GET /tournaments/{tournament_id}/matches?showMatches=pending"
+        ) as response:
+            if response.status_code != 200:
+                response.failure(f"Read pending matches failed: {response.status_code}")
+                return
+            matches = response.json()
+            response.success()
+
+        for match in matches[:SCORES_PER_TASK]:
+            # No draws, so knockout matches accept the score too
+            home = random.randint(1, 4)
+            score = {"score": {"home": home, "visitor": random.randint(0, home - 1)}}
+            with self.client.patch(
+                    f"/tournaments/{tournament_id}/matches/{match['id']}",
+                    json=score,
+                    catch_response=True,
+                    name="PATCH /tournaments/{tournament_id}/matches/{match_id}"
+            ) as response:
+                if response.status_code != 204:
+                    response.failure(f"Score update failed: {response.status_code}")
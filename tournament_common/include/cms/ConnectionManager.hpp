@@ -79,6 +79,15 @@ public:
             conn->createSession(cms::Session::AUTO_ACKNOWLEDGE));
     }
 
+    // Same, with another mode (SESSION_TRANSACTED for batched sends).
+    [[nodiscard]] virtual std::shared_ptr<cms::Session> CreateSession(cms::Session::AcknowledgeMode mode) const {
+        auto conn = connection_;
+        if (!conn) {
+            throw std::runtime_error("[ConnectionManager] CreateSession(): connection not initialized");
+        }
+        return std::shared_ptr<cms::Session>(conn->createSession(mode));
+    }
+
     // Virtual destructor so deleting through base pointer is safe
     virtual ~ConnectionManager() {
         // best-effort shutdown
@@ -1,39 +1,45 @@
 //
 // Created by root on 9/24/25.
 //
+// Push-mode consumer: Start() registers this object as the queue consumer's cms::MessageListener and
+// returns; the client's session thread calls onMessage for each message. Stop() closes the consumer
+// (waiting for an onMessage in progress) and the session.
+//
 
 #ifndef COMMON_QUEUE_MESSAGE_CONSUMER_HPP
 #define COMMON_QUEUE_MESSAGE_CONSUMER_HPP
 
 
-#include <atomic>
 #include <memory>
-#include <thread>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <cms/CMSException.h>
 #include <cms/MessageConsumer.h>
+#include <cms/MessageListener.h>
+#include <cms/Queue.h>
 #include <cms/Session.h>
+#include <cms/TextMessage.h>
 #include <print>
 
 #include "cms/ConnectionManager.hpp"
 
 class QueueMessageConsumer : public cms::MessageListener {
     std::shared_ptr<ConnectionManager> connectionManager;
-    std::atomic<bool> running;
-    std::thread worker;
-    // std::shared_ptr<cms::Connection> connection;
+    std::mutex mutex;
     std::shared_ptr<cms::Session> session;
     std::shared_ptr<cms::MessageConsumer> messageConsumer;
 
-    // void readMessage();
 public:
     explicit QueueMessageConsumer(const std::shared_ptr<ConnectionManager>& connectionManager);
-    ~QueueMessageConsumer();
+    ~QueueMessageConsumer() override;
     void Start(const std::string_view & queueName);
     void Stop();
-    virtual void onMessage(const cms::Message* message);
+    void onMessage(const cms::Message* message) override;
 };
 
 inline QueueMessageConsumer::QueueMessageConsumer(const std::shared_ptr<ConnectionManager>& connectionManager) : connectionManager(connectionManager) {
-    std::print("Created QueueMessageConsumer");
+    std::print("Created QueueMessageConsumer\n");
 }
 
 inline QueueMessageConsumer::~QueueMessageConsumer() {
@@ -41,60 +47,41 @@ inline QueueMessageConsumer::~QueueMessageConsumer() {
 }
 
 inline void QueueMessageConsumer::Start(const std::string_view& queueName) {
-    if (this->running)
+    std::lock_guard lock(mutex);
+    if (messageConsumer)
         return;
-    this->running = true;
     try {
         session = connectionManager->CreateSession();
-        const auto destination = std::unique_ptr<cms::Queue>(session->createQueue(queueName.data()));
-        auto consumer = std::unique_ptr<cms::MessageConsumer>(session->createConsumer(destination.get()));
-
-        while (running) {
-            std::unique_ptr<cms::Message> message(consumer->receive(1500));
-            if (message) {
-                if (auto text = dynamic_cast<cms::TextMessage*>(message.get())) {
-                    std::print("message consumed: {}", text->getText());
-                }
-            }
-        }
+        const auto destination = std::unique_ptr<cms::Queue>(session->createQueue(std::string(queueName)));
+        messageConsumer.reset(session->createConsumer(destination.get()));
+        messageConsumer->setMessageListener(this);
     } catch (const cms::CMSException& e) {
-
+        std::print("QueueMessageConsumer start failed: {}\n", e.getMessage());
+        messageConsumer.reset();
+        session.reset();
     }
 }
 
 inline void QueueMessageConsumer::Stop() {
-    running = false;
-    if (worker.joinable())
-        worker.join();
-
-    messageConsumer->close();
-    session->close();
-    // connection->close();
+    std::lock_guard lock(mutex);
+    if (messageConsumer) {
+        try { messageConsumer->close(); } catch (...) {}
+        messageConsumer.reset();
+    }
+    if (session) {
+        try { session->close(); } catch (...) {}
+        session.reset();
+    }
 }
 
 inline void QueueMessageConsumer::onMessage(const cms::Message* message) {
-
+    try {
+        if (auto text = dynamic_cast<const cms::TextMessage*>(message)) {
+            std::print("message consumed: {}\n", text->getText());
+        }
+    } catch (const cms::CMSException& e) {
+        std::print("QueueMessageConsumer onMessage failed: {}\n", e.getMessage());
+    }
 }
 
-// inline void QueueMessageConsumer::readMessage() {
-//     try {
-//         if (this->running)
-//             return;
-//         session = connectionManager->CreateSession();
-//         const auto destination = std::unique_ptr<cms::Destination>(session->createQueue(queueName));
-//         auto consumer = std::unique_ptr<cms::MessageConsumer>(session->createConsumer(destination.get()));
-//
-//         while (running) {
-//             std::unique_ptr<cms::Message> message(consumer->receive(1000));
-//             if (message) {
-//                 if (auto text = dynamic_cast<cms::TextMessage*>(message.get())) {
-//                     std::print("message consumed: {}", text->getText());
-//                 }
-//             }
-//         }
-//     } catch (const cms::CMSException& e) {
-//
-//     }
-// }
-
-#endif //COMMON_QUEUE_MESSAGE_CONSUMER_HPP
\ No newline at end of file
+#endif //COMMON_QUEUE_MESSAGE_CONSUMER_HPP
@@ -1,15 +1,84 @@
 #ifndef DATA_BASE_CONFIGURATION_HPP
 #define DATA_BASE_CONFIGURATION_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <string>
+#include <nlohmann/json.hpp>
 
 namespace config {
     struct DatabaseConfiguration{
         std::string connectionString;
+
+        // Elastic pool sizing: poolMin connections are opened eagerly, the pool grows up to poolMax on demand.
+        std::size_t poolMin = 1;
+        std::size_t poolMax = 2;
+        // How long Connection() waits for a free connection before failing.
+        int acquireTimeoutMs = 5000;
+        // Idle connections above poolMin are closed after this long without use.
+        int idleTimeoutMs = 60000;
+        // A connection idle for longer than this is validated (and reconnected if broken) before being handed out.
+        int validationIntervalMs = 30000;
+        // "shared": any thread takes any idle connection. "affinity": each worker thread gets a sticky home
+        // connection and falls back to the rest of the pool when it is busy.
+        std::string poolMode = "shared";
+
+        // Optional read replica ("replica" object). When empty, reads use the primary pool.
+        std::string replicaConnectionString;
+        std::size_t replicaPoolMin = 1;
+        std::size_t replicaPoolMax = 2;
+        // After a write, the same thread keeps reading from the primary for this long (replication lag bound).
+        int readYourWritesMs = 2000;
+
+        // Process-wide tournament cache ("tournamentCache" object). maxEntries 0 disables it.
+        std::size_t tournamentCacheMaxEntries = 1024;
+        std::size_t tournamentCacheShards = 16;
+
+        // Taken team/tournament names remembered to answer repeated POSTs with 409 without a query
+        // ("nameFilter" object). ttlMs 0 (default) disables it; see TakenNameFilter.hpp.
+        int nameFilterTtlMs = 0;
+        std::size_t nameFilterMaxEntries = 4096;
     };
 
     inline void from_json(const nlohmann::json& json, DatabaseConfiguration& databaseConfiguration) {
         json.at("connectionString").get_to(databaseConfiguration.connectionString);
+
+        // "poolSize" is the legacy fixed size; it still works as the upper bound when poolMax is absent.
+        const auto legacyPoolSize = json.value("poolSize", databaseConfiguration.poolMax);
+        databaseConfiguration.poolMax = json.value("poolMax", legacyPoolSize);
+        databaseConfiguration.poolMin = json.value("poolMin", databaseConfiguration.poolMin);
+        if (databaseConfiguration.poolMax == 0) {
+            databaseConfiguration.poolMax = 1;
+        }
+        if (databaseConfiguration.poolMin > databaseConfiguration.poolMax) {
+            databaseConfiguration.poolMin = databaseConfiguration.poolMax;
+        }
+
+        databaseConfiguration.acquireTimeoutMs     = json.value("acquireTimeoutMs", databaseConfiguration.acquireTimeoutMs);
+        databaseConfiguration.idleTimeoutMs        = json.value("idleTimeoutMs", databaseConfiguration.idleTimeoutMs);
+        databaseConfiguration.validationIntervalMs = json.value("validationIntervalMs", databaseConfiguration.validationIntervalMs);
+        databaseConfiguration.poolMode             = json.value("poolMode", databaseConfiguration.poolMode);
+        databaseConfiguration.readYourWritesMs     = json.value("readYourWritesMs", databaseConfiguration.readYourWritesMs);
+
+        if (json.contains("replica")) {
+            const auto& replica = json.at("replica");
+            replica.at("connectionString").get_to(databaseConfiguration.replicaConnectionString);
+            databaseConfiguration.replicaPoolMax = std::max<std::size_t>(1, replica.value("poolMax", databaseConfiguration.replicaPoolMax));
+            databaseConfiguration.replicaPoolMin = std::min(replica.value("poolMin", databaseConfiguration.replicaPoolMin),
+                                                            databaseConfiguration.replicaPoolMax);
+        }
+
+        if (json.contains("tournamentCache")) {
+            const auto& cache = json.at("tournamentCache");
+            databaseConfiguration.tournamentCacheMaxEntries = cache.value("maxEntries", databaseConfiguration.tournamentCacheMaxEntries);
+            databaseConfiguration.tournamentCacheShards = std::max<std::size_t>(1, cache.value("shards", databaseConfiguration.tournamentCacheShards));
+        }
+
+        if (json.contains("nameFilter")) {
+            const auto& filter = json.at("nameFilter");
+            databaseConfiguration.nameFilterTtlMs      = filter.value("ttlMs", databaseConfiguration.nameFilterTtlMs);
+            databaseConfiguration.nameFilterMaxEntries = filter.value("maxEntries", databaseConfiguration.nameFilterMaxEntries);
+        }
     }
 }
 #endif
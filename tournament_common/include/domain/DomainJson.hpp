@@ -0,0 +1,153 @@
+//
+// DomainJson.hpp
+// Field lists of the domain types for json_codec (JsonCodec.hpp). They give the API shape, which
+// is also what the repositories store in the document columns:
+//   Team       { id?, name }
+//   Group      { id?, name, tournamentId, teams: [Team] }
+//   Tournament { id?, name, format: { numberOfGroups, maxTeamsPerGroup, type } }
+//   Match      { id?, tournamentId, round, home, visitor, status, score?, winnerTeamId?, decidedBy?,
+//                nextMatchId?, nextMatchWinnerSlot? }
+// "?" members are left out when empty. Reading is lenient like the old from_json: unknown members
+// and members of the wrong type are ignored, except the required ones (Team and Tournament name).
+//
+
+#ifndef DOMAIN_DOMAIN_JSON_HPP
+#define DOMAIN_DOMAIN_JSON_HPP
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "domain/JsonCodec.hpp"
+#include "domain/Team.hpp"
+#include "domain/Group.hpp"
+#include "domain/Match.hpp"
+#include "domain/Tournament.hpp"
+
+namespace domain {
+    // Wire form of the match score: written only when both sides are set.
+    struct MatchScore {
+        std::optional<int> home;
+        std::optional<int> visitor;
+    };
+}
+
+namespace json_codec {
+
+    template<>
+    struct EnumNames<domain::TournamentType> {
+        static constexpr std::array names{
+            std::pair{domain::TournamentType::ROUND_ROBIN, std::string_view{"ROUND_ROBIN"}},
+            std::pair{domain::TournamentType::NFL, std::string_view{"NFL"}},
+        };
+    };
+
+    template<>
+    struct Fields<domain::Team> {
+        static constexpr auto list = std::tuple{
+            omit_empty("id", [](const domain::Team& t) -> const std::string& { return t.Id; },
+                       [](domain::Team& t, std::string&& v) { t.Id = std::move(v); }),
+            required("name", [](const domain::Team& t) -> const std::string& { return t.Name; },
+                     [](domain::Team& t, std::string&& v) { t.Name = std::move(v); }),
+        };
+    };
+
+    template<>
+    struct Fields<domain::Group> {
+        static constexpr auto list = std::tuple{
+            omit_empty("id", [](const domain::Group& g) -> const std::string& { return g.Id(); },
+                       [](domain::Group& g, std::string&& v) { g.Id() = std::move(v); }),
+            field("name", [](const domain::Group& g) -> const std::string& { return g.Name(); },
+                  [](domain::Group& g, std::string&& v) { g.Name() = std::move(v); }),
+            field("tournamentId", [](const domain::Group& g) -> const std::string& { return g.TournamentId(); },
+                  [](domain::Group& g, std::string&& v) { g.TournamentId() = std::move(v); }),
+            field("teams", [](const domain::Group& g) -> const std::vector<domain::Team>& { return g.Teams(); },
+                  [](domain::Group& g, std::vector<domain::Team>&& v) { g.Teams() = std::move(v); }),
+        };
+    };
+
+    template<>
+    struct Fields<domain::TournamentFormat> {
+        static constexpr auto list = std::tuple{
+            field("numberOfGroups", [](const domain::TournamentFormat& f) { return f.NumberOfGroups(); },
+                  [](domain::TournamentFormat& f, int&& v) { f.NumberOfGroups() = v; }),
+            field("maxTeamsPerGroup", [](const domain::TournamentFormat& f) { return f.MaxTeamsPerGroup(); },
+                  [](domain::TournamentFormat& f, int&& v) { f.MaxTeamsPerGroup() = v; }),
+            field("type", [](const domain::TournamentFormat& f) { return f.Type(); },
+                  [](domain::TournamentFormat& f, domain::TournamentType&& v) { f.Type() = v; }),
+        };
+    };
+
+    template<>
+    struct Fields<domain::Tournament> {
+        static constexpr auto list = std::tuple{
+            omit_empty("id", [](const domain::Tournament& t) -> const std::string& { return t.Id(); },
+                       [](domain::Tournament& t, std::string&& v) { t.Id() = std::move(v); }),
+            required("name", [](const domain::Tournament& t) -> const std::string& { return t.Name(); },
+                     [](domain::Tournament& t, std::string&& v) { t.Name() = std::move(v); }),
+            field("format", [](const domain::Tournament& t) -> const domain::TournamentFormat& { return t.Format(); },
+                  [](domain::Tournament& t, domain::TournamentFormat&& v) { t.Format() = v; }),
+        };
+    };
+
+    template<>
+    struct Fields<domain::TeamRef> {
+        static constexpr auto list = std::tuple{
+            field("id", [](const domain::TeamRef& t) -> const std::string& { return t.Id(); },
+                  [](domain::TeamRef& t, std::string&& v) { t.Id() = std::move(v); }),
+            field("name", [](const domain::TeamRef& t) -> const std::string& { return t.Name(); },
+                  [](domain::TeamRef& t, std::string&& v) { t.Name() = std::move(v); }),
+        };
+    };
+
+    template<>
+    struct Fields<domain::MatchScore> {
+        static constexpr auto list = std::tuple{
+            field("home", [](const domain::MatchScore& s) { return s.home; },
+                  [](domain::MatchScore& s, int&& v) { s.home = v; }),
+            field("visitor", [](const domain::MatchScore& s) { return s.visitor; },
+                  [](domain::MatchScore& s, int&& v) { s.visitor = v; }),
+        };
+    };
+
+    template<>
+    struct Fields<domain::Match> {
+        static constexpr auto list = std::tuple{
+            omit_empty("id", [](const domain::Match& m) -> const std::string& { return m.Id(); },
+                       [](domain::Match& m, std::string&& v) { m.Id() = std::move(v); }),
+            field("tournamentId", [](const domain::Match& m) -> const std::string& { return m.TournamentId(); },
+                  [](domain::Match& m, std::string&& v) { m.TournamentId() = std::move(v); }),
+            field("round", [](const domain::Match& m) -> const std::string& { return m.Round(); },
+                  [](domain::Match& m, std::string&& v) { m.Round() = std::move(v); }),
+            field("home", [](const domain::Match& m) -> const domain::TeamRef& { return m.Home(); },
+                  [](domain::Match& m, domain::TeamRef&& v) { m.Home() = std::move(v); }),
+            field("visitor", [](const domain::Match& m) -> const domain::TeamRef& { return m.Visitor(); },
+                  [](domain::Match& m, domain::TeamRef&& v) { m.Visitor() = std::move(v); }),
+            field("status", [](const domain::Match& m) -> const std::string& { return m.Status(); },
+                  [](domain::Match& m, std::string&& v) { m.Status() = std::move(v); }),
+            field("score",
+                  [](const domain::Match& m) {
+                      return m.HasScore() ? std::optional{domain::MatchScore{m.ScoreHome(), m.ScoreVisitor()}}
+                                          : std::nullopt;
+                  },
+                  [](domain::Match& m, domain::MatchScore&& s) {
+                      if (s.home && s.visitor) m.SetScore(*s.home, *s.visitor);
+                  }),
+            field("winnerTeamId", [](const domain::Match& m) -> const std::optional<std::string>& { return m.WinnerTeamId(); },
+                  [](domain::Match& m, std::string&& v) { m.SetWinnerTeamId(v); }),
+            field("decidedBy", [](const domain::Match& m) -> const std::optional<std::string>& { return m.DecidedBy(); },
+                  [](domain::Match& m, std::string&& v) { m.SetDecidedBy(v); }),
+            field("nextMatchId", [](const domain::Match& m) -> const std::optional<std::string>& { return m.NextMatchId(); },
+                  [](domain::Match& m, std::string&& v) { m.SetNextMatchId(v); }),
+            field("nextMatchWinnerSlot",
+                  [](const domain::Match& m) -> const std::optional<std::string>& { return m.NextMatchWinnerSlot(); },
+                  [](domain::Match& m, std::string&& v) { m.SetNextMatchWinnerSlot(v); }),
+        };
+    };
+}
+
+#endif //DOMAIN_DOMAIN_JSON_HPP
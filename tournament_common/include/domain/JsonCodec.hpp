@@ -0,0 +1,598 @@
+//
+// JsonCodec.hpp
+// One JSON writer and one JSON reader for every domain type, driven by constexpr field lists.
+// A type opts in by specializing json_codec::Fields<T> (see domain/DomainJson.hpp). Write appends
+// straight into the output string and Read pulls the members off the input text, so no DOM is
+// built in between. Strings are escaped per RFC 8259 (quotes, backslash, every control character)
+// and \uXXXX escapes, surrogate pairs included, are decoded to UTF-8.
+//
+
+#ifndef DOMAIN_JSON_CODEC_HPP
+#define DOMAIN_JSON_CODEC_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace json_codec {
+
+    // static constexpr auto list = std::tuple{ field(...), required(...), ... };
+    template<typename T> struct Fields;
+
+    // Enums written as strings: static constexpr std::array names{ std::pair{E::A, std::string_view{"A"}}, ... };
+    // An unknown string reads as the first entry.
+    template<typename E> struct EnumNames;
+
+    template<typename T> concept Described = requires { Fields<T>::list; };
+    template<typename T> concept NamedEnum = std::is_enum_v<T> && requires { EnumNames<T>::names; };
+
+    // get: (const Owner&) -> value, or std::optional<value> (nullopt: the member is not written).
+    // set: (Owner&, value&&); only called for members present in the input with the right type.
+    template<typename Get, typename Set>
+    struct Field {
+        std::string_view name;
+        Get get;
+        Set set;
+        bool required = false;   // reading fails when the member is missing or has the wrong type
+        bool omitEmpty = false;  // an empty string is not written (ids not assigned yet)
+    };
+
+    template<typename Get, typename Set>
+    constexpr Field<Get, Set> field(std::string_view name, Get get, Set set) {
+        return {name, get, set};
+    }
+
+    template<typename Get, typename Set>
+    constexpr Field<Get, Set> required(std::string_view name, Get get, Set set) {
+        return {name, get, set, true, false};
+    }
+
+    template<typename Get, typename Set>
+    constexpr Field<Get, Set> omit_empty(std::string_view name, Get get, Set set) {
+        return {name, get, set, false, true};
+    }
+
+    struct ReadError {
+        enum class Kind { Syntax, Field };
+        Kind kind = Kind::Syntax;
+        std::string message;
+    };
+
+    namespace detail {
+        template<typename T> struct is_optional : std::false_type {};
+        template<typename T> struct is_optional<std::optional<T>> : std::true_type {};
+        template<typename T> struct is_vector : std::false_type {};
+        template<typename T> struct is_vector<std::vector<T>> : std::true_type {};
+        template<typename T> struct is_shared_ptr : std::false_type {};
+        template<typename T> struct is_shared_ptr<std::shared_ptr<T>> : std::true_type {};
+
+        template<typename T> struct unwrap_optional { using type = T; };
+        template<typename T> struct unwrap_optional<std::optional<T>> { using type = T; };
+
+        // Type the reader decodes for a field of Owner (the getter's result without optional/ref).
+        template<typename Owner, typename F>
+        using value_t = typename unwrap_optional<
+            std::remove_cvref_t<std::invoke_result_t<decltype(std::declval<const F&>().get), const Owner&>>>::type;
+
+        template<typename T> inline constexpr bool always_false = false;
+    }
+
+    // ------------------------------------------------------------------ writer
+
+    inline void AppendString(std::string& out, std::string_view text) {
+        static constexpr char hex[] = "0123456789abcdef";
+        out += '"';
+        std::size_t run = 0;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const auto c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            out.append(text.data() + run, i - run);
+            run = i + 1;
+            switch (c) {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\b': out += "\\b"; break;
+                case '\f': out += "\\f"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    out += "\\u00";
+                    out += hex[c >> 4];
+                    out += hex[c & 0x0F];
+            }
+        }
+        out.append(text.data() + run, text.size() - run);
+        out += '"';
+    }
+
+    template<typename T>
+    void AppendValue(std::string& out, const T& value);
+
+    // One "key":value member of an object being written; first tracks the separating comma.
+    template<typename V>
+    void AppendField(std::string& out, std::string_view key, const V& value, bool& first) {
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        AppendString(out, key);
+        out += ':';
+        AppendValue(out, value);
+    }
+
+    namespace detail {
+        template<typename Owner, typename F>
+        void AppendDescribed(std::string& out, const F& f, const Owner& owner, bool& first) {
+            decltype(auto) value = f.get(owner);
+            using V = std::remove_cvref_t<decltype(value)>;
+            if constexpr (is_optional<V>::value) {
+                if (value) {
+                    AppendField(out, f.name, *value, first);
+                }
+            } else if constexpr (std::is_same_v<V, std::string>) {
+                if (!(f.omitEmpty && value.empty())) {
+                    AppendField(out, f.name, value, first);
+                }
+            } else {
+                AppendField(out, f.name, value, first);
+            }
+        }
+    }
+
+    // The members of value, without braces: lets callers add members of their own to the object.
+    template<Described T>
+    void AppendFields(std::string& out, const T& value, bool& first) {
+        std::apply([&](const auto&... f) { (detail::AppendDescribed(out, f, value, first), ...); }, Fields<T>::list);
+    }
+
+    template<typename T>
+    void AppendValue(std::string& out, const T& value) {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            AppendString(out, value);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            out += value ? "true" : "false";
+        } else if constexpr (NamedEnum<T>) {
+            std::string_view name = EnumNames<T>::names[0].second;
+            for (const auto& [v, n] : EnumNames<T>::names) {
+                if (v == value) name = n;
+            }
+            AppendString(out, name);
+        } else if constexpr (std::is_integral_v<T>) {
+            char buffer[24];
+            const auto [end, ec] = std::to_chars(buffer, buffer + sizeof buffer, value);
+            out.append(buffer, end);
+        } else if constexpr (Described<T>) {
+            out += '{';
+            bool first = true;
+            AppendFields(out, value, first);
+            out += '}';
+        } else if constexpr (detail::is_vector<T>::value) {
+            out += '[';
+            for (std::size_t i = 0; i < value.size(); ++i) {
+                if (i > 0) out += ',';
+                AppendValue(out, value[i]);
+            }
+            out += ']';
+        } else if constexpr (detail::is_shared_ptr<T>::value) {
+            if (value) {
+                AppendValue(out, *value);
+            } else {
+                out += "null";
+            }
+        } else {
+            static_assert(detail::always_false<T>, "no JSON mapping for this type");
+        }
+    }
+
+    template<typename T>
+    std::string Write(const T& value) {
+        std::string out;
+        out.reserve(128);
+        AppendValue(out, value);
+        return out;
+    }
+
+    // ------------------------------------------------------------------ reader
+
+    // Pull parser over the input text. Every method returns false once an error is recorded.
+    class Reader {
+        std::string_view text;
+        std::size_t pos = 0;
+        std::string scratch;
+
+        static constexpr int MaxDepth = 64;
+
+        static int HexDigit(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        bool Hex4(unsigned& value) {
+            if (text.size() - pos < 4) return Fail("truncated \\u escape");
+            value = 0;
+            for (int i = 0; i < 4; ++i) {
+                const int digit = HexDigit(text[pos++]);
+                if (digit < 0) return Fail("invalid \\u escape");
+                value = (value << 4) | static_cast<unsigned>(digit);
+            }
+            return true;
+        }
+
+        static void AppendUtf8(std::string& out, unsigned cp) {
+            if (cp < 0x80) {
+                out += static_cast<char>(cp);
+            } else if (cp < 0x800) {
+                out += static_cast<char>(0xC0 | (cp >> 6));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else if (cp < 0x10000) {
+                out += static_cast<char>(0xE0 | (cp >> 12));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (cp >> 18));
+                out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+
+        // After the backslash.
+        bool Escape(std::string& out) {
+            if (pos >= text.size()) return Fail("unterminated string");
+            switch (text[pos++]) {
+                case '"':  out += '"'; return true;
+                case '\\': out += '\\'; return true;
+                case '/':  out += '/'; return true;
+                case 'b':  out += '\b'; return true;
+                case 'f':  out += '\f'; return true;
+                case 'n':  out += '\n'; return true;
+                case 'r':  out += '\r'; return true;
+                case 't':  out += '\t'; return true;
+                case 'u': {
+                    unsigned cp = 0;
+                    if (!Hex4(cp)) return false;
+                    if (cp >= 0xDC00 && cp <= 0xDFFF) return Fail("unpaired surrogate");
+                    if (cp >= 0xD800 && cp <= 0xDBFF) {
+                        unsigned low = 0;
+                        if (text.substr(pos, 2) != "\\u") return Fail("unpaired surrogate");
+                        pos += 2;
+                        if (!Hex4(low)) return false;
+                        if (low < 0xDC00 || low > 0xDFFF) return Fail("unpaired surrogate");
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    AppendUtf8(out, cp);
+                    return true;
+                }
+                default:
+                    return Fail("invalid escape");
+            }
+        }
+
+    public:
+        std::optional<ReadError> error;
+
+        explicit Reader(std::string_view text) : text(text) {}
+
+        bool Fail(std::string message, ReadError::Kind kind = ReadError::Kind::Syntax) {
+            if (!error) {
+                if (kind == ReadError::Kind::Syntax) {
+                    message += " at offset " + std::to_string(pos);
+                }
+                error = ReadError{kind, std::move(message)};
+            }
+            return false;
+        }
+
+        // Next significant character, '\0' at the end of the input.
+        char Peek() {
+            while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) {
+                ++pos;
+            }
+            return pos < text.size() ? text[pos] : '\0';
+        }
+
+        bool Consume(char c) {
+            if (Peek() != c) {
+                return Fail(std::string("expected '") + c + "'");
+            }
+            ++pos;
+            return true;
+        }
+
+        bool AtEnd() { return Peek() == '\0' && pos == text.size(); }
+
+        // Decoded string. view points into the input when there are no escapes, otherwise into
+        // an internal buffer that the next StringView call reuses.
+        bool StringView(std::string_view& view) {
+            if (!Consume('"')) return false;
+            const std::size_t start = pos;
+            while (pos < text.size()) {
+                const auto c = static_cast<unsigned char>(text[pos]);
+                if (c == '"') {
+                    view = text.substr(start, pos - start);
+                    ++pos;
+                    return true;
+                }
+                if (c == '\\') break;
+                if (c < 0x20) return Fail("control character in string");
+                ++pos;
+            }
+            scratch.assign(text.data() + start, pos - start);
+            while (pos < text.size()) {
+                const auto c = static_cast<unsigned char>(text[pos]);
+                if (c == '"') {
+                    ++pos;
+                    view = scratch;
+                    return true;
+                }
+                ++pos;
+                if (c == '\\') {
+                    if (!Escape(scratch)) return false;
+                } else if (c < 0x20) {
+                    return Fail("control character in string");
+                } else {
+                    scratch += static_cast<char>(c);
+                }
+            }
+            return Fail("unterminated string");
+        }
+
+        bool String(std::string& out) {
+            std::string_view view;
+            if (!StringView(view)) return false;
+            out.assign(view);
+            return true;
+        }
+
+        // JSON number; integral is false when it has a fraction or an exponent.
+        bool Number(std::string_view& digits, bool& integral) {
+            Peek();
+            const std::size_t start = pos;
+            if (pos < text.size() && text[pos] == '-') ++pos;
+            const auto isDigit = [&] { return pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; };
+            if (!isDigit()) return Fail("invalid number");
+            if (text[pos] == '0') {
+                ++pos;
+            } else {
+                while (isDigit()) ++pos;
+            }
+            integral = true;
+            if (pos < text.size() && text[pos] == '.') {
+                integral = false;
+                ++pos;
+                if (!isDigit()) return Fail("invalid number");
+                while (isDigit()) ++pos;
+            }
+            if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+                integral = false;
+                ++pos;
+                if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) ++pos;
+                if (!isDigit()) return Fail("invalid number");
+                while (isDigit()) ++pos;
+            }
+            digits = text.substr(start, pos - start);
+            return true;
+        }
+
+        bool Literal(std::string_view word) {
+            Peek();
+            if (text.substr(pos, word.size()) != word) return Fail("invalid literal");
+            pos += word.size();
+            return true;
+        }
+
+        // Validates and discards one value of any type.
+        bool Skip(int depth = 0) {
+            if (depth > MaxDepth) return Fail("nesting too deep");
+            switch (Peek()) {
+                case '"': {
+                    std::string_view ignored;
+                    return StringView(ignored);
+                }
+                case '{': {
+                    ++pos;
+                    if (Peek() == '}') { ++pos; return true; }
+                    do {
+                        std::string_view key;
+                        if (!StringView(key) || !Consume(':') || !Skip(depth + 1)) return false;
+                    } while (Peek() == ',' && (++pos, true));
+                    return Consume('}');
+                }
+                case '[': {
+                    ++pos;
+                    if (Peek() == ']') { ++pos; return true; }
+                    do {
+                        if (!Skip(depth + 1)) return false;
+                    } while (Peek() == ',' && (++pos, true));
+                    return Consume(']');
+                }
+                case 't': return Literal("true");
+                case 'f': return Literal("false");
+                case 'n': return Literal("null");
+                default: {
+                    std::string_view digits;
+                    bool integral = false;
+                    return Number(digits, integral);
+                }
+            }
+        }
+
+        // Members of the object at the cursor: onMember(key) must consume the value.
+        template<typename OnMember>
+        bool Object(OnMember&& onMember) {
+            if (!Consume('{')) return false;
+            if (Peek() == '}') { ++pos; return true; }
+            do {
+                std::string_view key;
+                if (!StringView(key)) return false;
+                // The key may live in the scratch buffer that the value will reuse.
+                const std::string ownedKey = key.data() == scratch.data() ? std::string(key) : std::string();
+                const std::string_view stableKey = ownedKey.empty() ? key : std::string_view(ownedKey);
+                if (!Consume(':') || !onMember(stableKey)) return false;
+            } while (Peek() == ',' && (++pos, true));
+            return Consume('}');
+        }
+
+        template<typename OnItem>
+        bool Array(OnItem&& onItem) {
+            if (!Consume('[')) return false;
+            if (Peek() == ']') { ++pos; return true; }
+            do {
+                if (!onItem()) return false;
+            } while (Peek() == ',' && (++pos, true));
+            return Consume(']');
+        }
+    };
+
+    // Reads the value at the cursor into out. Returns false on a syntax error (reader.error);
+    // sets mismatch when the JSON type does not fit T, in which case the value is skipped.
+    template<typename T>
+    bool ReadValue(Reader& reader, T& out, bool& mismatch);
+
+    namespace detail {
+        template<typename Owner, typename F>
+        bool ReadDescribed(Reader& reader, Owner& owner, const F& f, std::uint64_t& seen, std::size_t index) {
+            value_t<Owner, F> value{};
+            bool mismatch = false;
+            if (!ReadValue(reader, value, mismatch)) {
+                return false;
+            }
+            if (mismatch) {
+                return f.required ? reader.Fail("invalid '" + std::string(f.name) + "'", ReadError::Kind::Field) : true;
+            }
+            f.set(owner, std::move(value));
+            seen |= std::uint64_t{1} << index;
+            return true;
+        }
+
+        template<typename T, std::size_t... I>
+        bool ReadMember(Reader& reader, T& out, std::string_view key, std::uint64_t& seen, std::index_sequence<I...>) {
+            constexpr const auto& list = Fields<T>::list;
+            bool matched = false;
+            bool ok = true;
+            ((!matched && std::get<I>(list).name == key
+                  ? (matched = true, ok = ReadDescribed(reader, out, std::get<I>(list), seen, I))
+                  : false),
+             ...);
+            return matched ? ok : reader.Skip();
+        }
+
+        template<typename T, std::size_t... I>
+        bool CheckRequired(Reader& reader, std::uint64_t seen, std::index_sequence<I...>) {
+            constexpr const auto& list = Fields<T>::list;
+            bool ok = true;
+            ((ok = ok && (!std::get<I>(list).required || (seen & (std::uint64_t{1} << I)) != 0
+                              || reader.Fail("missing '" + std::string(std::get<I>(list).name) + "'",
+                                             ReadError::Kind::Field))),
+             ...);
+            return ok;
+        }
+
+        template<typename T>
+        bool MismatchSkip(Reader& reader, bool& mismatch) {
+            mismatch = true;
+            return reader.Skip();
+        }
+    }
+
+    template<typename T>
+    bool ReadValue(Reader& reader, T& out, bool& mismatch) {
+        const char next = reader.Peek();
+        if constexpr (std::is_same_v<T, std::string>) {
+            return next == '"' ? reader.String(out) : detail::MismatchSkip<T>(reader, mismatch);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            if (next == 't') { out = true; return reader.Literal("true"); }
+            if (next == 'f') { out = false; return reader.Literal("false"); }
+            return detail::MismatchSkip<T>(reader, mismatch);
+        } else if constexpr (NamedEnum<T>) {
+            if (next != '"') return detail::MismatchSkip<T>(reader, mismatch);
+            std::string_view name;
+            if (!reader.StringView(name)) return false;
+            out = EnumNames<T>::names[0].first;
+            for (const auto& [v, n] : EnumNames<T>::names) {
+                if (n == name) out = v;
+            }
+            return true;
+        } else if constexpr (std::is_integral_v<T>) {
+            if (next != '-' && (next < '0' || next > '9')) return detail::MismatchSkip<T>(reader, mismatch);
+            std::string_view digits;
+            bool integral = false;
+            if (!reader.Number(digits, integral)) return false;
+            const auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), out);
+            mismatch = !integral || ec != std::errc{} || end != digits.data() + digits.size();
+            return true;
+        } else if constexpr (Described<T>) {
+            if (next != '{') return detail::MismatchSkip<T>(reader, mismatch);
+            constexpr auto count = std::tuple_size_v<std::remove_cvref_t<decltype(Fields<T>::list)>>;
+            static_assert(count <= 64, "too many fields");
+            std::uint64_t seen = 0;
+            const bool ok = reader.Object([&](std::string_view key) {
+                return detail::ReadMember(reader, out, key, seen, std::make_index_sequence<count>{});
+            });
+            return ok && detail::CheckRequired<T>(reader, seen, std::make_index_sequence<count>{});
+        } else if constexpr (detail::is_vector<T>::value) {
+            if (next != '[') return detail::MismatchSkip<T>(reader, mismatch);
+            T items;
+            const bool ok = reader.Array([&] {
+                typename T::value_type item{};
+                bool itemMismatch = false;
+                if (!ReadValue(reader, item, itemMismatch)) return false;
+                if (itemMismatch) {
+                    mismatch = true;
+                } else {
+                    items.push_back(std::move(item));
+                }
+                return true;
+            });
+            if (ok && !mismatch) out = std::move(items);
+            return ok;
+        } else if constexpr (detail::is_shared_ptr<T>::value) {
+            if (next == 'n') {
+                out.reset();
+                return reader.Literal("null");
+            }
+            auto value = std::make_shared<typename T::element_type>();
+            if (!ReadValue(reader, *value, mismatch)) return false;
+            if (!mismatch) out = std::move(value);
+            return true;
+        } else {
+            static_assert(detail::always_false<T>, "no JSON mapping for this type");
+        }
+    }
+
+    // Whole document -> T. Syntax errors and field errors (missing/invalid required member) are
+    // told apart so controllers can keep answering "Invalid JSON body" vs "missing 'name'".
+    template<typename T>
+    std::expected<T, ReadError> Read(std::string_view text) {
+        Reader reader{text};
+        T value{};
+        bool mismatch = false;
+        if (!ReadValue(reader, value, mismatch)) {
+            return std::unexpected(*reader.error);
+        }
+        if (!reader.AtEnd()) {
+            reader.Fail("trailing characters");
+            return std::unexpected(*reader.error);
+        }
+        if (mismatch) {
+            return std::unexpected(ReadError{ReadError::Kind::Field, "unexpected JSON type"});
+        }
+        return value;
+    }
+}
+
+#endif //DOMAIN_JSON_CODEC_HPP
@@ -0,0 +1,85 @@
+#ifndef DOMAIN_STANDING_HPP
+#define DOMAIN_STANDING_HPP
+
+#include <array>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace domain {
+    // One team's row in its group table (STANDINGS). Counted like wc::Table: a win is worth 3
+    // points, a draw only adds the match and the goals.
+    struct Standing {
+        std::string groupId;
+        std::string teamId;
+        std::string teamName;
+        int played = 0;
+        int won = 0;
+        int lost = 0;
+        int goalsFor = 0;
+        int goalsAgainst = 0;
+        int points = 0;
+
+        [[nodiscard]] int GoalDifference() const { return goalsFor - goalsAgainst; }
+
+        [[nodiscard]] bool IsZero() const {
+            return played == 0 && won == 0 && lost == 0 && goalsFor == 0 && goalsAgainst == 0 && points == 0;
+        }
+
+        Standing& operator+=(const Standing& other) {
+            played += other.played;
+            won += other.won;
+            lost += other.lost;
+            goalsFor += other.goalsFor;
+            goalsAgainst += other.goalsAgainst;
+            points += other.points;
+            return *this;
+        }
+    };
+
+    using Score = std::pair<int, int>; // home, visitor
+
+    // What one final score adds to the home and visitor rows; sign -1 takes it back.
+    inline std::array<Standing, 2> ScoreContribution(const std::string& homeId, const std::string& visitorId,
+                                                     Score score, int sign = 1) {
+        const auto [home, visitor] = score;
+        Standing h;
+        h.teamId = homeId;
+        Standing v;
+        v.teamId = visitorId;
+
+        h.played = v.played = sign;
+        h.goalsFor = v.goalsAgainst = sign * home;
+        h.goalsAgainst = v.goalsFor = sign * visitor;
+        if (home > visitor) {
+            h.won = v.lost = sign;
+            h.points = 3 * sign;
+        } else if (visitor > home) {
+            v.won = h.lost = sign;
+            v.points = 3 * sign;
+        }
+        return {h, v};
+    }
+
+    // Changes to apply to the table when a match goes from `before` (nullopt: not played yet) to
+    // `after`. Empty when nothing changes (same score sent again).
+    inline std::vector<Standing> StandingDeltas(const std::string& homeId, const std::string& visitorId,
+                                                const std::optional<Score>& before, Score after) {
+        auto deltas = ScoreContribution(homeId, visitorId, after);
+        if (before) {
+            const auto undo = ScoreContribution(homeId, visitorId, *before, -1);
+            deltas[0] += undo[0];
+            deltas[1] += undo[1];
+        }
+        std::vector<Standing> out;
+        for (auto& delta : deltas) {
+            if (!delta.IsZero()) {
+                out.push_back(std::move(delta));
+            }
+        }
+        return out;
+    }
+}
+
+#endif //DOMAIN_STANDING_HPP
@@ -50,10 +50,10 @@ namespace domain {
                             const TournamentFormat& format = TournamentFormat())
             : id(), name(name), format(format), groups(), matches() {}
 
-        std::string Id() const { return id; }
+        const std::string& Id() const { return id; }
         std::string& Id() { return id; }
 
-        std::string Name() const { return name; }
+        const std::string& Name() const { return name; }
         std::string& Name() { return name; }
 
         const TournamentFormat& Format() const { return format; }
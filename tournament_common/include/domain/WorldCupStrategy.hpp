@@ -1,5 +1,6 @@
 #pragma once
 #include "IMatchStrategy.hpp"
+#include "domain/Standing.hpp"
 
 #include <expected>
 #include <vector>
@@ -45,24 +46,29 @@ struct Table {
         if (!m.HasScore()) return;
         const auto& h  = m.Home();
         const auto& v  = m.Visitor();
-        const int sh   = *m.ScoreHome();
-        const int sv   = *m.ScoreVisitor();
 
         ensureTeam(h.Id(), h.Name());
         ensureTeam(v.Id(), v.Name());
 
-        auto& Rh = rows[h.Id()];
-        auto& Rv = rows[v.Id()];
+        // Same counting as the STANDINGS table (no points for a tie)
+        const auto [dh, dv] = domain::ScoreContribution(h.Id(), v.Id(), {*m.ScoreHome(), *m.ScoreVisitor()});
+        add(rows[h.Id()], dh);
+        add(rows[v.Id()], dv);
+    }
 
-        Rh.played++; Rv.played++;
-        Rh.gf += sh; Rh.ga += sv;
-        Rv.gf += sv; Rv.ga += sh;
+    // A row read from STANDINGS, already accumulated.
+    void addStanding(const domain::Standing& s) {
+        ensureTeam(s.teamId, s.teamName);
+        add(rows[s.teamId], s);
+    }
 
-        if (sh > sv) { Rh.won++; Rv.lost++; Rh.points += 3; }
-        else if (sh < sv) { Rv.won++; Rh.lost++; Rv.points += 3; }
-        else {
-            // No ties expected in your flow
-        }
+    static void add(TableRow& row, const domain::Standing& s) {
+        row.played += s.played;
+        row.won    += s.won;
+        row.lost   += s.lost;
+        row.gf     += s.goalsFor;
+        row.ga     += s.goalsAgainst;
+        row.points += s.points;
     }
 
     static bool better(const TableRow& a, const TableRow& b) {
@@ -160,13 +166,7 @@ public:
         }
 
         // --- 1) Build tables from GROUP matches only ---
-        std::map<std::string, wc::Table> standingsByGroup;
-        for (const auto& g : groups) standingsByGroup[g->Id()] = wc::Table{};
-
-        for (const auto& g : groups) {
-            auto& table = standingsByGroup[g->Id()];
-            for (const auto& t : g->Teams()) table.ensureTeam(t.Id, t.Name);
-        }
+        auto standingsByGroup = emptyTables(groups);
         for (const auto& msp : allMatches) {
             if (!msp) continue;
             const auto& m = *msp;
@@ -186,6 +186,48 @@ public:
             }
         }
 
+        return createPlayoffs(tournament, allMatches, groups, standingsByGroup);
+    }
+
+    // Same bracket, with the group tables read from STANDINGS (kept up to date on every score)
+    // instead of recomputed from every group match. allMatches is still needed for the KO rounds.
+    std::expected<std::vector<domain::Match>, std::string>
+    CreatePlayoffMatches(const domain::Tournament& tournament,
+                         const std::vector<std::shared_ptr<domain::Match>>& allMatches,
+                         const std::vector<std::shared_ptr<domain::Group>>& groups,
+                         const std::vector<domain::Standing>& standings)
+    {
+        if (groups.size() % 2 != 0) {
+            return std::unexpected("Groups count must be even for pairing");
+        }
+
+        auto standingsByGroup = emptyTables(groups);
+        for (const auto& s : standings) {
+            if (auto it = standingsByGroup.find(s.groupId); it != standingsByGroup.end()) {
+                it->second.addStanding(s);
+            }
+        }
+
+        return createPlayoffs(tournament, allMatches, groups, standingsByGroup);
+    }
+
+private:
+    // One table per group with all its teams at zero.
+    static std::map<std::string, wc::Table> emptyTables(const std::vector<std::shared_ptr<domain::Group>>& groups) {
+        std::map<std::string, wc::Table> standingsByGroup;
+        for (const auto& g : groups) {
+            auto& table = standingsByGroup[g->Id()];
+            for (const auto& t : g->Teams()) table.ensureTeam(t.Id, t.Name);
+        }
+        return standingsByGroup;
+    }
+
+    std::expected<std::vector<domain::Match>, std::string>
+    createPlayoffs(const domain::Tournament& tournament,
+                   const std::vector<std::shared_ptr<domain::Match>>& allMatches,
+                   const std::vector<std::shared_ptr<domain::Group>>& groups,
+                   std::map<std::string, wc::Table>& standingsByGroup)
+    {
         // --- 2) Get top-2 per group ---
         struct Qualified { TeamRef first; TeamRef second; };
         std::map<std::string, Qualified> top2;
@@ -0,0 +1,123 @@
+//
+// ConnectionPool.hpp
+//
+
+#ifndef TOURNAMENTS_CONNECTIONPOOL_HPP
+#define TOURNAMENTS_CONNECTIONPOOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "IDbConnectionProvider.hpp"
+
+enum class PoolMode {
+    // Any thread takes any idle connection.
+    Shared,
+    // Each thread gets a home slot it tries first; the rest of the pool is the overflow.
+    Affinity
+};
+
+struct ConnectionPoolSettings {
+    std::size_t minSize = 1;
+    std::size_t maxSize = 2;
+    std::chrono::milliseconds acquireTimeout{5000};
+    std::chrono::milliseconds idleTimeout{60000};
+    std::chrono::milliseconds validationInterval{30000};
+    PoolMode mode = PoolMode::Shared;
+};
+
+// Thrown by Acquire() when no connection becomes available before the deadline.
+class ConnectionAcquireTimeout : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * Elastic pool of IDbConnection.
+ * Keeps at least minSize connections open, grows on demand up to maxSize, closes connections
+ * idle for longer than idleTimeout (down to minSize) and validates a connection that has been
+ * idle for longer than validationInterval before handing it out, replacing it when broken.
+ * The pool knows nothing about the database driver: opening and validating are injected.
+ *
+ * Connections live in a fixed array of maxSize slots claimed with a CAS, so the hot path
+ * (take an idle connection, give it back) takes no lock. The mutex/condition variable is
+ * only used by threads that have to wait because every slot is busy. Idle/validation ages use a
+ * coarse clock ticked by the reaper thread, so checkouts don't read the system clock either.
+ */
+class ConnectionPool final : public ConnectionReleaser {
+public:
+    using Factory   = std::function<std::unique_ptr<IDbConnection>()>;
+    using Validator = std::function<bool(IDbConnection&)>;
+    using Clock     = std::chrono::steady_clock;
+
+    ConnectionPool(ConnectionPoolSettings settings, Factory factory, Validator validator);
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    PooledConnection Acquire();
+
+    [[nodiscard]] std::size_t OpenConnections() const;
+    [[nodiscard]] std::size_t IdleConnections() const;
+    [[nodiscard]] const ConnectionPoolSettings& Settings() const { return settings; }
+
+    // Runs one idle-reaping pass immediately (the background reaper calls this periodically).
+    void ReapIdle();
+    // Same pass with idle ages measured at `now` instead of the clock (tests move time with it).
+    void ReapIdle(Clock::time_point now);
+
+    void Release(IDbConnection* connection, std::size_t slot) noexcept override;
+
+private:
+    enum SlotState : std::uint8_t { Empty, Idle, Busy };
+
+    struct alignas(64) Slot {
+        std::atomic<std::uint8_t> state{Empty};
+        std::atomic<Clock::rep> lastUsed{0};
+        // Only touched by the thread that moved the slot to Busy.
+        std::unique_ptr<IDbConnection> connection;
+        Clock::rep lastValidated = 0;
+    };
+
+    ConnectionPoolSettings settings;
+    Factory factory;
+    Validator validator;
+    const std::uint64_t id;
+
+    std::unique_ptr<Slot[]> slots;
+    // Slots holding a connection (Idle or Busy) plus the ones being opened right now.
+    std::atomic<std::size_t> open{0};
+    std::atomic<std::size_t> nextHome{0};
+    // Coarse "now" (resolution: reaper tick), good enough for idle and validation ages.
+    std::atomic<Clock::rep> coarseNow{0};
+
+    std::mutex waitMutex;
+    std::condition_variable available;
+    std::atomic<std::size_t> waiters{0};
+
+    bool stopping = false;
+    std::condition_variable reaperWake;
+    std::thread reaper;
+
+    Clock::rep now() const { return coarseNow.load(std::memory_order_relaxed); }
+    Clock::rep tick();
+    std::size_t homeSlot();
+    bool tryTakeIdle(std::size_t start, std::size_t& taken);
+    bool tryReserve();
+    PooledConnection openInto(std::size_t preferred);
+    PooledConnection checkout(std::size_t index);
+    void dropConnection(Slot& slot);
+    void notifyWaiters();
+    void reaperLoop();
+};
+
+#endif //TOURNAMENTS_CONNECTIONPOOL_HPP
@@ -5,37 +5,84 @@
 #ifndef TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
 #define TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
 
+#include <cstddef>
 #include <memory>
-#include <functional>
+#include <utility>
 
 class IDbConnection {
 public:
     virtual ~IDbConnection() = default;
+    // Cheap, local liveness check (no round trip). Pools use it to drop dead connections on release.
+    [[nodiscard]] virtual bool IsOpen() const { return true; }
 };
 
+// Whoever hands out a PooledConnection gets it back through Release(); slot is opaque to the handle.
+class ConnectionReleaser {
+public:
+    virtual void Release(IDbConnection* connection, std::size_t slot) noexcept = 0;
+protected:
+    ~ConnectionReleaser() = default;
+};
 
+// Move-only checkout handle. No allocation per checkout: it only carries the connection, its owner and the slot.
 class PooledConnection {
-    std::unique_ptr<IDbConnection, std::function<void(IDbConnection*)>> connection;
+    IDbConnection* connection = nullptr;
+    ConnectionReleaser* owner = nullptr;
+    std::size_t slot = 0;
+
 public:
-    explicit PooledConnection(
-        IDbConnection* dbc,
-        std::function<void(IDbConnection*)> deleter) : connection(dbc, std::move(deleter)) {}
+    PooledConnection() = default;
+    PooledConnection(IDbConnection* dbc, ConnectionReleaser* owner, std::size_t slot)
+        : connection(dbc), owner(owner), slot(slot) {}
+
+    ~PooledConnection() { reset(); }
 
-    IDbConnection* operator->() { return connection.get(); }
+    IDbConnection* operator->() { return connection; }
     IDbConnection& operator*() { return *connection; }
-       // disable copy
+    explicit operator bool() const { return connection != nullptr; }
+
+    // Typed access for the provider's own connection type (the provider guarantees it, so no RTTI needed).
+    template<class TConnection>
+    TConnection& As() { return static_cast<TConnection&>(*connection); }
+
+    void reset() noexcept {
+        if (connection != nullptr && owner != nullptr) {
+            owner->Release(connection, slot);
+        }
+        connection = nullptr;
+        owner = nullptr;
+    }
+
+    // disable copy
     PooledConnection(const PooledConnection&) = delete;
     PooledConnection& operator=(const PooledConnection&) = delete;
 
     // allow move
-    PooledConnection(PooledConnection&&) noexcept = default;
-    PooledConnection& operator=(PooledConnection&&) noexcept = default;
+    PooledConnection(PooledConnection&& other) noexcept
+        : connection(std::exchange(other.connection, nullptr)),
+          owner(std::exchange(other.owner, nullptr)),
+          slot(other.slot) {}
+
+    PooledConnection& operator=(PooledConnection&& other) noexcept {
+        if (this != &other) {
+            reset();
+            connection = std::exchange(other.connection, nullptr);
+            owner = std::exchange(other.owner, nullptr);
+            slot = other.slot;
+        }
+        return *this;
+    }
 };
 
 
 class IDbConnectionProvider {
 public:
     virtual ~IDbConnectionProvider() = default;
+    // Primary connection: every write, and reads that must see them.
     virtual PooledConnection Connection() = 0;
+    // Connection for read-only work. Providers with a replica route it there; by default it is the primary.
+    virtual PooledConnection ReadConnection() { return Connection(); }
+    // True when ReadConnection() would hand out a replica connection right now.
+    [[nodiscard]] virtual bool ReadsFromReplica() const { return false; }
 };
-#endif //TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
\ No newline at end of file
+#endif //TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
@@ -4,17 +4,39 @@
 
 #ifndef TOURNAMENTS_POSTGRES_CONNECTION_HPP
 #define TOURNAMENTS_POSTGRES_CONNECTION_HPP
+#include <bitset>
 #include <memory>
 #include <pqxx/pqxx>
 #include "IDbConnectionProvider.hpp"
+#include "StatementCatalog.hpp"
 
 
 struct PostgresConnection final : IDbConnection{
     std::unique_ptr<pqxx::connection> connection;
     explicit PostgresConnection(std::unique_ptr<pqxx::connection> connection) : connection(std::move(connection)) {
     }
+
+    [[nodiscard]] bool IsOpen() const override {
+        return connection && connection->is_open();
+    }
+
+    // Prepares the statement on this connection the first time it is used and returns its handle.
+    // A reconnect builds a new PostgresConnection, so statements get prepared again there.
+    pqxx::prepped Prepared(statements::StatementId id) {
+        const auto index = static_cast<std::size_t>(id);
+        const auto& statement = statements::Get(id);
+        if (!prepared.test(index)) {
+            connection->prepare(pqxx::zview{statement.name.data(), statement.name.size()},
+                                pqxx::zview{statement.sql.data(), statement.sql.size()});
+            prepared.set(index);
+        }
+        return pqxx::prepped{pqxx::zview{statement.name.data(), statement.name.size()}};
+    }
+
+private:
+    std::bitset<statements::StatementCount> prepared;
 };
 
 
 
-#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
\ No newline at end of file
+#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
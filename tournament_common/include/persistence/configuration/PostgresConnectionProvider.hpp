@@ -4,79 +4,78 @@
 
 #ifndef TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
 #define TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
-#include <condition_variable>
-#include <queue>
+#include <chrono>
+#include <memory>
+#include <string>
 #include <pqxx/pqxx>
 
 #include "IDbConnectionProvider.hpp"
+#include "ConnectionPool.hpp"
 #include "PostgresConnection.hpp"
+#include "ReadRouting.hpp"
+#include "configuration/DatabaseConfiguration.hpp"
 
 class PostgresConnectionProvider : public IDbConnectionProvider{
-    std::string_view connectionString;
-    size_t poolSize = 1;
-    std::queue<std::unique_ptr<pqxx::connection>> connectionPool;
-    std::mutex connectionPoolMutex;
-    std::condition_variable connectionPoolCondition;
+    std::string connectionString;
+    ConnectionPool pool;
+    // Only set when a replica is configured.
+    std::unique_ptr<ConnectionPool> replicaPool;
+    std::chrono::milliseconds readYourWrites;
 
-public:
-    PostgresConnectionProvider(std::string_view connectionString, size_t poolSize) : connectionString(connectionString), poolSize(poolSize) {
-        for (size_t i = 0; i < poolSize; i++) {
-            connectionPool.push(std::make_unique<pqxx::connection>(connectionString.data()));
-            connectionPool.back()->prepare("insert_tournament", "insert into TOURNAMENTS (document) values($1) RETURNING id");
-            connectionPool.back()->prepare("select_tournament_by_id", "select * from TOURNAMENTS where id = $1");
+    static ConnectionPoolSettings poolSettings(const config::DatabaseConfiguration& configuration,
+                                               std::size_t minSize, std::size_t maxSize) {
+        ConnectionPoolSettings settings;
+        settings.minSize            = minSize;
+        settings.maxSize            = maxSize;
+        settings.acquireTimeout     = std::chrono::milliseconds{configuration.acquireTimeoutMs};
+        settings.idleTimeout        = std::chrono::milliseconds{configuration.idleTimeoutMs};
+        settings.validationInterval = std::chrono::milliseconds{configuration.validationIntervalMs};
+        settings.mode               = configuration.poolMode == "affinity" ? PoolMode::Affinity : PoolMode::Shared;
+        return settings;
+    }
 
-            connectionPool.back()->prepare("insert_team", "insert into TEAMS (document) values($1) RETURNING id");
-            connectionPool.back()->prepare("select_team_by_id", "select * from TEAMS where id = $1");
+    static ConnectionPool::Factory factoryFor(std::string connectionString) {
+        return [connectionString = std::move(connectionString)] {
+            // Statements are prepared lazily per connection (see PostgresConnection::Prepared).
+            auto connection = std::make_unique<pqxx::connection>(connectionString);
+            return std::unique_ptr<IDbConnection>(std::make_unique<PostgresConnection>(std::move(connection)));
+        };
+    }
 
-            connectionPool.back()->prepare("insert_group", "insert into GROUPS (tournament_id, document) values($1, $2) RETURNING id");
-            connectionPool.back()->prepare("select_groups_by_tournament", "select * from GROUPS where tournament_id = $1");
-            connectionPool.back()->prepare("select_group_in_tournament", R"(
-                select * from groups
-                where  tournament_id = $1
-                and document @> jsonb_build_object('teams', jsonb_build_array(jsonb_build_object('id', $2::text)))
-            )");
+    static bool validate(IDbConnection& dbc) {
+        auto& pc = static_cast<PostgresConnection&>(dbc);   // the factories above only build these
+        pqxx::nontransaction tx(*pc.connection);
+        tx.exec("select 1");
+        return true;
+    }
 
-            connectionPool.back()->prepare("select_group_by_tournamentid_groupid", "select * from GROUPS where tournament_id = $1 and id = $2");
-            // connectionPool.back()->prepare("update_group", "update GROUPS set name = $2, last_update_date = CURRENT_TIMESTAMP where id = $1  RETURNING id");
-            connectionPool.back()->prepare("update_group_add_team", R"(
-                update groups
-                    set document = jsonb_insert(
-                            document, '{teams,-1}', $2
-                                   ),
-                    last_update_date = CURRENT_TIMESTAMP
-                where id = $1
-            )");
+public:
+    explicit PostgresConnectionProvider(const config::DatabaseConfiguration& configuration)
+        : connectionString(configuration.connectionString),
+          pool(poolSettings(configuration, configuration.poolMin, configuration.poolMax),
+               factoryFor(configuration.connectionString), &PostgresConnectionProvider::validate),
+          readYourWrites(configuration.readYourWritesMs) {
+        if (!configuration.replicaConnectionString.empty()) {
+            replicaPool = std::make_unique<ConnectionPool>(
+                poolSettings(configuration, configuration.replicaPoolMin, configuration.replicaPoolMax),
+                factoryFor(configuration.replicaConnectionString), &PostgresConnectionProvider::validate);
         }
     }
 
     PooledConnection Connection() override {
-        std::unique_lock lock(connectionPoolMutex);
-
-        // wait until a connection is available
-        connectionPoolCondition.wait(lock, [this] { return !connectionPool.empty(); });
-
-        // take one out
-        auto conn = std::move(connectionPool.front());
-        connectionPool.pop();
-
-        // build PostgresConnection wrapper (adapts pqxx::connection -> IDbConnection)
-        auto dbc = new PostgresConnection(std::move(conn));
-
-        // return a RAII PooledConnection
-        return PooledConnection(
-            dbc,
-            [this](IDbConnection* dbc) {
-                auto pc = dynamic_cast<PostgresConnection*>(dbc);
+        read_routing::MarkWrite();
+        return pool.Acquire();
+    }
 
-                {
-                    std::lock_guard<std::mutex> lock(connectionPoolMutex);
-                    connectionPool.push(std::move(pc->connection));
-                }
+    PooledConnection ReadConnection() override {
+        if (!replicaPool || read_routing::PreferPrimary(readYourWrites)) {
+            return pool.Acquire();
+        }
+        return replicaPool->Acquire();
+    }
 
-                delete pc;
-                connectionPoolCondition.notify_one();
-            }
-        );
+    [[nodiscard]] bool ReadsFromReplica() const override {
+        return replicaPool && !read_routing::PreferPrimary(readYourWrites);
     }
 };
-#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
\ No newline at end of file
+#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
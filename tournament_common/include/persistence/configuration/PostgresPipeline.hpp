@@ -0,0 +1,94 @@
+//
+// PostgresPipeline.hpp
+// ReadBatch session for Postgres: one pooled connection and a pqxx::pipeline. Queued statements
+// are held back and sent together when the first result is retrieved, so a whole batch of
+// independent reads costs one network round trip. Inside a UnitOfWork the batch runs in the
+// unit's transaction; it has to be finished (its Deferreds gone) before the unit runs anything else.
+//
+
+#ifndef TOURNAMENTS_POSTGRESPIPELINE_HPP
+#define TOURNAMENTS_POSTGRESPIPELINE_HPP
+
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <pqxx/pqxx>
+
+#include "IDbConnectionProvider.hpp"
+#include "PostgresConnection.hpp"
+#include "StatementCatalog.hpp"
+#include "UnitOfWork.hpp"
+#include "persistence/repository/ReadBatch.hpp"
+
+class PostgresPipelineSession final : public ReadBatch::Session {
+    PooledConnection pooled;
+    // Reads only: no BEGIN/COMMIT around the batch (unless it joins a unit of work).
+    std::optional<pqxx::nontransaction> own;
+    pqxx::transaction_base& tx;
+    const bool inUnit;
+    const bool fromReplica;
+    pqxx::pipeline pipeline;
+
+public:
+    using QueryId = pqxx::pipeline::query_id;
+
+    PostgresPipelineSession(PooledConnection connection, bool replica)
+        : pooled(std::move(connection)),
+          tx(own.emplace(*pooled.As<PostgresConnection>().connection)),
+          inUnit(false),
+          fromReplica(replica),
+          pipeline(tx) {
+        // Keep everything queued until a result is needed.
+        pipeline.retain(std::numeric_limits<int>::max());
+    }
+
+    explicit PostgresPipelineSession(UnitOfWork& unit)
+        : tx(unit.Work()),
+          inUnit(true),
+          fromReplica(false),
+          pipeline(tx) {
+        pipeline.retain(std::numeric_limits<int>::max());
+    }
+
+    ~PostgresPipelineSession() override {
+        try {
+            pipeline.complete();
+        } catch (...) {
+            // results nobody asked for; nothing to report
+        }
+    }
+
+    // pqxx::pipeline takes plain SQL text, so parameters are quoted inline into the catalog SQL.
+    template<typename... Args>
+    QueryId Queue(statements::StatementId id, const Args&... args) {
+        return pipeline.insert(statements::Inline(id, std::vector<std::string>{tx.quote(args)...}));
+    }
+
+    pqxx::result Retrieve(QueryId id) {
+        return pipeline.retrieve(id);
+    }
+
+    // Same meaning as DbTransaction::InUnit.
+    [[nodiscard]] bool InUnit() const { return inUnit; }
+
+    // Reads may lag behind the primary (and must not fill caches that NOTIFY keeps fresh).
+    [[nodiscard]] bool FromReplica() const { return fromReplica; }
+
+    // The session of this provider in the batch, opened on first use.
+    static std::shared_ptr<PostgresPipelineSession> For(ReadBatch& batch, IDbConnectionProvider& provider) {
+        return batch.SessionFor<PostgresPipelineSession>(&provider, [&provider] {
+            if (UnitOfWork* unit = UnitOfWork::For(provider)) {
+                return std::make_shared<PostgresPipelineSession>(*unit);
+            }
+            auto connection = provider.ReadConnection();
+            // Asked after the checkout: the routing only moves from primary to replica (the
+            // read-your-writes window runs out), so a replica connection is never reported as primary.
+            const bool replica = provider.ReadsFromReplica();
+            return std::make_shared<PostgresPipelineSession>(std::move(connection), replica);
+        });
+    }
+};
+
+#endif //TOURNAMENTS_POSTGRESPIPELINE_HPP
@@ -0,0 +1,51 @@
+//
+// ReadRouting.hpp
+// Decides, per thread, whether a read may go to the replica. A thread that just checked out a
+// primary connection (a write) keeps reading from the primary for a short window, so a request
+// that mutates and then reads sees its own change even if the replica lags behind. The window belongs
+// to the request: REGISTER_ROUTE calls Reset() before each handler, so it does not carry over to the
+// next request served by the same worker thread.
+//
+
+#ifndef TOURNAMENTS_READROUTING_HPP
+#define TOURNAMENTS_READROUTING_HPP
+
+#include <chrono>
+
+namespace read_routing {
+    using Clock = std::chrono::steady_clock;
+
+    namespace detail {
+        inline thread_local Clock::time_point lastWrite{};
+        inline thread_local int primaryScopes = 0;
+    }
+
+    // Called by providers whenever a primary (write) connection is handed out.
+    inline void MarkWrite() {
+        detail::lastWrite = Clock::now();
+    }
+
+    // Forgets the last write of this thread (start of every request).
+    inline void Reset() {
+        detail::lastWrite = {};
+    }
+
+    inline bool PreferPrimary(std::chrono::milliseconds readYourWritesWindow) {
+        if (detail::primaryScopes > 0) {
+            return true;
+        }
+        return detail::lastWrite != Clock::time_point{}
+            && Clock::now() - detail::lastWrite < readYourWritesWindow;
+    }
+
+    // Forces every read in its lifetime onto the primary (read-your-writes for a whole flow).
+    class PrimaryScope {
+    public:
+        PrimaryScope() { ++detail::primaryScopes; }
+        ~PrimaryScope() { --detail::primaryScopes; }
+        PrimaryScope(const PrimaryScope&) = delete;
+        PrimaryScope& operator=(const PrimaryScope&) = delete;
+    };
+}
+
+#endif //TOURNAMENTS_READROUTING_HPP
@@ -0,0 +1,414 @@
+//
+// StatementCatalog.hpp
+// Every SQL statement the repositories run, declared once at compile time.
+// Repositories refer to statements by StatementId; PostgresConnection prepares each one lazily
+// the first time it is used on that connection.
+//
+
+#ifndef TOURNAMENTS_STATEMENTCATALOG_HPP
+#define TOURNAMENTS_STATEMENTCATALOG_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace statements {
+
+    enum class StatementId : std::uint8_t {
+        // teams
+        SelectAllTeams,
+        SelectTeamsJsonPage,
+        SelectTeamsJsonPageAfter,
+        SelectTeamById,
+        SelectTeamJsonById,
+        InsertTeam,
+        UpdateTeam,
+        DeleteTeam,
+        // tournaments
+        SelectAllTournaments,
+        SelectTournamentsJsonPage,
+        SelectTournamentsJsonPageAfter,
+        SelectTournamentById,
+        SelectTournamentVersion,
+        SelectTournamentWithVersion,
+        InsertTournament,
+        UpdateTournament,
+        DeleteTournament,
+        // groups
+        SelectAllGroups,
+        SelectGroupById,
+        SelectGroupsByTournament,
+        SelectGroupByTournamentIdGroupId,
+        SelectGroupByTournamentIdGroupIdForUpdate,
+        SelectGroupInTournament,
+        InsertGroup,
+        UpdateGroup,
+        UpdateGroupAddTeams,
+        DeleteGroup,
+        InsertGroupTeams,
+        SyncGroupTeams,
+        // matches
+        SelectMatchesByTournament,
+        SelectMatchesJsonPage,
+        SelectMatchesJsonPageAfter,
+        SelectMatchByTournamentIdMatchId,
+        SelectMatchByTournamentIdMatchIdForUpdate,
+        SelectMatchJsonByTournamentIdMatchId,
+        SelectMatchesVersion,
+        SelectMatchIdByNaturalKey,
+        InsertMatch,
+        InsertMatchIfNotExists,
+        InsertMatchesBatch,
+        UpdateMatch,
+        // standings
+        SelectStandingsByTournament,
+        SelectStandingsJsonByTournament,
+        SelectStandingsJsonByGroup,
+        ApplyStandingDeltas,
+        // outbox
+        InsertOutboxEvent,
+        ClaimOutboxBatch,
+        MarkOutboxPublished,
+        PurgeOutboxPublished,
+
+        Count
+    };
+
+    struct Statement {
+        StatementId id;
+        // Name used with PREPARE on the server.
+        std::string_view name;
+        std::string_view sql;
+        // Parameter types in $1..$n order, comma separated (documentation + placeholder check).
+        std::string_view parameterTypes;
+    };
+
+    inline constexpr std::size_t StatementCount = static_cast<std::size_t>(StatementId::Count);
+
+    // Response bodies built by Postgres for the pass-through (read-only) endpoints. Each one renders
+    // exactly what to_json of the domain type would, so controllers can send the bytes as they come.
+#define TEAM_JSON_BODY \
+    "json_build_object('id', id, 'name', COALESCE(document->>'name', ''))::text AS body"
+#define TOURNAMENT_JSON_BODY \
+    "json_build_object('id', id, 'name', COALESCE(document->>'name', ''), 'format', json_build_object(" \
+    "'maxTeamsPerGroup', COALESCE((document->'format'->>'maxTeamsPerGroup')::int, 16), " \
+    "'numberOfGroups', COALESCE((document->'format'->>'numberOfGroups')::int, 1), " \
+    "'type', CASE WHEN document->'format'->>'type' = 'NFL' THEN 'NFL' ELSE 'ROUND_ROBIN' END))::text AS body"
+    // Same fields and defaults as match_columns::Decode + to_json(Match); absent optionals are dropped.
+#define MATCH_JSON_BODY \
+    "json_strip_nulls(json_build_object('id', id, 'tournamentId', tournament_id, 'round', COALESCE(round_key, ''), " \
+    "'home', json_build_object('id', COALESCE(home_id_key::text, ''), 'name', COALESCE(home_name, '')), " \
+    "'visitor', json_build_object('id', COALESCE(visitor_id_key::text, ''), 'name', COALESCE(visitor_name, '')), " \
+    "'status', COALESCE(status, 'pending'), " \
+    "'score', CASE WHEN score_home IS NOT NULL AND score_visitor IS NOT NULL " \
+    "THEN json_build_object('home', score_home, 'visitor', score_visitor) END, " \
+    "'winnerTeamId', winner_team_id, 'decidedBy', decided_by, " \
+    "'nextMatchId', next_match_id, 'nextMatchWinnerSlot', next_match_winner_slot))::text AS body"
+
+    // Versions for ETags: row count plus the sum of last_update_date (in microseconds) of the rows a
+    // response is built from. Any insert, delete or update moves one of the two; a max() alone would
+    // miss an update committed after a later one.
+#define ROW_STAMPS(table) \
+    "(SELECT count(*) AS n, COALESCE(sum(floor(extract(epoch FROM last_update_date) * 1000000)), 0)::bigint AS stamp " \
+    "FROM " table " WHERE tournament_id = t.id)"
+
+// Version of a tournament t and the ROW_STAMPS g of its groups.
+#define TOURNAMENT_VERSION \
+    "COALESCE(floor(extract(epoch FROM t.last_update_date) * 1000000), 0)::bigint || '.' || g.n || '.' || g.stamp"
+
+    // Every team of the groups of tournament t (zeros until its first group match) with its rank in
+    // the group: points, goal difference, goals for, then name, like wc::Table::better.
+#define STANDING_ROWS \
+    "(SELECT gt.group_id, gt.team_id, COALESCE(tm.document->>'name', '') AS team_name, " \
+    "COALESCE(s.played, 0) AS played, COALESCE(s.won, 0) AS won, COALESCE(s.lost, 0) AS lost, " \
+    "COALESCE(s.goals_for, 0) AS goals_for, COALESCE(s.goals_against, 0) AS goals_against, " \
+    "COALESCE(s.points, 0) AS points, gr.created_at AS group_created_at, " \
+    "row_number() OVER (PARTITION BY gt.group_id ORDER BY COALESCE(s.points, 0) DESC, " \
+    "COALESCE(s.goals_for - s.goals_against, 0) DESC, COALESCE(s.goals_for, 0) DESC, tm.document->>'name') AS rank " \
+    "FROM group_teams gt JOIN groups gr ON gr.id = gt.group_id JOIN teams tm ON tm.id = gt.team_id " \
+    "LEFT JOIN standings s ON s.tournament_id = gt.tournament_id AND s.team_id = gt.team_id " \
+    "WHERE gt.tournament_id = t.id"
+#define STANDING_JSON_ARRAY \
+    "COALESCE(json_agg(json_build_object('groupId', r.group_id, 'rank', r.rank, 'teamId', r.team_id, " \
+    "'teamName', r.team_name, 'played', r.played, 'won', r.won, 'lost', r.lost, 'goalsFor', r.goals_for, " \
+    "'goalsAgainst', r.goals_against, 'goalDifference', r.goals_for - r.goals_against, 'points', r.points) " \
+    "ORDER BY r.group_created_at, r.group_id, r.rank), '[]')::text"
+
+    inline constexpr std::array<Statement, StatementCount> Catalog{{
+        {StatementId::SelectAllTeams, "select_all_teams",
+            "SELECT id, document FROM teams ORDER BY created_at ASC", ""},
+        // Keyset pages (see Page.hpp): limit is page size + 1, the extra row only signals a next page.
+        {StatementId::SelectTeamsJsonPage, "select_teams_json_page",
+            "SELECT id, created_at, " TEAM_JSON_BODY " FROM teams ORDER BY created_at, id LIMIT $1::int", "int"},
+        {StatementId::SelectTeamsJsonPageAfter, "select_teams_json_page_after",
+            "SELECT id, created_at, " TEAM_JSON_BODY " FROM teams WHERE (created_at, id) > ($1::timestamp, $2::uuid) "
+            "ORDER BY created_at, id LIMIT $3::int", "timestamp, uuid, int"},
+        {StatementId::SelectTeamById, "select_team_by_id",
+            "SELECT id, document FROM teams WHERE id = $1::uuid LIMIT 1", "uuid"},
+        {StatementId::SelectTeamJsonById, "select_team_json_by_id",
+            "SELECT " TEAM_JSON_BODY " FROM teams WHERE id = $1::uuid LIMIT 1", "uuid"},
+        // A taken name (team_unique_name_idx) inserts nothing and returns no row.
+        {StatementId::InsertTeam, "insert_team",
+            "INSERT INTO teams (document) VALUES ($1::jsonb) "
+            "ON CONFLICT ((document->>'name')) DO NOTHING RETURNING id", "jsonb"},
+        {StatementId::UpdateTeam, "update_team",
+            "UPDATE teams SET document = $2::jsonb, last_update_date = CURRENT_TIMESTAMP WHERE id = $1::uuid", "uuid, jsonb"},
+        {StatementId::DeleteTeam, "delete_team",
+            "DELETE FROM teams WHERE id = $1::uuid", "uuid"},
+
+        {StatementId::SelectAllTournaments, "select_all_tournaments",
+            "SELECT id, document FROM tournaments ORDER BY created_at ASC", ""},
+        {StatementId::SelectTournamentsJsonPage, "select_tournaments_json_page",
+            "SELECT id, created_at, " TOURNAMENT_JSON_BODY " FROM tournaments ORDER BY created_at, id LIMIT $1::int", "int"},
+        {StatementId::SelectTournamentsJsonPageAfter, "select_tournaments_json_page_after",
+            "SELECT id, created_at, " TOURNAMENT_JSON_BODY " FROM tournaments WHERE (created_at, id) > ($1::timestamp, $2::uuid) "
+            "ORDER BY created_at, id LIMIT $3::int", "timestamp, uuid, int"},
+        {StatementId::SelectTournamentById, "select_tournament_by_id",
+            "SELECT id, document FROM tournaments WHERE id = $1::uuid LIMIT 1", "uuid"},
+        // GET /tournaments/{id} renders the tournament and its groups. No row: the tournament doesn't exist.
+        {StatementId::SelectTournamentVersion, "select_tournament_version",
+            "SELECT " TOURNAMENT_VERSION " AS version "
+            "FROM tournaments t CROSS JOIN LATERAL " ROW_STAMPS("groups") " g WHERE t.id = $1::uuid", "uuid"},
+        // The row and its version from one snapshot: a body and the ETag sent with it.
+        {StatementId::SelectTournamentWithVersion, "select_tournament_with_version",
+            "SELECT t.id, t.document, " TOURNAMENT_VERSION " AS version "
+            "FROM tournaments t CROSS JOIN LATERAL " ROW_STAMPS("groups") " g WHERE t.id = $1::uuid", "uuid"},
+        // Same with tournament_unique_name_idx.
+        {StatementId::InsertTournament, "insert_tournament",
+            "INSERT INTO tournaments (document) VALUES ($1::jsonb) "
+            "ON CONFLICT ((document->>'name')) DO NOTHING RETURNING id", "jsonb"},
+        {StatementId::UpdateTournament, "update_tournament",
+            "UPDATE tournaments SET document = $2::jsonb, last_update_date = CURRENT_TIMESTAMP WHERE id = $1::uuid", "uuid, jsonb"},
+        {StatementId::DeleteTournament, "delete_tournament",
+            "DELETE FROM tournaments WHERE id = $1::uuid", "uuid"},
+
+        {StatementId::SelectAllGroups, "select_all_groups",
+            "SELECT id, document->>'name' AS name FROM groups", ""},
+        {StatementId::SelectGroupById, "select_group_by_id",
+            "SELECT id, document FROM groups WHERE id = $1::uuid", "uuid"},
+        {StatementId::SelectGroupsByTournament, "select_groups_by_tournament",
+            "SELECT id, document FROM groups WHERE tournament_id = $1::uuid", "uuid"},
+        {StatementId::SelectGroupByTournamentIdGroupId, "select_group_by_tournamentid_groupid",
+            "SELECT id, document FROM groups WHERE tournament_id = $1::uuid AND id = $2::uuid", "uuid, uuid"},
+        // Inside a unit of work: the group row stays locked until commit, so capacity checks can't race.
+        {StatementId::SelectGroupByTournamentIdGroupIdForUpdate, "select_group_by_tournamentid_groupid_for_update",
+            "SELECT id, document FROM groups WHERE tournament_id = $1::uuid AND id = $2::uuid FOR UPDATE", "uuid, uuid"},
+        {StatementId::SelectGroupInTournament, "select_group_in_tournament",
+            "SELECT g.id, g.document FROM group_teams gt JOIN groups g ON g.id = gt.group_id "
+            "WHERE gt.tournament_id = $1::uuid AND gt.team_id = $2::uuid", "uuid, uuid"},
+        {StatementId::InsertGroup, "insert_group",
+            "INSERT INTO groups (tournament_id, document) VALUES ($1::uuid, $2::jsonb) RETURNING id", "uuid, jsonb"},
+        {StatementId::UpdateGroup, "update_group",
+            "UPDATE groups SET document = $2::jsonb, last_update_date = CURRENT_TIMESTAMP WHERE id = $1::uuid RETURNING id", "uuid, jsonb"},
+        {StatementId::UpdateGroupAddTeams, "update_group_add_teams",
+            "UPDATE groups SET document = jsonb_set(document, '{teams}', COALESCE(document->'teams', '[]'::jsonb) || $2::jsonb), "
+            "last_update_date = CURRENT_TIMESTAMP WHERE id = $1::uuid", "uuid, jsonb"},
+        {StatementId::DeleteGroup, "delete_group",
+            "DELETE FROM groups WHERE id = $1::uuid", "uuid"},
+        // Membership rows backing "which group is this team in"; a team already in the tournament is skipped
+        // (not returned), the repository turns that into DuplicateEntityError.
+        {StatementId::InsertGroupTeams, "insert_group_teams",
+            "INSERT INTO group_teams (tournament_id, group_id, team_id) "
+            "SELECT g.tournament_id, g.id, t.team_id FROM groups g, unnest($2::uuid[]) AS t(team_id) WHERE g.id = $1::uuid "
+            "ON CONFLICT DO NOTHING RETURNING team_id", "uuid, uuid[]"},
+        // Makes the membership rows of a group match its document after a full update.
+        {StatementId::SyncGroupTeams, "sync_group_teams",
+            "WITH wanted AS (SELECT DISTINCT team_id FROM unnest($2::uuid[]) AS t(team_id)), "
+            "removed AS (DELETE FROM group_teams WHERE group_id = $1::uuid AND team_id NOT IN (SELECT team_id FROM wanted)) "
+            "INSERT INTO group_teams (tournament_id, group_id, team_id) "
+            "SELECT g.tournament_id, g.id, w.team_id FROM groups g, wanted w WHERE g.id = $1::uuid "
+            "ON CONFLICT (group_id, team_id) DO NOTHING", "uuid, uuid[]"},
+
+        {StatementId::SelectMatchesByTournament, "select_matches_by_tournament",
+            "SELECT id, tournament_id, round_key, status, home_id_key, home_name, visitor_id_key, visitor_name, "
+            "score_home, score_visitor, winner_team_id, decided_by, next_match_id, next_match_winner_slot "
+            "FROM matches WHERE tournament_id = $1::uuid ORDER BY created_at ASC", "uuid"},
+        // $2 is the showMatches filter: '' (all), 'played' or 'pending' (anything not played).
+        {StatementId::SelectMatchesJsonPage, "select_matches_json_page",
+            "SELECT id, created_at, " MATCH_JSON_BODY " FROM matches WHERE tournament_id = $1::uuid "
+            "AND ($2::text = '' OR (status IS NOT DISTINCT FROM 'played') = ($2::text = 'played')) "
+            "ORDER BY created_at, id LIMIT $3::int", "uuid, text, int"},
+        {StatementId::SelectMatchesJsonPageAfter, "select_matches_json_page_after",
+            "SELECT id, created_at, " MATCH_JSON_BODY " FROM matches WHERE tournament_id = $1::uuid "
+            "AND ($2::text = '' OR (status IS NOT DISTINCT FROM 'played') = ($2::text = 'played')) "
+            "AND (created_at, id) > ($3::timestamp, $4::uuid) "
+            "ORDER BY created_at, id LIMIT $5::int", "uuid, text, timestamp, uuid, int"},
+        {StatementId::SelectMatchByTournamentIdMatchId, "select_match_by_tournamentid_matchid",
+            "SELECT id, tournament_id, round_key, status, home_id_key, home_name, visitor_id_key, visitor_name, "
+            "score_home, score_visitor, winner_team_id, decided_by, next_match_id, next_match_winner_slot "
+            "FROM matches WHERE tournament_id = $1::uuid AND id = $2::uuid LIMIT 1", "uuid, uuid"},
+        // Inside a unit of work: the score update applies old vs new score to STANDINGS, so two
+        // updates of the same match must not both start from the same old score.
+        {StatementId::SelectMatchByTournamentIdMatchIdForUpdate, "select_match_by_tournamentid_matchid_for_update",
+            "SELECT id, tournament_id, round_key, status, home_id_key, home_name, visitor_id_key, visitor_name, "
+            "score_home, score_visitor, winner_team_id, decided_by, next_match_id, next_match_winner_slot "
+            "FROM matches WHERE tournament_id = $1::uuid AND id = $2::uuid FOR UPDATE", "uuid, uuid"},
+        {StatementId::SelectMatchJsonByTournamentIdMatchId, "select_match_json_by_tournamentid_matchid",
+            "SELECT " MATCH_JSON_BODY " FROM matches WHERE tournament_id = $1::uuid AND id = $2::uuid LIMIT 1", "uuid, uuid"},
+        // Every page of GET /tournaments/{id}/matches. No row: the tournament doesn't exist.
+        {StatementId::SelectMatchesVersion, "select_matches_version",
+            "SELECT g.n || '.' || g.stamp AS version "
+            "FROM tournaments t CROSS JOIN LATERAL " ROW_STAMPS("matches") " g WHERE t.id = $1::uuid", "uuid"},
+        {StatementId::SelectMatchIdByNaturalKey, "select_match_id_by_natural_key",
+            "SELECT id FROM matches "
+            "WHERE tournament_id = $1::uuid "
+            "AND round_key = ($2::jsonb->>'round') "
+            "AND home_id_key = NULLIF($2::jsonb->'home'->>'id', '')::uuid "
+            "AND visitor_id_key = NULLIF($2::jsonb->'visitor'->>'id', '')::uuid "
+            "LIMIT 1", "uuid, jsonb"},
+        {StatementId::InsertMatch, "insert_match",
+            "INSERT INTO matches (tournament_id, document) VALUES ($1::uuid, $2::jsonb) RETURNING id", "uuid, jsonb"},
+        {StatementId::InsertMatchIfNotExists, "insert_match_if_not_exists",
+            "INSERT INTO matches (tournament_id, document) VALUES ($1::uuid, $2::jsonb) "
+            "ON CONFLICT (tournament_id, round_key, home_id_key, visitor_id_key) DO NOTHING "
+            "RETURNING id", "uuid, jsonb"},
+        // One statement for a whole generated fixture: input order is kept through the ordinality, rows
+        // already present (same tournament/round/home/visitor) keep their id instead of failing.
+        {StatementId::InsertMatchesBatch, "insert_matches_batch",
+            "WITH input AS ("
+            "  SELECT doc, ord FROM unnest($1::jsonb[]) WITH ORDINALITY AS t(doc, ord)"
+            "), inserted AS ("
+            "  INSERT INTO matches (tournament_id, document)"
+            "  SELECT (doc->>'tournamentId')::uuid, doc FROM input ORDER BY ord"
+            "  ON CONFLICT DO NOTHING"
+            "  RETURNING id, tournament_id, round_key, home_id_key, visitor_id_key"
+            "), keyed AS ("
+            "  SELECT ord, (doc->>'tournamentId')::uuid AS tournament_id, doc->>'round' AS round_key,"
+            "         NULLIF(doc->'home'->>'id', '')::uuid AS home_id_key,"
+            "         NULLIF(doc->'visitor'->>'id', '')::uuid AS visitor_id_key"
+            "  FROM input"
+            ") "
+            "SELECT k.ord, COALESCE(i.id, m.id) AS id "
+            "FROM keyed k "
+            "LEFT JOIN inserted i ON i.tournament_id = k.tournament_id AND i.round_key = k.round_key "
+            "  AND i.home_id_key IS NOT DISTINCT FROM k.home_id_key "
+            "  AND i.visitor_id_key IS NOT DISTINCT FROM k.visitor_id_key "
+            "LEFT JOIN matches m ON m.tournament_id = k.tournament_id AND m.round_key = k.round_key "
+            "  AND m.home_id_key = k.home_id_key AND m.visitor_id_key = k.visitor_id_key "
+            "ORDER BY k.ord", "jsonb[]"},
+        {StatementId::UpdateMatch, "update_match",
+            "UPDATE matches SET document = $3::jsonb, last_update_date = CURRENT_TIMESTAMP "
+            "WHERE tournament_id = $1::uuid AND id = $2::uuid", "uuid, uuid, jsonb"},
+
+        {StatementId::SelectStandingsByTournament, "select_standings_by_tournament",
+            "SELECT r.* FROM tournaments t CROSS JOIN LATERAL " STANDING_ROWS ") r "
+            "WHERE t.id = $1::uuid ORDER BY r.group_created_at, r.group_id, r.rank", "uuid"},
+        // Bodies of GET /tournaments/{id}/standings and /groups/{gid}/standings. No row: no such tournament/group.
+        {StatementId::SelectStandingsJsonByTournament, "select_standings_json_by_tournament",
+            "SELECT (SELECT " STANDING_JSON_ARRAY " FROM " STANDING_ROWS ") r) AS body "
+            "FROM tournaments t WHERE t.id = $1::uuid", "uuid"},
+        {StatementId::SelectStandingsJsonByGroup, "select_standings_json_by_group",
+            "SELECT (SELECT " STANDING_JSON_ARRAY " FROM " STANDING_ROWS " AND gt.group_id = g.id) r) AS body "
+            "FROM groups g JOIN tournaments t ON t.id = g.tournament_id "
+            "WHERE t.id = $1::uuid AND g.id = $2::uuid", "uuid, uuid"},
+        // Adds one delta per team (parallel arrays) to the row of the team's group; teams without a
+        // group are skipped. The first delta of a team creates its row.
+        {StatementId::ApplyStandingDeltas, "apply_standing_deltas",
+            "INSERT INTO standings (tournament_id, group_id, team_id, played, won, lost, goals_for, goals_against, points) "
+            "SELECT gt.tournament_id, gt.group_id, gt.team_id, d.played, d.won, d.lost, d.goals_for, d.goals_against, d.points "
+            "FROM unnest($2::uuid[], $3::int[], $4::int[], $5::int[], $6::int[], $7::int[], $8::int[]) "
+            "AS d(team_id, played, won, lost, goals_for, goals_against, points) "
+            "JOIN group_teams gt ON gt.tournament_id = $1::uuid AND gt.team_id = d.team_id "
+            "ON CONFLICT (tournament_id, team_id) DO UPDATE SET "
+            "played = standings.played + excluded.played, won = standings.won + excluded.won, "
+            "lost = standings.lost + excluded.lost, goals_for = standings.goals_for + excluded.goals_for, "
+            "goals_against = standings.goals_against + excluded.goals_against, "
+            "points = standings.points + excluded.points, last_update_date = CURRENT_TIMESTAMP",
+            "uuid, uuid[], int[], int[], int[], int[], int[], int[]"},
+
+        {StatementId::InsertOutboxEvent, "insert_outbox_event",
+            "INSERT INTO outbox (queue, payload) VALUES ($1::text, $2::text)", "text, text"},
+        // Oldest pending rows not claimed by another relay; the locks last until the relay's transaction ends.
+        {StatementId::ClaimOutboxBatch, "claim_outbox_batch",
+            "SELECT id, queue, payload FROM outbox WHERE published_at IS NULL "
+            "ORDER BY id LIMIT $1::int FOR UPDATE SKIP LOCKED", "int"},
+        {StatementId::MarkOutboxPublished, "mark_outbox_published",
+            "UPDATE outbox SET published_at = CURRENT_TIMESTAMP WHERE id = ANY($1::bigint[])", "bigint[]"},
+        {StatementId::PurgeOutboxPublished, "purge_outbox_published",
+            "DELETE FROM outbox WHERE published_at < CURRENT_TIMESTAMP - $1::int * INTERVAL '1 hour'", "int"},
+    }};
+
+#undef TEAM_JSON_BODY
+#undef TOURNAMENT_JSON_BODY
+#undef MATCH_JSON_BODY
+#undef ROW_STAMPS
+#undef TOURNAMENT_VERSION
+#undef STANDING_ROWS
+#undef STANDING_JSON_ARRAY
+
+    constexpr const Statement& Get(StatementId id) {
+        return Catalog[static_cast<std::size_t>(id)];
+    }
+
+    namespace detail {
+        // Highest $n placeholder used in the SQL text.
+        constexpr std::size_t maxPlaceholder(std::string_view sql) {
+            std::size_t max = 0;
+            for (std::size_t i = 0; i < sql.size(); ++i) {
+                if (sql[i] != '$') continue;
+                std::size_t n = 0;
+                while (i + 1 < sql.size() && sql[i + 1] >= '0' && sql[i + 1] <= '9') {
+                    n = n * 10 + static_cast<std::size_t>(sql[++i] - '0');
+                }
+                if (n > max) max = n;
+            }
+            return max;
+        }
+
+        constexpr std::size_t typeCount(std::string_view types) {
+            if (types.empty()) return 0;
+            std::size_t n = 1;
+            for (char c : types) if (c == ',') ++n;
+            return n;
+        }
+
+        constexpr bool catalogIsConsistent() {
+            for (std::size_t i = 0; i < Catalog.size(); ++i) {
+                const auto& s = Catalog[i];
+                if (static_cast<std::size_t>(s.id) != i) return false;
+                if (s.name.empty() || s.sql.empty()) return false;
+                if (maxPlaceholder(s.sql) != typeCount(s.parameterTypes)) return false;
+                for (std::size_t j = 0; j < i; ++j) {
+                    if (Catalog[j].name == s.name) return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    static_assert(detail::catalogIsConsistent(),
+                  "statement catalog: entries must follow StatementId order, have unique names and declare one type per placeholder");
+
+    // SQL text of a statement with $1..$n replaced by already-quoted literals, for paths that cannot
+    // use the prepared form (pipelined batches).
+    inline std::string Inline(StatementId id, const std::vector<std::string>& literals) {
+        const std::string_view sql = Get(id).sql;
+        std::string out;
+        out.reserve(sql.size() + 64);
+        for (std::size_t i = 0; i < sql.size(); ++i) {
+            if (sql[i] != '$' || i + 1 >= sql.size() || sql[i + 1] < '0' || sql[i + 1] > '9') {
+                out.push_back(sql[i]);
+                continue;
+            }
+            std::size_t n = 0;
+            while (i + 1 < sql.size() && sql[i + 1] >= '0' && sql[i + 1] <= '9') {
+                n = n * 10 + static_cast<std::size_t>(sql[++i] - '0');
+            }
+            out += literals.at(n - 1);
+        }
+        return out;
+    }
+
+    // Prints the catalog (name, parameter types, SQL) for review.
+    inline void Dump(std::ostream& out) {
+        for (const auto& s : Catalog) {
+            out << s.name << " (" << s.parameterTypes << ")\n    " << s.sql << "\n";
+        }
+    }
+}
+
+#endif //TOURNAMENTS_STATEMENTCATALOG_HPP
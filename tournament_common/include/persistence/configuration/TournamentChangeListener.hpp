@@ -0,0 +1,56 @@
+//
+// TournamentChangeListener.hpp
+// Keeps the TournamentCache of this instance coherent with the writes of the others. A trigger on
+// TOURNAMENTS (database/migrations/004_tournament_change_notify.sql) sends NOTIFY tournament_changed
+// with the id of every updated or deleted tournament when its transaction commits. This listener
+// holds its own connection to the primary (outside the pool, LISTEN needs a session of its own),
+// waits for those notifications on a background thread and invalidates the ids it receives.
+// When the connection drops, notifications may be lost: the cache is cleared and the listener
+// reconnects with backoff.
+//
+
+#ifndef TOURNAMENTS_TOURNAMENTCHANGELISTENER_HPP
+#define TOURNAMENTS_TOURNAMENTCHANGELISTENER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "persistence/repository/TournamentCache.hpp"
+
+class TournamentChangeListener {
+public:
+    static constexpr std::string_view Channel = "tournament_changed";
+
+    TournamentChangeListener(std::string connectionString, std::shared_ptr<TournamentCache> cache);
+    ~TournamentChangeListener();
+
+    TournamentChangeListener(const TournamentChangeListener&) = delete;
+    TournamentChangeListener& operator=(const TournamentChangeListener&) = delete;
+
+    // Notifications applied since start (for logs and tests).
+    [[nodiscard]] std::uint64_t Received() const { return received.load(std::memory_order_relaxed); }
+
+    // What a notification does to the cache: an id invalidates it, an empty payload clears everything.
+    static void Apply(TournamentCache& cache, std::string_view payload);
+
+private:
+    std::string connectionString;
+    std::shared_ptr<TournamentCache> cache;
+    std::atomic<std::uint64_t> received{0};
+
+    std::mutex stopMutex;
+    std::condition_variable stopWake;
+    std::atomic<bool> stopping{false};
+    std::thread worker;
+
+    void listenLoop();
+    void logStatistics(TournamentCache::Stats& last);
+};
+
+#endif //TOURNAMENTS_TOURNAMENTCHANGELISTENER_HPP
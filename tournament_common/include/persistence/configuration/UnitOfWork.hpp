@@ -0,0 +1,147 @@
+//
+// UnitOfWork.hpp
+// One primary connection and one transaction for a whole delegate operation. A delegate opens a
+// UnitOfWork on the stack; every repository call made on that thread until it goes out of scope
+// runs on the same connection and transaction (reads included, so they see the unit's writes),
+// and Commit() commits everything at once. Leaving the scope without Commit() rolls it all back.
+// Repositories get their connection through DbTransaction, which joins the current unit or, when
+// there is none, checks out a connection and opens a transaction of its own as before.
+//
+
+#ifndef TOURNAMENTS_UNITOFWORK_HPP
+#define TOURNAMENTS_UNITOFWORK_HPP
+
+#include <optional>
+#include <pqxx/pqxx>
+
+#include "IDbConnectionProvider.hpp"
+#include "PostgresConnection.hpp"
+#include "StatementCatalog.hpp"
+
+class UnitOfWork {
+public:
+    // Becomes the thread's current unit, or joins the one already open (then the outer one commits).
+    UnitOfWork() : outer(current) {
+        if (outer == nullptr) {
+            current = this;
+        }
+    }
+
+    // Not committed: the transaction aborts when it is destroyed and the connection goes back to the pool.
+    ~UnitOfWork() {
+        if (outer == nullptr) {
+            current = nullptr;
+        }
+    }
+
+    UnitOfWork(const UnitOfWork&) = delete;
+    UnitOfWork& operator=(const UnitOfWork&) = delete;
+
+    // Commits once and returns the connection. Later calls on this thread get their own transactions.
+    void Commit() {
+        if (outer != nullptr) {
+            return;
+        }
+        finished = true;
+        if (work) {
+            work->commit();
+            work.reset();
+        }
+        pooled.reset();
+    }
+
+    // A unit is open on this thread and not committed yet.
+    [[nodiscard]] static bool Open() {
+        return current != nullptr && !current->finished;
+    }
+
+    // The thread's open unit, or nullptr. Unlike For() it never binds the unit to a provider, so it
+    // checks out no connection and opens no transaction.
+    [[nodiscard]] static const UnitOfWork* Current() {
+        return Open() ? current : nullptr;
+    }
+
+    // Unit the repository calls of this provider run in, or nullptr. The first provider asking binds
+    // the unit (the services share one provider); calls through any other run on their own.
+    static UnitOfWork* For(IDbConnectionProvider& provider) {
+        if (!Open()) {
+            return nullptr;
+        }
+        UnitOfWork* unit = current;
+        if (unit->provider == nullptr) {
+            unit->pooled = provider.Connection();
+            unit->connection = &unit->pooled.As<PostgresConnection>();
+            unit->work.emplace(*unit->connection->connection);
+            unit->provider = &provider;
+        }
+        return unit->provider == &provider ? unit : nullptr;
+    }
+
+    PostgresConnection& Connection() { return *connection; }
+    pqxx::work& Work() { return *work; }
+
+private:
+    static inline thread_local UnitOfWork* current = nullptr;
+
+    UnitOfWork* outer;
+    bool finished = false;
+    IDbConnectionProvider* provider = nullptr;
+    PooledConnection pooled;
+    PostgresConnection* connection = nullptr;
+    std::optional<pqxx::work> work;
+};
+
+// Connection and transaction of one repository call.
+class DbTransaction {
+public:
+    enum class Access { Read, Write };
+
+    DbTransaction(IDbConnectionProvider& provider, Access access) : unit(UnitOfWork::For(provider)) {
+        if (unit != nullptr) {
+            connection = &unit->Connection();
+            tx = &unit->Work();
+            return;
+        }
+        if (access == Access::Write) {
+            pooled = provider.Connection();
+            connection = &pooled.As<PostgresConnection>();
+            tx = &ownWrite.emplace(*connection->connection);
+        } else {
+            pooled = provider.ReadConnection();
+            connection = &pooled.As<PostgresConnection>();
+            tx = &ownRead.emplace(*connection->connection);
+        }
+    }
+
+    DbTransaction(const DbTransaction&) = delete;
+    DbTransaction& operator=(const DbTransaction&) = delete;
+
+    pqxx::result Exec(statements::StatementId id, pqxx::params params = {}) {
+        return tx->exec(connection->Prepared(id), std::move(params));
+    }
+
+    // Inside a unit the unit commits (or rolls back) at the end; Commit/Abort only apply to an own transaction.
+    void Commit() {
+        if (unit == nullptr) {
+            tx->commit();
+        }
+    }
+    void Abort() {
+        if (unit == nullptr) {
+            tx->abort();
+        }
+    }
+
+    // True when running in a unit: the primary, inside a read-write transaction (row locks are possible).
+    [[nodiscard]] bool InUnit() const { return unit != nullptr; }
+
+private:
+    UnitOfWork* unit;
+    PooledConnection pooled;
+    PostgresConnection* connection = nullptr;
+    std::optional<pqxx::work> ownWrite;
+    std::optional<pqxx::read_transaction> ownRead;
+    pqxx::transaction_base* tx = nullptr;
+};
+
+#endif //TOURNAMENTS_UNITOFWORK_HPP
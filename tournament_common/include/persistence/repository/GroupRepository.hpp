@@ -26,6 +26,11 @@ public:
     std::shared_ptr<domain::Group> FindByTournamentIdAndGroupId(const std::string_view& tournamentId, const std::string_view& groupId) override;
     std::shared_ptr<domain::Group> FindByTournamentIdAndTeamId(const std::string_view& tournamentId, const std::string_view& teamId) override;
     void UpdateGroupAddTeam(const std::string_view& groupId, const std::shared_ptr<domain::Team> & team) override;
+    void UpdateGroupAddTeams(const std::string_view& groupId, const std::vector<std::shared_ptr<domain::Team>>& teams) override;
+
+    Deferred<std::vector<std::shared_ptr<domain::Group>>> DeferFindByTournamentId(ReadBatch& batch, std::string_view tournamentId) override;
+    Deferred<std::shared_ptr<domain::Group>> DeferFindByTournamentIdAndGroupId(ReadBatch& batch, std::string_view tournamentId, std::string_view groupId) override;
+    Deferred<std::shared_ptr<domain::Group>> DeferFindByTournamentIdAndTeamId(ReadBatch& batch, std::string_view tournamentId, std::string_view teamId) override;
 };
 
 #endif //TOURNAMENTS_GROUPREPOSITORY_HPP
\ No newline at end of file
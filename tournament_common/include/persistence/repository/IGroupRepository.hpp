@@ -7,6 +7,7 @@
 
 #include "domain/Group.hpp"
 #include "IRepository.hpp"
+#include "RepositoryErrors.hpp"
 
 
 class IGroupRepository : public IRepository<domain::Group, std::string> {
@@ -14,6 +15,33 @@ public:
     virtual std::vector<std::shared_ptr<domain::Group>> FindByTournamentId(const std::string_view& tournamentId) = 0;
     virtual std::shared_ptr<domain::Group> FindByTournamentIdAndGroupId(const std::string_view& tournamentId, const std::string_view& groupId) = 0;
     virtual std::shared_ptr<domain::Group> FindByTournamentIdAndTeamId(const std::string_view& tournamentId, const std::string_view& teamId) = 0;
+    // Throws DuplicateEntityError (key = team id) when the team already plays in the tournament.
     virtual void UpdateGroupAddTeam(const std::string_view& groupId, const std::shared_ptr<domain::Team> & team) = 0;
+    // All teams or none. The default adds them one by one.
+    virtual void UpdateGroupAddTeams(const std::string_view& groupId, const std::vector<std::shared_ptr<domain::Team>>& teams) {
+        for (const auto& team : teams) {
+            UpdateGroupAddTeam(groupId, team);
+        }
+    }
+
+    // Batched reads (see ReadBatch). Defaults run the plain method when the value is needed.
+    virtual Deferred<std::vector<std::shared_ptr<domain::Group>>> DeferFindByTournamentId(ReadBatch& batch, std::string_view tournamentId) {
+        (void)batch;
+        return Deferred<std::vector<std::shared_ptr<domain::Group>>>([this, tid = std::string(tournamentId)] {
+            return FindByTournamentId(tid);
+        });
+    }
+    virtual Deferred<std::shared_ptr<domain::Group>> DeferFindByTournamentIdAndGroupId(ReadBatch& batch, std::string_view tournamentId, std::string_view groupId) {
+        (void)batch;
+        return Deferred<std::shared_ptr<domain::Group>>([this, tid = std::string(tournamentId), gid = std::string(groupId)] {
+            return FindByTournamentIdAndGroupId(tid, gid);
+        });
+    }
+    virtual Deferred<std::shared_ptr<domain::Group>> DeferFindByTournamentIdAndTeamId(ReadBatch& batch, std::string_view tournamentId, std::string_view teamId) {
+        (void)batch;
+        return Deferred<std::shared_ptr<domain::Group>>([this, tid = std::string(tournamentId), teid = std::string(teamId)] {
+            return FindByTournamentIdAndTeamId(tid, teid);
+        });
+    }
 };
 #endif //COMMON_IGROUPREPOSITORY_HPP
\ No newline at end of file
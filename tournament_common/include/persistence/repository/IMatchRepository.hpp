@@ -4,6 +4,8 @@
 #include <optional>
 #include <vector>
 #include "domain/Match.hpp"
+#include "Page.hpp"
+#include "ReadBatch.hpp"
 
 class IMatchRepository {
 public:
@@ -12,15 +14,62 @@ public:
     virtual std::vector<std::shared_ptr<domain::Match>>
     FindByTournamentId(const std::string& tournamentId) = 0;
 
+    // One keyset page of a tournament's matches, as the response JSON rendered by the database
+    // (see JsonPage). status: "" (all), "played" or "pending".
+    virtual JsonPage
+    FindJsonPageByTournamentId(const std::string& tournamentId, const std::string& status,
+                               const PageRequest& request) = 0;
+
+    virtual std::optional<std::string>
+    FindJsonByTournamentIdAndMatchId(const std::string& tournamentId, const std::string& matchId) = 0;
+
     virtual std::shared_ptr<domain::Match>
     FindByTournamentIdAndMatchId(const std::string& tournamentId,
                                  const std::string& matchId) = 0;
 
+    // Version of the tournament's match list for ETags (see SelectMatchesVersion); nullopt when the
+    // tournament doesn't exist or the repository keeps no versions.
+    virtual std::optional<std::string>
+    FindVersionByTournamentId(const std::string& tournamentId) {
+        (void)tournamentId;
+        return std::nullopt;
+    }
+
     // Create (may throw on UNIQUE violation if caller no filtra)
     virtual std::string Create(const domain::Match& entity) = 0;
 
     // Idempotent insert: returns existing id when duplicate key
     virtual std::string CreateIfNotExists(const domain::Match& entity) = 0;
 
+    // Inserts all matches in one statement/transaction (idempotent like CreateIfNotExists).
+    // Returns one id per input match, in the same order.
+    virtual std::vector<std::string> CreateBatch(const std::vector<domain::Match>& entities) = 0;
+
     virtual std::string Update(const domain::Match& entity) = 0;
+
+    // Batched reads (see ReadBatch). Defaults run the plain method when the value is needed.
+    virtual Deferred<std::vector<std::shared_ptr<domain::Match>>>
+    DeferFindByTournamentId(ReadBatch& batch, const std::string& tournamentId) {
+        (void)batch;
+        return Deferred<std::vector<std::shared_ptr<domain::Match>>>([this, tournamentId] {
+            return FindByTournamentId(tournamentId);
+        });
+    }
+
+    virtual Deferred<JsonPage>
+    DeferFindJsonPageByTournamentId(ReadBatch& batch, const std::string& tournamentId, const std::string& status,
+                                    const PageRequest& request) {
+        (void)batch;
+        return Deferred<JsonPage>([this, tournamentId, status, request] {
+            return FindJsonPageByTournamentId(tournamentId, status, request);
+        });
+    }
+
+    virtual Deferred<std::shared_ptr<domain::Match>>
+    DeferFindByTournamentIdAndMatchId(ReadBatch& batch, const std::string& tournamentId, const std::string& matchId) {
+        (void)batch;
+        return Deferred<std::shared_ptr<domain::Match>>([this, tournamentId, matchId] {
+            return FindByTournamentIdAndMatchId(tournamentId, matchId);
+        });
+    }
 };
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Events waiting to be published (OUTBOX, see database/migrations/006_outbox.sql).
+struct OutboxEvent {
+    std::int64_t id = 0;
+    std::string queue;
+    std::string payload;
+};
+
+class IOutboxRepository {
+public:
+    virtual ~IOutboxRepository() = default;
+
+    // Stores an event for queue. Runs in the current unit of work when there is one, so the event is
+    // committed (or rolled back) together with the change it announces.
+    virtual void Enqueue(const std::string& queue, const std::string& payload) = 0;
+
+    // Claims up to limit pending events, oldest first, skipping those another instance holds, and hands
+    // them to publish one by one. The ones published are marked in the same transaction. The first
+    // exception stops the batch: what was published before it is still marked, then it is rethrown.
+    // Returns how many were published.
+    virtual std::size_t PublishPending(std::size_t limit, const std::function<void(const OutboxEvent&)>& publish) = 0;
+
+    // Deletes the events published more than olderThanHours ago. Returns how many.
+    virtual std::size_t PurgePublished(int olderThanHours) = 0;
+};
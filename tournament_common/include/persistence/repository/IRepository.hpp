@@ -6,6 +6,19 @@
 #define RESTAPI_IREPOSITORY_HPP
 #include <vector>
 #include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "Page.hpp"
+#include "ReadBatch.hpp"
+
+// An entity and the version it was read at (ReadWithVersion).
+template<typename Type>
+struct Versioned {
+    std::shared_ptr<Type> entity;   // nullptr: not found
+    std::string version;            // empty: the repository keeps no versions
+};
 
 template<typename Type, typename Id>
 class IRepository {
@@ -16,5 +29,37 @@ public:
     virtual Id Update (const Type & entity) = 0;
     virtual void Delete(Id id) = 0;
     virtual std::vector<std::shared_ptr<Type>> ReadAll() = 0;
+
+    // Pass-through reads: the response JSON exactly as the database renders it, never parsed here.
+    virtual std::optional<std::string> ReadJsonById(Id id) {
+        (void)id;
+        throw std::logic_error("ReadJsonById is not supported by this repository");
+    }
+
+    virtual JsonPage ReadJsonPage(const PageRequest& request) {
+        (void)request;
+        throw std::logic_error("ReadJsonPage is not supported by this repository");
+    }
+
+    // Version of what ReadById serves, for ETags: changes whenever the resource does. nullopt when the
+    // entity doesn't exist or the repository keeps no versions.
+    virtual std::optional<std::string> ReadVersion(Id id) {
+        (void)id;
+        return std::nullopt;
+    }
+
+    // ReadById with the version of what it returns, for a body and its ETag. Default: the version is
+    // read first, so the entity is never older than it; a repository that may serve cached entities
+    // reads both in one statement instead.
+    virtual Versioned<Type> ReadWithVersion(Id id) {
+        auto version = ReadVersion(id);
+        return {ReadById(id), version.value_or(std::string{})};
+    }
+
+    // Queues ReadById on the batch. Default: plain ReadById when the value is needed.
+    virtual Deferred<std::shared_ptr<Type>> DeferReadById(ReadBatch& batch, Id id) {
+        (void)batch;
+        return Deferred<std::shared_ptr<Type>>([this, key = std::string(id)] { return ReadById(Id(key)); });
+    }
 };
 #endif //RESTAPI_IREPOSITORY_HPP
\ No newline at end of file
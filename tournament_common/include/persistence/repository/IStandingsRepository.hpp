@@ -0,0 +1,35 @@
+#pragma once
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "domain/Standing.hpp"
+#include "ReadBatch.hpp"
+
+// Group tables of a tournament (STANDINGS, see database/migrations/005_standings.sql).
+class IStandingsRepository {
+public:
+    virtual ~IStandingsRepository() = default;
+
+    // Adds each delta (teamId + counters) to the row of the team's group in tournamentId; teams
+    // without a group are skipped. Runs in the current unit of work when there is one.
+    virtual void Apply(const std::string& tournamentId, const std::vector<domain::Standing>& deltas) = 0;
+
+    // Every team of every group, zeros before its first match, in group order and ranked inside each group.
+    virtual std::vector<domain::Standing> FindByTournamentId(const std::string& tournamentId) = 0;
+
+    // Response bodies rendered by the database (JSON array of rows); nullopt when the tournament
+    // (or the group in that tournament) doesn't exist.
+    virtual std::optional<std::string> FindJsonByTournamentId(const std::string& tournamentId) = 0;
+    virtual std::optional<std::string>
+    FindJsonByTournamentIdAndGroupId(const std::string& tournamentId, const std::string& groupId) = 0;
+
+    // Batched read (see ReadBatch). The default runs the plain method when the value is needed.
+    virtual Deferred<std::vector<domain::Standing>>
+    DeferFindByTournamentId(ReadBatch& batch, const std::string& tournamentId) {
+        (void)batch;
+        return Deferred<std::vector<domain::Standing>>([this, tournamentId] {
+            return FindByTournamentId(tournamentId);
+        });
+    }
+};
@@ -0,0 +1,136 @@
+//
+// IdentityMap.hpp
+// Request/event scoped map of what the repositories already loaded. While an IdentityMap is alive on
+// a thread, repeating a lookup (same query, same key) returns the value loaded the first time, the
+// same shared_ptr, instead of going to the database again. "Not found" is remembered as well.
+// Repository writes drop the entries they may have changed. Each scope counts its hits (lookups
+// answered from the map) and loads (lookups that went to the database).
+// Without a scope, repositories read straight through, as before.
+//
+
+#ifndef TOURNAMENTS_IDENTITYMAP_HPP
+#define TOURNAMENTS_IDENTITYMAP_HPP
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class IdentityMap {
+public:
+    struct Stats {
+        std::size_t hits = 0;
+        std::size_t loads = 0;
+    };
+
+    // Becomes the thread's map, or shares the one already open.
+    IdentityMap() : outer(current) {
+        if (outer == nullptr) {
+            current = this;
+        }
+    }
+
+    ~IdentityMap() {
+        if (outer == nullptr) {
+            current = nullptr;
+        }
+    }
+
+    IdentityMap(const IdentityMap&) = delete;
+    IdentityMap& operator=(const IdentityMap&) = delete;
+
+    // Counters of the map in use (the outermost scope).
+    [[nodiscard]] const Stats& Statistics() const { return (outer != nullptr ? *outer : *this).stats; }
+
+    // Value loaded in this scope under (T, key), counted as a hit; nullopt if none or no scope.
+    template<class T>
+    static std::optional<T> Find(std::string_view key) {
+        if (current == nullptr) {
+            return std::nullopt;
+        }
+        auto& entries = current->table<T>();
+        const auto it = entries.find(std::string(key));
+        if (it == entries.end()) {
+            return std::nullopt;
+        }
+        ++current->stats.hits;
+        return *std::static_pointer_cast<T>(it->second);
+    }
+
+    // Records a value just read from the database for key, counted as a load.
+    template<class T>
+    static void Loaded(std::string_view key, const T& value) {
+        if (current == nullptr) {
+            return;
+        }
+        ++current->stats.loads;
+        Put<T>(key, value);
+    }
+
+    // Records a value known by other means (rows of a listing, a delete), not counted.
+    template<class T>
+    static void Put(std::string_view key, const T& value) {
+        if (current == nullptr) {
+            return;
+        }
+        current->table<T>().insert_or_assign(std::string(key), std::make_shared<T>(value));
+    }
+
+    // Find, or run load and remember what it returns.
+    template<class T, class Load>
+    static T Through(std::string_view key, Load&& load) {
+        if (auto known = Find<T>(key)) {
+            return std::move(*known);
+        }
+        T value = std::forward<Load>(load)();
+        Loaded<T>(key, value);
+        return value;
+    }
+
+    template<class T>
+    static void Evict(std::string_view key) {
+        if (current != nullptr) {
+            current->table<T>().erase(std::string(key));
+        }
+    }
+
+    template<class T>
+    static void EvictAll() {
+        if (current != nullptr) {
+            current->table<T>().clear();
+        }
+    }
+
+private:
+    using Table = std::unordered_map<std::string, std::shared_ptr<void>>;
+
+    // One address per value type, used as the table key (no RTTI).
+    template<class T>
+    struct Tag {
+        static constexpr char id = 0;
+    };
+
+    static inline thread_local IdentityMap* current = nullptr;
+
+    IdentityMap* outer;
+    Stats stats;
+    // Few value types per scope: a linear scan beats hashing the type.
+    std::vector<std::pair<const void*, Table>> tables;
+
+    template<class T>
+    Table& table() {
+        const void* tag = &Tag<T>::id;
+        for (auto& [t, entries] : tables) {
+            if (t == tag) {
+                return entries;
+            }
+        }
+        return tables.emplace_back(tag, Table{}).second;
+    }
+};
+
+#endif //TOURNAMENTS_IDENTITYMAP_HPP
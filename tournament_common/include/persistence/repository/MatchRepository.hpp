@@ -9,7 +9,6 @@
 class MatchRepository : public IMatchRepository {
     std::shared_ptr<IDbConnectionProvider> connectionProvider;
 
-    static std::string to_doc_string(const domain::Match& m);
     static std::shared_ptr<domain::Match> row_to_domain(const pqxx::row& row);
 
 public:
@@ -18,11 +17,33 @@ public:
     std::vector<std::shared_ptr<domain::Match>>
     FindByTournamentId(const std::string& tournamentId) override;
 
+    JsonPage
+    FindJsonPageByTournamentId(const std::string& tournamentId, const std::string& status,
+                               const PageRequest& request) override;
+
+    std::optional<std::string>
+    FindVersionByTournamentId(const std::string& tournamentId) override;
+
     std::shared_ptr<domain::Match>
     FindByTournamentIdAndMatchId(const std::string& tournamentId,
                                  const std::string& matchId) override;
 
+    std::optional<std::string>
+    FindJsonByTournamentIdAndMatchId(const std::string& tournamentId, const std::string& matchId) override;
+
     std::string Create(const domain::Match& entity) override;
     std::string CreateIfNotExists(const domain::Match& entity) override;
+    std::vector<std::string> CreateBatch(const std::vector<domain::Match>& entities) override;
     std::string Update(const domain::Match& entity) override;
+
+    Deferred<std::vector<std::shared_ptr<domain::Match>>>
+    DeferFindByTournamentId(ReadBatch& batch, const std::string& tournamentId) override;
+
+    Deferred<JsonPage>
+    DeferFindJsonPageByTournamentId(ReadBatch& batch, const std::string& tournamentId, const std::string& status,
+                                    const PageRequest& request) override;
+
+    Deferred<std::shared_ptr<domain::Match>>
+    DeferFindByTournamentIdAndMatchId(ReadBatch& batch, const std::string& tournamentId,
+                                      const std::string& matchId) override;
 };
@@ -0,0 +1,63 @@
+//
+// MatchRowDecoder.hpp
+// Builds a domain::Match straight from the typed columns of MATCHES (see the column list below),
+// without parsing the JSONB document. Templated on the row type so it works with pqxx::row and
+// can be measured without a database (benchmarks/MatchDecodeBenchmark.cpp).
+//
+
+#ifndef TOURNAMENTS_MATCHROWDECODER_HPP
+#define TOURNAMENTS_MATCHROWDECODER_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include "domain/Match.hpp"
+
+namespace match_columns {
+    // Order of the columns selected by the match SELECT statements in the catalog.
+    enum Column : std::size_t {
+        Id,
+        TournamentId,
+        Round,
+        Status,
+        HomeId,
+        HomeName,
+        VisitorId,
+        VisitorName,
+        ScoreHome,
+        ScoreVisitor,
+        WinnerTeamId,
+        DecidedBy,
+        NextMatchId,
+        NextMatchWinnerSlot
+    };
+
+    template<typename Row>
+    domain::Match Decode(const Row& row) {
+        const auto text = [&row](Column column) {
+            const auto& field = row[static_cast<std::size_t>(column)];
+            return field.is_null() ? std::string{} : std::string(field.c_str());
+        };
+
+        domain::Match m;
+        m.Id()           = text(Id);
+        m.TournamentId() = text(TournamentId);
+        m.Round()        = text(Round);
+        m.Status()       = row[Status].is_null() ? std::string("pending") : text(Status);
+        m.Home().Id()       = text(HomeId);
+        m.Home().Name()     = text(HomeName);
+        m.Visitor().Id()    = text(VisitorId);
+        m.Visitor().Name()  = text(VisitorName);
+
+        if (!row[ScoreHome].is_null() && !row[ScoreVisitor].is_null()) {
+            m.SetScore(row[ScoreHome].template as<int>(), row[ScoreVisitor].template as<int>());
+        }
+        if (!row[WinnerTeamId].is_null())        m.SetWinnerTeamId(text(WinnerTeamId));
+        if (!row[DecidedBy].is_null())           m.SetDecidedBy(text(DecidedBy));
+        if (!row[NextMatchId].is_null())         m.SetNextMatchId(text(NextMatchId));
+        if (!row[NextMatchWinnerSlot].is_null()) m.SetNextMatchWinnerSlot(text(NextMatchWinnerSlot));
+        return m;
+    }
+}
+
+#endif //TOURNAMENTS_MATCHROWDECODER_HPP
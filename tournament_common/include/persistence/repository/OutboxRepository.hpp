@@ -0,0 +1,18 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "persistence/repository/IOutboxRepository.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
+
+class OutboxRepository : public IOutboxRepository {
+    std::shared_ptr<IDbConnectionProvider> connectionProvider;
+
+public:
+    explicit OutboxRepository(std::shared_ptr<IDbConnectionProvider> provider);
+
+    void Enqueue(const std::string& queue, const std::string& payload) override;
+
+    std::size_t PublishPending(std::size_t limit, const std::function<void(const OutboxEvent&)>& publish) override;
+
+    std::size_t PurgePublished(int olderThanHours) override;
+};
@@ -0,0 +1,169 @@
+//
+// Page.hpp
+// Keyset pagination over (created_at, id). Listing reads never return more than one page: the
+// repository seeks past the last row of the previous page with WHERE (created_at, id) > (...)
+// instead of skipping rows with OFFSET, so every page costs the same on the supporting index.
+//
+
+#ifndef TOURNAMENTS_PAGE_HPP
+#define TOURNAMENTS_PAGE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Position of the last row of a page: created_at as Postgres prints it, plus the row id.
+struct PageCursor {
+    std::string createdAt;
+    std::string id;
+};
+
+struct PageRequest {
+    static constexpr std::size_t DefaultLimit = 50;
+    static constexpr std::size_t MaxLimit = 200;
+
+    std::size_t limit = DefaultLimit;
+    // Empty: first page.
+    std::optional<PageCursor> after;
+};
+
+// A page already rendered as the response body (a JSON array).
+struct JsonPage {
+    std::string body = "[]";
+    // Set only when there are more rows after this page.
+    std::optional<PageCursor> next;
+};
+
+namespace page_cursor {
+
+    // Clients only see an opaque token (base64url of "created_at|id").
+    inline std::string Encode(const PageCursor& cursor) {
+        static constexpr std::string_view alphabet =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        const std::string raw = cursor.createdAt + '|' + cursor.id;
+
+        std::string out;
+        out.reserve((raw.size() * 4 + 2) / 3);
+        std::size_t i = 0;
+        for (; i + 2 < raw.size(); i += 3) {
+            const unsigned n = (static_cast<unsigned char>(raw[i]) << 16)
+                             | (static_cast<unsigned char>(raw[i + 1]) << 8)
+                             | static_cast<unsigned char>(raw[i + 2]);
+            out += alphabet[(n >> 18) & 63];
+            out += alphabet[(n >> 12) & 63];
+            out += alphabet[(n >> 6) & 63];
+            out += alphabet[n & 63];
+        }
+        if (i < raw.size()) {
+            unsigned n = static_cast<unsigned char>(raw[i]) << 16;
+            if (i + 1 < raw.size()) n |= static_cast<unsigned char>(raw[i + 1]) << 8;
+            out += alphabet[(n >> 18) & 63];
+            out += alphabet[(n >> 12) & 63];
+            if (i + 1 < raw.size()) out += alphabet[(n >> 6) & 63];
+        }
+        return out;
+    }
+
+    // nullopt for anything that is not a cursor we produced (the controller answers 400).
+    inline std::optional<PageCursor> Decode(std::string_view token) {
+        static constexpr auto values = [] {
+            std::array<signed char, 256> table{};
+            table.fill(-1);
+            constexpr std::string_view alphabet =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+            for (std::size_t i = 0; i < alphabet.size(); ++i) {
+                table[static_cast<unsigned char>(alphabet[i])] = static_cast<signed char>(i);
+            }
+            return table;
+        }();
+
+        if (token.empty() || token.size() > 128 || token.size() % 4 == 1) {
+            return std::nullopt;
+        }
+        std::string raw;
+        raw.reserve(token.size() * 3 / 4);
+        unsigned buffer = 0;
+        int bits = 0;
+        for (const char c : token) {
+            const int v = values[static_cast<unsigned char>(c)];
+            if (v < 0) {
+                return std::nullopt;
+            }
+            buffer = (buffer << 6) | static_cast<unsigned>(v);
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                raw += static_cast<char>((buffer >> bits) & 0xFF);
+            }
+        }
+
+        const auto bar = raw.find('|');
+        if (bar == std::string::npos || bar == 0) {
+            return std::nullopt;
+        }
+        PageCursor cursor{raw.substr(0, bar), raw.substr(bar + 1)};
+
+        // created_at: digits and the separators of an ISO timestamp, nothing a cast would choke on.
+        const bool timestampOk = std::all_of(cursor.createdAt.begin(), cursor.createdAt.end(), [](char c) {
+            return (c >= '0' && c <= '9') || c == '-' || c == ':' || c == '.' || c == ' ' || c == '+' || c == 'T';
+        });
+        // id: canonical uuid text.
+        bool idOk = cursor.id.size() == 36;
+        for (std::size_t i = 0; idOk && i < cursor.id.size(); ++i) {
+            const char c = cursor.id[i];
+            idOk = (i == 8 || i == 13 || i == 18 || i == 23)
+                ? c == '-'
+                : (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        }
+        if (!timestampOk || !idOk) {
+            return std::nullopt;
+        }
+        return cursor;
+    }
+
+    inline std::size_t PageSize(const PageRequest& request) {
+        return std::clamp<std::size_t>(request.limit, 1, PageRequest::MaxLimit);
+    }
+
+    // Rows to ask the database for: one more than the page, the extra row only says "there is more".
+    inline int FetchLimit(const PageRequest& request) {
+        return static_cast<int>(PageSize(request) + 1);
+    }
+
+    // Builds a page from a result fetched with LIMIT FetchLimit(request). Each row carries its final
+    // JSON in a "body" column built by Postgres, plus "created_at" and "id" for the cursor: the
+    // elements are copied once into the array and never parsed.
+    template<typename Result>
+    JsonPage JsonArrayFromRows(const Result& rows, const PageRequest& request) {
+        const std::size_t limit = PageSize(request);
+        const auto fetched = static_cast<std::size_t>(rows.size());
+        const std::size_t count = std::min(fetched, limit);
+
+        std::size_t bytes = 2 + count;
+        for (std::size_t i = 0; i < count; ++i) {
+            bytes += rows[i]["body"].size();
+        }
+
+        JsonPage page;
+        page.body.clear();
+        page.body.reserve(bytes);
+        page.body += '[';
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto field = rows[i]["body"];
+            if (i > 0) page.body += ',';
+            page.body.append(field.c_str(), field.size());
+        }
+        page.body += ']';
+
+        if (fetched > limit) {
+            const auto& last = rows[count - 1];
+            page.next = PageCursor{last["created_at"].c_str(), last["id"].c_str()};
+        }
+        return page;
+    }
+}
+
+#endif //TOURNAMENTS_PAGE_HPP
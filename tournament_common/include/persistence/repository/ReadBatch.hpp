@@ -0,0 +1,78 @@
+//
+// ReadBatch.hpp
+// Lets a delegate queue several independent reads and consume them afterwards.
+// Repositories that can pipeline (the Postgres ones) send everything queued in the batch in a
+// single round trip on one connection the first time any result is needed; the default
+// Defer* implementations simply call the regular method when the value is asked for.
+//
+
+#ifndef TOURNAMENTS_READBATCH_HPP
+#define TOURNAMENTS_READBATCH_HPP
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Result of a queued read. get() resolves it once (running the batch if needed) and caches it.
+template<typename T>
+class Deferred {
+    struct State {
+        std::optional<T> value;
+        std::function<T()> resolve;
+    };
+    std::shared_ptr<State> state;
+
+public:
+    Deferred() = default;
+    explicit Deferred(std::function<T()> resolve) : state(std::make_shared<State>()) {
+        state->resolve = std::move(resolve);
+    }
+
+    static Deferred Ready(T value) {
+        Deferred deferred;
+        deferred.state = std::make_shared<State>();
+        deferred.state->value.emplace(std::move(value));
+        return deferred;
+    }
+
+    T& get() {
+        if (!state->value) {
+            state->value.emplace(state->resolve());
+            state->resolve = nullptr;   // drops whatever the resolver kept alive (connection, pipeline)
+        }
+        return *state->value;
+    }
+};
+
+class ReadBatch {
+public:
+    // Per-backend state shared by all reads queued on this batch (e.g. one connection + pipeline).
+    class Session {
+    public:
+        virtual ~Session() = default;
+    };
+
+    ReadBatch() = default;
+    ReadBatch(const ReadBatch&) = delete;
+    ReadBatch& operator=(const ReadBatch&) = delete;
+
+    // Returns the session registered for key (typically the connection provider), creating it on first use.
+    template<typename TSession, typename Make>
+    std::shared_ptr<TSession> SessionFor(const void* key, Make&& make) {
+        for (auto& [k, session] : sessions) {
+            if (k == key) {
+                return std::static_pointer_cast<TSession>(session);
+            }
+        }
+        std::shared_ptr<TSession> created = make();
+        sessions.emplace_back(key, created);
+        return created;
+    }
+
+private:
+    std::vector<std::pair<const void*, std::shared_ptr<Session>>> sessions;
+};
+
+#endif //TOURNAMENTS_READBATCH_HPP
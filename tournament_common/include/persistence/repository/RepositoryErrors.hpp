@@ -0,0 +1,24 @@
+//
+// RepositoryErrors.hpp
+// Exceptions repositories throw for rule violations the database reports, so callers can react
+// without knowing the driver's error types.
+//
+
+#ifndef TOURNAMENTS_REPOSITORYERRORS_HPP
+#define TOURNAMENTS_REPOSITORYERRORS_HPP
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// A write hit a unique constraint. key() is the offending value when the repository knows it.
+class DuplicateEntityError : public std::runtime_error {
+    std::string duplicateKey;
+public:
+    explicit DuplicateEntityError(const std::string& message, std::string key = {})
+        : std::runtime_error(message), duplicateKey(std::move(key)) {}
+
+    [[nodiscard]] const std::string& key() const { return duplicateKey; }
+};
+
+#endif //TOURNAMENTS_REPOSITORYERRORS_HPP
@@ -0,0 +1,28 @@
+#pragma once
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <pqxx/pqxx>
+#include "persistence/repository/IStandingsRepository.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
+
+class StandingsRepository : public IStandingsRepository {
+    std::shared_ptr<IDbConnectionProvider> connectionProvider;
+
+    static domain::Standing row_to_domain(const pqxx::row& row);
+
+public:
+    explicit StandingsRepository(std::shared_ptr<IDbConnectionProvider> provider);
+
+    void Apply(const std::string& tournamentId, const std::vector<domain::Standing>& deltas) override;
+
+    std::vector<domain::Standing> FindByTournamentId(const std::string& tournamentId) override;
+
+    std::optional<std::string> FindJsonByTournamentId(const std::string& tournamentId) override;
+    std::optional<std::string>
+    FindJsonByTournamentIdAndGroupId(const std::string& tournamentId, const std::string& groupId) override;
+
+    Deferred<std::vector<domain::Standing>>
+    DeferFindByTournamentId(ReadBatch& batch, const std::string& tournamentId) override;
+};
@@ -0,0 +1,88 @@
+//
+// TakenNameFilter.hpp
+// Optional in-process memory of names known to be taken (created here, or rejected by the unique
+// index), so a repeated POST with the same name is answered 409 without a round trip.
+// The database stays the authority: a name missing from the filter is always tried with the
+// INSERT ... ON CONFLICT. A name freed elsewhere (rename or delete through another instance) is
+// still rejected here until its entry expires, so the TTL bounds how stale a 409 can be.
+// The owning repository clears the filter on its own updates and deletes.
+//
+
+#ifndef TOURNAMENTS_TAKENNAMEFILTER_HPP
+#define TOURNAMENTS_TAKENNAMEFILTER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct TakenNameFilterSettings {
+    // How long a name is remembered; 0 disables the filter.
+    std::chrono::milliseconds ttl{0};
+    std::size_t maxEntries = 4096;
+};
+
+class TakenNameFilter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TakenNameFilter(TakenNameFilterSettings settings = {}) : settings(settings) {}
+
+    [[nodiscard]] bool Enabled() const { return settings.ttl.count() > 0 && settings.maxEntries > 0; }
+
+    // True when name was seen taken less than ttl ago.
+    bool Taken(std::string_view name) {
+        if (!Enabled()) {
+            return false;
+        }
+        std::lock_guard lock(mutex);
+        const auto it = names.find(name);
+        if (it == names.end()) {
+            return false;
+        }
+        if (it->second <= Clock::now()) {
+            names.erase(it);
+            return false;
+        }
+        return true;
+    }
+
+    void Remember(std::string_view name) {
+        if (!Enabled()) {
+            return;
+        }
+        const auto now = Clock::now();
+        std::lock_guard lock(mutex);
+        if (names.size() >= settings.maxEntries && !names.contains(name)) {
+            std::erase_if(names, [now](const auto& entry) { return entry.second <= now; });
+            if (names.size() >= settings.maxEntries) {
+                names.clear();
+            }
+        }
+        names.insert_or_assign(std::string(name), now + settings.ttl);
+    }
+
+    void Clear() {
+        if (!Enabled()) {
+            return;
+        }
+        std::lock_guard lock(mutex);
+        names.clear();
+    }
+
+private:
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+
+    TakenNameFilterSettings settings;
+    std::mutex mutex;
+    // name -> expiry
+    std::unordered_map<std::string, Clock::time_point, NameHash, std::equal_to<>> names;
+};
+
+#endif //TOURNAMENTS_TAKENNAMEFILTER_HPP
@@ -7,84 +7,133 @@
 #include <string>
 #include <memory>
 #include <stdexcept>
-#include <nlohmann/json.hpp>
 #include <pqxx/pqxx>
 
 #include "persistence/configuration/IDbConnectionProvider.hpp"
 #include "persistence/configuration/PostgresConnection.hpp"
+#include "persistence/configuration/PostgresPipeline.hpp"
+#include "persistence/configuration/UnitOfWork.hpp"
 #include "IRepository.hpp"
+#include "IdentityMap.hpp"
+#include "RepositoryErrors.hpp"
+#include "TakenNameFilter.hpp"
 #include "domain/Team.hpp"
-#include "domain/Utilities.hpp"
+#include "domain/DomainJson.hpp"
 
 class TeamRepository : public IRepository<domain::Team, std::string_view> {
     std::shared_ptr<IDbConnectionProvider> connectionProvider;
+    // Optional (see TakenNameFilter.hpp).
+    std::shared_ptr<TakenNameFilter> takenNames;
+    // Identity map entries: team (or nullptr) by id.
+    using Loaded = std::shared_ptr<domain::Team>;
+
+    // document -> Team; the id comes from the column.
+    static std::shared_ptr<domain::Team> row_to_team(const pqxx::row& row) {
+        auto team = json_codec::Read<domain::Team>(row["document"].c_str());
+        if (!team) {
+            throw std::runtime_error("invalid team document: " + team.error().message);
+        }
+        team->Id = row["id"].c_str();
+        return std::make_shared<domain::Team>(std::move(*team));
+    }
 
 public:
     explicit TeamRepository(std::shared_ptr<IDbConnectionProvider> connectionProvider)
         : connectionProvider(std::move(connectionProvider)) {}
 
+    void UseNameFilter(std::shared_ptr<TakenNameFilter> filter) { takenNames = std::move(filter); }
+
     // READ ALL: return full document; Id (UUID) set from column
     std::vector<std::shared_ptr<domain::Team>> ReadAll() override {
         std::vector<std::shared_ptr<domain::Team>> teams;
 
-        auto pooled = connectionProvider->Connection();
-        auto* connection = dynamic_cast<PostgresConnection*>(&*pooled);
-
-        pqxx::read_transaction tx{*(connection->connection)};
+        DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
         // Fetch full JSON document so controllers can serialize everything
-        pqxx::result result = tx.exec(
-            "SELECT id, document FROM teams ORDER BY created_at ASC"
-        );
+        pqxx::result result = tx.Exec(statements::StatementId::SelectAllTeams);
 
         teams.reserve(result.size());
         for (const auto& row : result) {
-            auto doc  = nlohmann::json::parse(row["document"].c_str());
-            auto team = std::make_shared<domain::Team>(doc); // uses your Team(json) ctor
-            team->Id  = row["id"].c_str();                   // set DB uuid
-            teams.emplace_back(std::move(team));
+            teams.emplace_back(row_to_team(row));
+            IdentityMap::Put<Loaded>(teams.back()->Id, teams.back());
         }
         return teams;
     }
 
+    // READ PAGE: keyset page ordered by (created_at, id), as the final JSON array (pass-through GET /teams).
+    JsonPage ReadJsonPage(const PageRequest& request) override {
+        DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+        const int fetch = page_cursor::FetchLimit(request);
+        pqxx::result result = request.after
+            ? tx.Exec(statements::StatementId::SelectTeamsJsonPageAfter,
+                      pqxx::params{request.after->createdAt, request.after->id, fetch})
+            : tx.Exec(statements::StatementId::SelectTeamsJsonPage, pqxx::params{fetch});
+        return page_cursor::JsonArrayFromRows(result, request);
+    }
+
+    // READ BY ID as the final JSON object (pass-through GET /teams/{id}). nullopt if not found.
+    std::optional<std::string> ReadJsonById(std::string_view id) override {
+        const std::string key{id};
+        DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+        pqxx::result result = tx.Exec(statements::StatementId::SelectTeamJsonById, pqxx::params{key});
+        if (result.empty()) {
+            return std::nullopt;
+        }
+        return std::string(result[0]["body"].c_str(), result[0]["body"].size());
+    }
+
     // READ BY ID (UUID). Return nullptr if not found.
     std::shared_ptr<domain::Team> ReadById(std::string_view id) override {
-        auto pooled = connectionProvider->Connection();
-        auto* connection = dynamic_cast<PostgresConnection*>(&*pooled);
-
         const std::string key{id}; // ensure type matches pqxx binding
-        pqxx::read_transaction tx{*(connection->connection)};
+        return IdentityMap::Through<Loaded>(key, [&]() -> Loaded {
+            DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
 
-        pqxx::result result = tx.exec_params(
-            "SELECT id, document FROM teams WHERE id = $1::uuid LIMIT 1",
-            key
-        );
-        if (result.empty()) {
-            return nullptr;
-        }
+            pqxx::result result = tx.Exec(statements::StatementId::SelectTeamById, pqxx::params{key});
+            if (result.empty()) {
+                return nullptr;
+            }
+
+            return row_to_team(result[0]);
+        });
+    }
 
-        auto doc  = nlohmann::json::parse(result[0]["document"].c_str());
-        auto team = std::make_shared<domain::Team>(doc);
-        team->Id  = result[0]["id"].c_str();
-        return team;
+    // READ BY ID queued on a batch (pipelined with the batch's other reads).
+    Deferred<std::shared_ptr<domain::Team>> DeferReadById(ReadBatch& batch, std::string_view id) override {
+        if (auto known = IdentityMap::Find<Loaded>(id)) {
+            return Deferred<std::shared_ptr<domain::Team>>::Ready(std::move(*known));
+        }
+        auto session = PostgresPipelineSession::For(batch, *connectionProvider);
+        const auto query = session->Queue(statements::StatementId::SelectTeamById, id);
+        return Deferred<std::shared_ptr<domain::Team>>([session, query, key = std::string(id)]() -> std::shared_ptr<domain::Team> {
+            const pqxx::result result = session->Retrieve(query);
+            Loaded team = result.empty() ? nullptr : row_to_team(result[0]);
+            IdentityMap::Loaded<Loaded>(key, team);
+            return team;
+        });
     }
 
     // CREATE: insert JSON document; DB generates UUID; return it.
+    // Throws DuplicateEntityError (key = name) when the name is taken.
     std::string_view Create(const domain::Team &entity) override {
-        auto pooled = connectionProvider->Connection();
-        auto* connection = dynamic_cast<PostgresConnection*>(&*pooled);
-
-        nlohmann::json body = entity; // rely on your to_json mapping
-
-        pqxx::work tx{*(connection->connection)};
-        pqxx::result result = tx.exec_params(
-            "INSERT INTO teams (document) VALUES ($1::jsonb) RETURNING id",
-            body.dump()
-        );
+        if (takenNames && takenNames->Taken(entity.Name)) {
+            throw DuplicateEntityError("team name already exists", entity.Name);
+        }
+        const std::string body = json_codec::Write(entity);
+
+        DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+        pqxx::result result;
+        try {
+            result = tx.Exec(statements::StatementId::InsertTeam, pqxx::params{body});
+        } catch (const pqxx::unique_violation& e) {
+            throw DuplicateEntityError(e.what(), entity.Name);
+        }
         if (result.empty()) {
-            tx.abort();
-            throw std::runtime_error("insert failed");
+            // ON CONFLICT DO NOTHING: the name index already has it.
+            tx.Abort();
+            if (takenNames) takenNames->Remember(entity.Name);
+            throw DuplicateEntityError("team name already exists", entity.Name);
         }
-        tx.commit();
+        tx.Commit();
+        if (takenNames) takenNames->Remember(entity.Name);
 
         // Return a string_view with stable storage
         thread_local std::string id_buffer;
@@ -97,24 +146,18 @@ public:
         if (entity.Id.empty()) {
             throw std::invalid_argument("team.Id is required for update");
         }
-        auto pooled = connectionProvider->Connection();
-        auto* connection = dynamic_cast<PostgresConnection*>(&*pooled);
-
-        nlohmann::json body = entity;
-
-        pqxx::work tx{*(connection->connection)};
-        pqxx::result r = tx.exec_params(
-            "UPDATE teams "
-            "SET document = $2::jsonb, last_update_date = CURRENT_TIMESTAMP "
-            "WHERE id = $1::uuid",
-            entity.Id,
-            body.dump()
-        );
+        const std::string body = json_codec::Write(entity);
+        IdentityMap::Evict<Loaded>(entity.Id);
+
+        DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+        pqxx::result r = tx.Exec(statements::StatementId::UpdateTeam, pqxx::params{entity.Id, body});
         if (r.affected_rows() == 0) {
-            tx.abort();
+            tx.Abort();
             throw std::runtime_error("not found");
         }
-        tx.commit();
+        tx.Commit();
+        // The old name may be free now.
+        if (takenNames) takenNames->Clear();
 
         thread_local std::string id_buffer;
         id_buffer = entity.Id;
@@ -123,21 +166,19 @@ public:
 
     // DELETE by UUID. Throws if not found.
     void Delete(std::string_view id) override {
-        auto pooled = connectionProvider->Connection();
-        auto* connection = dynamic_cast<PostgresConnection*>(&*pooled);
-
         const std::string key{id};
 
-        pqxx::work tx{*(connection->connection)};
-        pqxx::result r = tx.exec_params(
-            "DELETE FROM teams WHERE id = $1::uuid",
-            key
-        );
+        DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+        IdentityMap::Evict<Loaded>(key);
+        pqxx::result r = tx.Exec(statements::StatementId::DeleteTeam, pqxx::params{key});
         if (r.affected_rows() == 0) {
-            tx.abort();
+            tx.Abort();
             throw std::runtime_error("not found");
         }
-        tx.commit();
+        tx.Commit();
+        if (takenNames) takenNames->Clear();
+        // Known to be gone for the rest of the scope.
+        IdentityMap::Put<Loaded>(key, nullptr);
     }
 };
 
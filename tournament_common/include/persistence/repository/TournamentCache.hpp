@@ -0,0 +1,189 @@
+//
+// TournamentCache.hpp
+// Process-wide read-through cache of tournaments, shared by every request and message. Tournaments
+// are read at the start of almost every group and match operation and are almost never written.
+// Keys are spread over shards. Each shard publishes an immutable snapshot of its entries
+// (RCU style): readers load the current snapshot and never take a lock, and writers copy the
+// snapshot under the shard's mutex and publish the copy. A hit hands out a copy of the tournament,
+// so callers may modify what they get.
+// Entries are dropped by Invalidate(): the repository calls it after its own writes, and
+// TournamentChangeListener calls it for the writes of the other instances (Postgres LISTEN/NOTIFY).
+// Only tournaments that exist are cached; "not found" always goes to the database.
+//
+
+#ifndef TOURNAMENTS_TOURNAMENTCACHE_HPP
+#define TOURNAMENTS_TOURNAMENTCACHE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "domain/Tournament.hpp"
+
+struct TournamentCacheSettings {
+    // Upper bound on cached tournaments (0 disables the cache). Split evenly between the shards.
+    std::size_t maxEntries = 1024;
+    std::size_t shards = 16;
+};
+
+class TournamentCache {
+public:
+    struct Stats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        // Entries dropped to stay under maxEntries.
+        std::uint64_t evictions = 0;
+        // Entries dropped because the tournament changed (or everything was cleared).
+        std::uint64_t invalidations = 0;
+        std::size_t size = 0;
+    };
+
+    // Shard generation taken before a database read; Put() ignores the value if an invalidation
+    // happened in between, so a read racing with a write can't cache the old row.
+    using Stamp = std::uint64_t;
+
+    explicit TournamentCache(TournamentCacheSettings settings = {})
+        : shardCount(std::max<std::size_t>(1, settings.shards)),
+          shardCapacity(settings.maxEntries == 0 ? 0 : (settings.maxEntries + shardCount - 1) / shardCount),
+          shards(std::make_unique<Shard[]>(shardCount)) {}
+
+    TournamentCache(const TournamentCache&) = delete;
+    TournamentCache& operator=(const TournamentCache&) = delete;
+
+    [[nodiscard]] bool Enabled() const { return shardCapacity > 0; }
+
+    // Copy of the cached tournament, or nullptr on a miss.
+    std::shared_ptr<domain::Tournament> Find(std::string_view id) {
+        if (!Enabled()) {
+            return nullptr;
+        }
+        Shard& shard = shardFor(id);
+        const auto snapshot = shard.snapshot.load(std::memory_order_acquire);
+        if (snapshot) {
+            if (const auto it = snapshot->find(id); it != snapshot->end()) {
+                shard.hits.fetch_add(1, std::memory_order_relaxed);
+                return std::make_shared<domain::Tournament>(*it->second.value);
+            }
+        }
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    [[nodiscard]] Stamp StampFor(std::string_view id) const {
+        return shardFor(id).generation.load(std::memory_order_acquire);
+    }
+
+    // Caches a tournament read from the database after StampFor(). When the shard is full the
+    // entry cached first is evicted.
+    void Put(const domain::Tournament& tournament, Stamp stamp) {
+        if (!Enabled() || tournament.Id().empty()) {
+            return;
+        }
+        Shard& shard = shardFor(tournament.Id());
+        auto value = std::make_shared<const domain::Tournament>(tournament);
+
+        std::lock_guard lock(shard.writer);
+        if (shard.generation.load(std::memory_order_relaxed) != stamp) {
+            return;
+        }
+        const auto current = shard.snapshot.load(std::memory_order_relaxed);
+        auto next = current ? std::make_shared<Snapshot>(*current) : std::make_shared<Snapshot>();
+        if (!next->contains(tournament.Id()) && next->size() >= shardCapacity) {
+            const auto oldest = std::min_element(next->begin(), next->end(), [](const auto& a, const auto& b) {
+                return a.second.sequence < b.second.sequence;
+            });
+            next->erase(oldest);
+            shard.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+        next->insert_or_assign(tournament.Id(), Entry{std::move(value), ++shard.sequence});
+        shard.snapshot.store(std::move(next), std::memory_order_release);
+    }
+
+    void Invalidate(std::string_view id) {
+        if (!Enabled()) {
+            return;
+        }
+        Shard& shard = shardFor(id);
+        std::lock_guard lock(shard.writer);
+        shard.generation.fetch_add(1, std::memory_order_release);
+        const auto current = shard.snapshot.load(std::memory_order_relaxed);
+        if (!current || !current->contains(id)) {
+            return;
+        }
+        auto next = std::make_shared<Snapshot>(*current);
+        next->erase(next->find(id));
+        shard.invalidations.fetch_add(1, std::memory_order_relaxed);
+        shard.snapshot.store(std::move(next), std::memory_order_release);
+    }
+
+    // Drops everything (the change feed was interrupted and notifications may have been missed).
+    void Clear() {
+        for (std::size_t i = 0; i < shardCount; ++i) {
+            Shard& shard = shards[i];
+            std::lock_guard lock(shard.writer);
+            shard.generation.fetch_add(1, std::memory_order_release);
+            const auto current = shard.snapshot.exchange(nullptr, std::memory_order_acq_rel);
+            if (current) {
+                shard.invalidations.fetch_add(current->size(), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    [[nodiscard]] Stats Statistics() const {
+        Stats stats;
+        for (std::size_t i = 0; i < shardCount; ++i) {
+            const Shard& shard = shards[i];
+            stats.hits          += shard.hits.load(std::memory_order_relaxed);
+            stats.misses        += shard.misses.load(std::memory_order_relaxed);
+            stats.evictions     += shard.evictions.load(std::memory_order_relaxed);
+            stats.invalidations += shard.invalidations.load(std::memory_order_relaxed);
+            if (const auto snapshot = shard.snapshot.load(std::memory_order_acquire)) {
+                stats.size += snapshot->size();
+            }
+        }
+        return stats;
+    }
+
+private:
+    struct Entry {
+        std::shared_ptr<const domain::Tournament> value;
+        // Insertion order inside the shard, the oldest is evicted first.
+        std::uint64_t sequence;
+    };
+
+    // Heterogeneous lookup, so Find(string_view) doesn't build a std::string.
+    struct KeyHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+    };
+    using Snapshot = std::unordered_map<std::string, Entry, KeyHash, std::equal_to<>>;
+
+    // Own cache line per shard: the counters and the snapshot pointer of one shard don't slow down the others.
+    struct alignas(64) Shard {
+        std::atomic<std::shared_ptr<const Snapshot>> snapshot;
+        std::mutex writer;
+        std::atomic<Stamp> generation{0};
+        std::uint64_t sequence = 0;
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+        std::atomic<std::uint64_t> evictions{0};
+        std::atomic<std::uint64_t> invalidations{0};
+    };
+
+    std::size_t shardCount;
+    std::size_t shardCapacity;
+    std::unique_ptr<Shard[]> shards;
+
+    Shard& shardFor(std::string_view id) const {
+        return shards[KeyHash{}(id) % shardCount];
+    }
+};
+
+#endif //TOURNAMENTS_TOURNAMENTCACHE_HPP
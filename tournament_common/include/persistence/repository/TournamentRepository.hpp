@@ -3,18 +3,37 @@
 #include <string>
 #include <vector>
 #include "IRepository.hpp"
+#include "TakenNameFilter.hpp"
+#include "TournamentCache.hpp"
 #include "domain/Tournament.hpp"
 #include "persistence/configuration/IDbConnectionProvider.hpp"
 
 class TournamentRepository : public IRepository<domain::Tournament, std::string> {
     std::shared_ptr<IDbConnectionProvider> connectionProvider;
+    // Optional, shared by every repository instance of the process (see TournamentCache.hpp).
+    std::shared_ptr<TournamentCache> cache;
+    // Optional (see TakenNameFilter.hpp).
+    std::shared_ptr<TakenNameFilter> takenNames;
 
 public:
     explicit TournamentRepository(std::shared_ptr<IDbConnectionProvider> provider);
 
+    // ReadById/DeferReadById read through the cache (filled from the primary only); Update/Delete invalidate it.
+    void UseCache(std::shared_ptr<TournamentCache> tournamentCache) { cache = std::move(tournamentCache); }
+    void UseNameFilter(std::shared_ptr<TakenNameFilter> filter) { takenNames = std::move(filter); }
+
+    // Throws DuplicateEntityError (key = name) when the name is taken.
+
     std::string Create(const domain::Tournament& entity) override;
     std::vector<std::shared_ptr<domain::Tournament>> ReadAll() override;
+    JsonPage ReadJsonPage(const PageRequest& request) override;
     std::shared_ptr<domain::Tournament> ReadById(std::string id) override;
+    // Covers the tournament row and its groups (what GET /tournaments/{id} renders).
+    std::optional<std::string> ReadVersion(std::string id) override;
+    // One statement, never from the cache: a cached row may be older than the version.
+    Versioned<domain::Tournament> ReadWithVersion(std::string id) override;
     std::string Update(const domain::Tournament& entity) override;
     void Delete(std::string id) override;
+
+    Deferred<std::shared_ptr<domain::Tournament>> DeferReadById(ReadBatch& batch, std::string id) override;
 };
@@ -0,0 +1,296 @@
+//
+// ConnectionPool.cpp
+//
+
+#include "persistence/configuration/ConnectionPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <utility>
+
+namespace {
+    std::atomic<std::uint64_t> nextPoolId{1};
+
+    // Per-thread home slots, keyed by pool id so a thread can be sticky on a few pools at once.
+    struct HomeEntry {
+        std::uint64_t poolId = 0;
+        std::size_t slot = 0;
+    };
+    thread_local std::array<HomeEntry, 4> homes{};
+    thread_local std::size_t homesNext = 0;
+
+    // Spreads shared-mode scans without touching a shared cache line.
+    thread_local std::size_t sharedStart = std::hash<std::thread::id>{}(std::this_thread::get_id());
+}
+
+ConnectionPool::ConnectionPool(ConnectionPoolSettings settings, Factory factory, Validator validator)
+    : settings(settings), factory(std::move(factory)), validator(std::move(validator)),
+      id(nextPoolId.fetch_add(1, std::memory_order_relaxed)) {
+    if (this->settings.maxSize == 0) {
+        this->settings.maxSize = 1;
+    }
+    this->settings.minSize = std::min(this->settings.minSize, this->settings.maxSize);
+    slots = std::make_unique<Slot[]>(this->settings.maxSize);
+
+    const auto now = tick();
+    for (std::size_t i = 0; i < this->settings.minSize; ++i) {
+        slots[i].connection = this->factory();
+        slots[i].lastValidated = now;
+        slots[i].lastUsed.store(now);
+        slots[i].state.store(Idle);
+        open.fetch_add(1);
+    }
+
+    reaper = std::thread([this] { reaperLoop(); });
+}
+
+ConnectionPool::~ConnectionPool() {
+    {
+        std::lock_guard lock(waitMutex);
+        stopping = true;
+    }
+    reaperWake.notify_all();
+    if (reaper.joinable()) {
+        reaper.join();
+    }
+}
+
+PooledConnection ConnectionPool::Acquire() {
+    const std::size_t start = settings.mode == PoolMode::Affinity
+        ? homeSlot()
+        : sharedStart++ % settings.maxSize;
+
+    // Fast path: no lock.
+    std::size_t index = 0;
+    if (tryTakeIdle(start, index)) {
+        return checkout(index);
+    }
+    if (tryReserve()) {
+        return openInto(start);
+    }
+
+    // Slow path: every slot is busy. Register as a waiter before re-checking so a concurrent
+    // Release() either sees us and notifies, or we see the slot it freed.
+    const auto deadline = Clock::now() + settings.acquireTimeout;
+    std::unique_lock lock(waitMutex);
+    waiters.fetch_add(1);
+    struct WaiterGuard {
+        std::atomic<std::size_t>& waiters;
+        ~WaiterGuard() { waiters.fetch_sub(1); }
+    } guard{waiters};
+
+    while (true) {
+        if (tryTakeIdle(start, index)) {
+            lock.unlock();
+            return checkout(index);
+        }
+        if (tryReserve()) {
+            lock.unlock();
+            return openInto(start);
+        }
+        if (available.wait_until(lock, deadline) == std::cv_status::timeout) {
+            if (tryTakeIdle(start, index)) {
+                lock.unlock();
+                return checkout(index);
+            }
+            throw ConnectionAcquireTimeout("[ConnectionPool] timed out waiting for a database connection");
+        }
+    }
+}
+
+void ConnectionPool::Release(IDbConnection* connection, std::size_t index) noexcept {
+    Slot& slot = slots[index];
+    if (!connection->IsOpen()) {
+        // Died while in use; drop it so the next Acquire() opens a fresh one.
+        dropConnection(slot);
+        return;
+    }
+    slot.lastUsed.store(now(), std::memory_order_relaxed);
+    slot.state.store(Idle);
+    notifyWaiters();
+}
+
+std::size_t ConnectionPool::OpenConnections() const {
+    return open.load();
+}
+
+std::size_t ConnectionPool::IdleConnections() const {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < settings.maxSize; ++i) {
+        if (slots[i].state.load() == Idle) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+ConnectionPool::Clock::rep ConnectionPool::tick() {
+    const auto current = Clock::now().time_since_epoch().count();
+    coarseNow.store(current, std::memory_order_relaxed);
+    return current;
+}
+
+std::size_t ConnectionPool::homeSlot() {
+    for (const auto& entry : homes) {
+        if (entry.poolId == id) {
+            return entry.slot;
+        }
+    }
+    auto& entry = homes[homesNext++ % homes.size()];
+    entry.poolId = id;
+    entry.slot = nextHome.fetch_add(1, std::memory_order_relaxed) % settings.maxSize;
+    return entry.slot;
+}
+
+bool ConnectionPool::tryTakeIdle(std::size_t start, std::size_t& taken) {
+    const std::size_t n = settings.maxSize;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t index = (start + i) % n;
+        auto& state = slots[index].state;
+        std::uint8_t expected = Idle;
+        if (state.load() == Idle && state.compare_exchange_strong(expected, Busy)) {
+            taken = index;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ConnectionPool::tryReserve() {
+    std::size_t current = open.load();
+    while (current < settings.maxSize) {
+        if (open.compare_exchange_weak(current, current + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+PooledConnection ConnectionPool::openInto(std::size_t preferred) {
+    // A reservation guarantees an Empty slot exists (or is about to, if the reaper is mid-way).
+    const std::size_t n = settings.maxSize;
+    std::size_t index = 0;
+    for (bool claimed = false; !claimed; ) {
+        for (std::size_t i = 0; i < n && !claimed; ++i) {
+            index = (preferred + i) % n;
+            std::uint8_t expected = Empty;
+            claimed = slots[index].state.compare_exchange_strong(expected, Busy);
+        }
+        if (!claimed) {
+            std::this_thread::yield();
+        }
+    }
+
+    Slot& slot = slots[index];
+    try {
+        slot.connection = factory();
+    } catch (...) {
+        slot.state.store(Empty);
+        open.fetch_sub(1);
+        notifyWaiters();
+        throw;
+    }
+    slot.lastValidated = now();
+    return PooledConnection(slot.connection.get(), this, index);
+}
+
+PooledConnection ConnectionPool::checkout(std::size_t index) {
+    Slot& slot = slots[index];
+    const auto current = now();
+    const auto validationInterval = std::chrono::duration_cast<Clock::duration>(settings.validationInterval).count();
+    if (current - slot.lastValidated < validationInterval) {
+        return PooledConnection(slot.connection.get(), this, index);
+    }
+
+    bool healthy = false;
+    try {
+        healthy = slot.connection->IsOpen() && validator(*slot.connection);
+    } catch (const std::exception& e) {
+        std::cerr << "[ConnectionPool] validation failed: " << e.what() << std::endl;
+    }
+    if (healthy) {
+        slot.lastValidated = current;
+        return PooledConnection(slot.connection.get(), this, index);
+    }
+
+    // Broken (e.g. the server restarted): replace it in place, the slot stays counted.
+    slot.connection.reset();
+    try {
+        slot.connection = factory();
+    } catch (...) {
+        dropConnection(slot);
+        throw;
+    }
+    slot.lastValidated = now();
+    return PooledConnection(slot.connection.get(), this, index);
+}
+
+void ConnectionPool::dropConnection(Slot& slot) {
+    slot.connection.reset();
+    slot.state.store(Empty);
+    open.fetch_sub(1);
+    notifyWaiters();
+}
+
+void ConnectionPool::notifyWaiters() {
+    if (waiters.load() > 0) {
+        std::lock_guard lock(waitMutex);
+        available.notify_one();
+    }
+}
+
+void ConnectionPool::ReapIdle() {
+    tick();
+    ReapIdle(Clock::now());
+}
+
+void ConnectionPool::ReapIdle(Clock::time_point at) {
+    const auto now = at.time_since_epoch().count();
+    const auto idleTimeout = std::chrono::duration_cast<Clock::duration>(settings.idleTimeout).count();
+
+    for (std::size_t i = 0; i < settings.maxSize; ++i) {
+        Slot& slot = slots[i];
+        std::uint8_t expected = Idle;
+        if (slot.state.load() != Idle
+            || now - slot.lastUsed.load(std::memory_order_relaxed) < idleTimeout
+            || !slot.state.compare_exchange_strong(expected, Busy)) {
+            continue;
+        }
+
+        std::size_t current = open.load();
+        bool shrink = false;
+        while (current > settings.minSize && !shrink) {
+            shrink = open.compare_exchange_weak(current, current - 1);
+        }
+        if (!shrink) {
+            slot.state.store(Idle);
+            notifyWaiters();
+            return;
+        }
+        slot.connection.reset();
+        slot.state.store(Empty);
+        notifyWaiters();
+    }
+}
+
+void ConnectionPool::reaperLoop() {
+    constexpr auto tickPeriod = std::chrono::milliseconds{100};
+    const auto reapPeriod = std::max(tickPeriod, settings.idleTimeout / 2);
+    auto nextReap = Clock::now() + reapPeriod;
+
+    std::unique_lock lock(waitMutex);
+    while (!stopping) {
+        reaperWake.wait_for(lock, tickPeriod, [this] { return stopping; });
+        if (stopping) {
+            break;
+        }
+        lock.unlock();
+        tick();
+        if (Clock::now() >= nextReap) {
+            ReapIdle();
+            nextReap = Clock::now() + reapPeriod;
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,102 @@
+//
+// TournamentChangeListener.cpp
+//
+
+#include "persistence/configuration/TournamentChangeListener.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <utility>
+#include <pqxx/pqxx>
+
+namespace {
+    // One await_notification() at most this long, so a stop request is seen quickly.
+    constexpr long kAwaitSeconds = 1;
+    constexpr auto kStatisticsPeriod = std::chrono::minutes{1};
+    constexpr auto kMaxBackoff = std::chrono::seconds{30};
+
+    class Receiver final : public pqxx::notification_receiver {
+    public:
+        Receiver(pqxx::connection& connection, TournamentCache& cache, std::atomic<std::uint64_t>& received)
+            : pqxx::notification_receiver(connection, TournamentChangeListener::Channel),
+              cache(cache), received(received) {}
+
+        void operator()(const std::string& payload, int) override {
+            TournamentChangeListener::Apply(cache, payload);
+            received.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    private:
+        TournamentCache& cache;
+        std::atomic<std::uint64_t>& received;
+    };
+}
+
+TournamentChangeListener::TournamentChangeListener(std::string connectionString, std::shared_ptr<TournamentCache> cache)
+    : connectionString(std::move(connectionString)), cache(std::move(cache)) {
+    worker = std::thread([this] { listenLoop(); });
+}
+
+TournamentChangeListener::~TournamentChangeListener() {
+    {
+        std::lock_guard lock(stopMutex);
+        stopping = true;
+    }
+    stopWake.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void TournamentChangeListener::Apply(TournamentCache& cache, std::string_view payload) {
+    if (payload.empty()) {
+        cache.Clear();
+    } else {
+        cache.Invalidate(payload);
+    }
+}
+
+void TournamentChangeListener::listenLoop() {
+    auto backoff = std::chrono::seconds{1};
+    auto nextStatistics = std::chrono::steady_clock::now() + kStatisticsPeriod;
+    TournamentCache::Stats last;
+
+    while (!stopping) {
+        try {
+            pqxx::connection connection(connectionString);
+            Receiver receiver(connection, *cache, received);
+            // LISTEN is active from here on; whatever changed before may have been missed.
+            cache->Clear();
+            backoff = std::chrono::seconds{1};
+
+            while (!stopping) {
+                connection.await_notification(kAwaitSeconds, 0);
+                if (std::chrono::steady_clock::now() >= nextStatistics) {
+                    logStatistics(last);
+                    nextStatistics = std::chrono::steady_clock::now() + kStatisticsPeriod;
+                }
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[TournamentChangeListener] " << e.what() << ", reconnecting in "
+                      << backoff.count() << "s" << std::endl;
+            cache->Clear();
+        }
+
+        std::unique_lock lock(stopMutex);
+        stopWake.wait_for(lock, backoff, [this] { return stopping.load(); });
+        backoff = std::min<std::chrono::seconds>(backoff * 2, kMaxBackoff);
+    }
+}
+
+// One line per period, only when the cache was used.
+void TournamentChangeListener::logStatistics(TournamentCache::Stats& last) {
+    const auto now = cache->Statistics();
+    if (now.hits == last.hits && now.misses == last.misses && now.invalidations == last.invalidations) {
+        return;
+    }
+    std::cout << "[TournamentCache] hits=" << now.hits << " misses=" << now.misses
+              << " evictions=" << now.evictions << " invalidations=" << now.invalidations
+              << " size=" << now.size << std::endl;
+    last = now;
+}
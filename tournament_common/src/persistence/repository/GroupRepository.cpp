@@ -2,93 +2,131 @@
 // Created by root on 9/27/25.
 //
 
-#include "domain/Utilities.hpp"
+#include "domain/DomainJson.hpp"
 #include "persistence/repository/GroupRepository.hpp"
+#include "persistence/configuration/PostgresPipeline.hpp"
+#include "persistence/configuration/UnitOfWork.hpp"
+#include "persistence/repository/IdentityMap.hpp"
 
-#include <nlohmann/json.hpp>
 #include <pqxx/pqxx>
+#include <unordered_map>
 #include <utility>
 
 namespace {
+// Identity map entries. Single groups are keyed by id, "tournamentId/groupId" or "tournamentId/team/teamId";
+// lists by tournament id.
+using LoadedGroup  = std::shared_ptr<domain::Group>;
+using LoadedGroups = std::vector<std::shared_ptr<domain::Group>>;
+
+// Any group write may change what those lookups return.
+void forget_groups() {
+    IdentityMap::EvictAll<LoadedGroup>();
+    IdentityMap::EvictAll<LoadedGroups>();
+}
+
+std::string group_key(std::string_view tournamentId, std::string_view groupId) {
+    return std::string(tournamentId) + "/" + std::string(groupId);
+}
+
+std::string team_key(std::string_view tournamentId, std::string_view teamId) {
+    return std::string(tournamentId) + "/team/" + std::string(teamId);
+}
+
 std::shared_ptr<domain::Group> build_group_from_row(const pqxx::row& row) {
     const auto* documentPtr = row["document"].c_str();
     if (documentPtr == nullptr) {
         return nullptr;
     }
 
-    const auto parsed = nlohmann::json::parse(documentPtr, nullptr, false);
-    if (parsed.is_discarded()) {
+    auto entity = json_codec::Read<domain::Group>(documentPtr);
+    if (!entity) {
         return nullptr;
     }
-
-    domain::Group entity;
-    parsed.get_to(entity);
     if (!row["id"].is_null()) {
-        entity.Id() = row["id"].as<std::string>();
+        entity->Id() = row["id"].as<std::string>();
+    }
+    return std::make_shared<domain::Group>(std::move(*entity));
+}
+
+std::vector<std::string> team_ids(const std::vector<domain::Team>& teams) {
+    std::vector<std::string> ids;
+    ids.reserve(teams.size());
+    for (const auto& team : teams) {
+        ids.push_back(team.Id);
+    }
+    return ids;
+}
+
+// Inserts the membership rows of groupId; every team must be new to the tournament.
+void insert_memberships(DbTransaction& tx, std::string_view groupId, const std::vector<std::string>& teamIds) {
+    if (teamIds.empty()) {
+        return;
+    }
+    const pqxx::result inserted = tx.Exec(statements::StatementId::InsertGroupTeams, pqxx::params{groupId, teamIds});
+    if (inserted.size() == teamIds.size()) {
+        return;
+    }
+    // Skipped rows are the duplicates: report the first requested id that did not get its row.
+    std::unordered_map<std::string, int> remaining;
+    for (const auto& row : inserted) {
+        ++remaining[row["team_id"].as<std::string>()];
+    }
+    for (const auto& teamId : teamIds) {
+        if (remaining[teamId]-- <= 0) {
+            throw DuplicateEntityError("team already belongs to a group of the tournament", teamId);
+        }
     }
-    return std::make_shared<domain::Group>(entity);
 }
 } // namespace
 
 GroupRepository::GroupRepository(const std::shared_ptr<IDbConnectionProvider>& connectionProvider) : connectionProvider(std::move(connectionProvider)) {}
 
 std::shared_ptr<domain::Group> GroupRepository::ReadById(std::string id) {
-    auto pooled = connectionProvider->Connection();
-    auto* conn = dynamic_cast<PostgresConnection*>(&*pooled);
+    return IdentityMap::Through<LoadedGroup>(id, [&]() -> LoadedGroup {
+        DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+        const pqxx::result result = tx.Exec(statements::StatementId::SelectGroupById, pqxx::params{id});
+        tx.Commit();
 
-    pqxx::work tx(*(conn->connection));
-    const pqxx::result result = tx.exec_params(
-        "SELECT id, document FROM groups WHERE id = $1::uuid",
-        id
-    );
-    tx.commit();
-
-    if (result.empty()) {
-        return nullptr;
-    }
+        if (result.empty()) {
+            return nullptr;
+        }
 
-    return build_group_from_row(result[0]);
+        return build_group_from_row(result[0]);
+    });
 }
 
 std::string GroupRepository::Create (const domain::Group & entity) {
-    auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
-    nlohmann::json groupBody = entity;
+    const std::string groupBody = json_codec::Write(entity);
+    forget_groups();
 
-    pqxx::work tx(*(connection->connection));
-    pqxx::result result = tx.exec(pqxx::prepped{"insert_group"}, pqxx::params{entity.TournamentId(), groupBody.dump()});
-
-    tx.commit();
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    pqxx::result result = tx.Exec(statements::StatementId::InsertGroup, pqxx::params{entity.TournamentId(), groupBody});
 
     if (result.empty()) {
         return {};
     }
 
-    return result[0]["id"].as<std::string>();
+    const auto id = result[0]["id"].as<std::string>();
+    insert_memberships(tx, id, team_ids(entity.Teams()));
+    tx.Commit();
+
+    return id;
 }
 
 void GroupRepository::Delete(std::string id) {
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
-
-    pqxx::work tx(*(conn->connection));
-    pqxx::result r = tx.exec_params(
-        "DELETE FROM groups WHERE id = $1::uuid",
-        id
-    );
-    tx.commit();
+    forget_groups();
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    tx.Exec(statements::StatementId::DeleteGroup, pqxx::params{id});
+    tx.Commit();
 }
 
 
 std::vector<std::shared_ptr<domain::Group>> GroupRepository::ReadAll() {
     std::vector<std::shared_ptr<domain::Group>> teams;
 
-    auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
-
-    pqxx::work tx(*(connection->connection));
-    pqxx::result result{tx.exec("select id, document->>'name' as name from groups")};
-    tx.commit();
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    pqxx::result result{tx.Exec(statements::StatementId::SelectAllGroups)};
+    tx.Commit();
 
     for (const auto& row : result) {
         teams.push_back(std::make_shared<domain::Group>(domain::Group{row["name"].c_str(), row["id"].c_str()}));
@@ -98,82 +136,155 @@ std::vector<std::shared_ptr<domain::Group>> GroupRepository::ReadAll() {
 }
 
 std::vector<std::shared_ptr<domain::Group>> GroupRepository::FindByTournamentId(const std::string_view& tournamentId) {
-    auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
-
-    pqxx::work tx(*(connection->connection));
-    pqxx::result result = tx.exec(pqxx::prepped{"select_groups_by_tournament"}, pqxx::params{tournamentId.data()});
-    tx.commit();
-
-    std::vector<std::shared_ptr<domain::Group>> groups;
-    groups.reserve(result.size());
-    for (const auto& row : result) {
-        auto group = build_group_from_row(row);
-        if (group) {
-            groups.push_back(group);
+    return IdentityMap::Through<LoadedGroups>(tournamentId, [&] {
+        DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+        pqxx::result result = tx.Exec(statements::StatementId::SelectGroupsByTournament, pqxx::params{tournamentId});
+        tx.Commit();
+
+        std::vector<std::shared_ptr<domain::Group>> groups;
+        groups.reserve(result.size());
+        for (const auto& row : result) {
+            auto group = build_group_from_row(row);
+            if (group) {
+                groups.push_back(group);
+            }
         }
-    }
 
-    return groups;
+        return groups;
+    });
 }
 // GroupRepository.cpp
 std::string GroupRepository::Update(const domain::Group& entity) {
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
-
-    nlohmann::json body = entity; // usa tu to_json(Group)
-    pqxx::work tx(*(conn->connection));
-    pqxx::result r = tx.exec_params(
-        "UPDATE groups "
-        "SET document = $2::jsonb, last_update_date = CURRENT_TIMESTAMP "
-        "WHERE id = $1::uuid "
-        "RETURNING id",
+    const std::string body = json_codec::Write(entity);
+    forget_groups();
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    pqxx::result r = tx.Exec(statements::StatementId::UpdateGroup, pqxx::params{
         entity.Id(),                // $1
-        body.dump()                 // $2
-    );
-    tx.commit();
+        body                        // $2
+    });
 
     if (r.empty()) {
         return {};
     }
 
+    try {
+        tx.Exec(statements::StatementId::SyncGroupTeams, pqxx::params{entity.Id(), team_ids(entity.Teams())});
+    } catch (const pqxx::unique_violation& e) {
+        throw DuplicateEntityError(e.what());
+    }
+    tx.Commit();
+
     return r[0]["id"].as<std::string>();
 }
 
 std::shared_ptr<domain::Group> GroupRepository::FindByTournamentIdAndGroupId(const std::string_view& tournamentId, const std::string_view& groupId) {
-    auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    const std::string key = group_key(tournamentId, groupId);
+    // Inside a unit of work this read takes the row lock, so it always goes to the database.
+    if (!UnitOfWork::Open()) {
+        if (auto known = IdentityMap::Find<LoadedGroup>(key)) {
+            return *known;
+        }
+    }
 
-    pqxx::work tx(*(connection->connection));
-    pqxx::result result = tx.exec(pqxx::prepped{"select_group_by_tournamentid_groupid"}, pqxx::params{tournamentId.data(), groupId.data()});
-    tx.commit();
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    pqxx::result result = tx.Exec(tx.InUnit() ? statements::StatementId::SelectGroupByTournamentIdGroupIdForUpdate
+                                              : statements::StatementId::SelectGroupByTournamentIdGroupId,
+                                  pqxx::params{tournamentId, groupId});
+    tx.Commit();
 
-    if (result.empty()) {
-        return nullptr;
+    LoadedGroup group = result.empty() ? nullptr : build_group_from_row(result[0]);
+    IdentityMap::Loaded<LoadedGroup>(key, group);
+    return group;
+}
+
+std::shared_ptr<domain::Group> GroupRepository::FindByTournamentIdAndTeamId(const std::string_view& tournamentId, const std::string_view& teamId) {
+    return IdentityMap::Through<LoadedGroup>(team_key(tournamentId, teamId), [&]() -> LoadedGroup {
+        DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+        const pqxx::result result = tx.Exec(statements::StatementId::SelectGroupInTournament, pqxx::params{tournamentId, teamId});
+        tx.Commit();
+        if (result.empty()) {
+            return nullptr;
+        }
+        return build_group_from_row(result[0]);
+    });
+}
+
+void GroupRepository::UpdateGroupAddTeam(const std::string_view& groupId, const std::shared_ptr<domain::Team> & team) {
+    UpdateGroupAddTeams(groupId, {team});
+}
+
+// Membership rows first (the unique index rejects a team already in the tournament), then the document, one transaction.
+void GroupRepository::UpdateGroupAddTeams(const std::string_view& groupId, const std::vector<std::shared_ptr<domain::Team>>& teams) {
+    if (teams.empty()) {
+        return;
     }
+    std::vector<std::string> ids;
+    ids.reserve(teams.size());
+    for (const auto& team : teams) {
+        ids.push_back(team->Id);
+    }
+    const std::string teamDocuments = json_codec::Write(teams);
+    forget_groups();
 
-    return build_group_from_row(result[0]);
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    insert_memberships(tx, groupId, ids);
+    tx.Exec(statements::StatementId::UpdateGroupAddTeams, pqxx::params{groupId, teamDocuments});
+    tx.Commit();
 }
 
-std::shared_ptr<domain::Group> GroupRepository::FindByTournamentIdAndTeamId(const std::string_view& tournamentId, const std::string_view& teamId) {
-    auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+// ---- batched reads ----
 
-    pqxx::work tx(*(connection->connection));
-    const pqxx::result result = tx.exec(pqxx::prepped{"select_group_in_tournament"}, pqxx::params{tournamentId.data(), teamId.data()});
-    tx.commit();
-    if (result.empty()) {
-        return nullptr;
+Deferred<std::vector<std::shared_ptr<domain::Group>>> GroupRepository::DeferFindByTournamentId(ReadBatch& batch, std::string_view tournamentId) {
+    if (auto known = IdentityMap::Find<LoadedGroups>(tournamentId)) {
+        return Deferred<std::vector<std::shared_ptr<domain::Group>>>::Ready(std::move(*known));
+    }
+    auto session = PostgresPipelineSession::For(batch, *connectionProvider);
+    const auto query = session->Queue(statements::StatementId::SelectGroupsByTournament, tournamentId);
+    return Deferred<std::vector<std::shared_ptr<domain::Group>>>([session, query, key = std::string(tournamentId)] {
+        const pqxx::result result = session->Retrieve(query);
+        std::vector<std::shared_ptr<domain::Group>> groups;
+        groups.reserve(result.size());
+        for (const auto& row : result) {
+            if (auto group = build_group_from_row(row)) {
+                groups.push_back(group);
+            }
+        }
+        IdentityMap::Loaded<LoadedGroups>(key, groups);
+        return groups;
+    });
+}
+
+Deferred<std::shared_ptr<domain::Group>> GroupRepository::DeferFindByTournamentIdAndGroupId(ReadBatch& batch, std::string_view tournamentId, std::string_view groupId) {
+    std::string key = group_key(tournamentId, groupId);
+    // Same as FindByTournamentIdAndGroupId: locking reads are never answered from the map.
+    if (!UnitOfWork::Open()) {
+        if (auto known = IdentityMap::Find<LoadedGroup>(key)) {
+            return Deferred<std::shared_ptr<domain::Group>>::Ready(std::move(*known));
+        }
     }
-    return build_group_from_row(result[0]);
+    auto session = PostgresPipelineSession::For(batch, *connectionProvider);
+    const auto query = session->Queue(session->InUnit() ? statements::StatementId::SelectGroupByTournamentIdGroupIdForUpdate
+                                                        : statements::StatementId::SelectGroupByTournamentIdGroupId,
+                                      tournamentId, groupId);
+    return Deferred<std::shared_ptr<domain::Group>>([session, query, key = std::move(key)]() -> std::shared_ptr<domain::Group> {
+        const pqxx::result result = session->Retrieve(query);
+        LoadedGroup group = result.empty() ? nullptr : build_group_from_row(result[0]);
+        IdentityMap::Loaded<LoadedGroup>(key, group);
+        return group;
+    });
 }
 
-void GroupRepository::UpdateGroupAddTeam(const std::string_view& groupId, const std::shared_ptr<domain::Team> & team) {
-    nlohmann::json teamDocument = team;
-    auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
-
-    pqxx::work tx(*(connection->connection));
-    const pqxx::result result = tx.exec(pqxx::prepped{"update_group_add_team"}, pqxx::params{groupId.data(), teamDocument.dump()});
-    tx.commit();
-}
\ No newline at end of file
+Deferred<std::shared_ptr<domain::Group>> GroupRepository::DeferFindByTournamentIdAndTeamId(ReadBatch& batch, std::string_view tournamentId, std::string_view teamId) {
+    std::string key = team_key(tournamentId, teamId);
+    if (auto known = IdentityMap::Find<LoadedGroup>(key)) {
+        return Deferred<std::shared_ptr<domain::Group>>::Ready(std::move(*known));
+    }
+    auto session = PostgresPipelineSession::For(batch, *connectionProvider);
+    const auto query = session->Queue(statements::StatementId::SelectGroupInTournament, tournamentId, teamId);
+    return Deferred<std::shared_ptr<domain::Group>>([session, query, key = std::move(key)]() -> std::shared_ptr<domain::Group> {
+        const pqxx::result result = session->Retrieve(query);
+        LoadedGroup group = result.empty() ? nullptr : build_group_from_row(result[0]);
+        IdentityMap::Loaded<LoadedGroup>(key, group);
+        return group;
+    });
+}
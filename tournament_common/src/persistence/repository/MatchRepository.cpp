@@ -1,64 +1,30 @@
 #include <pqxx/pqxx>
-#include <nlohmann/json.hpp>
 #include "persistence/repository/MatchRepository.hpp"
+#include "persistence/repository/MatchRowDecoder.hpp"
+#include "domain/DomainJson.hpp"
 #include "persistence/configuration/PostgresConnection.hpp"
-
-using nlohmann::json;
-
-static std::string esc(const std::string& s) {
-    std::string out; out.reserve(s.size() + 8);
-    for (char c : s) {
-        if (c == '\\' || c == '\"') { out.push_back('\\'); out.push_back(c); }
-        else out.push_back(c);
-    }
-    return out;
+#include "persistence/configuration/PostgresPipeline.hpp"
+#include "persistence/configuration/UnitOfWork.hpp"
+#include "persistence/repository/IdentityMap.hpp"
+
+namespace {
+// Identity map entries: a match by "tournamentId/matchId", the matches of a tournament by its id.
+using LoadedMatch   = std::shared_ptr<domain::Match>;
+using LoadedMatches = std::vector<std::shared_ptr<domain::Match>>;
+
+void forget_matches() {
+    IdentityMap::EvictAll<LoadedMatch>();
+    IdentityMap::EvictAll<LoadedMatches>();
 }
 
-std::string MatchRepository::to_doc_string(const domain::Match& m) {
-    std::string doc = "{";
-
-    doc += "\"tournamentId\":\""; doc += esc(m.TournamentId()); doc += "\",";
-    doc += "\"round\":\"";        doc += esc(m.Round());        doc += "\",";
-
-    doc += "\"home\":{";
-    doc += "\"id\":\"";   doc += esc(m.Home().Id());   doc += "\",";
-    doc += "\"name\":\""; doc += esc(m.Home().Name()); doc += "\"},";
-
-    doc += "\"visitor\":{";
-    doc += "\"id\":\"";   doc += esc(m.Visitor().Id());   doc += "\",";
-    doc += "\"name\":\""; doc += esc(m.Visitor().Name()); doc += "\"},";
-
-    doc += "\"status\":\""; doc += esc(m.Status()); doc += "\"";
-
-    if (m.HasScore()) {
-        doc += ",\"score\":{";
-        doc += "\"home\":";    doc += std::to_string(*m.ScoreHome());    doc += ",";
-        doc += "\"visitor\":"; doc += std::to_string(*m.ScoreVisitor());
-        doc += "}";
-    }
-    if (m.WinnerTeamId().has_value()) {
-        doc += ",\"winnerTeamId\":\""; doc += esc(*m.WinnerTeamId()); doc += "\"";
-    }
-    if (m.DecidedBy().has_value()) {
-        doc += ",\"decidedBy\":\""; doc += esc(*m.DecidedBy()); doc += "\"";
-    }
-    if (m.NextMatchId().has_value()) {
-        doc += ",\"nextMatchId\":\""; doc += esc(*m.NextMatchId()); doc += "\"";
-    }
-    if (m.NextMatchWinnerSlot().has_value()) {
-        doc += ",\"nextMatchWinnerSlot\":\""; doc += esc(*m.NextMatchWinnerSlot()); doc += "\"";
-    }
-
-    doc += "}";
-    return doc;
+std::string match_key(std::string_view tournamentId, std::string_view matchId) {
+    return std::string(tournamentId) + "/" + std::string(matchId);
+}
 }
 
+// Typed columns only (see MatchRowDecoder.hpp); the JSONB document is not read back.
 std::shared_ptr<domain::Match> MatchRepository::row_to_domain(const pqxx::row& row) {
-    const std::string id  = row["id"].c_str();
-    json j = json::parse(row["document"].c_str());
-    domain::Match m = j.get<domain::Match>();
-    m.Id() = id;
-    return std::make_shared<domain::Match>(std::move(m));
+    return std::make_shared<domain::Match>(match_columns::Decode(row));
 }
 
 MatchRepository::MatchRepository(std::shared_ptr<IDbConnectionProvider> provider)
@@ -66,63 +32,127 @@ MatchRepository::MatchRepository(std::shared_ptr<IDbConnectionProvider> provider
 
 std::vector<std::shared_ptr<domain::Match>>
 MatchRepository::FindByTournamentId(const std::string& tournamentId) {
-    std::vector<std::shared_ptr<domain::Match>> out;
+    return IdentityMap::Through<LoadedMatches>(tournamentId, [&] {
+        std::vector<std::shared_ptr<domain::Match>> out;
+
+        DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+        pqxx::result r = tx.Exec(statements::StatementId::SelectMatchesByTournament, pqxx::params{tournamentId});
+        out.reserve(r.size());
+        for (const auto& row : r) out.emplace_back(row_to_domain(row));
+        return out;
+    });
+}
+
+JsonPage
+MatchRepository::FindJsonPageByTournamentId(const std::string& tournamentId, const std::string& status,
+                                            const PageRequest& request) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    const int fetch = page_cursor::FetchLimit(request);
+    pqxx::result r = request.after
+        ? tx.Exec(statements::StatementId::SelectMatchesJsonPageAfter,
+                  pqxx::params{tournamentId, status, request.after->createdAt, request.after->id, fetch})
+        : tx.Exec(statements::StatementId::SelectMatchesJsonPage, pqxx::params{tournamentId, status, fetch});
+    return page_cursor::JsonArrayFromRows(r, request);
+}
 
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
+std::optional<std::string>
+MatchRepository::FindJsonByTournamentIdAndMatchId(const std::string& tournamentId, const std::string& matchId) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    pqxx::result r = tx.Exec(statements::StatementId::SelectMatchJsonByTournamentIdMatchId, pqxx::params{tournamentId, matchId});
+    if (r.empty()) return std::nullopt;
+    return std::string(r[0]["body"].c_str(), r[0]["body"].size());
+}
 
-    pqxx::read_transaction tx(*(conn->connection));
-    pqxx::result r = tx.exec_params(
-        "SELECT id, document "
-        "FROM matches "
-        "WHERE tournament_id = $1::uuid "
-        "ORDER BY created_at ASC",
-        tournamentId
-    );
-    out.reserve(r.size());
-    for (const auto& row : r) out.emplace_back(row_to_domain(row));
-    return out;
+std::optional<std::string>
+MatchRepository::FindVersionByTournamentId(const std::string& tournamentId) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    pqxx::result r = tx.Exec(statements::StatementId::SelectMatchesVersion, pqxx::params{tournamentId});
+    if (r.empty()) return std::nullopt;
+    return r[0]["version"].as<std::string>();
 }
 
 std::shared_ptr<domain::Match>
 MatchRepository::FindByTournamentIdAndMatchId(const std::string& tournamentId,
                                               const std::string& matchId) {
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
+    const std::string key = match_key(tournamentId, matchId);
+    // Inside a unit of work this read takes the row lock, so it always goes to the database.
+    if (!UnitOfWork::Open()) {
+        if (auto known = IdentityMap::Find<LoadedMatch>(key)) {
+            return *known;
+        }
+    }
+
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    pqxx::result r = tx.Exec(tx.InUnit() ? statements::StatementId::SelectMatchByTournamentIdMatchIdForUpdate
+                                         : statements::StatementId::SelectMatchByTournamentIdMatchId,
+                             pqxx::params{tournamentId, matchId});
+    LoadedMatch match = r.empty() ? nullptr : row_to_domain(r[0]);
+    IdentityMap::Loaded<LoadedMatch>(key, match);
+    return match;
+}
+
+Deferred<std::vector<std::shared_ptr<domain::Match>>>
+MatchRepository::DeferFindByTournamentId(ReadBatch& batch, const std::string& tournamentId) {
+    if (auto known = IdentityMap::Find<LoadedMatches>(tournamentId)) {
+        return Deferred<std::vector<std::shared_ptr<domain::Match>>>::Ready(std::move(*known));
+    }
+    auto session = PostgresPipelineSession::For(batch, *connectionProvider);
+    const auto query = session->Queue(statements::StatementId::SelectMatchesByTournament, tournamentId);
+    return Deferred<std::vector<std::shared_ptr<domain::Match>>>([session, query, tournamentId] {
+        const pqxx::result r = session->Retrieve(query);
+        std::vector<std::shared_ptr<domain::Match>> out;
+        out.reserve(r.size());
+        for (const auto& row : r) out.emplace_back(row_to_domain(row));
+        IdentityMap::Loaded<LoadedMatches>(tournamentId, out);
+        return out;
+    });
+}
 
-    pqxx::read_transaction tx(*(conn->connection));
-    pqxx::result r = tx.exec_params(
-        "SELECT id, document "
-        "FROM matches "
-        "WHERE tournament_id = $1::uuid AND id = $2::uuid "
-        "LIMIT 1",
-        tournamentId, matchId
-    );
-    if (r.empty()) return nullptr;
-    return row_to_domain(r[0]);
+Deferred<JsonPage>
+MatchRepository::DeferFindJsonPageByTournamentId(ReadBatch& batch, const std::string& tournamentId,
+                                                 const std::string& status, const PageRequest& request) {
+    auto session = PostgresPipelineSession::For(batch, *connectionProvider);
+    const int fetch = page_cursor::FetchLimit(request);
+    const auto query = request.after
+        ? session->Queue(statements::StatementId::SelectMatchesJsonPageAfter, tournamentId, status,
+                         request.after->createdAt, request.after->id, fetch)
+        : session->Queue(statements::StatementId::SelectMatchesJsonPage, tournamentId, status, fetch);
+    return Deferred<JsonPage>([session, query, request] {
+        return page_cursor::JsonArrayFromRows(session->Retrieve(query), request);
+    });
+}
+
+Deferred<std::shared_ptr<domain::Match>>
+MatchRepository::DeferFindByTournamentIdAndMatchId(ReadBatch& batch, const std::string& tournamentId,
+                                                   const std::string& matchId) {
+    std::string key = match_key(tournamentId, matchId);
+    if (auto known = IdentityMap::Find<LoadedMatch>(key)) {
+        return Deferred<std::shared_ptr<domain::Match>>::Ready(std::move(*known));
+    }
+    auto session = PostgresPipelineSession::For(batch, *connectionProvider);
+    const auto query = session->Queue(statements::StatementId::SelectMatchByTournamentIdMatchId, tournamentId, matchId);
+    return Deferred<std::shared_ptr<domain::Match>>([session, query, key = std::move(key)]() -> std::shared_ptr<domain::Match> {
+        const pqxx::result r = session->Retrieve(query);
+        LoadedMatch match = r.empty() ? nullptr : row_to_domain(r[0]);
+        IdentityMap::Loaded<LoadedMatch>(key, match);
+        return match;
+    });
 }
 
 std::string MatchRepository::Update(const domain::Match& entity) {
     if (entity.Id().empty()) throw std::invalid_argument("match.Id is required");
     if (entity.TournamentId().empty()) throw std::invalid_argument("match.TournamentId is required");
 
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
-
-    const std::string doc = to_doc_string(entity);
+    const std::string doc = json_codec::Write(entity);
+    forget_matches();
 
-    pqxx::work tx(*(conn->connection));
-    pqxx::result r = tx.exec_params(
-        "UPDATE matches "
-        "SET document = $3::jsonb, last_update_date = CURRENT_TIMESTAMP "
-        "WHERE tournament_id = $1::uuid AND id = $2::uuid",
-        entity.TournamentId(), entity.Id(), doc
-    );
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    pqxx::result r = tx.Exec(statements::StatementId::UpdateMatch, pqxx::params{entity.TournamentId(), entity.Id(), doc});
     if (r.affected_rows() == 0) {
-        tx.abort();
+        tx.Abort();
         throw std::runtime_error("not found");
     }
-    tx.commit();
+    tx.Commit();
     return entity.Id();
 }
 
@@ -131,24 +161,17 @@ std::string MatchRepository::Create(const domain::Match& entity) {
         throw std::invalid_argument("match.TournamentId is required");
     }
 
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
+    const std::string doc = json_codec::Write(entity);
+    forget_matches();
 
-    const std::string doc = to_doc_string(entity);
-
-    pqxx::work tx(*(conn->connection));
-    pqxx::result r = tx.exec_params(
-        "INSERT INTO matches (tournament_id, document) "
-        "VALUES ($1::uuid, $2::jsonb) "
-        "RETURNING id",
-        entity.TournamentId(), doc
-    );
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    pqxx::result r = tx.Exec(statements::StatementId::InsertMatch, pqxx::params{entity.TournamentId(), doc});
     if (r.empty()) {
-        tx.abort();
+        tx.Abort();
         throw std::runtime_error("insert failed");
     }
     const std::string id = r[0]["id"].c_str();
-    tx.commit();
+    tx.Commit();
     return id;
 }
 
@@ -158,43 +181,60 @@ std::string MatchRepository::CreateIfNotExists(const domain::Match& entity) {
         throw std::invalid_argument("match.TournamentId is required");
     }
 
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
-
-    const std::string doc = to_doc_string(entity);
+    const std::string doc = json_codec::Write(entity);
+    forget_matches();
 
-    pqxx::work tx(*(conn->connection));
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
     // ON CONFLICT over (tournament_id, round_key, home_id_key, visitor_id_key)
-    pqxx::result r = tx.exec_params(
-        "INSERT INTO matches (tournament_id, document) "
-        "VALUES ($1::uuid, $2::jsonb) "
-        "ON CONFLICT (tournament_id, round_key, home_id_key, visitor_id_key) "
-        "DO NOTHING "
-        "RETURNING id",
-        entity.TournamentId(), doc
-    );
+    pqxx::result r = tx.Exec(statements::StatementId::InsertMatchIfNotExists, pqxx::params{entity.TournamentId(), doc});
 
     if (!r.empty()) {
         const std::string id = r[0]["id"].c_str();
-        tx.commit();
+        tx.Commit();
         return id;
     }
 
     // Conflict: fetch the existing id to return it
-    pqxx::result r2 = tx.exec_params(
-        "SELECT id FROM matches "
-        "WHERE tournament_id = $1::uuid "
-        "AND round_key   = ($2::jsonb->>'round') "
-        "AND home_id_key = (($2::jsonb->'home'->>'id')::uuid) "
-        "AND visitor_id_key = (($2::jsonb->'visitor'->>'id')::uuid) "
-        "LIMIT 1",
-        entity.TournamentId(), doc
-    );
+    pqxx::result r2 = tx.Exec(statements::StatementId::SelectMatchIdByNaturalKey, pqxx::params{entity.TournamentId(), doc});
     if (r2.empty()) {
-        tx.abort();
+        tx.Abort();
         throw std::runtime_error("conflict occurred but existing row not found");
     }
     const std::string existingId = r2[0]["id"].c_str();
-    tx.commit();
+    tx.Commit();
     return existingId;
 }
+
+// Whole fixture in one round trip: the documents travel as a single jsonb[] parameter.
+std::vector<std::string> MatchRepository::CreateBatch(const std::vector<domain::Match>& entities) {
+    std::vector<std::string> ids;
+    if (entities.empty()) return ids;
+
+    std::vector<std::string> docs;
+    docs.reserve(entities.size());
+    for (const auto& entity : entities) {
+        if (entity.TournamentId().empty()) {
+            throw std::invalid_argument("match.TournamentId is required");
+        }
+        docs.emplace_back(json_codec::Write(entity));
+    }
+    forget_matches();
+
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    pqxx::result r = tx.Exec(statements::StatementId::InsertMatchesBatch, pqxx::params{docs});
+    if (r.size() != entities.size()) {
+        tx.Abort();
+        throw std::runtime_error("batch insert returned an unexpected number of rows");
+    }
+
+    ids.reserve(r.size());
+    for (const auto& row : r) {
+        if (row["id"].is_null()) {
+            tx.Abort();
+            throw std::runtime_error("conflict occurred but existing row not found");
+        }
+        ids.emplace_back(row["id"].c_str());
+    }
+    tx.Commit();
+    return ids;
+}
@@ -0,0 +1,57 @@
+#include <exception>
+#include <vector>
+#include <pqxx/pqxx>
+#include "persistence/repository/OutboxRepository.hpp"
+#include "persistence/configuration/PostgresConnection.hpp"
+#include "persistence/configuration/UnitOfWork.hpp"
+
+OutboxRepository::OutboxRepository(std::shared_ptr<IDbConnectionProvider> provider)
+    : connectionProvider(std::move(provider)) {}
+
+void OutboxRepository::Enqueue(const std::string& queue, const std::string& payload) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    tx.Exec(statements::StatementId::InsertOutboxEvent, pqxx::params{queue, payload});
+    tx.Commit();
+}
+
+// The claimed rows stay locked while they are published: another relay skips them instead of sending
+// them twice, and a relay that dies mid-batch leaves them pending for the next one.
+std::size_t OutboxRepository::PublishPending(std::size_t limit,
+                                             const std::function<void(const OutboxEvent&)>& publish) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    const pqxx::result r = tx.Exec(statements::StatementId::ClaimOutboxBatch,
+                                   pqxx::params{static_cast<int>(limit)});
+
+    std::vector<std::int64_t> published;
+    published.reserve(r.size());
+    std::exception_ptr failure;
+    for (const auto& row : r) {
+        OutboxEvent event;
+        event.id      = row["id"].as<std::int64_t>();
+        event.queue   = row["queue"].as<std::string>();
+        event.payload = row["payload"].as<std::string>();
+        try {
+            publish(event);
+        } catch (...) {
+            failure = std::current_exception();
+            break;
+        }
+        published.push_back(event.id);
+    }
+
+    if (!published.empty()) {
+        tx.Exec(statements::StatementId::MarkOutboxPublished, pqxx::params{published});
+    }
+    tx.Commit();
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    return published.size();
+}
+
+std::size_t OutboxRepository::PurgePublished(int olderThanHours) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    const pqxx::result r = tx.Exec(statements::StatementId::PurgeOutboxPublished, pqxx::params{olderThanHours});
+    tx.Commit();
+    return static_cast<std::size_t>(r.affected_rows());
+}
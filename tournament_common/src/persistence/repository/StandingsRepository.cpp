@@ -0,0 +1,83 @@
+#include <pqxx/pqxx>
+#include "persistence/repository/StandingsRepository.hpp"
+#include "persistence/configuration/PostgresConnection.hpp"
+#include "persistence/configuration/PostgresPipeline.hpp"
+#include "persistence/configuration/UnitOfWork.hpp"
+
+// Columns of STANDING_ROWS (StatementCatalog.hpp).
+domain::Standing StandingsRepository::row_to_domain(const pqxx::row& row) {
+    domain::Standing s;
+    s.groupId      = row["group_id"].as<std::string>();
+    s.teamId       = row["team_id"].as<std::string>();
+    s.teamName     = row["team_name"].as<std::string>();
+    s.played       = row["played"].as<int>();
+    s.won          = row["won"].as<int>();
+    s.lost         = row["lost"].as<int>();
+    s.goalsFor     = row["goals_for"].as<int>();
+    s.goalsAgainst = row["goals_against"].as<int>();
+    s.points       = row["points"].as<int>();
+    return s;
+}
+
+StandingsRepository::StandingsRepository(std::shared_ptr<IDbConnectionProvider> provider)
+    : connectionProvider(std::move(provider)) {}
+
+// One statement for all the teams: the deltas travel as parallel arrays.
+void StandingsRepository::Apply(const std::string& tournamentId, const std::vector<domain::Standing>& deltas) {
+    if (deltas.empty()) return;
+
+    std::vector<std::string> teamIds;
+    std::vector<int> played, won, lost, goalsFor, goalsAgainst, points;
+    teamIds.reserve(deltas.size());
+    for (const auto& d : deltas) {
+        teamIds.push_back(d.teamId);
+        played.push_back(d.played);
+        won.push_back(d.won);
+        lost.push_back(d.lost);
+        goalsFor.push_back(d.goalsFor);
+        goalsAgainst.push_back(d.goalsAgainst);
+        points.push_back(d.points);
+    }
+
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    tx.Exec(statements::StatementId::ApplyStandingDeltas,
+            pqxx::params{tournamentId, teamIds, played, won, lost, goalsFor, goalsAgainst, points});
+    tx.Commit();
+}
+
+std::vector<domain::Standing> StandingsRepository::FindByTournamentId(const std::string& tournamentId) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    const pqxx::result r = tx.Exec(statements::StatementId::SelectStandingsByTournament, pqxx::params{tournamentId});
+    std::vector<domain::Standing> out;
+    out.reserve(r.size());
+    for (const auto& row : r) out.push_back(row_to_domain(row));
+    return out;
+}
+
+std::optional<std::string> StandingsRepository::FindJsonByTournamentId(const std::string& tournamentId) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    const pqxx::result r = tx.Exec(statements::StatementId::SelectStandingsJsonByTournament, pqxx::params{tournamentId});
+    if (r.empty()) return std::nullopt;
+    return std::string(r[0]["body"].c_str(), r[0]["body"].size());
+}
+
+std::optional<std::string>
+StandingsRepository::FindJsonByTournamentIdAndGroupId(const std::string& tournamentId, const std::string& groupId) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    const pqxx::result r = tx.Exec(statements::StatementId::SelectStandingsJsonByGroup, pqxx::params{tournamentId, groupId});
+    if (r.empty()) return std::nullopt;
+    return std::string(r[0]["body"].c_str(), r[0]["body"].size());
+}
+
+Deferred<std::vector<domain::Standing>>
+StandingsRepository::DeferFindByTournamentId(ReadBatch& batch, const std::string& tournamentId) {
+    auto session = PostgresPipelineSession::For(batch, *connectionProvider);
+    const auto query = session->Queue(statements::StatementId::SelectStandingsByTournament, tournamentId);
+    return Deferred<std::vector<domain::Standing>>([session, query] {
+        const pqxx::result r = session->Retrieve(query);
+        std::vector<domain::Standing> out;
+        out.reserve(r.size());
+        for (const auto& row : r) out.push_back(row_to_domain(row));
+        return out;
+    });
+}
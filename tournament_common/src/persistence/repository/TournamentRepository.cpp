@@ -1,136 +1,184 @@
 #include <memory>
+#include <optional>
 #include <string>
 #include <stdexcept>
 #include <pqxx/pqxx>
-#include <nlohmann/json.hpp>
 
 #include "persistence/repository/TournamentRepository.hpp"
 #include "persistence/configuration/IDbConnectionProvider.hpp"
 #include "persistence/configuration/PostgresConnection.hpp"
+#include "persistence/configuration/PostgresPipeline.hpp"
+#include "persistence/configuration/ReadRouting.hpp"
+#include "persistence/configuration/UnitOfWork.hpp"
+#include "persistence/repository/IdentityMap.hpp"
+#include "persistence/repository/RepositoryErrors.hpp"
 #include "domain/Tournament.hpp"
+#include "domain/DomainJson.hpp"
 
-using nlohmann::json;
+// Identity map entries: tournament (or nullptr) by id.
+using Loaded = std::shared_ptr<domain::Tournament>;
 
-// enum <-> string helpers
-static std::string type_to_string(domain::TournamentType t) {
-    return (t == domain::TournamentType::NFL) ? "NFL" : "ROUND_ROBIN";
-}
-static domain::TournamentType string_to_type(const std::string& s) {
-    return (s == "NFL") ? domain::TournamentType::NFL : domain::TournamentType::ROUND_ROBIN;
-}
+// Unit that last wrote a tournament on this thread. Until it commits it reads its own rows, which
+// are not committed yet: it bypasses the shared cache (a stale address only costs a cache miss).
+static thread_local const UnitOfWork* writingUnit = nullptr;
 
-// simple escaper
-static std::string esc(const std::string& s) {
-    std::string out; out.reserve(s.size() + 8);
-    for (char c : s) {
-        if (c == '\\' || c == '\"') { out.push_back('\\'); out.push_back(c); }
-        else out.push_back(c);
-    }
-    return out;
+// Only looks at the current unit: a read that may be served from the cache must not bind it (that
+// checks out a primary connection and opens its transaction).
+static bool cacheable() {
+    const UnitOfWork* unit = UnitOfWork::Current();
+    return unit == nullptr || unit != writingUnit;
 }
 
-// domain -> JSON string for document column
-static std::string to_doc_string(const domain::Tournament& t) {
-    std::string doc = "{\"name\":\"";
-    doc += esc(t.Name());
-    doc += "\",\"format\":{";
-    doc += "\"numberOfGroups\":";   doc += std::to_string(t.Format().NumberOfGroups());
-    doc += ",\"maxTeamsPerGroup\":"; doc += std::to_string(t.Format().MaxTeamsPerGroup());
-    doc += ",\"type\":\"";          doc += type_to_string(t.Format().Type()); doc += "\"}}";
-    return doc;
-}
-
-// row -> domain
+// document -> domain (json_codec); the id comes from the column.
 static std::shared_ptr<domain::Tournament> row_to_domain(const pqxx::row& row) {
-    json j = json::parse(row["document"].c_str());
-    const std::string name = j.value("name", "");
-    const json& jf        = j.at("format");
-    const int ng         = jf.value("numberOfGroups", 1);
-    const int mtg        = jf.value("maxTeamsPerGroup", 16);
-    const std::string ts = jf.value("type", "ROUND_ROBIN");
-
-    domain::TournamentFormat fmt{ng, mtg, string_to_type(ts)};
-    auto t = std::make_shared<domain::Tournament>(name, fmt);
+    auto t = json_codec::Read<domain::Tournament>(row["document"].c_str());
+    if (!t) throw std::runtime_error("invalid tournament document: " + t.error().message);
     t->Id() = row["id"].as<std::string>();
-    return t;
+    return std::make_shared<domain::Tournament>(std::move(*t));
 }
 
 TournamentRepository::TournamentRepository(std::shared_ptr<IDbConnectionProvider> provider)
     : connectionProvider(std::move(provider)) {}
 
 std::string TournamentRepository::Create(const domain::Tournament& entity) {
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
-
-    const std::string doc = to_doc_string(entity);
-
-    pqxx::work tx(*(conn->connection));
-    pqxx::result r = tx.exec_params(
-        "INSERT INTO tournaments (document) VALUES ($1::jsonb) RETURNING id",
-        doc
-    );
-    if (r.empty()) { tx.abort(); throw std::runtime_error("insert failed"); }
+    if (takenNames && takenNames->Taken(entity.Name())) {
+        throw DuplicateEntityError("tournament name already exists", entity.Name());
+    }
+    const std::string doc = json_codec::Write(entity);
+
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    pqxx::result r;
+    try {
+        r = tx.Exec(statements::StatementId::InsertTournament, pqxx::params{doc});
+    } catch (const pqxx::unique_violation& e) {
+        throw DuplicateEntityError(e.what(), entity.Name());
+    }
+    if (r.empty()) {
+        // ON CONFLICT DO NOTHING: the name index already has it.
+        tx.Abort();
+        if (takenNames) takenNames->Remember(entity.Name());
+        throw DuplicateEntityError("tournament name already exists", entity.Name());
+    }
     const std::string id = r[0]["id"].as<std::string>();
-    tx.commit();
+    tx.Commit();
+    if (takenNames) takenNames->Remember(entity.Name());
     return id;
 }
 
 std::vector<std::shared_ptr<domain::Tournament>> TournamentRepository::ReadAll() {
     std::vector<std::shared_ptr<domain::Tournament>> out;
 
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
-
-    pqxx::read_transaction tx(*(conn->connection));
-    pqxx::result r = tx.exec("SELECT id, document FROM tournaments ORDER BY created_at ASC");
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    pqxx::result r = tx.Exec(statements::StatementId::SelectAllTournaments);
 
     out.reserve(r.size());
-    for (const auto& row : r) out.emplace_back(row_to_domain(row));
+    for (const auto& row : r) {
+        out.emplace_back(row_to_domain(row));
+        IdentityMap::Put<Loaded>(out.back()->Id(), out.back());
+    }
     return out;
 }
 
+JsonPage TournamentRepository::ReadJsonPage(const PageRequest& request) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    const int fetch = page_cursor::FetchLimit(request);
+    pqxx::result r = request.after
+        ? tx.Exec(statements::StatementId::SelectTournamentsJsonPageAfter,
+                  pqxx::params{request.after->createdAt, request.after->id, fetch})
+        : tx.Exec(statements::StatementId::SelectTournamentsJsonPage, pqxx::params{fetch});
+    return page_cursor::JsonArrayFromRows(r, request);
+}
+
 std::shared_ptr<domain::Tournament> TournamentRepository::ReadById(std::string id) {
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
-
-    pqxx::read_transaction tx(*(conn->connection));
-    pqxx::result r = tx.exec_params(
-        "SELECT id, document FROM tournaments WHERE id = $1::uuid LIMIT 1",
-        id
-    );
-    if (r.empty()) return nullptr;
-    return row_to_domain(r[0]);
+    return IdentityMap::Through<Loaded>(id, [&]() -> Loaded {
+        const bool keep = cache && cacheable();
+        if (keep) {
+            if (auto cached = cache->Find(id)) return cached;
+        }
+        const auto stamp = keep ? cache->StampFor(id) : TournamentCache::Stamp{};
+        // A row that fills the cache comes from the primary: a lagging replica can still return the
+        // version the last NOTIFY invalidated, and it would stay cached until the next change.
+        std::optional<read_routing::PrimaryScope> primary;
+        if (keep) primary.emplace();
+        DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+        pqxx::result r = tx.Exec(statements::StatementId::SelectTournamentById, pqxx::params{id});
+        if (r.empty()) return nullptr;
+        auto t = row_to_domain(r[0]);
+        if (keep) cache->Put(*t, stamp);
+        return t;
+    });
 }
 
-std::string TournamentRepository::Update(const domain::Tournament& entity) {
-    if (entity.Id().empty()) throw std::invalid_argument("tournament.Id is required");
+std::optional<std::string> TournamentRepository::ReadVersion(std::string id) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    pqxx::result r = tx.Exec(statements::StatementId::SelectTournamentVersion, pqxx::params{id});
+    if (r.empty()) return std::nullopt;
+    return r[0]["version"].as<std::string>();
+}
+
+Versioned<domain::Tournament> TournamentRepository::ReadWithVersion(std::string id) {
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Read);
+    pqxx::result r = tx.Exec(statements::StatementId::SelectTournamentWithVersion, pqxx::params{id});
+    if (r.empty()) return {};
+    auto t = row_to_domain(r[0]);
+    IdentityMap::Put<Loaded>(id, t);
+    return {std::move(t), r[0]["version"].as<std::string>()};
+}
 
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
+Deferred<std::shared_ptr<domain::Tournament>> TournamentRepository::DeferReadById(ReadBatch& batch, std::string id) {
+    if (auto known = IdentityMap::Find<Loaded>(id)) {
+        return Deferred<std::shared_ptr<domain::Tournament>>::Ready(std::move(*known));
+    }
+    std::shared_ptr<TournamentCache> keep = cache && cacheable() ? cache : nullptr;
+    if (keep) {
+        if (auto cached = keep->Find(id)) {
+            IdentityMap::Put<Loaded>(id, cached);
+            return Deferred<std::shared_ptr<domain::Tournament>>::Ready(std::move(cached));
+        }
+    }
+    const auto stamp = keep ? keep->StampFor(id) : TournamentCache::Stamp{};
+    std::optional<read_routing::PrimaryScope> primary;
+    if (keep) primary.emplace();
+    auto session = PostgresPipelineSession::For(batch, *connectionProvider);
+    // Session opened on the replica by an earlier read of the batch: read there, but don't cache it.
+    if (session->FromReplica()) keep = nullptr;
+    const auto query = session->Queue(statements::StatementId::SelectTournamentById, id);
+    return Deferred<std::shared_ptr<domain::Tournament>>([session, query, id, keep = std::move(keep), stamp]() -> std::shared_ptr<domain::Tournament> {
+        const pqxx::result r = session->Retrieve(query);
+        Loaded t = r.empty() ? nullptr : row_to_domain(r[0]);
+        if (t && keep) keep->Put(*t, stamp);
+        IdentityMap::Loaded<Loaded>(id, t);
+        return t;
+    });
+}
 
-    const std::string doc = to_doc_string(entity);
+std::string TournamentRepository::Update(const domain::Tournament& entity) {
+    if (entity.Id().empty()) throw std::invalid_argument("tournament.Id is required");
 
-    pqxx::work tx(*(conn->connection));
-    pqxx::result r = tx.exec_params(
-        "UPDATE tournaments "
-        "SET document = $2::jsonb, last_update_date = CURRENT_TIMESTAMP "
-        "WHERE id = $1::uuid",
-        entity.Id(), doc
-    );
-    if (r.affected_rows() == 0) { tx.abort(); throw std::runtime_error("not found"); }
-    tx.commit();
+    const std::string doc = json_codec::Write(entity);
+    IdentityMap::Evict<Loaded>(entity.Id());
+
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    pqxx::result r = tx.Exec(statements::StatementId::UpdateTournament, pqxx::params{entity.Id(), doc});
+    if (r.affected_rows() == 0) { tx.Abort(); throw std::runtime_error("not found"); }
+    tx.Commit();
+    writingUnit = UnitOfWork::For(*connectionProvider);
+    // Inside a unit the row changes on the unit's commit; the trigger's NOTIFY, which this instance
+    // receives too, invalidates again then.
+    if (cache) cache->Invalidate(entity.Id());
+    // The old name may be free now.
+    if (takenNames) takenNames->Clear();
     return entity.Id();
 }
 
 void TournamentRepository::Delete(std::string id) {
-    auto pooled = connectionProvider->Connection();
-    auto* conn  = dynamic_cast<PostgresConnection*>(&*pooled);
-
-    pqxx::work tx(*(conn->connection));
-    pqxx::result r = tx.exec_params(
-        "DELETE FROM tournaments WHERE id = $1::uuid",
-        id
-    );
-    if (r.affected_rows() == 0) { tx.abort(); throw std::runtime_error("not found"); }
-    tx.commit();
+    IdentityMap::Evict<Loaded>(id);
+    DbTransaction tx(*connectionProvider, DbTransaction::Access::Write);
+    pqxx::result r = tx.Exec(statements::StatementId::DeleteTournament, pqxx::params{id});
+    if (r.affected_rows() == 0) { tx.Abort(); throw std::runtime_error("not found"); }
+    tx.Commit();
+    writingUnit = UnitOfWork::For(*connectionProvider);
+    if (cache) cache->Invalidate(id);
+    if (takenNames) takenNames->Clear();
+    IdentityMap::Put<Loaded>(id, nullptr);
 }
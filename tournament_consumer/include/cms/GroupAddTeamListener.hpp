@@ -5,6 +5,7 @@
 #include <nlohmann/json.hpp>
 #include "QueueMessageListener.hpp"
 #include "delegate/MatchDelegate.hpp"
+#include "event/EventCodec.hpp"
 #include "event/TeamAddEvent.hpp"
 
 class GroupAddTeamListener : public QueueMessageListener {
@@ -12,8 +13,12 @@ class GroupAddTeamListener : public QueueMessageListener {
 
 protected:
     void processMessage(const std::string& message) override;
+    // Events of one tournament stay in order on the dispatcher.
+    std::string shardKey(const std::string& message) override { return TournamentIdOf(message); }
 
 public:
+    static constexpr std::string_view Queue = "tournament.team-add";
+
     GroupAddTeamListener(const std::shared_ptr<ConnectionManager>& connectionManager,
                          const std::shared_ptr<MatchDelegate>& matchDelegate);
     ~GroupAddTeamListener() override;
@@ -31,25 +36,43 @@ inline GroupAddTeamListener::~GroupAddTeamListener() {
     Stop();
 }
 
+// A malformed event is logged and dropped; a failure while processing it is rethrown, so the
+// listener rolls it back and the broker redelivers it.
 inline void GroupAddTeamListener::processMessage(const std::string& message) {
-    std::cout << "[GroupAddTeamListener] Received: " << message << std::endl;
+    TeamAddEvent evt;
     try {
-        auto json = nlohmann::json::parse(message);
-        TeamAddEvent evt{
-            json.at("tournamentId").get<std::string>(),
-            json.at("groupId").get<std::string>(),
-            json.at("teamId").get<std::string>()
-        };
-
-        if (!matchDelegate) {
-            std::cout << "[GroupAddTeamListener] ERROR: matchDelegate is null!" << std::endl;
-            return;
+        if (event_codec::IsBinary(message)) {
+            event_codec::TeamAddView view;
+            if (!event_codec::Decode(message, view)) {
+                std::cout << "[GroupAddTeamListener] ERROR: not a team-add event" << std::endl;
+                return;
+            }
+            evt = event_codec::ToEvent(view);
+            std::cout << "[GroupAddTeamListener] Received team " << evt.teamId << " for group " << evt.groupId << std::endl;
+        } else {
+            std::cout << "[GroupAddTeamListener] Received: " << message << std::endl;
+            auto json = nlohmann::json::parse(message);
+            evt = TeamAddEvent{
+                json.at("tournamentId").get<std::string>(),
+                json.at("groupId").get<std::string>(),
+                json.at("teamId").get<std::string>()
+            };
         }
+    } catch (const std::exception& e) {
+        std::cout << "[GroupAddTeamListener] ERROR: malformed event, dropped: " << e.what() << std::endl;
+        return;
+    }
 
-        matchDelegate->ProcessTeamAddition(evt);
+    if (!matchDelegate) {
+        std::cout << "[GroupAddTeamListener] ERROR: matchDelegate is null!" << std::endl;
+        return;
+    }
 
+    try {
+        matchDelegate->ProcessTeamAddition(evt);
     } catch (const std::exception& e) {
         std::cout << "[GroupAddTeamListener] ERROR: " << e.what() << std::endl;
+        throw;
     }
 }
 
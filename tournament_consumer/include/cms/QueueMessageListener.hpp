@@ -1,80 +1,387 @@
 //
 // QueueMessageListener.hpp
+// The session is always transacted: a message is acknowledged (committed) only once it has been
+// processed, also when it ran on a dispatcher worker. A crash loses nothing; what was received and
+// not committed is redelivered (at least once).
+// Poll mode: Start() takes up to batchSize messages, or what arrives within batchTimeMs after the
+// first one, processes them (in parallel across shards when a dispatcher is set) and commits them
+// together once every one of them is done. If processing throws, the batch is rolled back and the
+// broker redelivers it. batchSize 1 commits message by message.
+// Push mode ("mode": "push"): no receive loop. The listener registers itself as the consumer's
+// cms::MessageListener and the client's session thread hands each message to onMessage, which
+// processes it (waiting for its shard worker) and commits it, or rolls it back when it fails. The next
+// message comes only after onMessage returns, so push mode is serial across all keys: use it for
+// low-volume queues, batched poll mode for parallel ones.
+// Start() just waits for Stop(), so an idle listener never wakes up and Stop() returns it at once.
 //
-#ifndef COMMON_QUEUE_MESSAGE_CONSUMER_HPP
-#define COMMON_QUEUE_MESSAGE_CONSUMER_HPP
+#ifndef CONSUMER_QUEUE_MESSAGE_LISTENER_HPP
+#define CONSUMER_QUEUE_MESSAGE_LISTENER_HPP
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <iostream>
+#include <vector>
 
 #include <cms/Session.h>
 #include <cms/Message.h>
 #include <cms/MessageConsumer.h>
+#include <cms/MessageListener.h>
 #include <cms/TextMessage.h>
+#include <cms/BytesMessage.h>
 #include <cms/Queue.h>
 #include <cms/CMSException.h>
+#include <nlohmann/json.hpp>
 
 #include "cms/ConnectionManager.hpp"
+#include "cms/ShardedDispatcher.hpp"
+#include "event/EventCodec.hpp"
+#include "persistence/repository/IdentityMap.hpp"
 
-class QueueMessageListener {
+// How a listener takes messages off its queue ("consumer.listeners.<queue>" in configuration.json).
+struct ReceiveSettings {
+    // Messages per transaction; 1 commits each message once it is processed.
+    std::size_t batchSize = 1;
+    // How long a batch waits for more messages after its first one.
+    std::chrono::milliseconds batchTime{50};
+    // Messages the broker pushes ahead to this consumer; 0 keeps the broker default.
+    int prefetch = 0;
+    // Delivery through onMessage instead of receive(); one message per transaction, batchSize does not apply.
+    bool push = false;
+};
+
+inline void from_json(const nlohmann::json& json, ReceiveSettings& settings) {
+    settings.batchSize = std::max<std::size_t>(1, json.value("batchSize", settings.batchSize));
+    settings.batchTime = std::chrono::milliseconds{std::max(0, json.value("batchTimeMs", static_cast<int>(settings.batchTime.count())))};
+    settings.prefetch  = std::max(0, json.value("prefetch", settings.prefetch));
+    settings.push      = json.value("mode", std::string(settings.push ? "push" : "poll")) == "push";
+}
+
+class QueueMessageListener : private cms::MessageListener {
     std::shared_ptr<ConnectionManager> connectionManager;
     std::atomic<bool> running{false};
     // Note: Start() is blocking by design; we do not use an internal worker thread.
+    // Dispatched tasks point to this listener: stop the dispatcher before destroying it.
     std::shared_ptr<cms::Session> session;
     std::shared_ptr<cms::MessageConsumer> messageConsumer;
+    // Guards running/messageConsumer between Start() and Stop(); stopped wakes a push-mode Start().
+    std::mutex stateMutex;
+    std::condition_variable stopped;
+    // Optional: when set, messages with a shard key run on its workers instead of the receive thread.
+    std::shared_ptr<ShardedDispatcher> dispatcher;
+    ReceiveSettings receiveSettings;
+
+    // Identity map totals over every event (handle() runs on the workers too), logged once per period
+    // by the thread that commits: the receive loop, or the session thread in push mode.
+    static constexpr auto kStatisticsPeriod = std::chrono::minutes(1);
+    std::atomic<std::size_t> identityLoads{0};
+    std::atomic<std::size_t> identityHits{0};
+    std::size_t loggedLoads = 0;
+    std::size_t loggedHits = 0;
+    std::chrono::steady_clock::time_point nextStatistics = std::chrono::steady_clock::now() + kStatisticsPeriod;
 
     virtual void processMessage(const std::string& message) = 0;
 
+    // Messages with the same key are processed in order; empty means "run on the receive thread".
+    virtual std::string shardKey(const std::string&) { return {}; }
+
+    // Shared by the tasks of one processBatch call.
+    struct Batch {
+        std::mutex mutex;
+        std::condition_variable done;
+        std::size_t left = 0;
+        std::exception_ptr error;
+        // Work the messages handed on (AwaitBeforeCommit); waited for once every message is done.
+        std::vector<std::shared_future<void>> awaited;
+    };
+    // The batch whose message this thread is processing, if any.
+    static inline thread_local Batch* currentBatch = nullptr;
+
+    void handle(const std::string& message);
+    void handleIn(Batch& batch, const std::string& message);
+    void receiveBatch();
+    // Push mode: called by the client's session thread.
+    void onMessage(const cms::Message* message) override;
+    void closeResources();
+    void logStatistics();
+
+protected:
+    // Runs a whole batch and returns once every message is processed; throws when one failed.
+    void processBatch(const std::vector<std::string>& messages);
+
+    // From processMessage: the batch is committed only after done completes, and rolled back if it
+    // throws. No-op outside processBatch.
+    static void AwaitBeforeCommit(std::shared_future<void> done);
+
+    // "tournamentId" of a JSON or binary event, or empty when the message has none.
+    static std::string TournamentIdOf(const std::string& message);
+
+    // Text of a TextMessage, or the bytes of a BytesMessage in a known event encoding
+    // (event/EventCodec.hpp); nullopt for anything else.
+    static std::optional<std::string> BodyOf(const cms::Message* message);
+
 public:
     explicit QueueMessageListener(const std::shared_ptr<ConnectionManager>& connectionManager)
         : connectionManager(connectionManager) {}
 
-    virtual ~QueueMessageListener() = default;
+    ~QueueMessageListener() override = default;
+
+    void UseDispatcher(std::shared_ptr<ShardedDispatcher> shardedDispatcher) { dispatcher = std::move(shardedDispatcher); }
+    // Call before Start().
+    void UseReceiveSettings(const ReceiveSettings& settings) { receiveSettings = settings; }
 
     void Start(const std::string_view& queueName);
     void Stop();
 };
 
 inline void QueueMessageListener::Start(const std::string_view& queueName) {
-    if (running) return;
-    running = true;
+    {
+        std::lock_guard lock(stateMutex);
+        if (running) return;
+        running = true;
+    }
 
     try {
-        session = connectionManager->CreateSession();
+        session = connectionManager->CreateSession(cms::Session::SESSION_TRANSACTED);
 
-        auto destination = std::unique_ptr<cms::Queue>(
-            session->createQueue(std::string(queueName).c_str())
-        );
-        // Keep the consumer as a member so Stop() can close it.
-        messageConsumer.reset(session->createConsumer(destination.get()));
+        // Prefetch is a consumer option of the destination URI.
+        std::string destinationName(queueName);
+        if (receiveSettings.prefetch > 0) {
+            destinationName += "?consumer.prefetchSize=" + std::to_string(receiveSettings.prefetch);
+        }
+        auto destination = std::unique_ptr<cms::Queue>(session->createQueue(destinationName));
+        {
+            // Keep the consumer as a member so Stop() can close it.
+            std::lock_guard lock(stateMutex);
+            messageConsumer.reset(session->createConsumer(destination.get()));
+        }
 
+        if (receiveSettings.push) {
+            messageConsumer->setMessageListener(this);
+            std::unique_lock lock(stateMutex);
+            stopped.wait(lock, [this] { return !running; });
+        }
         while (running) {
-            std::unique_ptr<cms::Message> message(messageConsumer->receive(1500));
-            if (!message) continue;
-
-            if (auto text = dynamic_cast<cms::TextMessage*>(message.get())) {
-                processMessage(text->getText());
-            }
-            // If needed, handle other message types here.
+            receiveBatch();
         }
     } catch (const cms::CMSException& e) {
-        std::cerr << "[QueueMessageListener] CMSException: " << e.getMessage() << std::endl;
-        running = false;
+        // Stop() closing the consumer under a blocked receive is not an error.
+        if (running) std::cerr << "[QueueMessageListener] CMSException: " << e.getMessage() << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "[QueueMessageListener] std::exception: " << e.what() << std::endl;
-        running = false;
     } catch (...) {
         std::cerr << "[QueueMessageListener] unknown exception\n";
-        running = false;
     }
+    running = false;
+    closeResources();
 }
 
+inline void QueueMessageListener::onMessage(const cms::Message* message) {
+    // Nothing may escape into the client's thread. Committed once processed; a failure rolls it back.
+    try {
+        std::vector<std::string> batch;
+        if (auto body = BodyOf(message)) {
+            batch.push_back(std::move(*body));
+        }
+        try {
+            processBatch(batch);
+        } catch (const std::exception& e) {
+            std::cerr << "[QueueMessageListener] message rolled back: " << e.what() << std::endl;
+            session->rollback();
+            return;
+        }
+        session->commit();
+        logStatistics();
+    } catch (const cms::CMSException& e) {
+        std::cerr << "[QueueMessageListener] CMSException: " << e.getMessage() << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "[QueueMessageListener] message failed: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "[QueueMessageListener] message failed\n";
+    }
+}
+
+inline void QueueMessageListener::receiveBatch() {
+    std::unique_ptr<cms::Message> first(messageConsumer->receive(1500));
+    if (!first) return;
+
+    std::vector<std::string> batch;
+    batch.reserve(receiveSettings.batchSize);
+    std::size_t received = 0;
+    auto take = [&](const cms::Message* message) {
+        ++received;
+        if (auto body = BodyOf(message)) {
+            batch.push_back(std::move(*body));
+        }
+    };
+    take(first.get());
+
+    const auto deadline = std::chrono::steady_clock::now() + receiveSettings.batchTime;
+    while (received < receiveSettings.batchSize) {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        std::unique_ptr<cms::Message> next(left.count() > 0 ? messageConsumer->receive(static_cast<int>(left.count()))
+                                                            : messageConsumer->receiveNoWait());
+        if (!next) break;
+        take(next.get());
+    }
+
+    try {
+        processBatch(batch);
+        session->commit();
+    } catch (const cms::CMSException&) {
+        throw;
+    } catch (const std::exception& e) {
+        std::cerr << "[QueueMessageListener] batch of " << received << " rolled back: " << e.what() << std::endl;
+        session->rollback();
+    }
+    logStatistics();
+}
+
+inline void QueueMessageListener::processBatch(const std::vector<std::string>& messages) {
+    Batch batch;
+
+    auto finish = [&batch](std::exception_ptr error) {
+        std::lock_guard lock(batch.mutex);
+        if (error && !batch.error) batch.error = error;
+        if (--batch.left == 0) batch.done.notify_all();
+    };
+
+    for (const auto& message : messages) {
+        const std::string key = dispatcher ? shardKey(message) : std::string{};
+        if (key.empty()) {
+            // Still wait for what was dispatched before reporting a failure.
+            try {
+                handleIn(batch, message);
+            } catch (...) {
+                std::lock_guard lock(batch.mutex);
+                if (!batch.error) batch.error = std::current_exception();
+            }
+            continue;
+        }
+        {
+            std::lock_guard lock(batch.mutex);
+            ++batch.left;
+        }
+        const bool queued = dispatcher->Dispatch(key, [this, &batch, &message, &finish] {
+            try {
+                handleIn(batch, message);
+                finish(nullptr);
+            } catch (...) {
+                finish(std::current_exception());
+            }
+        });
+        if (!queued) {
+            finish(std::make_exception_ptr(std::runtime_error("dispatcher stopped")));
+        }
+    }
+
+    std::unique_lock lock(batch.mutex);
+    batch.done.wait(lock, [&batch] { return batch.left == 0; });
+    // Here, not on a worker: the awaited work may need the worker's shard.
+    for (auto& awaited : batch.awaited) {
+        try {
+            awaited.get();
+        } catch (...) {
+            if (!batch.error) batch.error = std::current_exception();
+        }
+    }
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+inline void QueueMessageListener::handleIn(Batch& batch, const std::string& message) {
+    struct Current {
+        explicit Current(Batch* batch) { currentBatch = batch; }
+        ~Current() { currentBatch = nullptr; }
+    } current(&batch);
+    handle(message);
+}
+
+inline void QueueMessageListener::AwaitBeforeCommit(std::shared_future<void> done) {
+    if (!currentBatch) return;
+    std::lock_guard lock(currentBatch->mutex);
+    currentBatch->awaited.push_back(std::move(done));
+}
+
+inline void QueueMessageListener::handle(const std::string& message) {
+    // One identity map per event: repeated lookups inside it don't go back to the database.
+    IdentityMap identityMap;
+    processMessage(message);
+    const auto& stats = identityMap.Statistics();
+    identityLoads.fetch_add(stats.loads, std::memory_order_relaxed);
+    identityHits.fetch_add(stats.hits, std::memory_order_relaxed);
+}
+
+// One line per period, only when events used the identity map.
+inline void QueueMessageListener::logStatistics() {
+    const auto now = std::chrono::steady_clock::now();
+    if (now < nextStatistics) return;
+    nextStatistics = now + kStatisticsPeriod;
+
+    const std::size_t loads = identityLoads.load(std::memory_order_relaxed);
+    const std::size_t hits = identityHits.load(std::memory_order_relaxed);
+    if (loads == loggedLoads && hits == loggedHits) return;
+    std::cout << "[QueueMessageListener] identity map: loads=" << loads << " saved=" << hits << std::endl;
+    loggedLoads = loads;
+    loggedHits = hits;
+}
+
+inline std::string QueueMessageListener::TournamentIdOf(const std::string& message) {
+    if (event_codec::IsBinary(message)) {
+        const auto tournamentId = event_codec::TournamentIdOf(message);
+        return tournamentId ? event_codec::FormatUuid(*tournamentId) : std::string{};
+    }
+    const auto json = nlohmann::json::parse(message, nullptr, false);
+    if (json.is_object() && json.contains("tournamentId") && json["tournamentId"].is_string()) {
+        return json["tournamentId"].get<std::string>();
+    }
+    return {};
+}
+
+inline std::optional<std::string> QueueMessageListener::BodyOf(const cms::Message* message) {
+    if (auto text = dynamic_cast<const cms::TextMessage*>(message)) {
+        return text->getText();
+    }
+    if (auto bytes = dynamic_cast<const cms::BytesMessage*>(message)) {
+        const std::string property(event_codec::EncodingProperty);
+        if (bytes->propertyExists(property) && bytes->getStringProperty(property) == event_codec::BinaryV1) {
+            // getBodyBytes() returns a copy the caller owns.
+            const std::unique_ptr<unsigned char[]> data(bytes->getBodyBytes());
+            if (!data) return std::string{};
+            return std::string(reinterpret_cast<const char*>(data.get()), static_cast<std::size_t>(bytes->getBodyLength()));
+        }
+    }
+    std::cerr << "[QueueMessageListener] unsupported message type or encoding, skipped\n";
+    return std::nullopt;
+}
+
+// Returns Start() right away in push mode (closing the consumer waits for an onMessage in progress)
+// and within one receive otherwise; a blocked receive is woken by the close.
 inline void QueueMessageListener::Stop() {
-    running = false;
+    {
+        std::lock_guard lock(stateMutex);
+        running = false;
+        if (messageConsumer) {
+            try { messageConsumer->close(); } catch (...) {}
+        }
+    }
+    stopped.notify_all();
+}
 
-    // Close resources defensively; CMS allows closing in any order.
+// Start()'s thread only, once it no longer uses them. CMS allows closing twice.
+inline void QueueMessageListener::closeResources() {
+    std::lock_guard lock(stateMutex);
     try {
         if (messageConsumer) {
             try { messageConsumer->close(); } catch (...) {}
@@ -89,4 +396,4 @@ inline void QueueMessageListener::Stop() {
     }
 }
 
-#endif // COMMON_QUEUE_MESSAGE_CONSUMER_HPP
+#endif // CONSUMER_QUEUE_MESSAGE_LISTENER_HPP
@@ -0,0 +1,224 @@
+//
+// ScoreEventCoalescer.hpp
+// ProcessScoreUpdate does not depend on which match changed: it reloads the tournament and, once the
+// groups are done, rebuilds the bracket. So for each tournament the coalescer keeps at most one
+// evaluation waiting. The first score event schedules it `window` later. The events that arrive
+// before it starts are absorbed into it. An event that arrives while it runs schedules exactly one
+// follow-up. Evaluations go to the executor (the ShardedDispatcher), so they still run in the
+// tournament's order.
+// A caller that waits for the future before taking more events (the score listener holds its batch
+// commit) only merges what it already handed over: run it with a window of 0.
+// Submit() never waits; it returns a future that is ready once the evaluation covering the event has
+// run, so the caller can hold its acknowledgement until then. Only the coalescer's timer thread calls
+// the executor, so a worker that submits cannot block on its own full shard.
+//
+
+#ifndef CONSUMER_SCOREEVENTCOALESCER_HPP
+#define CONSUMER_SCOREEVENTCOALESCER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class ScoreEventCoalescer {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Task = std::function<void()>;
+    // Runs task for key (in key order); false when it was not accepted.
+    using Executor = std::function<bool(const std::string& key, Task task)>;
+
+    struct Stats {
+        std::uint64_t received = 0;
+        std::uint64_t evaluations = 0;
+        // Events absorbed by an evaluation that was already waiting: received - coalesced = evaluations
+        // (plus the ones still waiting).
+        std::uint64_t coalesced = 0;
+    };
+
+    ScoreEventCoalescer(std::chrono::milliseconds window, Executor executor)
+        : window(window), executor(std::move(executor)) {
+        timer = std::thread([this] { run(); });
+    }
+
+    ~ScoreEventCoalescer() { Stop(); }
+
+    ScoreEventCoalescer(const ScoreEventCoalescer&) = delete;
+    ScoreEventCoalescer& operator=(const ScoreEventCoalescer&) = delete;
+
+    // evaluation: what to run for key; only the first one submitted while none is waiting is kept.
+    // The future completes with that evaluation, or holds what it threw.
+    std::shared_future<void> Submit(const std::string& key, Task evaluation) {
+        received.fetch_add(1, std::memory_order_relaxed);
+        std::shared_future<void> finished;
+        {
+            std::lock_guard lock(mutex);
+            if (stopping) {
+                // Late event during shutdown: nothing left to batch it with.
+                evaluations.fetch_add(1, std::memory_order_relaxed);
+                std::promise<void> done;
+                try {
+                    evaluation();
+                    done.set_value();
+                } catch (...) {
+                    done.set_exception(std::current_exception());
+                }
+                return done.get_future().share();
+            }
+            auto [it, added] = waiting.try_emplace(key);
+            if (!added) {
+                coalesced.fetch_add(1, std::memory_order_relaxed);
+                return it->second.finished;
+            }
+            it->second.due = Clock::now() + window;
+            it->second.evaluation = std::move(evaluation);
+            it->second.done = std::make_shared<std::promise<void>>();
+            it->second.finished = it->second.done->get_future().share();
+            finished = it->second.finished;
+        }
+        wake.notify_one();
+        return finished;
+    }
+
+    // Hands what is still waiting to the executor right away and stops the timer. Idempotent.
+    void Stop() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        if (timer.joinable()) {
+            timer.join();
+        }
+    }
+
+    [[nodiscard]] Stats Statistics() const {
+        return {received.load(std::memory_order_relaxed), evaluations.load(std::memory_order_relaxed),
+                coalesced.load(std::memory_order_relaxed)};
+    }
+
+private:
+    struct Waiting {
+        Clock::time_point due;
+        Task evaluation;
+        // Shared by every event the evaluation absorbs.
+        std::shared_ptr<std::promise<void>> done;
+        std::shared_future<void> finished;
+        bool dispatched = false;
+    };
+
+    static constexpr auto kStatisticsPeriod = std::chrono::minutes(1);
+
+    const std::chrono::milliseconds window;
+    Executor executor;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    // Tournaments with an evaluation not started yet.
+    std::unordered_map<std::string, Waiting> waiting;
+    bool stopping = false;
+    std::thread timer;
+
+    std::atomic<std::uint64_t> received{0};
+    std::atomic<std::uint64_t> evaluations{0};
+    std::atomic<std::uint64_t> coalesced{0};
+
+    void run() {
+        Stats last;
+        auto nextStatistics = Clock::now() + kStatisticsPeriod;
+        std::unique_lock lock(mutex);
+        while (true) {
+            auto next = nextStatistics;
+            std::vector<std::string> due;
+            const auto now = Clock::now();
+            for (const auto& [key, entry] : waiting) {
+                if (entry.dispatched) continue;
+                if (stopping || entry.due <= now) {
+                    due.push_back(key);
+                } else if (entry.due < next) {
+                    next = entry.due;
+                }
+            }
+
+            if (!due.empty()) {
+                for (const auto& key : due) {
+                    waiting[key].dispatched = true;
+                }
+                lock.unlock();
+                for (const auto& key : due) {
+                    dispatch(key);
+                }
+                lock.lock();
+                continue;
+            }
+            if (stopping) {
+                return;
+            }
+            if (now >= nextStatistics) {
+                lock.unlock();
+                logStatistics(last);
+                lock.lock();
+                nextStatistics = Clock::now() + kStatisticsPeriod;
+                continue;
+            }
+            wake.wait_until(lock, next);
+        }
+    }
+
+    void dispatch(const std::string& key) {
+        // Once the evaluation starts, new events for the key wait for a new one.
+        auto start = [this, key] {
+            Task evaluation;
+            std::shared_ptr<std::promise<void>> done;
+            {
+                std::lock_guard lock(mutex);
+                auto it = waiting.find(key);
+                if (it == waiting.end()) return;
+                evaluation = std::move(it->second.evaluation);
+                done = std::move(it->second.done);
+                waiting.erase(it);
+            }
+            evaluations.fetch_add(1, std::memory_order_relaxed);
+            try {
+                evaluation();
+                done->set_value();
+            } catch (...) {
+                done->set_exception(std::current_exception());
+            }
+        };
+        bool accepted = false;
+        try {
+            accepted = executor(key, start);
+        } catch (const std::exception& e) {
+            std::cerr << "[ScoreEventCoalescer] executor failed: " << e.what() << std::endl;
+        }
+        if (!accepted) {
+            // Executor gone (shutdown): run here rather than lose the evaluation.
+            start();
+        }
+    }
+
+    // One line per period, only when events arrived.
+    void logStatistics(Stats& last) {
+        const auto now = Statistics();
+        if (now.received == last.received) {
+            return;
+        }
+        std::cout << "[ScoreEventCoalescer] received=" << now.received << " evaluations=" << now.evaluations
+                  << " coalesced=" << now.coalesced << std::endl;
+        last = now;
+    }
+};
+
+#endif // CONSUMER_SCOREEVENTCOALESCER_HPP
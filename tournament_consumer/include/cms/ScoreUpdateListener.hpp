@@ -5,18 +5,30 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include "QueueMessageListener.hpp"
+#include "ScoreEventCoalescer.hpp"
 #include "delegate/MatchDelegate.hpp"
+#include "event/EventCodec.hpp"
 #include "event/ScoreUpdateEvent.hpp"
 
 class ScoreUpdateListener : public QueueMessageListener {
     std::shared_ptr<MatchDelegate> matchDelegate;
+    // Optional: collapses the score events of a tournament into fewer evaluations.
+    std::shared_ptr<ScoreEventCoalescer> coalescer;
+
+    void evaluate(const ScoreUpdateEvent& event);
 
 
 public:
+    static constexpr std::string_view Queue = "match.score-recorded";
+
     void processMessage(const std::string& message) override;
+    // Events of one tournament stay in order on the dispatcher.
+    std::string shardKey(const std::string& message) override { return TournamentIdOf(message); }
     ScoreUpdateListener(const std::shared_ptr<ConnectionManager>& connectionManager,
                         const std::shared_ptr<MatchDelegate>& matchDelegate);
     ~ScoreUpdateListener() override;
+
+    void UseCoalescer(std::shared_ptr<ScoreEventCoalescer> scoreEventCoalescer) { coalescer = std::move(scoreEventCoalescer); }
 };
 
 inline ScoreUpdateListener::ScoreUpdateListener(
@@ -31,26 +43,60 @@ inline ScoreUpdateListener::~ScoreUpdateListener() {
     Stop();
 }
 
+// A malformed event is logged and dropped; a failure while processing it is rethrown, so the
+// listener rolls it back and the broker redelivers it.
 inline void ScoreUpdateListener::processMessage(const std::string& message) {
-    std::cout << "[ScoreUpdateListener] Received message: " << message << std::endl;
+    ScoreUpdateEvent event;
     try {
-        auto json = nlohmann::json::parse(message);
-        if (!json.contains("tournamentId") || !json.contains("matchId")) {
-            std::cout << "[ScoreUpdateListener] Missing fields\n";
-            return;
+        if (event_codec::IsBinary(message)) {
+            event_codec::ScoreUpdateView view;
+            if (!event_codec::Decode(message, view)) {
+                std::cout << "[ScoreUpdateListener] Not a score event\n";
+                return;
+            }
+            event = event_codec::ToEvent(view);
+            std::cout << "[ScoreUpdateListener] Received score of match " << event.matchId << std::endl;
+        } else {
+            std::cout << "[ScoreUpdateListener] Received message: " << message << std::endl;
+            auto json = nlohmann::json::parse(message);
+            if (!json.contains("tournamentId") || !json.contains("matchId")) {
+                std::cout << "[ScoreUpdateListener] Missing fields\n";
+                return;
+            }
+            event = ScoreUpdateEvent{json.at("tournamentId").get<std::string>(), json.at("matchId").get<std::string>()};
         }
-        const std::string tournamentId = json.at("tournamentId").get<std::string>();
-        const std::string matchId      = json.at("matchId").get<std::string>();
+    } catch (const std::exception& e) {
+        std::cout << "[ScoreUpdateListener] ERROR: malformed event, dropped: " << e.what() << std::endl;
+        return;
+    }
 
-        if (!matchDelegate) {
-            std::cout << "[ScoreUpdateListener] ERROR: matchDelegate is null!\n";
-            return;
+    if (!matchDelegate) {
+        std::cout << "[ScoreUpdateListener] ERROR: matchDelegate is null!\n";
+        return;
+    }
+    try {
+        if (coalescer) {
+            // The batch commits once the evaluation covering this event has run.
+            AwaitBeforeCommit(coalescer->Submit(event.tournamentId, [this, event] { evaluate(event); }));
+        } else {
+            matchDelegate->ProcessScoreUpdate(event);
         }
-        matchDelegate->ProcessScoreUpdate(ScoreUpdateEvent{tournamentId, matchId});
     } catch (const std::exception& e) {
         std::cout << "[ScoreUpdateListener] ERROR processing message: " << e.what() << std::endl;
+        throw;
     }
 }
 
+// A coalesced evaluation, run later on the dispatcher with its own identity map. A failure reaches
+// the batches waiting for it, which roll back.
+inline void ScoreUpdateListener::evaluate(const ScoreUpdateEvent& event) {
+    try {
+        IdentityMap identityMap;
+        matchDelegate->ProcessScoreUpdate(event);
+    } catch (const std::exception& e) {
+        std::cout << "[ScoreUpdateListener] ERROR evaluating " << event.tournamentId << ": " << e.what() << std::endl;
+        throw;
+    }
+}
 
 #endif // LISTENER_SCOREUPDATE_LISTENER_HPP
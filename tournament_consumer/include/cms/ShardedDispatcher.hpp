@@ -0,0 +1,127 @@
+//
+// ShardedDispatcher.hpp
+// Runs the work of the listeners on a fixed set of worker threads. Each task has a key (the
+// tournamentId) and every key always lands on the same shard, so the events of one tournament are
+// processed one at a time and in arrival order, while other tournaments go on in parallel.
+// Each shard has a bounded queue: Dispatch() blocks while it is full, which stops the receive loop
+// from taking more messages off the broker (backpressure).
+//
+
+#ifndef CONSUMER_SHARDEDDISPATCHER_HPP
+#define CONSUMER_SHARDEDDISPATCHER_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+struct ShardedDispatcherSettings {
+    std::size_t workers = 4;
+    // Tasks waiting per shard before Dispatch() blocks.
+    std::size_t queueCapacity = 64;
+};
+
+class ShardedDispatcher {
+public:
+    using Task = std::function<void()>;
+
+    explicit ShardedDispatcher(ShardedDispatcherSettings settings = {})
+        : capacity(std::max<std::size_t>(1, settings.queueCapacity)) {
+        const auto workers = std::max<std::size_t>(1, settings.workers);
+        shards.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) {
+            shards.push_back(std::make_unique<Shard>());
+        }
+        for (auto& shard : shards) {
+            shard->worker = std::thread([this, s = shard.get()] { run(*s); });
+        }
+    }
+
+    ~ShardedDispatcher() { Stop(); }
+
+    ShardedDispatcher(const ShardedDispatcher&) = delete;
+    ShardedDispatcher& operator=(const ShardedDispatcher&) = delete;
+
+    [[nodiscard]] std::size_t Workers() const { return shards.size(); }
+
+    [[nodiscard]] std::size_t ShardOf(std::string_view key) const {
+        return std::hash<std::string_view>{}(key) % shards.size();
+    }
+
+    // Queues task behind the earlier tasks of the same key; waits while that shard is full.
+    // False when the dispatcher is stopping (the task is dropped).
+    bool Dispatch(std::string_view key, Task task) {
+        auto& shard = *shards[ShardOf(key)];
+        std::unique_lock lock(shard.mutex);
+        shard.notFull.wait(lock, [&] { return shard.stopping || shard.tasks.size() < capacity; });
+        if (shard.stopping) {
+            return false;
+        }
+        shard.tasks.push_back(std::move(task));
+        shard.notEmpty.notify_one();
+        return true;
+    }
+
+    // Lets the workers finish what is already queued, then joins them. Idempotent.
+    void Stop() {
+        for (auto& shard : shards) {
+            {
+                std::lock_guard lock(shard->mutex);
+                shard->stopping = true;
+            }
+            shard->notEmpty.notify_all();
+            shard->notFull.notify_all();
+        }
+        for (auto& shard : shards) {
+            if (shard->worker.joinable()) {
+                shard->worker.join();
+            }
+        }
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::condition_variable notEmpty;
+        std::condition_variable notFull;
+        std::deque<Task> tasks;
+        bool stopping = false;
+        std::thread worker;
+    };
+
+    void run(Shard& shard) {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock lock(shard.mutex);
+                shard.notEmpty.wait(lock, [&] { return shard.stopping || !shard.tasks.empty(); });
+                if (shard.tasks.empty()) {
+                    return;
+                }
+                task = std::move(shard.tasks.front());
+                shard.tasks.pop_front();
+            }
+            shard.notFull.notify_one();
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "[ShardedDispatcher] task failed: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "[ShardedDispatcher] task failed\n";
+            }
+        }
+    }
+
+    const std::size_t capacity;
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+#endif // CONSUMER_SHARDEDDISPATCHER_HPP
@@ -0,0 +1,31 @@
+#ifndef CONSUMER_CONFIGURATION_HPP
+#define CONSUMER_CONFIGURATION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <nlohmann/json.hpp>
+
+namespace config {
+    // "consumer" object of configuration.json.
+    struct ConsumerConfiguration {
+        // Worker threads of the ShardedDispatcher; events of one tournament always go to the same one.
+        // Keep it at or below databaseConfig.poolMax or the workers wait for connections.
+        std::size_t workers = 4;
+        // Events queued per worker before the receive loops stop taking messages from the broker.
+        std::size_t shardQueueCapacity = 64;
+        // Score events of one tournament arriving within this window share one evaluation; 0 merges
+        // the events that reach the shard while an evaluation is waiting on it. The score listener
+        // commits a batch only after its evaluations, so no later batch can join one: a window only
+        // delays every commit.
+        int scoreCoalesceWindowMs = 0;
+    };
+
+    inline void from_json(const nlohmann::json& json, ConsumerConfiguration& consumerConfiguration) {
+        consumerConfiguration.workers = std::max<std::size_t>(1, json.value("workers", consumerConfiguration.workers));
+        consumerConfiguration.shardQueueCapacity =
+            std::max<std::size_t>(1, json.value("shardQueueCapacity", consumerConfiguration.shardQueueCapacity));
+        consumerConfiguration.scoreCoalesceWindowMs =
+            std::max(0, json.value("scoreCoalesceWindowMs", consumerConfiguration.scoreCoalesceWindowMs));
+    }
+}
+#endif
@@ -10,19 +10,26 @@
 // DB & repos
 #include "persistence/configuration/IDbConnectionProvider.hpp"
 #include "persistence/configuration/PostgresConnectionProvider.hpp"
+#include "persistence/configuration/TournamentChangeListener.hpp"
 #include "persistence/repository/IRepository.hpp"
 #include "persistence/repository/TeamRepository.hpp"
 #include "persistence/repository/TournamentRepository.hpp"
+#include "persistence/repository/TournamentCache.hpp"
 #include "persistence/repository/IMatchRepository.hpp"
 #include "persistence/repository/MatchRepository.hpp"
 #include "persistence/repository/IGroupRepository.hpp"
 #include "persistence/repository/GroupRepository.hpp"
+#include "persistence/repository/IStandingsRepository.hpp"
+#include "persistence/repository/StandingsRepository.hpp"
 
 // Delegate
 #include "delegate/MatchDelegate.hpp"
 
 // MQ
+#include "configuration/ConsumerConfiguration.hpp"
 #include "cms/ConnectionManager.hpp"
+#include "cms/ShardedDispatcher.hpp"
+#include "cms/ScoreEventCoalescer.hpp"
 #include "cms/GroupAddTeamListener.hpp"
 #include "cms/ScoreUpdateListener.hpp"
 
@@ -40,12 +47,18 @@ inline std::shared_ptr<Hypodermic::Container> containerSetup() {
     }
 
     // Postgres provider (instance)
-    auto pg = std::make_shared<PostgresConnectionProvider>(
-        configuration["databaseConfig"]["connectionString"].get<std::string>(),
-        configuration["databaseConfig"]["poolSize"].get<size_t>()
-    );
+    const auto dbConfig = configuration["databaseConfig"].get<config::DatabaseConfiguration>();
+    auto pg = std::make_shared<PostgresConnectionProvider>(dbConfig);
     builder.registerInstance(pg).as<IDbConnectionProvider>();
 
+    // Tournament cache (same as the services: LISTEN keeps it in step with every instance's writes)
+    auto tournamentCache = std::make_shared<TournamentCache>(
+        TournamentCacheSettings{dbConfig.tournamentCacheMaxEntries, dbConfig.tournamentCacheShards});
+    builder.registerInstance(tournamentCache);
+    if (tournamentCache->Enabled()) {
+        builder.registerInstance(std::make_shared<TournamentChangeListener>(dbConfig.connectionString, tournamentCache));
+    }
+
     // ActiveMQ connection
     const std::string brokerUrl = configuration["activemq"]["broker-url"].get<std::string>();
     builder.registerType<ConnectionManager>()
@@ -55,6 +68,29 @@ inline std::shared_ptr<Hypodermic::Container> containerSetup() {
         })
         .singleInstance();
 
+    // Workers shared by both queues: team additions and scores of one tournament never run at the same time.
+    const auto consumerJson = configuration.value("consumer", nlohmann::json::object());
+    const auto consumerConfig = consumerJson.get<config::ConsumerConfiguration>();
+    auto dispatcher = std::make_shared<ShardedDispatcher>(
+        ShardedDispatcherSettings{consumerConfig.workers, consumerConfig.shardQueueCapacity});
+    builder.registerInstance(dispatcher);
+
+    // Score events of a tournament close together share one bracket evaluation, run on the tournament's shard.
+    auto coalescer = std::make_shared<ScoreEventCoalescer>(
+        std::chrono::milliseconds{consumerConfig.scoreCoalesceWindowMs},
+        [dispatcher](const std::string& key, ScoreEventCoalescer::Task task) {
+            return dispatcher->Dispatch(key, std::move(task));
+        });
+    builder.registerInstance(coalescer);
+
+    // Batch size, batch time and prefetch per queue ("consumer.listeners.<queue>")
+    const auto listenersJson = consumerJson.value("listeners", nlohmann::json::object());
+    auto receiveSettings = [&listenersJson](std::string_view queue) {
+        return listenersJson.value(std::string(queue), nlohmann::json::object()).get<ReceiveSettings>();
+    };
+    const auto teamAddReceive = receiveSettings(GroupAddTeamListener::Queue);
+    const auto scoreReceive   = receiveSettings(ScoreUpdateListener::Queue);
+
     // Repositories
     builder.registerType<GroupRepository>()
         .as<IGroupRepository>()
@@ -64,9 +100,17 @@ inline std::shared_ptr<Hypodermic::Container> containerSetup() {
         .as<IMatchRepository>()
         .singleInstance();
 
+    builder.registerType<StandingsRepository>()
+        .as<IStandingsRepository>()
+        .singleInstance();
+
     // Regístralo como INTERFAZ y también como CONCRETO (para ctors que piden concreto)
     builder.registerType<TournamentRepository>()
         .as<IRepository<domain::Tournament, std::string>>()
+        .onActivated([tournamentCache](Hypodermic::ComponentContext&,
+                                       const std::shared_ptr<TournamentRepository>& repository) {
+            repository->UseCache(tournamentCache);
+        })
         .singleInstance();
 
     builder.registerType<TeamRepository>()
@@ -75,8 +119,21 @@ inline std::shared_ptr<Hypodermic::Container> containerSetup() {
 
     // Delegate y listeners (resolución por tipo concreto)
     builder.registerType<MatchDelegate>().singleInstance();
-    builder.registerType<GroupAddTeamListener>().singleInstance();
-    builder.registerType<ScoreUpdateListener>().singleInstance();
+    builder.registerType<GroupAddTeamListener>()
+        .onActivated([dispatcher, teamAddReceive](Hypodermic::ComponentContext&,
+                                                  const std::shared_ptr<GroupAddTeamListener>& listener) {
+            listener->UseDispatcher(dispatcher);
+            listener->UseReceiveSettings(teamAddReceive);
+        })
+        .singleInstance();
+    builder.registerType<ScoreUpdateListener>()
+        .onActivated([dispatcher, coalescer, scoreReceive](Hypodermic::ComponentContext&,
+                                                           const std::shared_ptr<ScoreUpdateListener>& listener) {
+            listener->UseDispatcher(dispatcher);
+            listener->UseCoalescer(coalescer);
+            listener->UseReceiveSettings(scoreReceive);
+        })
+        .singleInstance();
 
     return builder.build();
 }
@@ -13,6 +13,7 @@
 
 #include "persistence/repository/IMatchRepository.hpp"
 #include "persistence/repository/IGroupRepository.hpp"
+#include "persistence/repository/IStandingsRepository.hpp"
 #include "persistence/repository/TournamentRepository.hpp"
 
 #include "domain/Match.hpp"
@@ -22,6 +23,7 @@ class MatchDelegate {
     std::shared_ptr<IMatchRepository>     matchRepository;
     std::shared_ptr<IGroupRepository>     groupRepository;
     std::shared_ptr<TournamentRepository> tournamentRepository;
+    std::shared_ptr<IStandingsRepository> standingsRepository;
 
     static std::string RoundKey(std::string_view r) {
         if (r == rounds::GROUP) return "group";
@@ -35,43 +37,53 @@ class MatchDelegate {
 public:
     MatchDelegate(const std::shared_ptr<IMatchRepository>& matchRepository,
                   const std::shared_ptr<IGroupRepository>& groupRepository,
-                  const std::shared_ptr<TournamentRepository>& tournamentRepository)
+                  const std::shared_ptr<TournamentRepository>& tournamentRepository,
+                  const std::shared_ptr<IStandingsRepository>& standingsRepository)
         : matchRepository(matchRepository),
           groupRepository(groupRepository),
-          tournamentRepository(tournamentRepository) {}
+          tournamentRepository(tournamentRepository),
+          standingsRepository(standingsRepository) {}
 
     void ProcessTeamAddition(const TeamAddEvent& teamAddEvent) {
         std::cout << "[MatchDelegate/WC] Team added in tournament: "
                   << teamAddEvent.tournamentId << "\n";
 
-        if (auto grp = groupRepository->FindByTournamentIdAndGroupId(
-                teamAddEvent.tournamentId, teamAddEvent.groupId)) {
-            auto tRes = tournamentRepository->ReadById(teamAddEvent.tournamentId);
+        std::shared_ptr<domain::Group> grp;
+        std::shared_ptr<domain::Tournament> tRes;
+        std::vector<std::shared_ptr<domain::Group>> allGroups;
+        {
+            // Group, tournament and all groups in one round trip; reused below instead of re-reading.
+            ReadBatch batch;
+            auto groupRead      = groupRepository->DeferFindByTournamentIdAndGroupId(batch, teamAddEvent.tournamentId, teamAddEvent.groupId);
+            auto tournamentRead = tournamentRepository->DeferReadById(batch, teamAddEvent.tournamentId);
+            auto groupsRead     = groupRepository->DeferFindByTournamentId(batch, teamAddEvent.tournamentId);
+            grp       = groupRead.get();
+            tRes      = tournamentRead.get();
+            allGroups = std::move(groupsRead.get());
+        }
+
+        if (grp) {
             int expectedPerGroup = tRes ? tRes->Format().MaxTeamsPerGroup() : 0;
             std::cout << "[WC] Group " << grp->Name() << ": "
                       << grp->Teams().size() << "/" << expectedPerGroup
                       << " teams\n";
         }
 
-        {
-            auto allGroups = groupRepository->FindByTournamentId(teamAddEvent.tournamentId);
-            if (!allGroups.empty()) {
-                auto tRes = tournamentRepository->ReadById(teamAddEvent.tournamentId);
-                int expectedGroups   = tRes ? tRes->Format().NumberOfGroups()   : 0;
-                int expectedPerGroup = tRes ? tRes->Format().MaxTeamsPerGroup() : 0;
-
-                int complete = 0;
-                for (const auto& g : allGroups) {
-                    if (static_cast<int>(g->Teams().size()) == expectedPerGroup) complete++;
-                }
-                std::cout << "[WC] Progress: " << complete << "/" << expectedGroups
-                          << " groups complete\n";
+        if (!allGroups.empty()) {
+            int expectedGroups   = tRes ? tRes->Format().NumberOfGroups()   : 0;
+            int expectedPerGroup = tRes ? tRes->Format().MaxTeamsPerGroup() : 0;
+
+            int complete = 0;
+            for (const auto& g : allGroups) {
+                if (static_cast<int>(g->Teams().size()) == expectedPerGroup) complete++;
             }
+            std::cout << "[WC] Progress: " << complete << "/" << expectedGroups
+                      << " groups complete\n";
         }
 
-        if (IsTournamentReady(teamAddEvent.tournamentId)) {
+        if (IsTournamentReady(tRes, allGroups)) {
             std::cout << "[MatchDelegate/WC] All groups complete -> creating group-stage matches...\n";
-            CreateGroupStageMatches(teamAddEvent.tournamentId);
+            CreateGroupStageMatches(*tRes, allGroups);
         } else {
             std::cout << "[MatchDelegate/WC] Tournament not ready yet; waiting for more teams...\n";
         }
@@ -80,23 +92,41 @@ public:
     void ProcessScoreUpdate(const ScoreUpdateEvent& e) {
         std::cout << "[MatchDelegate/WC] Score update for tournament: " << e.tournamentId << "\n";
 
-        if (!AllGroupMatchesPlayed(e.tournamentId)) {
-            std::cout << "[MatchDelegate/WC] Still pending group matches...\n";
-            return;
+        std::shared_ptr<domain::Tournament> t;
+        std::vector<std::shared_ptr<domain::Group>> groups;
+        std::vector<std::shared_ptr<domain::Match>> all;
+        std::vector<domain::Standing> standings;
+        {
+            // Matches, tournament, groups and group tables go out together (one round trip); the bracket step reuses them.
+            ReadBatch batch;
+            auto matchesRead    = matchRepository->DeferFindByTournamentId(batch, e.tournamentId);
+            auto tournamentRead = tournamentRepository->DeferReadById(batch, e.tournamentId);
+            auto groupsRead     = groupRepository->DeferFindByTournamentId(batch, e.tournamentId);
+            auto standingsRead  = standingsRepository
+                ? standingsRepository->DeferFindByTournamentId(batch, e.tournamentId)
+                : Deferred<std::vector<domain::Standing>>::Ready({});
+
+            all = std::move(matchesRead.get());
+            if (!AllGroupMatchesPlayed(all)) {
+                std::cout << "[MatchDelegate/WC] Still pending group matches...\n";
+                return;
+            }
+            t         = tournamentRead.get();
+            groups    = std::move(groupsRead.get());
+            standings = std::move(standingsRead.get());
         }
 
-        CreateKnockoutMatches(e.tournamentId);
+        CreateKnockoutMatches(t, groups, all, standings);
     }
 
 private:
-    bool IsTournamentReady(const std::string& tournamentId) {
-        auto t = tournamentRepository->ReadById(tournamentId);
+    bool IsTournamentReady(const std::shared_ptr<domain::Tournament>& t,
+                           const std::vector<std::shared_ptr<domain::Group>>& groups) {
         if (!t) {
             std::cout << "[WC] Tournament not found\n";
             return false;
         }
 
-        auto groups = groupRepository->FindByTournamentId(tournamentId);
         const int expectedGroups = t->Format().NumberOfGroups();
         if (static_cast<int>(groups.size()) != expectedGroups) {
             std::cout << "[WC] Groups count mismatch. Have " << groups.size()
@@ -117,8 +147,7 @@ private:
     }
 
     // FIX: ignore string status; rely only on score presence
-    bool AllGroupMatchesPlayed(const std::string& tournamentId) {
-        auto all = matchRepository->FindByTournamentId(tournamentId);
+    static bool AllGroupMatchesPlayed(const std::vector<std::shared_ptr<domain::Match>>& all) {
         for (const auto& m : all) {
             if (!m) continue;
             if (m->Round() == rounds::GROUP && !m->HasScore())
@@ -127,43 +156,40 @@ private:
         return true;
     }
 
-    void CreateGroupStageMatches(const std::string& tournamentId) {
-        auto t = tournamentRepository->ReadById(tournamentId);
-        if (!t) {
-            std::cout << "[WC] ERROR: tournament not found\n";
-            return;
-        }
-
-        auto groups = groupRepository->FindByTournamentId(tournamentId);
-
+    void CreateGroupStageMatches(const domain::Tournament& t,
+                                 const std::vector<std::shared_ptr<domain::Group>>& groups) {
         WorldCupStrategy s;
-        auto createdOrErr = s.CreateRegularPhaseMatches(*t, groups);
+        auto createdOrErr = s.CreateRegularPhaseMatches(t, groups);
         if (!createdOrErr) {
             std::cout << "[WC] Strategy error: " << createdOrErr.error() << "\n";
             return;
         }
         const auto& created = createdOrErr.value();
 
-        int ok = 0;
-        for (const auto& m : created) {
-            const std::string id = matchRepository->Create(m);
-            if (!id.empty()) ok++;
-            else std::cout << "[WC] ERROR creating match\n";
+        // Whole fixture in a single statement/transaction instead of one Create() per match.
+        std::vector<std::string> ids;
+        try {
+            ids = matchRepository->CreateBatch(created);
+        } catch (const std::exception& e) {
+            // Rethrown so the listener rolls the event back and the broker redelivers it.
+            std::cout << "[WC] ERROR creating group matches: " << e.what() << "\n";
+            throw;
         }
+        const auto ok = std::count_if(ids.begin(), ids.end(), [](const std::string& id) { return !id.empty(); });
         std::cout << "[WC] Created " << ok << "/" << created.size()
                   << " group matches\n";
     }
 
-    void CreateKnockoutMatches(const std::string& tournamentId) {
-        auto t = tournamentRepository->ReadById(tournamentId);
+    // standings: rows of STANDINGS; empty (no table yet) falls back to recomputing from the group matches.
+    void CreateKnockoutMatches(const std::shared_ptr<domain::Tournament>& t,
+                               const std::vector<std::shared_ptr<domain::Group>>& groups,
+                               const std::vector<std::shared_ptr<domain::Match>>& all,
+                               const std::vector<domain::Standing>& standings) {
         if (!t) {
             std::cout << "[WC] ERROR: tournament not found\n";
             return;
         }
 
-        auto groups = groupRepository->FindByTournamentId(tournamentId);
-        auto all    = matchRepository->FindByTournamentId(tournamentId);
-
         auto makeKey = [&](const domain::Match& m) {
             const std::string r   = RoundKey(m.Round());
             const std::string hid = m.Home().Id();
@@ -187,7 +213,8 @@ private:
         }
 
         WorldCupStrategy s;
-        auto createdOrErr = s.CreatePlayoffMatches(*t, all, groups);
+        auto createdOrErr = standings.empty() ? s.CreatePlayoffMatches(*t, all, groups)
+                                              : s.CreatePlayoffMatches(*t, all, groups, standings);
         if (!createdOrErr) {
             std::cout << "[WC] Strategy error: " << createdOrErr.error() << "\n";
             return;
@@ -209,25 +236,14 @@ private:
             return;
         }
 
-        int inserted = 0, skipped = 0;
-        for (const auto& m : toCreate) {
-            // Prefer idempotent insert if your repo lo soporta; si no, usa Create(m)
-            std::string id;
-            try {
-                id = matchRepository->CreateIfNotExists(m);
-            } catch (...) {
-                id.clear();
-            }
-            if (id.empty()) {
-                try {
-                    id = matchRepository->Create(m);
-                } catch (...) {
-                    id.clear();
-                }
-            }
-            if (!id.empty()) inserted++; else skipped++;
+        // Idempotent batch: proposals that already exist keep their id, so a redelivered event is harmless.
+        std::vector<std::string> ids;
+        try {
+            ids = matchRepository->CreateBatch(toCreate);
+        } catch (const std::exception& e) {
+            std::cout << "[WC] ERROR creating knockout matches: " << e.what() << "\n";
+            throw;
         }
-
-        std::cout << "[WC] Created " << inserted << " knockout matches; " << skipped << " already existed\n";
+        std::cout << "[WC] Stored " << ids.size() << " knockout matches\n";
     }
 };
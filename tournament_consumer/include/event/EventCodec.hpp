@@ -0,0 +1,212 @@
+//
+// EventCodec.hpp
+// Binary wire format of TeamAddEvent and ScoreUpdateEvent, next to the JSON one.
+// Version 1 has a fixed layout: a 4-byte header followed by the ids as 16-byte UUIDs, in struct order.
+//   [0] 0x00 (a JSON text never starts with it)  [1] version  [2] kind  [3] 0
+//   TeamAdd:     tournamentId groupId teamId    (52 bytes)
+//   ScoreUpdate: tournamentId matchId           (36 bytes)
+// The tournamentId always comes first, so the shard key is read without knowing the kind.
+// Binary bodies travel as a BytesMessage whose EncodingProperty is BinaryV1; text messages stay
+// JSON. Consumers take both, so producers can switch over one by one. Decoding into the *View
+// structs allocates nothing. Ids are written back in lowercase canonical form.
+//
+
+#ifndef TOURNAMENTS_EVENTCODEC_HPP
+#define TOURNAMENTS_EVENTCODEC_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+#include "event/ScoreUpdateEvent.hpp"
+#include "event/TeamAddEvent.hpp"
+
+namespace event_codec {
+
+    // Message property telling the consumer how the body is encoded.
+    inline constexpr std::string_view EncodingProperty = "eventEncoding";
+    inline constexpr std::string_view BinaryV1 = "binary-v1";
+
+    inline constexpr std::uint8_t Version = 1;
+    enum class Kind : std::uint8_t { TeamAdd = 1, ScoreUpdate = 2 };
+
+    inline constexpr std::size_t HeaderSize = 4;
+    inline constexpr std::size_t UuidSize = 16;
+    inline constexpr std::size_t UuidTextSize = 36;
+
+    using Uuid = std::array<std::uint8_t, UuidSize>;
+
+    struct TeamAddView {
+        Uuid tournamentId;
+        Uuid groupId;
+        Uuid teamId;
+    };
+
+    struct ScoreUpdateView {
+        Uuid tournamentId;
+        Uuid matchId;
+    };
+
+    namespace detail {
+        inline int hexValue(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        inline constexpr std::size_t sizeOf(Kind kind) {
+            return HeaderSize + UuidSize * (kind == Kind::TeamAdd ? 3 : 2);
+        }
+
+        inline void writeHeader(std::string& out, Kind kind) {
+            out.push_back('\0');
+            out.push_back(static_cast<char>(Version));
+            out.push_back(static_cast<char>(kind));
+            out.push_back('\0');
+        }
+
+        inline void readUuid(std::string_view body, std::size_t offset, Uuid& out) {
+            for (std::size_t i = 0; i < UuidSize; ++i) {
+                out[i] = static_cast<std::uint8_t>(body[offset + i]);
+            }
+        }
+
+        // Header of a version-1 body of this kind, with the right length.
+        inline bool isBody(std::string_view body, Kind kind) {
+            return body.size() == sizeOf(kind) && body[0] == '\0' &&
+                   static_cast<std::uint8_t>(body[1]) == Version && static_cast<Kind>(body[2]) == kind;
+        }
+    }
+
+    // Canonical 8-4-4-4-12 hex form, either case.
+    inline bool ParseUuid(std::string_view text, Uuid& out) {
+        if (text.size() != UuidTextSize) return false;
+        std::size_t byte = 0;
+        for (std::size_t i = 0; i < UuidTextSize;) {
+            if (i == 8 || i == 13 || i == 18 || i == 23) {
+                if (text[i] != '-') return false;
+                ++i;
+                continue;
+            }
+            const int high = detail::hexValue(text[i]);
+            const int low = detail::hexValue(text[i + 1]);
+            if (high < 0 || low < 0) return false;
+            out[byte++] = static_cast<std::uint8_t>(high << 4 | low);
+            i += 2;
+        }
+        return true;
+    }
+
+    inline void FormatUuid(const Uuid& uuid, char* out) {
+        static constexpr char digits[] = "0123456789abcdef";
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < UuidSize; ++i) {
+            if (i == 4 || i == 6 || i == 8 || i == 10) out[pos++] = '-';
+            out[pos++] = digits[uuid[i] >> 4];
+            out[pos++] = digits[uuid[i] & 0x0f];
+        }
+    }
+
+    inline std::string FormatUuid(const Uuid& uuid) {
+        std::string text(UuidTextSize, '\0');
+        FormatUuid(uuid, text.data());
+        return text;
+    }
+
+    // Binary body (as opposed to JSON text) of any kind and version.
+    inline bool IsBinary(std::string_view body) {
+        return body.size() >= HeaderSize && body[0] == '\0';
+    }
+
+    // nullopt when an id is not a UUID: send that event as JSON.
+    inline std::optional<std::string> Encode(const TeamAddEvent& event) {
+        Uuid tournament, group, team;
+        if (!ParseUuid(event.tournamentId, tournament) || !ParseUuid(event.groupId, group) ||
+            !ParseUuid(event.teamId, team)) {
+            return std::nullopt;
+        }
+        std::string out;
+        out.reserve(detail::sizeOf(Kind::TeamAdd));
+        detail::writeHeader(out, Kind::TeamAdd);
+        for (const auto* uuid : {&tournament, &group, &team}) {
+            out.append(reinterpret_cast<const char*>(uuid->data()), UuidSize);
+        }
+        return out;
+    }
+
+    inline std::optional<std::string> Encode(const ScoreUpdateEvent& event) {
+        Uuid tournament, match;
+        if (!ParseUuid(event.tournamentId, tournament) || !ParseUuid(event.matchId, match)) {
+            return std::nullopt;
+        }
+        std::string out;
+        out.reserve(detail::sizeOf(Kind::ScoreUpdate));
+        detail::writeHeader(out, Kind::ScoreUpdate);
+        for (const auto* uuid : {&tournament, &match}) {
+            out.append(reinterpret_cast<const char*>(uuid->data()), UuidSize);
+        }
+        return out;
+    }
+
+    // False when body is not a version-1 body of that kind.
+    inline bool Decode(std::string_view body, TeamAddView& out) {
+        if (!detail::isBody(body, Kind::TeamAdd)) return false;
+        detail::readUuid(body, HeaderSize, out.tournamentId);
+        detail::readUuid(body, HeaderSize + UuidSize, out.groupId);
+        detail::readUuid(body, HeaderSize + 2 * UuidSize, out.teamId);
+        return true;
+    }
+
+    inline bool Decode(std::string_view body, ScoreUpdateView& out) {
+        if (!detail::isBody(body, Kind::ScoreUpdate)) return false;
+        detail::readUuid(body, HeaderSize, out.tournamentId);
+        detail::readUuid(body, HeaderSize + UuidSize, out.matchId);
+        return true;
+    }
+
+    inline TeamAddEvent ToEvent(const TeamAddView& view) {
+        return {FormatUuid(view.tournamentId), FormatUuid(view.groupId), FormatUuid(view.teamId)};
+    }
+
+    inline ScoreUpdateEvent ToEvent(const ScoreUpdateView& view) {
+        return {FormatUuid(view.tournamentId), FormatUuid(view.matchId)};
+    }
+
+    // tournamentId of a binary body of any kind; nullopt when it is not one.
+    inline std::optional<Uuid> TournamentIdOf(std::string_view body) {
+        if (!IsBinary(body) || static_cast<std::uint8_t>(body[1]) != Version ||
+            body.size() < HeaderSize + UuidSize) {
+            return std::nullopt;
+        }
+        Uuid tournament;
+        detail::readUuid(body, HeaderSize, tournament);
+        return tournament;
+    }
+
+    // Binary form of a JSON event ("type" tournament.team.added or match.score-recorded), for events
+    // stored as JSON before they are sent (the outbox). nullopt: unknown type or non-UUID ids.
+    inline std::optional<std::string> FromJson(std::string_view json) {
+        const auto parsed = nlohmann::json::parse(json, nullptr, false);
+        if (!parsed.is_object()) return std::nullopt;
+        const auto text = [&parsed](const char* key) {
+            const auto it = parsed.find(key);
+            return it != parsed.end() && it->is_string() ? it->get<std::string>() : std::string{};
+        };
+        const auto type = text("type");
+        if (type == "tournament.team.added") {
+            return Encode(TeamAddEvent{text("tournamentId"), text("groupId"), text("teamId")});
+        }
+        if (type == "match.score-recorded") {
+            return Encode(ScoreUpdateEvent{text("tournamentId"), text("matchId")});
+        }
+        return std::nullopt;
+    }
+}
+
+#endif //TOURNAMENTS_EVENTCODEC_HPP
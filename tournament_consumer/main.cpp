@@ -1,5 +1,7 @@
 // main.cpp
 #include <activemq/library/ActiveMQCPP.h>
+#include <csignal>
+#include <pthread.h>
 #include <thread>
 #include <iostream>
 
@@ -8,6 +10,14 @@
 #include "cms/ScoreUpdateListener.hpp"
 
 int main() {
+    // SIGINT/SIGTERM are taken by sigwait below, not by whichever thread they hit: block them before
+    // any thread (broker client included) is started, threads inherit the mask.
+    sigset_t shutdownSignals;
+    sigemptyset(&shutdownSignals);
+    sigaddset(&shutdownSignals, SIGINT);
+    sigaddset(&shutdownSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &shutdownSignals, nullptr);
+
     activemq::library::ActiveMQCPP::initializeLibrary();
     {
         std::cout << "Starting tournament consumer...\n";
@@ -15,16 +25,26 @@ int main() {
         std::cout << "Container initialized\n";
 
         auto teamAddListener  = container->resolve<GroupAddTeamListener>();
-        auto matchDelegate    = container->resolve<MatchDelegate>();
-        auto connectionMgr    = container->resolve<ConnectionManager>();
-        auto scoreListener    = std::make_shared<ScoreUpdateListener>(connectionMgr, matchDelegate);
+        auto scoreListener    = container->resolve<ScoreUpdateListener>();
+        auto dispatcher       = container->resolve<ShardedDispatcher>();
+        auto coalescer        = container->resolve<ScoreEventCoalescer>();
+        std::cout << "Dispatching on " << dispatcher->Workers() << " workers\n";
 
-        std::thread t1([l = teamAddListener]() { l->Start("tournament.team-add"); });
-        std::thread t2([l = scoreListener  ]() { l->Start("match.score-recorded"); });
+        std::thread t1([l = teamAddListener]() { l->Start(GroupAddTeamListener::Queue); });
+        std::thread t2([l = scoreListener  ]() { l->Start(ScoreUpdateListener::Queue); });
 
         std::cout << "Listener threads started\n";
+        int signal = 0;
+        sigwait(&shutdownSignals, &signal);
+        std::cout << "Signal " << signal << ", stopping listeners\n";
+        teamAddListener->Stop();
+        scoreListener->Stop();
         t1.join();
         t2.join();
+        // Receive loops are done: hand over the waiting evaluations, then let the workers drain
+        // before the listeners go away.
+        coalescer->Stop();
+        dispatcher->Stop();
     }
     activemq::library::ActiveMQCPP::shutdownLibrary();
     return 0;
@@ -8,6 +8,15 @@ class IQueueMessageProducer
 public:
     virtual ~IQueueMessageProducer() = default;
     virtual void SendMessage(const std::string_view& message, const std::string_view& queue) = 0;
+
+    // Returns once the broker has the message, even when SendMessage would only queue it; throws when
+    // it could not be sent. For callers that must know (the outbox relay marks what was sent).
+    virtual void SendMessageNow(const std::string_view& message, const std::string_view& queue) {
+        SendMessage(message, queue);
+    }
+
+    // Events may be sent in the binary encoding (event/EventCodec.hpp) instead of JSON.
+    virtual bool BinaryEvents() const { return false; }
 };
  
 
@@ -0,0 +1,193 @@
+//
+// OutboxRelay.hpp
+// Publishes the events the delegates wrote to the outbox (IOutboxRepository) from one background
+// thread per instance: it claims a batch of pending rows, sends each one over the producer and marks
+// the ones sent, all in one transaction. A full batch is followed by the next one right away; otherwise
+// the relay sleeps pollInterval. Rows claimed by another instance are skipped (SKIP LOCKED), so several
+// instances can run their relays on the same table.
+// Delivery is at least once: a relay that dies after sending but before committing leaves the rows
+// pending and they go out again. Published rows older than retentionHours are purged once an hour.
+//
+
+#ifndef SERVICE_OUTBOX_RELAY_HPP
+#define SERVICE_OUTBOX_RELAY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+#include "IQueueMessageProducer.hpp"
+#include "event/EventCodec.hpp"
+#include "persistence/repository/IOutboxRepository.hpp"
+
+struct OutboxRelaySettings {
+    // Off: the delegates publish directly, as before the outbox.
+    bool enabled = true;
+    // Most events claimed per transaction.
+    std::size_t batchSize = 100;
+    std::chrono::milliseconds pollInterval{100};
+    // Wait after a failed batch (broker or database down).
+    std::chrono::milliseconds retryBackoff{1000};
+    int retentionHours = 24;
+};
+
+// "outbox" object of the configuration.
+inline void from_json(const nlohmann::json& json, OutboxRelaySettings& settings) {
+    settings.enabled        = json.value("enabled", settings.enabled);
+    settings.batchSize      = std::max<std::size_t>(1, json.value("batchSize", settings.batchSize));
+    settings.pollInterval   = std::chrono::milliseconds{json.value("pollIntervalMs", static_cast<int>(settings.pollInterval.count()))};
+    settings.retryBackoff   = std::chrono::milliseconds{json.value("retryBackoffMs", static_cast<int>(settings.retryBackoff.count()))};
+    settings.retentionHours = std::max(1, json.value("retentionHours", settings.retentionHours));
+}
+
+class OutboxRelay {
+public:
+    struct Stats {
+        std::uint64_t published = 0;
+        std::uint64_t batches = 0;
+        std::uint64_t failures = 0;
+        std::uint64_t purged = 0;
+    };
+
+    OutboxRelay(const std::shared_ptr<IOutboxRepository>& outboxRepository,
+                const std::shared_ptr<IQueueMessageProducer>& messageProducer)
+        : outboxRepository(outboxRepository), messageProducer(messageProducer) {}
+
+    ~OutboxRelay() { Stop(); }
+
+    OutboxRelay(const OutboxRelay&) = delete;
+    OutboxRelay& operator=(const OutboxRelay&) = delete;
+
+    // Call before Start (DI .onActivated).
+    void Configure(const OutboxRelaySettings& relaySettings) { settings = relaySettings; }
+
+    void Start() {
+        if (!settings.enabled || relay.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard lock(mutex);
+            stopping = false;
+        }
+        relay = std::thread([this] { run(); });
+    }
+
+    // Finishes the batch in progress and stops the thread. Idempotent.
+    void Stop() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        if (relay.joinable()) {
+            relay.join();
+        }
+    }
+
+    // One batch on the calling thread. Returns how many events were published; rethrows the error that
+    // stopped the batch (the events before it are already marked).
+    std::size_t RunOnce() {
+        batches.fetch_add(1, std::memory_order_relaxed);
+        const bool binary = messageProducer->BinaryEvents();
+        const auto count = outboxRepository->PublishPending(settings.batchSize, [this, binary](const OutboxEvent& event) {
+            // Stored as JSON; re-encoded when the producer sends binary events.
+            if (binary) {
+                if (const auto body = event_codec::FromJson(event.payload)) {
+                    messageProducer->SendMessageNow(*body, event.queue);
+                    return;
+                }
+            }
+            messageProducer->SendMessageNow(event.payload, event.queue);
+        });
+        published.fetch_add(count, std::memory_order_relaxed);
+        return count;
+    }
+
+    [[nodiscard]] Stats Statistics() const {
+        return {published.load(std::memory_order_relaxed), batches.load(std::memory_order_relaxed),
+                failures.load(std::memory_order_relaxed), purged.load(std::memory_order_relaxed)};
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr auto kStatisticsPeriod = std::chrono::minutes(1);
+    static constexpr auto kPurgePeriod = std::chrono::hours(1);
+
+    std::shared_ptr<IOutboxRepository> outboxRepository;
+    std::shared_ptr<IQueueMessageProducer> messageProducer;
+    OutboxRelaySettings settings;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread relay;
+
+    std::atomic<std::uint64_t> published{0};
+    std::atomic<std::uint64_t> batches{0};
+    std::atomic<std::uint64_t> failures{0};
+    std::atomic<std::uint64_t> purged{0};
+
+    void run() {
+        Stats last;
+        auto nextStatistics = Clock::now() + kStatisticsPeriod;
+        auto nextPurge = Clock::now();
+        while (true) {
+            auto pause = settings.pollInterval;
+            try {
+                if (RunOnce() == settings.batchSize) {
+                    pause = std::chrono::milliseconds::zero();
+                }
+            } catch (const std::exception& e) {
+                failures.fetch_add(1, std::memory_order_relaxed);
+                std::cerr << "[OutboxRelay] batch failed: " << e.what() << std::endl;
+                pause = settings.retryBackoff;
+            }
+
+            const auto now = Clock::now();
+            if (now >= nextPurge) {
+                purge();
+                nextPurge = now + kPurgePeriod;
+            }
+            if (now >= nextStatistics) {
+                logStatistics(last);
+                nextStatistics = now + kStatisticsPeriod;
+            }
+
+            std::unique_lock lock(mutex);
+            if (wake.wait_for(lock, pause, [this] { return stopping; })) {
+                return;
+            }
+        }
+    }
+
+    void purge() {
+        try {
+            purged.fetch_add(outboxRepository->PurgePublished(settings.retentionHours), std::memory_order_relaxed);
+        } catch (const std::exception& e) {
+            std::cerr << "[OutboxRelay] purge failed: " << e.what() << std::endl;
+        }
+    }
+
+    // One line per period, only when something was published or failed.
+    void logStatistics(Stats& last) {
+        const auto now = Statistics();
+        if (now.published == last.published && now.failures == last.failures) {
+            return;
+        }
+        std::cout << "[OutboxRelay] published=" << now.published << " batches=" << now.batches
+                  << " failures=" << now.failures << " purged=" << now.purged << std::endl;
+        last = now;
+    }
+};
+
+#endif //SERVICE_OUTBOX_RELAY_HPP
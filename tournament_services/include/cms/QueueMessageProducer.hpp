@@ -1,48 +1,386 @@
 //
 // Created by tomas on 9/9/25.
 //
+// Sessions and producers are created once per queue and kept in a small pool instead of being opened
+// and closed on every message. With "async" on, SendMessage only queues the message (bounded queue,
+// many request threads, one publisher thread); the publisher sends what has accumulated in
+// transacted batches, one commit per queue per batch, and retries a failed batch on a fresh session.
+// Messages still failing after maxAttempts are counted and logged; the counters are also logged
+// once a minute. Binary event bodies (event/EventCodec.hpp) go out as a BytesMessage tagged with
+// the encoding property; everything else as a TextMessage.
+//
 
 #ifndef SERVICE_MESSAGE_PRODUCER_HPP
 #define SERVICE_MESSAGE_PRODUCER_HPP
 
-#include <string_view>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cms/BytesMessage.h>
+#include <cms/CMSException.h>
+#include <cms/DeliveryMode.h>
+#include <cms/MessageProducer.h>
+#include <cms/Session.h>
+#include <cms/TextMessage.h>
+#include <nlohmann/json.hpp>
 
 #include "IQueueMessageProducer.hpp"
 #include "cms/ConnectionManager.hpp"
+#include "event/EventCodec.hpp"
+
+struct ProducerSettings {
+    // Queue on the request thread and publish from a background thread.
+    bool async = false;
+    // Messages waiting for the publisher; when full, SendMessage sends inline.
+    std::size_t queueCapacity = 1024;
+    // Most messages per commit.
+    std::size_t batchSize = 64;
+    // Idle session/producer pairs kept per queue name.
+    std::size_t maxIdlePerQueue = 4;
+    int maxAttempts = 3;
+    std::chrono::milliseconds retryBackoff{200};
+    // "eventEncoding": "binary": publishers send events in the binary encoding. Turn it on once every
+    // consumer reads it.
+    bool binaryEvents = false;
+};
+
+// "producer" object of the "activemq" configuration.
+inline void from_json(const nlohmann::json& json, ProducerSettings& settings) {
+    settings.async           = json.value("async", settings.async);
+    settings.queueCapacity   = std::max<std::size_t>(1, json.value("queueCapacity", settings.queueCapacity));
+    settings.batchSize       = std::max<std::size_t>(1, json.value("batchSize", settings.batchSize));
+    settings.maxIdlePerQueue = json.value("maxIdlePerQueue", settings.maxIdlePerQueue);
+    settings.maxAttempts     = std::max(1, json.value("maxAttempts", settings.maxAttempts));
+    settings.retryBackoff    = std::chrono::milliseconds{json.value("retryBackoffMs", static_cast<int>(settings.retryBackoff.count()))};
+    settings.binaryEvents    = json.value("eventEncoding", std::string("json")) == "binary";
+}
 
 class QueueMessageProducer: public IQueueMessageProducer {
-    std::shared_ptr<ConnectionManager> connectionManager;
 public:
-    explicit QueueMessageProducer(const std::shared_ptr<ConnectionManager>& connectionManager) : connectionManager(connectionManager){}
+    // A session with its producer, bound to one queue. Used by one thread at a time.
+    class Channel {
+    public:
+        virtual ~Channel() = default;
+        virtual void Send(const std::string& message) = 0;
+        // Makes the sends since the last commit visible (transacted channels only).
+        virtual void Commit() {}
+    };
+    using ChannelFactory = std::function<std::unique_ptr<Channel>(const std::string& queue, bool transacted)>;
+
+    struct Stats {
+        std::uint64_t sent = 0;
+        std::uint64_t retried = 0;
+        std::uint64_t failed = 0;
+        // Async sends done inline because the queue was full.
+        std::uint64_t overflow = 0;
+        std::size_t pending = 0;
+    };
+
+    explicit QueueMessageProducer(const std::shared_ptr<ConnectionManager>& connectionManager)
+        : connectionManager(connectionManager),
+          channelFactory([this](const std::string& queue, bool transacted) {
+              return std::unique_ptr<Channel>(std::make_unique<CmsChannel>(*this->connectionManager, queue, transacted));
+          }) {}
+
+    ~QueueMessageProducer() override { Stop(); }
+
+    QueueMessageProducer(const QueueMessageProducer&) = delete;
+    QueueMessageProducer& operator=(const QueueMessageProducer&) = delete;
+
+    // Call once, before the first message (DI .onActivated).
+    void Configure(const ProducerSettings& producerSettings) {
+        settings = producerSettings;
+        if (settings.async && !publisher.joinable()) {
+            {
+                std::lock_guard lock(queueMutex);
+                stopping = false;
+                accepting = true;
+            }
+            publisher = std::thread([this] { publishLoop(); });
+        }
+    }
+
+    // Replaces how channels are opened (tests). Call before the first message.
+    void UseChannelFactory(ChannelFactory factory) { channelFactory = std::move(factory); }
 
-    // QueueMessageProducer.hpp  (solo método SendMessage)
     void SendMessage(const std::string_view& message, const std::string_view& queue) override {
-        try {
-            auto session = connectionManager->CreateSession(); // shared_ptr<cms::Session>
+        {
+            std::unique_lock lock(queueMutex);
+            if (accepting) {
+                if (pending.size() < settings.queueCapacity) {
+                    pending.push_back({std::string(queue), std::string(message)});
+                    lock.unlock();
+                    queueWake.notify_one();
+                    return;
+                }
+                overflow.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        sendNow(std::string(queue), std::string(message));
+    }
+
+    bool BinaryEvents() const override { return settings.binaryEvents; }
+
+    // Always inline, on a pooled session (for the outbox relay, a single long-lived one).
+    void SendMessageNow(const std::string_view& message, const std::string_view& queue) override {
+        sendNow(std::string(queue), std::string(message));
+    }
+
+    // Publishes what is queued and stops the publisher; later messages are sent inline.
+    void Stop() {
+        {
+            std::lock_guard lock(queueMutex);
+            stopping = true;
+            accepting = false;
+        }
+        queueWake.notify_all();
+        if (publisher.joinable()) {
+            publisher.join();
+        }
+    }
+
+    [[nodiscard]] Stats Statistics() const {
+        Stats stats;
+        stats.sent     = sent.load(std::memory_order_relaxed);
+        stats.retried  = retried.load(std::memory_order_relaxed);
+        stats.failed   = failed.load(std::memory_order_relaxed);
+        stats.overflow = overflow.load(std::memory_order_relaxed);
+        std::lock_guard lock(queueMutex);
+        stats.pending = pending.size();
+        return stats;
+    }
+
+private:
+    struct Outgoing {
+        std::string queue;
+        std::string message;
+    };
+
+    class CmsChannel : public Channel {
+        std::shared_ptr<cms::Session> session;
+        std::unique_ptr<cms::Destination> destination;
+        std::unique_ptr<cms::MessageProducer> producer;
+        bool transacted;
+
+    public:
+        CmsChannel(ConnectionManager& connectionManager, const std::string& queue, bool transacted)
+            : session(transacted ? connectionManager.CreateSession(cms::Session::SESSION_TRANSACTED)
+                                 : connectionManager.CreateSession()),
+              transacted(transacted) {
+            destination.reset(session->createQueue(queue));
+            producer.reset(session->createProducer(destination.get()));
+            // Persistent for durability; the pool and the batches pay for it.
+            producer->setDeliveryMode(cms::DeliveryMode::PERSISTENT);
+        }
+
+        ~CmsChannel() override {
+            try { if (producer) producer->close(); } catch (...) {}
+            try { if (session) session->close(); } catch (...) {}
+        }
+
+        void Send(const std::string& message) override {
+            if (event_codec::IsBinary(message)) {
+                std::unique_ptr<cms::BytesMessage> msg(session->createBytesMessage(
+                    reinterpret_cast<const unsigned char*>(message.data()), static_cast<int>(message.size())));
+                msg->setStringProperty(std::string(event_codec::EncodingProperty), std::string(event_codec::BinaryV1));
+                producer->send(msg.get());
+                return;
+            }
+            std::unique_ptr<cms::TextMessage> msg(session->createTextMessage(message));
+            producer->send(msg.get());
+        }
+
+        void Commit() override {
+            if (transacted) {
+                session->commit();
+            }
+        }
+    };
+
+    static constexpr auto kStatisticsPeriod = std::chrono::minutes(1);
+
+    std::shared_ptr<ConnectionManager> connectionManager;
+    ChannelFactory channelFactory;
+    ProducerSettings settings;
+
+    // Idle non-transacted channels by queue name.
+    std::mutex poolMutex;
+    std::unordered_map<std::string, std::vector<std::unique_ptr<Channel>>> idle;
+
+    mutable std::mutex queueMutex;
+    std::condition_variable queueWake;
+    std::deque<Outgoing> pending;
+    bool stopping = false;
+    // Async mode and the publisher is running.
+    bool accepting = false;
+    std::thread publisher;
+
+    std::atomic<std::uint64_t> sent{0};
+    std::atomic<std::uint64_t> retried{0};
+    std::atomic<std::uint64_t> failed{0};
+    std::atomic<std::uint64_t> overflow{0};
+
+    std::unique_ptr<Channel> acquire(const std::string& queue) {
+        {
+            std::lock_guard lock(poolMutex);
+            auto& channels = idle[queue];
+            if (!channels.empty()) {
+                auto channel = std::move(channels.back());
+                channels.pop_back();
+                return channel;
+            }
+        }
+        return channelFactory(queue, false);
+    }
+
+    void release(const std::string& queue, std::unique_ptr<Channel> channel) {
+        std::lock_guard lock(poolMutex);
+        auto& channels = idle[queue];
+        if (channels.size() < settings.maxIdlePerQueue) {
+            channels.push_back(std::move(channel));
+        }
+    }
 
-            std::unique_ptr<cms::Destination> dest(session->createQueue(queue.data()));
-            std::unique_ptr<cms::MessageProducer> prod(session->createProducer(dest.get()));
+    // Inline send on a pooled channel. A channel that fails is dropped and the next attempt opens a
+    // new one (the broker may have gone away since it was pooled). Rethrows the last error.
+    void sendNow(const std::string& queue, const std::string& message) {
+        for (int attempt = 1;; ++attempt) {
+            try {
+                auto channel = acquire(queue);
+                channel->Send(message);
+                release(queue, std::move(channel));
+                sent.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } catch (const std::exception& e) {
+                if (attempt >= settings.maxAttempts) {
+                    failed.fetch_add(1, std::memory_order_relaxed);
+                    std::cerr << "[QueueMessageProducer] send to " << queue << " failed: " << e.what() << std::endl;
+                    throw;
+                }
+                retried.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
 
-            // Choose delivery mode (Persistent for durability; NonPersistent for speed)
-            prod->setDeliveryMode(cms::DeliveryMode::PERSISTENT);
+    void publishLoop() {
+        // Transacted channels belong to this thread only.
+        std::unordered_map<std::string, std::unique_ptr<Channel>> channels;
+        Stats last;
+        auto nextStatistics = std::chrono::steady_clock::now() + kStatisticsPeriod;
 
-            std::unique_ptr<cms::TextMessage> msg(session->createTextMessage(std::string(message)));
-            prod->send(msg.get());
+        while (true) {
+            std::vector<Outgoing> batch;
+            {
+                std::unique_lock lock(queueMutex);
+                queueWake.wait_until(lock, nextStatistics, [this] { return stopping || !pending.empty(); });
+                const auto take = std::min(pending.size(), settings.batchSize);
+                batch.reserve(take);
+                for (std::size_t i = 0; i < take; ++i) {
+                    batch.push_back(std::move(pending.front()));
+                    pending.pop_front();
+                }
+                if (batch.empty() && stopping) {
+                    break;
+                }
+            }
 
-            // Ensure clean shutdown order
-            prod->close();
-            session->close();
-        } catch (const cms::CMSException& e) {
-            // Minimal logging; adjust to your logger
-            std::cerr << "[QueueMessageProducer] CMSException: " << e.getMessage() << std::endl;
-            throw; // rethrow so caller can decide (optional)
-        } catch (const std::exception& e) {
-            std::cerr << "[QueueMessageProducer] Exception: " << e.what() << std::endl;
-            throw;
+            // One commit per queue; the order inside a queue is kept.
+            std::vector<std::string> queues;
+            for (const auto& out : batch) {
+                if (std::find(queues.begin(), queues.end(), out.queue) == queues.end()) {
+                    queues.push_back(out.queue);
+                }
+            }
+            for (const auto& queue : queues) {
+                publish(channels, queue, batch);
+            }
+
+            if (std::chrono::steady_clock::now() >= nextStatistics) {
+                logStatistics(last);
+                nextStatistics = std::chrono::steady_clock::now() + kStatisticsPeriod;
+            }
         }
     }
 
+    // For logs: JSON as is; a binary body by its size and tournament, never its raw bytes.
+    static std::string describe(const std::string& message) {
+        if (!event_codec::IsBinary(message)) {
+            return message;
+        }
+        const auto tournamentId = event_codec::TournamentIdOf(message);
+        return "binary event of " + std::to_string(message.size()) + " bytes, tournament "
+             + (tournamentId ? event_codec::FormatUuid(*tournamentId) : std::string("unknown"));
+    }
+
+    void publish(std::unordered_map<std::string, std::unique_ptr<Channel>>& channels,
+                 const std::string& queue, const std::vector<Outgoing>& batch) {
+        std::size_t count = 0;
+        for (int attempt = 1;; ++attempt) {
+            try {
+                auto& channel = channels[queue];
+                if (!channel) {
+                    channel = channelFactory(queue, true);
+                }
+                count = 0;
+                for (const auto& out : batch) {
+                    if (out.queue == queue) {
+                        channel->Send(out.message);
+                        ++count;
+                    }
+                }
+                channel->Commit();
+                sent.fetch_add(count, std::memory_order_relaxed);
+                return;
+            } catch (const std::exception& e) {
+                // Nothing of an uncommitted batch was delivered: drop the session and send it all again.
+                channels.erase(queue);
+                if (attempt >= settings.maxAttempts) {
+                    std::size_t lost = 0;
+                    for (const auto& out : batch) {
+                        if (out.queue == queue) {
+                            std::cerr << "[QueueMessageProducer] dropped message for " << queue << ": " << describe(out.message) << std::endl;
+                            ++lost;
+                        }
+                    }
+                    failed.fetch_add(lost, std::memory_order_relaxed);
+                    std::cerr << "[QueueMessageProducer] batch to " << queue << " failed after " << attempt
+                              << " attempts: " << e.what() << std::endl;
+                    return;
+                }
+                retried.fetch_add(1, std::memory_order_relaxed);
+                std::unique_lock lock(queueMutex);
+                queueWake.wait_for(lock, settings.retryBackoff * attempt, [this] { return stopping; });
+            }
+        }
+    }
+
+    // One line per period, only when something was sent or failed.
+    void logStatistics(Stats& last) {
+        const auto now = Statistics();
+        if (now.sent == last.sent && now.failed == last.failed && now.overflow == last.overflow) {
+            return;
+        }
+        std::cout << "[QueueMessageProducer] sent=" << now.sent << " retried=" << now.retried
+                  << " failed=" << now.failed << " overflow=" << now.overflow
+                  << " pending=" << now.pending << std::endl;
+        last = now;
+    }
 };
 
-#endif //SERVICE_MESSAGE_PRODUCER_HPP
\ No newline at end of file
+#endif //SERVICE_MESSAGE_PRODUCER_HPP
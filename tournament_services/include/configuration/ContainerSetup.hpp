@@ -16,16 +16,21 @@
 // DB
 #include "persistence/configuration/IDbConnectionProvider.hpp"
 #include "persistence/configuration/PostgresConnectionProvider.hpp"
+#include "persistence/configuration/TournamentChangeListener.hpp"
 
 // Repositories
 #include "persistence/repository/IRepository.hpp"
+#include "persistence/repository/TakenNameFilter.hpp"
 #include "persistence/repository/TeamRepository.hpp"
 #include "persistence/repository/TournamentRepository.hpp"
+#include "persistence/repository/TournamentCache.hpp"
 #include "persistence/repository/GroupRepository.hpp"
+#include "persistence/repository/OutboxRepository.hpp"
 
 // Messaging
 #include "cms/ConnectionManager.hpp"
 #include "cms/QueueMessageProducer.hpp"
+#include "cms/OutboxRelay.hpp"
 #include "cms/QueueResolver.hpp"
 
 // Delegates
@@ -49,6 +54,13 @@
 #include "controller/MatchController.hpp"
 // --------------------------------
 
+// Standings
+#include "persistence/repository/IStandingsRepository.hpp"
+#include "persistence/repository/StandingsRepository.hpp"
+#include "delegate/IStandingsDelegate.hpp"
+#include "delegate/StandingsDelegate.hpp"
+#include "controller/StandingsController.hpp"
+
 namespace config {
 
     inline std::shared_ptr<Hypodermic::Container> containerSetup() {
@@ -64,12 +76,18 @@ namespace config {
         builder.registerInstance(appConfig);
 
         // Postgres connection provider
-        auto pgProvider = std::make_shared<PostgresConnectionProvider>(
-            configuration["databaseConfig"]["connectionString"].get<std::string>(),
-            configuration["databaseConfig"]["poolSize"].get<size_t>()
-        );
+        const auto dbConfig = configuration["databaseConfig"].get<config::DatabaseConfiguration>();
+        auto pgProvider = std::make_shared<PostgresConnectionProvider>(dbConfig);
         builder.registerInstance(pgProvider).as<IDbConnectionProvider>();
 
+        // Tournament cache, invalidated by this process's writes and by the other instances' (LISTEN/NOTIFY)
+        auto tournamentCache = std::make_shared<TournamentCache>(
+            TournamentCacheSettings{dbConfig.tournamentCacheMaxEntries, dbConfig.tournamentCacheShards});
+        builder.registerInstance(tournamentCache);
+        if (tournamentCache->Enabled()) {
+            builder.registerInstance(std::make_shared<TournamentChangeListener>(dbConfig.connectionString, tournamentCache));
+        }
+
         // Messaging (ActiveMQ)
         builder.registerType<ConnectionManager>()
             .onActivated([configuration](Hypodermic::ComponentContext&, const std::shared_ptr<ConnectionManager>& instance) {
@@ -82,9 +100,23 @@ namespace config {
             .singleInstance();
 
 
-        // Producer as interface
+        // Producer as interface: pooled sessions, and publishing off the request thread when "producer.async"
+        const auto producerSettings = configuration["activemq"].value("producer", nlohmann::json::object()).get<ProducerSettings>();
         builder.registerType<QueueMessageProducer>()
                .as<IQueueMessageProducer>()
+               .onActivated([producerSettings](Hypodermic::ComponentContext&, const std::shared_ptr<QueueMessageProducer>& instance) {
+                   instance->Configure(producerSettings);
+               })
+               .singleInstance();
+
+
+        // Outbox relay: publishes what the delegates wrote to the outbox, started on first resolve (main)
+        const auto outboxSettings = configuration.value("outbox", nlohmann::json::object()).get<OutboxRelaySettings>();
+        builder.registerType<OutboxRelay>()
+               .onActivated([outboxSettings](Hypodermic::ComponentContext&, const std::shared_ptr<OutboxRelay>& instance) {
+                   instance->Configure(outboxSettings);
+                   instance->Start();
+               })
                .singleInstance();
 
 
@@ -95,8 +127,17 @@ namespace config {
                .singleInstance();
 
         // ----- Repositories -----
+        // Optional name filters in front of the unique-name inserts (off unless nameFilter.ttlMs > 0)
+        const TakenNameFilterSettings nameFilterSettings{std::chrono::milliseconds{dbConfig.nameFilterTtlMs},
+                                                         dbConfig.nameFilterMaxEntries};
+        auto teamNames = std::make_shared<TakenNameFilter>(nameFilterSettings);
+        auto tournamentNames = std::make_shared<TakenNameFilter>(nameFilterSettings);
+
         builder.registerType<TeamRepository>()
                .as<IRepository<domain::Team, std::string_view>>()
+               .onActivated([teamNames](Hypodermic::ComponentContext&, const std::shared_ptr<TeamRepository>& instance) {
+                   instance->UseNameFilter(teamNames);
+               })
                .singleInstance();
 
         builder.registerType<GroupRepository>()
@@ -105,6 +146,10 @@ namespace config {
 
         builder.registerType<TournamentRepository>()
                .as<IRepository<domain::Tournament, std::string>>()
+               .onActivated([tournamentCache, tournamentNames](Hypodermic::ComponentContext&, const std::shared_ptr<TournamentRepository>& instance) {
+                   instance->UseCache(tournamentCache);
+                   instance->UseNameFilter(tournamentNames);
+               })
                .singleInstance();
 
         // Matches repo (NEW)
@@ -112,6 +157,14 @@ namespace config {
                .as<IMatchRepository>()
                .singleInstance();
 
+        builder.registerType<StandingsRepository>()
+               .as<IStandingsRepository>()
+               .singleInstance();
+
+        builder.registerType<OutboxRepository>()
+               .as<IOutboxRepository>()
+               .singleInstance();
+
         // ----- Delegates -----
         builder.registerType<TeamDelegate>()
                .as<ITeamDelegate>()
@@ -119,6 +172,11 @@ namespace config {
 
         builder.registerType<GroupDelegate>()
                .as<IGroupDelegate>()
+               .onActivated([outboxSettings](Hypodermic::ComponentContext& context, const std::shared_ptr<GroupDelegate>& instance) {
+                   if (outboxSettings.enabled) {
+                       instance->UseOutbox(context.resolve<IOutboxRepository>());
+                   }
+               })
                .singleInstance();
 
         builder.registerType<TournamentDelegate>()
@@ -129,6 +187,10 @@ namespace config {
         builder.registerType<MatchDelegate>()
                .as<IMatchDelegate>();
 
+        builder.registerType<StandingsDelegate>()
+               .as<IStandingsDelegate>()
+               .singleInstance();
+
         // ----- Controllers -----
         builder.registerType<TeamController>()
                .singleInstance();
@@ -139,10 +201,13 @@ namespace config {
         builder.registerType<TournamentController>()
                .singleInstance();
 
-        // Matches controller (NEW)
+        // Matches controller (NEW): publishes match.score-recorded through the shared IQueueMessageProducer
         builder.registerType<MatchController>()
                .singleInstance();
 
+        builder.registerType<StandingsController>()
+               .singleInstance();
+
         return builder.build();
     }
 
@@ -11,6 +11,9 @@
 #include <functional>
 #include <string>
 
+#include "persistence/configuration/ReadRouting.hpp"
+#include "persistence/repository/IdentityMap.hpp"
+
 // Route definition storage
 struct RouteDefinition {
     std::string path;
@@ -51,6 +54,8 @@ struct Controller## _##Method##_RouteRegistrator { \
             [](crow::SimpleApp& app, const std::shared_ptr<Hypodermic::Container>& container) { \
                     CROW_ROUTE(app, Path).methods(HttpMethod)( \
                         [container](const crow::request& request ,auto&&... args) { \
+                        IdentityMap identityMap; /* repository reads are shared within the request */ \
+                        read_routing::Reset();   /* read-your-writes of a previous request on this worker */ \
                         auto controller = container->resolve<Controller>(); \
                         return invokeController(controller.get(), &Controller::Method, request, std::forward<decltype(args)>(args)...); \
                     } \
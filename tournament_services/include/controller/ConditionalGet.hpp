@@ -0,0 +1,82 @@
+//
+// ConditionalGet.hpp
+// Conditional GET for the endpoints clients poll. The version of a resource comes from a cheap query
+// over last_update_date (see SelectTournamentVersion / SelectMatchesVersion); when the client sends
+// it back in If-None-Match the answer is 304 without reading or serializing the resource.
+//   GET /tournaments/{id}            ETag: "<version>"
+//   GET /tournaments/{id}/matches    ETag: "<version>-<hash of filter and page>"
+// The ETags are strong: the same version always renders the same bytes (GET /tournaments/{id} reads
+// the tournament row and its version in one statement, never from the tournament cache).
+//
+
+#ifndef RESTAPI_CONDITIONALGET_HPP
+#define RESTAPI_CONDITIONALGET_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <crow.h>
+
+// Clients may keep the body but must revalidate before using it.
+inline constexpr std::string_view CACHE_CONTROL_REVALIDATE = "no-cache";
+
+// variant: what else selects the body besides the version (query parameters); empty for none.
+inline std::string EntityTag(std::string_view version, std::string_view variant = {}) {
+    std::string tag = "\"";
+    tag += version;
+    if (!variant.empty()) {
+        // FNV-1a, only to keep the tag short.
+        std::uint64_t hash = 14695981039346656037ull;
+        for (const unsigned char c : variant) {
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+        static constexpr char digits[] = "0123456789abcdef";
+        tag += '-';
+        for (int shift = 60; shift >= 0; shift -= 4) {
+            tag += digits[(hash >> shift) & 0xf];
+        }
+    }
+    tag += '"';
+    return tag;
+}
+
+// True when If-None-Match lists etag or is "*". Weak tags (W/"...") compare by their value, as
+// RFC 9110 asks for If-None-Match.
+inline bool IfNoneMatch(const crow::request& request, std::string_view etag) {
+    const std::string header = request.get_header_value("If-None-Match");
+    std::string_view rest{header};
+    while (!rest.empty()) {
+        const auto comma = rest.find(',');
+        std::string_view candidate = rest.substr(0, comma);
+        rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+
+        const auto first = candidate.find_first_not_of(" \t");
+        if (first == std::string_view::npos) {
+            continue;
+        }
+        candidate = candidate.substr(first, candidate.find_last_not_of(" \t") - first + 1);
+        if (candidate == "*") {
+            return true;
+        }
+        if (candidate.starts_with("W/")) {
+            candidate.remove_prefix(2);
+        }
+        if (candidate == etag) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void AddValidators(crow::response& response, const std::string& etag) {
+    response.add_header("ETag", etag);
+    response.add_header("Cache-Control", std::string(CACHE_CONTROL_REVALIDATE));
+}
+
+inline crow::response NotModified(const std::string& etag) {
+    crow::response res{crow::NOT_MODIFIED};
+    AddValidators(res, etag);
+    return res;
+}
+
+#endif //RESTAPI_CONDITIONALGET_HPP
@@ -0,0 +1,39 @@
+//
+// JsonBody.hpp
+// Request/response bodies of the domain types through json_codec (domain/DomainJson.hpp).
+//
+
+#ifndef RESTAPI_JSONBODY_HPP
+#define RESTAPI_JSONBODY_HPP
+
+#include <expected>
+#include <string>
+#include <string_view>
+#include <crow.h>
+
+#include "domain/DomainJson.hpp"
+
+// The error is the 400 message: "Invalid JSON body" for malformed JSON, otherwise the member at fault
+// ("missing 'name'", "invalid 'name'").
+template<typename T>
+std::expected<T, std::string> ReadJsonBody(const crow::request& request) {
+    auto parsed = json_codec::Read<T>(request.body);
+    if (!parsed) {
+        if (parsed.error().kind == json_codec::ReadError::Kind::Syntax) {
+            return std::unexpected(std::string("Invalid JSON body"));
+        }
+        return std::unexpected(std::move(parsed.error().message));
+    }
+    return std::move(*parsed);
+}
+
+// {"id":"..."} as answered by the create endpoints.
+inline std::string IdBody(std::string_view id) {
+    std::string body{"{"};
+    bool first = true;
+    json_codec::AppendField(body, "id", id, first);
+    body += '}';
+    return body;
+}
+
+#endif //RESTAPI_JSONBODY_HPP
@@ -5,21 +5,21 @@
 #include "crow.h"
 #include "controller/MatchController.hpp"
 #include "delegate/IMatchDelegate.hpp"
-#include "cms/ConnectionManager.hpp"   // <-- add
+#include "cms/IQueueMessageProducer.hpp"
 
 class MatchController {
-    std::shared_ptr<IMatchDelegate>   matchDelegate;
-    std::shared_ptr<ConnectionManager> connectionManager; // <-- add
+    std::shared_ptr<IMatchDelegate>        matchDelegate;
+    // Shared producer (pooled session, async send); null: score events are not published.
+    std::shared_ptr<IQueueMessageProducer> messageProducer;
 
 public:
     explicit MatchController(std::shared_ptr<IMatchDelegate> d)
         : matchDelegate(std::move(d)) {}
 
-    // Minimal extra ctor to inject the ConnectionManager
     MatchController(std::shared_ptr<IMatchDelegate> d,
-                    std::shared_ptr<ConnectionManager> cm)            // <-- add
+                    std::shared_ptr<IQueueMessageProducer> producer)
         : matchDelegate(std::move(d)),
-          connectionManager(std::move(cm)) {}
+          messageProducer(std::move(producer)) {}
 
     crow::response ReadAll(const crow::request& request,
                            const std::string& tournamentId) const;
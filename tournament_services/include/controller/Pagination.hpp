@@ -0,0 +1,57 @@
+//
+// Pagination.hpp
+// Query parameters and response header shared by the paginated listing endpoints:
+//   GET /teams?limit=50&after=<cursor>
+// The body stays a plain JSON array; when more rows exist the response carries
+//   Link: </teams?limit=50&after=<next cursor>>; rel="next"
+//
+
+#ifndef RESTAPI_PAGINATION_HPP
+#define RESTAPI_PAGINATION_HPP
+
+#include <charconv>
+#include <cstring>
+#include <expected>
+#include <optional>
+#include <string>
+#include <crow.h>
+
+#include "persistence/repository/Page.hpp"
+
+// limit defaults to PageRequest::DefaultLimit and must be 1..MaxLimit; after must be a cursor we issued.
+inline std::expected<PageRequest, std::string> ParsePageRequest(const crow::request& request) {
+    PageRequest page;
+    if (const char* limit = request.url_params.get("limit")) {
+        std::size_t value = 0;
+        const char* end = limit + std::strlen(limit);
+        const auto [ptr, ec] = std::from_chars(limit, end, value);
+        if (ec != std::errc{} || ptr != end || value == 0 || value > PageRequest::MaxLimit) {
+            return std::unexpected("limit must be between 1 and " + std::to_string(PageRequest::MaxLimit));
+        }
+        page.limit = value;
+    }
+    if (const char* after = request.url_params.get("after")) {
+        page.after = page_cursor::Decode(after);
+        if (!page.after) {
+            return std::unexpected(std::string("invalid 'after' cursor"));
+        }
+    }
+    return page;
+}
+
+// path: the listing URL without query; next: the page's cursor (Page::next / JsonPage::next);
+// extraQuery: other parameters to keep on the next link ("a=b").
+inline void AddNextPageLink(crow::response& response, const std::string& path, const PageRequest& request,
+                            const std::optional<PageCursor>& next, const std::string& extraQuery = {}) {
+    if (!next) {
+        return;
+    }
+    std::string url = path + "?limit=" + std::to_string(page_cursor::PageSize(request))
+                    + "&after=" + page_cursor::Encode(*next);
+    if (!extraQuery.empty()) {
+        url += "&" + extraQuery;
+    }
+    response.add_header("Link", "<" + url + ">; rel=\"next\"");
+}
+
+#endif //RESTAPI_PAGINATION_HPP
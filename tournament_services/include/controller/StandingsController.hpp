@@ -0,0 +1,17 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <crow.h>
+
+#include "delegate/IStandingsDelegate.hpp"
+
+class StandingsController {
+    std::shared_ptr<IStandingsDelegate> standingsDelegate;
+
+public:
+    explicit StandingsController(std::shared_ptr<IStandingsDelegate> delegate)
+        : standingsDelegate(std::move(delegate)) {}
+
+    crow::response ReadByTournament(const std::string& tournamentId) const;                           // GET /tournaments/{id}/standings
+    crow::response ReadByGroup(const std::string& tournamentId, const std::string& groupId) const;    // GET /tournaments/{id}/groups/{gid}/standings
+};
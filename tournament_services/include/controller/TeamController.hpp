@@ -12,7 +12,7 @@
 
 #include "delegate/ITeamDelegate.hpp"
 
-// Keep local fallback regex if Utilities is unavailable in header scope
+// Formato aceptado para ids en rutas y cuerpos
 static const std::regex ID_VALUE("[A-Za-z0-9\\-]+");
 
 class TeamController {
@@ -21,7 +21,7 @@ public:
     explicit TeamController(const std::shared_ptr<ITeamDelegate>& teamDelegate);
 
     [[nodiscard]] crow::response getTeam(const std::string& teamId) const;
-    [[nodiscard]] crow::response getAllTeams() const;
+    [[nodiscard]] crow::response getAllTeams(const crow::request& request) const; // ?limit=&after=
     [[nodiscard]] crow::response SaveTeam(const crow::request& request) const; // Create
 
     // New endpoints:
@@ -16,8 +16,8 @@ public:
         : tournamentDelegate(std::move(tournament)), groupRepository(std::move(groupRepo)) {}
 
     crow::response CreateTournament(const crow::request& request);                   // POST /tournaments
-    crow::response ReadAll();                                                       // GET  /tournaments
-    crow::response ReadById(const std::string& id);                                 // GET  /tournaments/{id}
+    crow::response ReadAll(const crow::request& request);                           // GET  /tournaments?limit=&after=
+    crow::response ReadById(const crow::request& request, const std::string& id);  // GET  /tournaments/{id} (ETag)
     crow::response UpdateTournament(const crow::request& request, const std::string& id); // PUT
     crow::response DeleteTournament(const std::string& id);                              // DELETE
 };
@@ -14,6 +14,7 @@
 #include "persistence/repository/IGroupRepository.hpp"
 #include "persistence/repository/GroupRepository.hpp"
 #include "persistence/repository/TeamRepository.hpp"
+#include "persistence/repository/IOutboxRepository.hpp"
 
 // Use the interface, not the concrete producer
 #include "cms/IQueueMessageProducer.hpp"
@@ -23,6 +24,7 @@ class GroupDelegate : public IGroupDelegate {
     std::shared_ptr<IGroupRepository>          groupRepository;
     std::shared_ptr<TeamRepository>            teamRepository;
     std::shared_ptr<IQueueMessageProducer>     messageProducer; // interface-based
+    std::shared_ptr<IOutboxRepository>         outboxRepository;
 
 public:
     GroupDelegate(const std::shared_ptr<TournamentRepository>& tournamentRepository,
@@ -30,6 +32,10 @@ public:
                   const std::shared_ptr<TeamRepository>& teamRepository,
                   const std::shared_ptr<IQueueMessageProducer>& messageProducer);
 
+    // Events go to the outbox, in the transaction of the change, instead of straight to the producer
+    // (DI .onActivated when "outbox.enabled"; the OutboxRelay publishes them).
+    void UseOutbox(std::shared_ptr<IOutboxRepository> outbox) { outboxRepository = std::move(outbox); }
+
     // IGroupDelegate
     std::expected<std::string, std::string>
     CreateGroup(std::string_view tournamentId, const domain::Group& group) override;
@@ -7,6 +7,7 @@
 #include <vector>
 #include <expected>
 #include <nlohmann/json.hpp>
+#include "persistence/repository/Page.hpp"
 
 namespace domain { class Match; }
 
@@ -18,9 +19,28 @@ public:
     ReadAll(const std::string& tournamentId,
             const std::optional<std::string_view>& showFilter) = 0;
 
+    // One keyset page of ReadAll, rendered by the database as the JSON response body (no domain
+    // objects); same filter and not_found contract.
+    virtual JsonPage
+    ReadJsonPage(const std::string& tournamentId,
+                 const std::optional<std::string_view>& showFilter,
+                 const PageRequest& request) = 0;
+
+    // Version of the tournament's match list (every page and filter) for ETags; nullopt when the
+    // tournament doesn't exist or versions are not available (the default).
+    virtual std::optional<std::string>
+    ReadVersion(const std::string& tournamentId) {
+        (void)tournamentId;
+        return std::nullopt;
+    }
+
     virtual std::shared_ptr<domain::Match>
     ReadById(const std::string& tournamentId, const std::string& matchId) = 0;
 
+    // nullopt when the match does not exist in that tournament.
+    virtual std::optional<std::string>
+    ReadJsonById(const std::string& tournamentId, const std::string& matchId) = 0;
+
     virtual std::expected<void, std::string>
     UpdateScore(const std::string& tournamentId, const std::string& matchId,
                 int home, int visitor) = 0;
@@ -0,0 +1,19 @@
+// delegate/IStandingsDelegate.hpp
+#ifndef ISTANDINGS_DELEGATE_HPP
+#define ISTANDINGS_DELEGATE_HPP
+
+#include <optional>
+#include <string>
+
+/// Tablas de posiciones por grupo (tabla STANDINGS, actualizada en cada marcador).
+class IStandingsDelegate {
+public:
+    virtual ~IStandingsDelegate() = default;
+
+    // JSON armado por Postgres; nullopt si el torneo (o el grupo dentro del torneo) no existe.
+    virtual std::optional<std::string> ReadTournamentStandingsJson(const std::string& tournamentId) = 0;
+    virtual std::optional<std::string> ReadGroupStandingsJson(const std::string& tournamentId,
+                                                              const std::string& groupId) = 0;
+};
+
+#endif /* ISTANDINGS_DELEGATE_HPP */
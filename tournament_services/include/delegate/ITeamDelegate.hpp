@@ -5,8 +5,10 @@
 #include <string>
 #include <string_view>
 #include <memory>
+#include <optional>
 #include <vector>
 #include "domain/Team.hpp"
+#include "persistence/repository/Page.hpp"
 
 /// Interfaz de la capa Delegate para CRUD de Team.
 class ITeamDelegate {
@@ -16,6 +18,9 @@ public:
     // Read
     virtual std::shared_ptr<domain::Team> GetTeam(std::string_view id) = 0;
     virtual std::vector<std::shared_ptr<domain::Team>> GetAllTeams() = 0;
+    // Lecturas "pass-through": el JSON de respuesta tal como lo arma Postgres.
+    virtual std::optional<std::string> GetTeamJson(std::string_view id) = 0;
+    virtual JsonPage GetTeamsJsonPage(const PageRequest& request) = 0;
 
     virtual std::string_view SaveTeam(const domain::Team& team) = 0;
 
@@ -1,9 +1,13 @@
 #pragma once
 #include <expected>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include "domain/Tournament.hpp"
+#include "persistence/repository/IRepository.hpp"
+#include "persistence/repository/Page.hpp"
+#include "persistence/repository/ReadBatch.hpp"
 
 struct ITournamentDelegate {
     virtual ~ITournamentDelegate() = default;
@@ -11,6 +15,10 @@ struct ITournamentDelegate {
     virtual std::expected<std::vector<std::shared_ptr<domain::Tournament>>, std::string>
     ReadAll() = 0;
 
+    // One keyset page, already rendered as the JSON response body.
+    virtual std::expected<JsonPage, std::string>
+    ReadJsonPage(const PageRequest& request) = 0;
+
     virtual std::expected<std::shared_ptr<domain::Tournament>, std::string>
     ReadById(const std::string& id) = 0;
 
@@ -22,4 +30,29 @@ struct ITournamentDelegate {
 
     virtual std::expected<bool, std::string>
     DeleteTournament(const std::string& id) = 0;
+
+    // Version of GET /tournaments/{id} for its ETag; nullopt: not found (or no versions, the default).
+    virtual std::expected<std::optional<std::string>, std::string>
+    ReadVersion(const std::string& id) {
+        (void)id;
+        return std::nullopt;
+    }
+
+    // ReadById with the version of what it returns (GET /tournaments/{id}: the body and its ETag).
+    // Default: ReadVersion first, then ReadById.
+    virtual std::expected<Versioned<domain::Tournament>, std::string>
+    ReadWithVersion(const std::string& id) {
+        auto version = ReadVersion(id);
+        if (!version) return std::unexpected(version.error());
+        auto tournament = ReadById(id);
+        if (!tournament) return std::unexpected(tournament.error());
+        return Versioned<domain::Tournament>{std::move(*tournament), version->value_or(std::string{})};
+    }
+
+    // ReadById queued on a batch; the default runs ReadById when the value is needed.
+    virtual Deferred<std::expected<std::shared_ptr<domain::Tournament>, std::string>>
+    DeferReadById(ReadBatch& batch, const std::string& id) {
+        (void)batch;
+        return Deferred<std::expected<std::shared_ptr<domain::Tournament>, std::string>>([this, id] { return ReadById(id); });
+    }
 };
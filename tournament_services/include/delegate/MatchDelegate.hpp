@@ -14,11 +14,13 @@
 
 
 class IMatchRepository;
+class IStandingsRepository;
 class ITournamentDelegate;
 
 class MatchDelegate : public IMatchDelegate {
     std::shared_ptr<IMatchRepository> matchRepository;
     std::shared_ptr<ITournamentDelegate> tournamentDelegate;
+    std::shared_ptr<IStandingsRepository> standingsRepository;
 
     static std::string pickDeterministicWinner(const std::string& tournamentId,
                                                const std::string& matchId,
@@ -26,15 +28,27 @@ class MatchDelegate : public IMatchDelegate {
                                                const std::string& visitorTeamId);
 public:
     MatchDelegate(std::shared_ptr<IMatchRepository> matchRepo,
-                  std::shared_ptr<ITournamentDelegate> tournamentDel);
+                  std::shared_ptr<ITournamentDelegate> tournamentDel,
+                  std::shared_ptr<IStandingsRepository> standingsRepo);
 
     std::vector<std::shared_ptr<domain::Match>>
     ReadAll(const std::string& tournamentId,
             const std::optional<std::string_view>& showFilter) override;
 
+    JsonPage
+    ReadJsonPage(const std::string& tournamentId,
+                 const std::optional<std::string_view>& showFilter,
+                 const PageRequest& request) override;
+
+    std::optional<std::string>
+    ReadVersion(const std::string& tournamentId) override;
+
     std::shared_ptr<domain::Match>
     ReadById(const std::string& tournamentId, const std::string& matchId) override;
 
+    std::optional<std::string>
+    ReadJsonById(const std::string& tournamentId, const std::string& matchId) override;
+
     std::expected<void, std::string>
     UpdateScore(const std::string& tournamentId,
                 const std::string& matchId,
@@ -0,0 +1,22 @@
+#ifndef RESTAPI_STANDINGSDELEGATE_HPP
+#define RESTAPI_STANDINGSDELEGATE_HPP
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "persistence/repository/IStandingsRepository.hpp"
+#include "IStandingsDelegate.hpp"
+
+class StandingsDelegate : public IStandingsDelegate {
+    std::shared_ptr<IStandingsRepository> standingsRepository;
+
+public:
+    explicit StandingsDelegate(std::shared_ptr<IStandingsRepository> repository);
+
+    std::optional<std::string> ReadTournamentStandingsJson(const std::string& tournamentId) override;
+    std::optional<std::string> ReadGroupStandingsJson(const std::string& tournamentId,
+                                                      const std::string& groupId) override;
+};
+
+#endif //RESTAPI_STANDINGSDELEGATE_HPP
@@ -20,6 +20,8 @@ public:
 
     std::shared_ptr<domain::Team> GetTeam(std::string_view id) override;
     std::vector<std::shared_ptr<domain::Team>> GetAllTeams() override;
+    std::optional<std::string> GetTeamJson(std::string_view id) override;
+    JsonPage GetTeamsJsonPage(const PageRequest& request) override;
     std::string_view SaveTeam(const domain::Team& team) override;          // Create
     bool UpdateTeam(std::string_view id, const domain::Team& team) override; // Update
     bool DeleteTeam(std::string_view id) override;                            // Delete
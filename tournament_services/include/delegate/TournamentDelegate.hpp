@@ -20,12 +20,24 @@ public:
     std::expected<std::vector<std::shared_ptr<domain::Tournament>>, std::string>
     ReadAll() override;
 
+    std::expected<JsonPage, std::string>
+    ReadJsonPage(const PageRequest& request) override;
+
     std::expected<std::shared_ptr<domain::Tournament>, std::string>
     ReadById(const std::string& id) override;
 
+    std::expected<std::optional<std::string>, std::string>
+    ReadVersion(const std::string& id) override;
+
+    std::expected<Versioned<domain::Tournament>, std::string>
+    ReadWithVersion(const std::string& id) override;
+
     std::expected<bool, std::string>
     UpdateTournament(const std::string& id, const domain::Tournament& t) override;
 
     std::expected<bool, std::string>
     DeleteTournament(const std::string& id) override;
+
+    Deferred<std::expected<std::shared_ptr<domain::Tournament>, std::string>>
+    DeferReadById(ReadBatch& batch, const std::string& id) override;
 };
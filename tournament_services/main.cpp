@@ -1,23 +1,45 @@
 
 #include <activemq/library/ActiveMQCPP.h>
+#include <iostream>
+#include <memory>
+#include <string_view>
 
+#include "include/cms/QueueMessageProducer.hpp"
 #include "include/configuration/ContainerSetup.hpp"
 #include "include/configuration/RunConfiguration.hpp"
+#include "persistence/configuration/StatementCatalog.hpp"
+
+int main(int argc, char* argv[]) {
+    // Print the SQL statement catalog and exit (for review, no DB or broker needed)
+    if (argc > 1 && std::string_view{argv[1]} == "--dump-statements") {
+        statements::Dump(std::cout);
+        return 0;
+    }
 
-int main() {
     activemq::library::ActiveMQCPP::initializeLibrary();
-    const auto container = config::containerSetup();
-    crow::SimpleApp app;
+    {
+        // Scoped so the container, and the CMS sessions its producer pools, go before shutdownLibrary().
+        const auto container = config::containerSetup();
+        crow::SimpleApp app;
 
-    // Bind all annotated routes
-    for (auto& def : routeRegistry()) {
-        def.binder(app, container);
-    }
+        // Bind all annotated routes
+        for (auto& def : routeRegistry()) {
+            def.binder(app, container);
+        }
 
-    auto appConfig = container->resolve<config::RunConfiguration>();
+        auto appConfig = container->resolve<config::RunConfiguration>();
+        // Starts publishing the outbox (no-op when "outbox.enabled" is false)
+        auto outboxRelay = container->resolve<OutboxRelay>();
+        auto producer = container->resolve<IQueueMessageProducer>();
 
-    app.port(appConfig->port)
-        .concurrency(appConfig->concurrency)
-        .run();
+        app.port(appConfig->port)
+            .concurrency(appConfig->concurrency)
+            .run();
+        outboxRelay->Stop();
+        // Async mode: publish the events already answered to their requests while the library is up.
+        if (auto queueProducer = std::dynamic_pointer_cast<QueueMessageProducer>(producer)) {
+            queueProducer->Stop();
+        }
+    }
     activemq::library::ActiveMQCPP::shutdownLibrary();
 }
@@ -9,7 +9,7 @@
 #include <expected>
 #include <string_view>
 #include <utility>
-#include "domain/Utilities.hpp"
+#include "domain/DomainJson.hpp"
 
 using nlohmann::json;
 using namespace std::literals;
@@ -131,9 +131,7 @@ crow::response GroupController::GetGroup(const std::string& tournamentId, const
         return json_error(crow::NOT_FOUND, "group not found");
     }
 
-    json body;
-    domain::to_json(body, groupPtr); // use to_json from Utilities.hpp
-    crow::response res{crow::OK, body.dump()};
+    crow::response res{crow::OK, json_codec::Write(groupPtr)};
     res.set_header("content-type", std::string(kJsonContentType));
     return res;
 }
@@ -152,21 +150,20 @@ crow::response GroupController::GetGroups(const std::string& tournamentId) {
         return json_error(crow::NOT_FOUND, result.error());
     }
 
-    json arr = json::array();
+    // List shape kept as before the codec: id, name, teams (no tournamentId, it is in the path).
+    std::string body{"["};
     for (const auto& g : result.value()) {
-        json groupJson;
-        groupJson["name"] = g->Name();
-        groupJson["id"]   = g->Id();
-
-        json teamArr = json::array();
-        for (const auto& t : g->Teams()) {
-            teamArr.push_back({{"id", t.Id}, {"name", t.Name}});
-        }
-        groupJson["teams"] = teamArr;
-        arr.push_back(groupJson);
+        if (body.size() > 1) body += ',';
+        body += '{';
+        bool first = true;
+        json_codec::AppendField(body, "id", g->Id(), first);
+        json_codec::AppendField(body, "name", g->Name(), first);
+        json_codec::AppendField(body, "teams", g->Teams(), first);
+        body += '}';
     }
+    body += ']';
 
-    crow::response res{crow::OK, arr.dump()};
+    crow::response res{crow::OK, std::move(body)};
     res.set_header("content-type", std::string(kJsonContentType));
     return res;
 }
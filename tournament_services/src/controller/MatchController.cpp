@@ -1,24 +1,19 @@
 // MatchController.cpp
 #include "controller/MatchController.hpp"
 #include "configuration/RouteDefinition.hpp"
+#include "controller/Pagination.hpp"
+#include "controller/JsonBody.hpp"
+#include "controller/ConditionalGet.hpp"
 #include "delegate/MatchDelegate.hpp"
+#include "event/EventCodec.hpp"
 
 #include <nlohmann/json.hpp>
 #include <regex>
 #include <optional>
 #include <string_view>
-#include <cstdlib>   // std::getenv
 #include <memory>
 #include <iostream>
 
-// ActiveMQ-CPP / CMS
-#include <cms/CMSException.h>
-#include <cms/Connection.h>
-#include <cms/ConnectionFactory.h>
-#include <cms/MessageProducer.h>
-#include <cms/Session.h>
-#include <cms/TextMessage.h>
-
 #define JSON_CONTENT_TYPE   "application/json"
 #define CONTENT_TYPE_HEADER "content-type"
 
@@ -29,93 +24,56 @@ static const std::regex UUID_RE("^[0-9a-fA-F]{8}-"
                                 "[0-9a-fA-F]{4}-"
                                 "[0-9a-fA-F]{12}$");
 
-// Optional guard so tests can disable publishing
-static bool is_score_publish_disabled() {
-    if (const char* env = std::getenv("DISABLE_SCORE_PUBLISH")) {
-        return env[0] != '\0';
-    }
-    return false;
-}
-
-// ----------- Simple one-shot publisher (safe and minimal) -----------
-static std::string brokerUrl() {
-    if (const char* env = std::getenv("BROKER_URL")) {
-        return std::string(env);
-    }
-    return std::string("failover://(tcp://artemis:61616)");
-}
-
-static void publish_score_recorded(const std::string& tournamentId,
-                                   const std::string& matchId) {
-    // When DISABLE_SCORE_PUBLISH is set, skip broker calls (useful for tests)
-    if (is_score_publish_disabled()) {
-        std::cerr << "[MatchController] score publish disabled by env (DISABLE_SCORE_PUBLISH)"
-                  << std::endl;
-        return;
-    }
-
-    try {
-        std::unique_ptr<cms::ConnectionFactory> factory(
-            cms::ConnectionFactory::createCMSConnectionFactory(brokerUrl()));
-        std::unique_ptr<cms::Connection> connection(factory->createConnection());
-        connection->start();
-
-        std::unique_ptr<cms::Session> session(
-            connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
-
-        std::unique_ptr<cms::Destination> dest(
-            session->createQueue("match.score-recorded"));
-
-        std::unique_ptr<cms::MessageProducer> producer(
-            session->createProducer(dest.get()));
-        producer->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
-
-        nlohmann::json j = {
-            {"type", "match.score-recorded"},
-            {"tournamentId", tournamentId},
-            {"matchId", matchId}
-        };
-
-        std::unique_ptr<cms::TextMessage> msg(
-            session->createTextMessage(j.dump()));
-        producer->send(msg.get());
-
-        std::cerr << "[MatchController] published match.score-recorded "
-                  << matchId << " in " << tournamentId << std::endl;
-    } catch (const cms::CMSException& e) {
-        std::cerr << "[MatchController] ERROR publishing (CMS): "
-                  << e.getMessage() << std::endl;
-    } catch (const std::exception& e) {
-        std::cerr << "[MatchController] ERROR publishing: "
-                  << e.what() << std::endl;
-    }
-}
+// Queue must match the consumer's Start("match.score-recorded").
+static constexpr std::string_view SCORE_RECORDED_QUEUE = "match.score-recorded";
 
 // ------------------- Endpoints -------------------
 
-// GET /tournaments/{tId}/matches?showMatches=played|pending
+// GET /tournaments/{tId}/matches?showMatches=played|pending&limit=&after=
 crow::response MatchController::ReadAll(const crow::request& request,
                                         const std::string& tournamentId) const {
     if (!std::regex_match(tournamentId, UUID_RE)) {
         return crow::response{crow::BAD_REQUEST, "Invalid tournament ID format"};
     }
 
+    auto pageRequest = ParsePageRequest(request);
+    if (!pageRequest) {
+        return crow::response{crow::BAD_REQUEST, pageRequest.error()};
+    }
+
     try {
         std::optional<std::string_view> filter;
         if (const char* p = request.url_params.get("showMatches")) {
             filter = std::string_view{p};
         }
 
-        auto matches = matchDelegate->ReadAll(tournamentId, filter);
-
-        nlohmann::json body = nlohmann::json::array();
-        for (const auto& m : matches) {
-            if (m) body.push_back(*m);
+        // Same version for every page and filter; they only change the variant.
+        std::string etag;
+        if (auto version = matchDelegate->ReadVersion(tournamentId)) {
+            std::string variant = filter ? std::string(*filter) : std::string{};
+            variant += '&' + std::to_string(page_cursor::PageSize(*pageRequest));
+            if (pageRequest->after) {
+                variant += '&' + page_cursor::Encode(*pageRequest->after);
+            }
+            etag = EntityTag(*version, variant);
+            if (IfNoneMatch(request, etag)) {
+                return NotModified(etag);
+            }
         }
 
-        crow::response res(body.dump());
+        // The page comes back as the final JSON array; no domain::Match on the read path.
+        auto page = matchDelegate->ReadJsonPage(tournamentId, filter, *pageRequest);
+
+        crow::response res(std::move(page.body));
         res.code = crow::OK;
         res.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+        // Only the known filter values are echoed into the next link.
+        const bool knownFilter = filter && (*filter == "played" || *filter == "pending");
+        AddNextPageLink(res, "/tournaments/" + tournamentId + "/matches", *pageRequest, page.next,
+                        knownFilter ? "showMatches=" + std::string(*filter) : std::string{});
+        if (!etag.empty()) {
+            AddValidators(res, etag);
+        }
         return res;
     } catch (const std::runtime_error& e) {
         if (std::string_view{e.what()} == "not_found") {
@@ -136,14 +94,12 @@ crow::response MatchController::ReadById(const std::string& tournamentId,
     }
 
     try {
-        auto m = matchDelegate->ReadById(tournamentId, matchId);
+        auto m = matchDelegate->ReadJsonById(tournamentId, matchId);
         if (!m) {
             return crow::response{crow::NOT_FOUND, "match not found"};
         }
 
-        nlohmann::json body = *m;
-
-        crow::response res(body.dump());
+        crow::response res(std::move(*m));
         res.code = crow::OK;
         res.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
         return res;
@@ -189,8 +145,27 @@ crow::response MatchController::PatchScore(const crow::request& request,
         return crow::response{crow::INTERNAL_SERVER_ERROR, "update score failed"};
     }
 
-    // Publish event so the consumer can advance the tournament
-    publish_score_recorded(tournamentId, matchId);
+    // Publish event so the consumer can advance the tournament. The score is already stored, so a
+    // failed publish is logged and the answer stays 204.
+    if (messageProducer) {
+        try {
+            // Binary when the producer is set for it and the ids are UUIDs; JSON otherwise.
+            std::optional<std::string> body;
+            if (messageProducer->BinaryEvents()) {
+                body = event_codec::Encode(ScoreUpdateEvent{tournamentId, matchId});
+            }
+            if (!body) {
+                body = nlohmann::json{
+                    {"type", "match.score-recorded"},
+                    {"tournamentId", tournamentId},
+                    {"matchId", matchId}
+                }.dump();
+            }
+            messageProducer->SendMessage(*body, SCORE_RECORDED_QUEUE);
+        } catch (const std::exception& e) {
+            std::cerr << "[MatchController] ERROR publishing " << SCORE_RECORDED_QUEUE << ": " << e.what() << std::endl;
+        }
+    }
 
     return crow::response{crow::NO_CONTENT};
 }
@@ -220,8 +195,7 @@ crow::response MatchController::Create(const crow::request& request,
             return crow::response{crow::INTERNAL_SERVER_ERROR, "create match failed"};
         }
 
-        nlohmann::json resp = { {"id", result.value()} };
-        crow::response res(resp.dump());
+        crow::response res(IdBody(result.value()));
         res.code = crow::CREATED;
         res.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
         res.add_header("Location",
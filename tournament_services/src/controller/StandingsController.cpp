@@ -0,0 +1,55 @@
+// StandingsController.cpp
+#include "controller/StandingsController.hpp"
+#include "configuration/RouteDefinition.hpp"
+
+#include <regex>
+
+#define JSON_CONTENT_TYPE "application/json"
+#define CONTENT_TYPE_HEADER "content-type"
+
+namespace {
+const std::regex UUID_RE(
+    R"(^[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}$)"
+);
+
+crow::response json_body(std::string body) {
+    crow::response res{crow::OK, std::move(body)};
+    res.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+    return res;
+}
+}
+
+// GET /tournaments/{id}/standings  (todas las filas, por grupo y posición)
+crow::response StandingsController::ReadByTournament(const std::string& tournamentId) const {
+    if (!std::regex_match(tournamentId, UUID_RE)) {
+        return crow::response{crow::BAD_REQUEST, "Invalid tournament ID format"};
+    }
+    try {
+        auto body = standingsDelegate->ReadTournamentStandingsJson(tournamentId);
+        if (!body) {
+            return crow::response{crow::NOT_FOUND, "tournament not found"};
+        }
+        return json_body(std::move(*body));
+    } catch (...) {
+        return crow::response{crow::INTERNAL_SERVER_ERROR, "read standings failed"};
+    }
+}
+
+// GET /tournaments/{id}/groups/{gid}/standings
+crow::response StandingsController::ReadByGroup(const std::string& tournamentId, const std::string& groupId) const {
+    if (!std::regex_match(tournamentId, UUID_RE) || !std::regex_match(groupId, UUID_RE)) {
+        return crow::response{crow::BAD_REQUEST, "Invalid ID format"};
+    }
+    try {
+        auto body = standingsDelegate->ReadGroupStandingsJson(tournamentId, groupId);
+        if (!body) {
+            return crow::response{crow::NOT_FOUND, "group not found"};
+        }
+        return json_body(std::move(*body));
+    } catch (...) {
+        return crow::response{crow::INTERNAL_SERVER_ERROR, "read standings failed"};
+    }
+}
+
+REGISTER_ROUTE(StandingsController, ReadByTournament, "/tournaments/<string>/standings",                 "GET"_method)
+REGISTER_ROUTE(StandingsController, ReadByGroup,      "/tournaments/<string>/groups/<string>/standings", "GET"_method)
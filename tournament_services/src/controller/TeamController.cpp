@@ -9,8 +9,9 @@
 
 #include "configuration/RouteDefinition.hpp"
 #include "controller/TeamController.hpp"
-#include "domain/Utilities.hpp"
-#include <nlohmann/json.hpp>
+#include "controller/Pagination.hpp"
+#include "controller/JsonBody.hpp"
+#include "persistence/repository/RepositoryErrors.hpp"
 #include <algorithm>
 #include <regex>
 
@@ -23,52 +24,42 @@ crow::response TeamController::getTeam(const std::string& teamId) const {
         return crow::response{crow::BAD_REQUEST, "Invalid ID format"};
     }
 
-    auto team = teamDelegate->GetTeam(teamId);
-    if (team == nullptr) {
+    // El JSON ya viene armado por la base: se escribe tal cual, sin pasar por domain::Team.
+    auto team = teamDelegate->GetTeamJson(teamId);
+    if (!team) {
         return crow::response{crow::NOT_FOUND, "team not found"};
     }
 
-    nlohmann::json body = *team;
-    auto response = crow::response{crow::OK, body.dump()};
+    auto response = crow::response{crow::OK, std::move(*team)};
     response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
     return response;
 }
 
-//Obtenemos todos los teams por /teams
-crow::response TeamController::getAllTeams() const {
-    nlohmann::json body = teamDelegate->GetAllTeams();
-    crow::response response{crow::OK, body.dump()};
+//Obtenemos los teams por /teams, una página a la vez (?limit=&after=)
+crow::response TeamController::getAllTeams(const crow::request& request) const {
+    auto pageRequest = ParsePageRequest(request);
+    if (!pageRequest) {
+        return crow::response{crow::BAD_REQUEST, pageRequest.error()};
+    }
+
+    auto page = teamDelegate->GetTeamsJsonPage(*pageRequest);
+    crow::response response{crow::OK, std::move(page.body)};
     response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+    AddNextPageLink(response, "/teams", *pageRequest, page.next);
     return response;
 }
 
 // POST /teams  (con 409 por nombre duplicado)
 crow::response TeamController::SaveTeam(const crow::request& request) const {
-    if (!nlohmann::json::accept(request.body)) {
-        return crow::response{crow::BAD_REQUEST, "Invalid JSON body"};
-    }
-    auto body = nlohmann::json::parse(request.body);
-
-    // Validación de nombre
-    if (!body.contains("name") || !body["name"].is_string()) {
-        return crow::response{crow::BAD_REQUEST, "missing 'name'"};
-    }
-    std::string incomingName = body["name"].get<std::string>();
-
-    // 409 si name ya existe
-    auto all = teamDelegate->GetAllTeams();
-    auto dup = std::find_if(all.begin(), all.end(),
-                            [&](const std::shared_ptr<domain::Team>& x){
-                                return x && x->Name == incomingName;
-                            });
-    if (dup != all.end()) {
-        return crow::response{crow::CONFLICT, "team name already exists"};
+    // JSON inválido o sin nombre -> 400
+    auto team = ReadJsonBody<domain::Team>(request);
+    if (!team) {
+        return crow::response{crow::BAD_REQUEST, team.error()};
     }
 
     // Si el cliente pasa id, valida formato y conflicto de id
-    std::string clientId;
-    if (body.contains("id") && body["id"].is_string()) {
-        clientId = body["id"].get<std::string>();
+    const std::string clientId = team->Id;
+    if (!clientId.empty()) {
         if (!std::regex_match(clientId, ID_VALUE)) {
             return crow::response{crow::BAD_REQUEST, "Invalid ID format"};
         }
@@ -78,8 +69,7 @@ crow::response TeamController::SaveTeam(const crow::request& request) const {
     }
 
     try {
-        domain::Team team = body;
-        auto createdId = teamDelegate->SaveTeam(team);
+        auto createdId = teamDelegate->SaveTeam(*team);
 
         std::string location = !clientId.empty() ? clientId : std::string(createdId);
 
@@ -87,8 +77,11 @@ crow::response TeamController::SaveTeam(const crow::request& request) const {
         res.code = crow::CREATED;
         res.add_header("location", location);
         res.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);   
-        res.write(nlohmann::json{{"id", location}}.dump());
+        res.write(IdBody(location));
         return res;
+    } catch (const DuplicateEntityError&) {
+        // 409 si name ya existe: lo decide el índice único en el INSERT, sin listar la tabla
+        return crow::response{crow::CONFLICT, "team name already exists"};
     } catch (const std::exception& e) {
         return crow::response{crow::INTERNAL_SERVER_ERROR, std::string("error creating team: ") + e.what()};
     }
@@ -100,16 +93,13 @@ crow::response TeamController::UpdateTeam(const crow::request& request,
     if (!std::regex_match(teamId, ID_VALUE)) {
         return crow::response{crow::BAD_REQUEST, "Invalid ID format"};
     }
-    if (!nlohmann::json::accept(request.body)) {
-        return crow::response{crow::BAD_REQUEST, "Invalid JSON body"};
+    auto team = ReadJsonBody<domain::Team>(request);
+    if (!team) {
+        return crow::response{crow::BAD_REQUEST, team.error()};
     }
+    team->Id = teamId;  // id en body es opcional/ignorado
 
-    nlohmann::json body = nlohmann::json::parse(request.body);
-
-    domain::Team team = body;  // id en body es opcional/ignorado
-    team.Id = teamId;     
-
-    const bool updated = teamDelegate->UpdateTeam(teamId, team);
+    const bool updated = teamDelegate->UpdateTeam(teamId, *team);
     if (!updated) {
         //equipo no encontrado 44
         return crow::response{crow::NOT_FOUND, "team not found"};
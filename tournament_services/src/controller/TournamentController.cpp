@@ -1,6 +1,8 @@
 #include "controller/TournamentController.hpp"
 #include "configuration/RouteDefinition.hpp"
-#include "domain/Utilities.hpp"   // to_json/from_json para Tournament y Groups
+#include "controller/Pagination.hpp"
+#include "controller/JsonBody.hpp"
+#include "controller/ConditionalGet.hpp"
 
 #include <algorithm>
 #include <sstream>
@@ -8,61 +10,20 @@
 #define JSON_CONTENT_TYPE "application/json"
 #define CONTENT_TYPE_HEADER "content-type"
 
-// Helpers
-static std::string esc(const std::string& s) {
-    std::string out; out.reserve(s.size() + 8);
-    for (char c : s) {
-        if (c == '"' || c == '\\') { out.push_back('\\'); out.push_back(c); }
-        else if (c == '\n') out += "\\n";
-        else out.push_back(c);
-    }
-    return out;
-}
-
-static std::string tournament_to_json_string(const domain::Tournament& t) {
-    nlohmann::json j = t; // Utilities.hpp
-    return j.dump();
-}
-
-static domain::Tournament parse_tournament_body(const nlohmann::json& body) {
-    domain::Tournament t;
-    t = body.get<domain::Tournament>(); // Utilities.hpp
-    return t;
-}
-
 // POST /tournaments  (con 409 por nombre duplicado)
 crow::response TournamentController::CreateTournament(const crow::request& request) {
-    if (!nlohmann::json::accept(request.body)) {
-        return crow::response{crow::BAD_REQUEST, "Invalid JSON body"};
+    // JSON inválido o sin nombre -> 400
+    auto parsed = ReadJsonBody<domain::Tournament>(request);
+    if (!parsed) {
+        return crow::response{crow::BAD_REQUEST, parsed.error()};
     }
 
-    nlohmann::json body = nlohmann::json::parse(request.body);
-
-    // Validación de nombre
-    if (!body.contains("name") || !body["name"].is_string()) {
-        return crow::response{crow::BAD_REQUEST, "missing 'name'"};
-    }
-    std::string incomingName = body["name"].get<std::string>();
-
-    // 409 si name ya existe
-    auto allResult = tournamentDelegate->ReadAll();
-    if (!allResult) {
-        return crow::response{crow::INTERNAL_SERVER_ERROR, allResult.error()};
-    }
-    
-    auto& all = allResult.value();
-    auto dup = std::find_if(all.begin(), all.end(),
-                            [&](const std::shared_ptr<domain::Tournament>& x){
-                                return x && x->Name() == incomingName;
-                            });
-    if (dup != all.end()) {
-        return crow::response{crow::CONFLICT, "tournament name already exists"};
-    }
-
-    domain::Tournament t = parse_tournament_body(body);
-    auto idResult = tournamentDelegate->CreateTournament(std::make_shared<domain::Tournament>(t));
+    // 409 si name ya existe: lo decide el índice único en el INSERT, sin listar la tabla
+    auto idResult = tournamentDelegate->CreateTournament(std::make_shared<domain::Tournament>(std::move(*parsed)));
     if (!idResult) {
-        return crow::response{crow::INTERNAL_SERVER_ERROR, idResult.error()};
+        const auto code = idResult.error().find("already exists") != std::string::npos
+            ? crow::CONFLICT : crow::INTERNAL_SERVER_ERROR;
+        return crow::response{code, idResult.error()};
     }
 
     const std::string& id = idResult.value();
@@ -70,59 +31,78 @@ crow::response TournamentController::CreateTournament(const crow::request& reque
     res.code = crow::CREATED;
     res.add_header("location", id);
     res.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
-    res.write(std::string("{\"id\":\"") + esc(id) + "\"}");
+    res.write(IdBody(id));
     return res;
 }
 
-// GET /tournaments
-crow::response TournamentController::ReadAll() {
-    auto itemsResult = tournamentDelegate->ReadAll();
-    if (!itemsResult) {
-        return crow::response{crow::INTERNAL_SERVER_ERROR, itemsResult.error()};
+// GET /tournaments?limit=&after=
+crow::response TournamentController::ReadAll(const crow::request& request) {
+    auto pageRequest = ParsePageRequest(request);
+    if (!pageRequest) {
+        return crow::response{crow::BAD_REQUEST, pageRequest.error()};
     }
 
-    nlohmann::json arr = nlohmann::json::array();
-    for (const auto& it : itemsResult.value()) {
-        if (it) arr.push_back(*it);
+    // Body rendered by the database; written as is.
+    auto pageResult = tournamentDelegate->ReadJsonPage(*pageRequest);
+    if (!pageResult) {
+        return crow::response{crow::INTERNAL_SERVER_ERROR, pageResult.error()};
     }
-    
-    crow::response res{crow::OK, arr.dump()};
+
+    crow::response res{crow::OK, std::move(pageResult->body)};
     res.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+    AddNextPageLink(res, "/tournaments", *pageRequest, pageResult->next);
     return res;
 }
 
 // GET /tournaments/{id}  (embebido: groups + teams)
-crow::response TournamentController::ReadById(const std::string& id) {
-    auto tResult = tournamentDelegate->ReadById(id);
+// 304 si If-None-Match coincide: solo se consulta la versión, ni torneo ni grupos.
+crow::response TournamentController::ReadById(const crow::request& request, const std::string& id) {
+    // Sin versión (no existe o falló la consulta) se sigue por el camino normal.
+    if (!request.get_header_value("If-None-Match").empty()) {
+        if (auto version = tournamentDelegate->ReadVersion(id); version && *version) {
+            const std::string etag = EntityTag(**version);
+            if (IfNoneMatch(request, etag)) {
+                return NotModified(etag);
+            }
+        }
+    }
+
+    // The ETag comes with the tournament row (one statement), so it never names a newer body than the
+    // one sent. Groups are read after it: at worst newer, and the next poll is a 200.
+    auto tResult = tournamentDelegate->ReadWithVersion(id);
     if (!tResult) {
         return crow::response{crow::INTERNAL_SERVER_ERROR, tResult.error()};
     }
 
-    auto t = tResult.value();
+    auto t = tResult->entity;
     if (!t) {
         return crow::response{crow::NOT_FOUND, "tournament not found"};
     }
+    const std::string etag = tResult->version.empty() ? std::string{} : EntityTag(tResult->version);
 
-    nlohmann::json body = *t; // id, name, format
-    // Embebido de grupos:
-    auto groups = groupRepository->FindByTournamentId(id);
-    body["groups"] = groups;
+    // id, name, format + grupos embebidos
+    std::string body{"{"};
+    bool first = true;
+    json_codec::AppendFields(body, *t, first);
+    json_codec::AppendField(body, "groups", groupRepository->FindByTournamentId(id), first);
+    body += '}';
 
-    crow::response res{crow::OK, body.dump()};
+    crow::response res{crow::OK, std::move(body)};
     res.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+    if (!etag.empty()) {
+        AddValidators(res, etag);
+    }
     return res;
 }
 
 // PATCH /tournaments/{id}
 crow::response TournamentController::UpdateTournament(const crow::request& request, const std::string& id) {
-    if (!nlohmann::json::accept(request.body)) {
-        return crow::response{crow::BAD_REQUEST, "Invalid JSON body"};
+    auto t = ReadJsonBody<domain::Tournament>(request);
+    if (!t) {
+        return crow::response{crow::BAD_REQUEST, t.error()};
     }
 
-    auto body = nlohmann::json::parse(request.body);
-    domain::Tournament t = parse_tournament_body(body);
-
-    auto updateResult = tournamentDelegate->UpdateTournament(id, t);
+    auto updateResult = tournamentDelegate->UpdateTournament(id, *t);
     if (!updateResult) {
         return crow::response{crow::INTERNAL_SERVER_ERROR, updateResult.error()};
     }
@@ -1,7 +1,10 @@
 //GroupDelegate.cpp
 #include "delegate/GroupDelegate.hpp"
 #include "../include/cms/QueueMessageProducer.hpp"
+#include "persistence/configuration/UnitOfWork.hpp"
+#include "event/EventCodec.hpp"
 #include <chrono>        // for timestamp
+#include <optional>
 #include <nlohmann/json.hpp>
 
 #include <algorithm>
@@ -21,6 +24,8 @@ GroupDelegate::GroupDelegate(
 // ---------------- CreateGroup ----------------
 std::expected<std::string, std::string>
 GroupDelegate::CreateGroup(std::string_view tournamentId, const domain::Group& group) {
+    // Lookups and insert share one connection and one transaction.
+    UnitOfWork unit;
     auto tournament = tournamentRepository->ReadById(std::string(tournamentId));
     if (!tournament) {
         return std::unexpected("Tournament doesn't exist");
@@ -40,17 +45,21 @@ GroupDelegate::CreateGroup(std::string_view tournamentId, const domain::Group& g
             if (!team) {
                 return std::unexpected("Team doesn't exist");
             }
-            if (groupRepository->FindByTournamentIdAndTeamId(tournament->Id(), t.Id)) {
-                return std::unexpected("Team " + t.Id + " already exists in tournament " + tournament->Id());
-            }
         }
     }
 
-    auto id = groupRepository->Create(g);
+    // One group per team per tournament is enforced by the group_teams unique index.
+    std::string id;
+    try {
+        id = groupRepository->Create(g);
+    } catch (const DuplicateEntityError& e) {
+        return std::unexpected("Team " + e.key() + " already exists in tournament " + tournament->Id());
+    }
     if (id.empty()) {
         return std::unexpected("Failed to create group");
     }
 
+    unit.Commit();
     return id;
 }
 
@@ -91,7 +100,8 @@ GroupDelegate::UpdateGroup(std::string_view tournamentId, const domain::Group& g
         return std::unexpected("Group name required");
     }
 
-    // Validar torneo y grupo existen
+    // Validar torneo y grupo existen (misma transacción que el update)
+    UnitOfWork unit;
     auto tournament = tournamentRepository->ReadById(std::string(tournamentId));
     if (!tournament) {
         return std::unexpected("Tournament doesn't exist");
@@ -109,13 +119,15 @@ GroupDelegate::UpdateGroup(std::string_view tournamentId, const domain::Group& g
         return std::unexpected("Failed to update group");
     }
 
+    unit.Commit();
     return {};
 }
 
 // ---------------- RemoveGroup ----------------
 std::expected<void, std::string>
 GroupDelegate::RemoveGroup(std::string_view tournamentId, std::string_view groupId) {
-    // Validar torneo y grupo existen
+    // Validar torneo y grupo existen (misma transacción que el delete)
+    UnitOfWork unit;
     auto tournament = tournamentRepository->ReadById(std::string(tournamentId));
     if (!tournament) {
         return std::unexpected("Tournament doesn't exist");
@@ -126,6 +138,7 @@ GroupDelegate::RemoveGroup(std::string_view tournamentId, std::string_view group
     }
 
     groupRepository->Delete(std::string(groupId));
+    unit.Commit();
     return {};
 }
 
@@ -134,39 +147,55 @@ std::expected<void, std::string>
 GroupDelegate::UpdateTeams(std::string_view tournamentId,
                            std::string_view groupId,
                            const std::vector<domain::Team>& teams) {
-    auto tournament = tournamentRepository->ReadById(std::string(tournamentId));
-    if (!tournament) {
-        return std::unexpected("Tournament doesn't exist");
-    }
+    // Reads, capacity check and writes in one transaction; the group row stays locked until commit.
+    UnitOfWork unit;
+    std::vector<std::shared_ptr<domain::Team>> persistedTeams;
+    {
+        // Every lookup is independent: queue them all (2 + N reads) and pay a single round trip.
+        ReadBatch batch;
+        auto tournamentRead = tournamentRepository->DeferReadById(batch, std::string(tournamentId));
+        auto groupRead      = groupRepository->DeferFindByTournamentIdAndGroupId(batch, tournamentId, groupId);
+        std::vector<Deferred<std::shared_ptr<domain::Team>>> teamReads;
+        teamReads.reserve(teams.size());
+        for (const auto& team : teams) {
+            teamReads.push_back(teamRepository->DeferReadById(batch, team.Id));
+        }
 
-    auto group = groupRepository->FindByTournamentIdAndGroupId(tournamentId, groupId);
-    if (!group) {
-        return std::unexpected("Group doesn't exist");
-    }
+        auto tournament = tournamentRead.get();
+        if (!tournament) {
+            return std::unexpected("Tournament doesn't exist");
+        }
 
-    const int maxPerGroup = tournament->Format().MaxTeamsPerGroup();
-    const std::size_t current  = group->Teams().size();
-    const std::size_t incoming = teams.size();
-    if (static_cast<int>(current + incoming) > maxPerGroup) {
-        return std::unexpected("Group at max capacity");
-    }
+        auto group = groupRead.get();
+        if (!group) {
+            return std::unexpected("Group doesn't exist");
+        }
 
-    for (const auto& team : teams) {
-        auto existing = groupRepository->FindByTournamentIdAndTeamId(tournamentId, team.Id);
-        if (existing) {
-            return std::unexpected("Team " + team.Id +
-                                   " already exists in tournament " + std::string(tournamentId));
+        const int maxPerGroup = tournament->Format().MaxTeamsPerGroup();
+        const std::size_t current  = group->Teams().size();
+        const std::size_t incoming = teams.size();
+        if (static_cast<int>(current + incoming) > maxPerGroup) {
+            return std::unexpected("Group at max capacity");
         }
-    }
 
-    for (const auto& team : teams) {
-        auto persistedTeam = teamRepository->ReadById(team.Id);
-        if (!persistedTeam) {
-            return std::unexpected("Team " + team.Id + " doesn't exist");
+        persistedTeams.reserve(teams.size());
+        for (std::size_t i = 0; i < teams.size(); ++i) {
+            auto persistedTeam = teamReads[i].get();
+            if (!persistedTeam) {
+                return std::unexpected("Team " + teams[i].Id + " doesn't exist");
+            }
+            persistedTeams.push_back(std::move(persistedTeam));
         }
-        groupRepository->UpdateGroupAddTeam(std::string(groupId), persistedTeam);
+    }   // the batch must be finished before the unit writes
+
+    // All or nothing; a team already placed in the tournament is rejected by the database.
+    try {
+        groupRepository->UpdateGroupAddTeams(std::string(groupId), persistedTeams);
+    } catch (const DuplicateEntityError& e) {
+        return std::unexpected("Team " + e.key() + " already exists in tournament " + std::string(tournamentId));
     }
 
+    unit.Commit();
     return {};
 }
 
@@ -175,48 +204,72 @@ std::expected<void, std::string>
 GroupDelegate::AddTeamToGroup(std::string_view tournamentId,
                               std::string_view groupId,
                               std::string_view teamId) {
-    auto tournament = tournamentRepository->ReadById(std::string(tournamentId));
-    if (!tournament) {
-        return std::unexpected("Tournament doesn't exist");
-    }
+    UnitOfWork unit;
+    std::shared_ptr<domain::Tournament> tournament;
+    std::shared_ptr<domain::Group> group;
+    std::shared_ptr<domain::Team> team;
+    {
+        // Tournament, group and team lookups go out together: one round trip.
+        ReadBatch batch;
+        auto tournamentRead = tournamentRepository->DeferReadById(batch, std::string(tournamentId));
+        auto groupRead      = groupRepository->DeferFindByTournamentIdAndGroupId(batch, tournamentId, groupId);
+        auto teamRead       = teamRepository->DeferReadById(batch, teamId);
+
+        tournament = tournamentRead.get();
+        if (!tournament) {
+            return std::unexpected("Tournament doesn't exist");
+        }
 
-    auto group = groupRepository->FindByTournamentIdAndGroupId(tournamentId, groupId);
-    if (!group) {
-        return std::unexpected("Group doesn't exist");
-    }
+        group = groupRead.get();
+        if (!group) {
+            return std::unexpected("Group doesn't exist");
+        }
 
-    auto team = teamRepository->ReadById(std::string(teamId));
-    if (!team) {
-        return std::unexpected("Team doesn't exist");
-    }
+        team = teamRead.get();
+        if (!team) {
+            return std::unexpected("Team doesn't exist");
+        }
 
-    auto existing = groupRepository->FindByTournamentIdAndTeamId(tournamentId, teamId);
-    if (existing) {
-        return std::unexpected("Team " + std::string(teamId) +
-                               " already exists in tournament " + std::string(tournamentId));
-    }
+    }   // the batch must be finished before the unit writes
 
     const int maxPerGroup = tournament->Format().MaxTeamsPerGroup();
     if (static_cast<int>(group->Teams().size()) >= maxPerGroup) {
         return std::unexpected("Group is full");
     }
 
-    groupRepository->UpdateGroupAddTeam(std::string(groupId), team);
-
-    // --- Publish domain event ---
-    if (messageProducer) {
-        nlohmann::json evt;
-        evt["type"]         = "tournament.team.added";
-        evt["tournamentId"] = std::string(tournamentId);
-        evt["groupId"]      = std::string(groupId);
-        evt["teamId"]       = std::string(teamId);
-        evt["occurredAt"]   = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                  std::chrono::system_clock::now().time_since_epoch()
-                              ).count();
+    try {
+        groupRepository->UpdateGroupAddTeam(std::string(groupId), team);
+    } catch (const DuplicateEntityError&) {
+        return std::unexpected("Team " + std::string(teamId) +
+                               " already exists in tournament " + std::string(tournamentId));
+    }
 
-        // Queue name must match your consumer Start("tournament.team-add")
-        messageProducer->SendMessage(evt.dump(), "tournament.team-add");
-        std::cout << "[producer] published tournament.team-add: " << evt.dump() << std::endl;
+    // --- Domain event ---
+    nlohmann::json evt;
+    evt["type"]         = "tournament.team.added";
+    evt["tournamentId"] = std::string(tournamentId);
+    evt["groupId"]      = std::string(groupId);
+    evt["teamId"]       = std::string(teamId);
+    evt["occurredAt"]   = std::chrono::duration_cast<std::chrono::milliseconds>(
+                              std::chrono::system_clock::now().time_since_epoch()
+                          ).count();
+
+    // Queue name must match your consumer Start("tournament.team-add")
+    if (outboxRepository) {
+        // Same transaction as the team: the event exists exactly when the change does.
+        outboxRepository->Enqueue("tournament.team-add", evt.dump());
+        unit.Commit();
+    } else {
+        // Published only once the team is really in the group.
+        unit.Commit();
+        if (messageProducer) {
+            std::optional<std::string> body;
+            if (messageProducer->BinaryEvents()) {
+                body = event_codec::Encode(TeamAddEvent{std::string(tournamentId), std::string(groupId), std::string(teamId)});
+            }
+            messageProducer->SendMessage(body ? *body : evt.dump(), "tournament.team-add");
+            std::cout << "[producer] published tournament.team-add: " << evt.dump() << std::endl;
+        }
     }
 
     return {};
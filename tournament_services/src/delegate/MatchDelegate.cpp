@@ -7,6 +7,10 @@
 #include <stdexcept>
 
 #include "persistence/repository/IMatchRepository.hpp"
+#include "persistence/repository/IStandingsRepository.hpp"
+#include "domain/Standing.hpp"
+#include "domain/WorldCupStrategy.hpp"
+#include "persistence/configuration/UnitOfWork.hpp"
 #include "delegate/ITournamentDelegate.hpp"
 
 using std::string;
@@ -19,12 +23,22 @@ namespace {
 const std::regex UUID_RE_DELEG(
     R"(^[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}$)"
 );
+
+// Same filter values as ReadAll, as the status the page statements filter on ("" = all).
+std::string status_filter(const std::optional<std::string_view>& showFilter) {
+    if (showFilter.has_value() && (*showFilter == "played" || *showFilter == "pending")) {
+        return std::string(*showFilter);
+    }
+    return {};
+}
 }
 
 MatchDelegate::MatchDelegate(std::shared_ptr<IMatchRepository> matchRepo,
-                             std::shared_ptr<ITournamentDelegate> tournamentDel)
+                             std::shared_ptr<ITournamentDelegate> tournamentDel,
+                             std::shared_ptr<IStandingsRepository> standingsRepo)
     : matchRepository(std::move(matchRepo)),
-      tournamentDelegate(std::move(tournamentDel)) {}
+      tournamentDelegate(std::move(tournamentDel)),
+      standingsRepository(std::move(standingsRepo)) {}
 
 // ---------- helpers ----------
 
@@ -49,13 +63,18 @@ MatchDelegate::ReadAll(const std::string& tournamentId,
         throw std::runtime_error("not_found");
     }
 
-    auto t = tournamentDelegate->ReadById(tournamentId);
+    // Tournament check and match list in one round trip.
+    ReadBatch batch;
+    auto tournamentRead = tournamentDelegate->DeferReadById(batch, tournamentId);
+    auto matchesRead    = matchRepository->DeferFindByTournamentId(batch, tournamentId);
+
+    auto t = tournamentRead.get();
     if (!t.has_value()) {
         // Controllers map this runtime_error to HTTP 404.
         throw std::runtime_error("not_found");
     }
 
-    auto matches = matchRepository->FindByTournamentId(tournamentId);
+    auto matches = std::move(matchesRead.get());
 
     if (showFilter.has_value()) {
         const auto f = *showFilter;
@@ -74,12 +93,44 @@ MatchDelegate::ReadAll(const std::string& tournamentId,
     return matches;
 }
 
+JsonPage
+MatchDelegate::ReadJsonPage(const std::string& tournamentId,
+                            const std::optional<std::string_view>& showFilter,
+                            const PageRequest& request) {
+    if (!tournamentDelegate) {
+        throw std::runtime_error("not_found");
+    }
+
+    // Filter applied in SQL so every page is full.
+    ReadBatch batch;
+    auto tournamentRead = tournamentDelegate->DeferReadById(batch, tournamentId);
+    auto pageRead       = matchRepository->DeferFindJsonPageByTournamentId(batch, tournamentId,
+                                                                           status_filter(showFilter), request);
+
+    auto t = tournamentRead.get();
+    if (!t.has_value()) {
+        throw std::runtime_error("not_found");
+    }
+    return std::move(pageRead.get());
+}
+
+std::optional<std::string>
+MatchDelegate::ReadVersion(const std::string& tournamentId) {
+    return matchRepository->FindVersionByTournamentId(tournamentId);
+}
+
 std::shared_ptr<domain::Match>
 MatchDelegate::ReadById(const std::string& tournamentId,
                         const std::string& matchId) {
     return matchRepository->FindByTournamentIdAndMatchId(tournamentId, matchId);
 }
 
+std::optional<std::string>
+MatchDelegate::ReadJsonById(const std::string& tournamentId,
+                            const std::string& matchId) {
+    return matchRepository->FindJsonByTournamentIdAndMatchId(tournamentId, matchId);
+}
+
 // ---------- UpdateScore ----------
 
 std::expected<void, std::string>
@@ -91,11 +142,19 @@ MatchDelegate::UpdateScore(const std::string& tournamentId,
         return std::unexpected("validation:score_out_of_range");
     }
 
+    // Read (row locked), update and standings in one transaction.
+    UnitOfWork unit;
     auto m = matchRepository->FindByTournamentIdAndMatchId(tournamentId, matchId);
     if (!m) {
         return std::unexpected("not_found");
     }
 
+    // Score before this update: a corrected result first takes the old one out of the table.
+    std::optional<domain::Score> previous;
+    if (m->HasScore()) {
+        previous = domain::Score{*m->ScoreHome(), *m->ScoreVisitor()};
+    }
+
     // Set score inside domain entity.
     m->SetScore(homeScore, visitorScore);
 
@@ -118,6 +177,13 @@ MatchDelegate::UpdateScore(const std::string& tournamentId,
 
     try {
         matchRepository->Update(*m);
+        if (standingsRepository && m->Round() == rounds::GROUP) {
+            auto deltas = domain::StandingDeltas(m->Home().Id(), m->Visitor().Id(), previous, {homeScore, visitorScore});
+            if (!deltas.empty()) {
+                standingsRepository->Apply(tournamentId, deltas);
+            }
+        }
+        unit.Commit();
         return {};
     } catch (const std::exception& e) {
         return std::unexpected(std::string("unexpected:") + e.what());
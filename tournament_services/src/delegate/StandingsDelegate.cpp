@@ -0,0 +1,16 @@
+// delegate/StandingsDelegate.cpp
+#include "delegate/StandingsDelegate.hpp"
+#include <utility>
+
+StandingsDelegate::StandingsDelegate(std::shared_ptr<IStandingsRepository> repository)
+    : standingsRepository(std::move(repository)) {}
+
+// Una sola lectura de la tabla materializada: O(equipos), sin recorrer los partidos.
+std::optional<std::string> StandingsDelegate::ReadTournamentStandingsJson(const std::string& tournamentId) {
+    return standingsRepository->FindJsonByTournamentId(tournamentId);
+}
+
+std::optional<std::string> StandingsDelegate::ReadGroupStandingsJson(const std::string& tournamentId,
+                                                                     const std::string& groupId) {
+    return standingsRepository->FindJsonByTournamentIdAndGroupId(tournamentId, groupId);
+}
@@ -1,5 +1,6 @@
 // delegate/TeamDelegate.cpp
 #include "delegate/TeamDelegate.hpp"
+#include "persistence/configuration/UnitOfWork.hpp"
 #include <utility>
 #include <string_view>
 
@@ -9,11 +10,22 @@ TeamDelegate::TeamDelegate(std::shared_ptr<IRepository<domain::Team, std::string
 std::vector<std::shared_ptr<domain::Team>> TeamDelegate::GetAllTeams() {
     return teamRepository->ReadAll();
 }
+
+std::optional<std::string> TeamDelegate::GetTeamJson(std::string_view id) {
+    return teamRepository->ReadJsonById(id);
+}
+
+JsonPage TeamDelegate::GetTeamsJsonPage(const PageRequest& request) {
+    return teamRepository->ReadJsonPage(request);
+}
+
 bool TeamDelegate::UpdateTeam(std::string_view id, const domain::Team& incoming) {
+    UnitOfWork unit;
     if (!teamRepository->ReadById(std::string(id))) return false;  // no existe → 404 en controller
     domain::Team toUpdate = incoming;
     toUpdate.Id = std::string(id);
     teamRepository->Update(toUpdate);
+    unit.Commit();
     return true;
 }
 
@@ -27,14 +39,19 @@ std::string_view TeamDelegate::SaveTeam(const domain::Team& team) {
 }
 
 bool TeamDelegate::DeleteTeam(std::string_view id) {
-    // pre-check con string_view
+    // pre-check, delete y post-check en una sola transacción
+    UnitOfWork unit;
     if (teamRepository->ReadById(id) == nullptr) {
         return false; // not found
     }
     // delete con string_view
     teamRepository->Delete(id);
     // post-check con string_view
-    return teamRepository->ReadById(id) == nullptr;
+    const bool deleted = teamRepository->ReadById(id) == nullptr;
+    if (deleted) {
+        unit.Commit();
+    }
+    return deleted;
 }
 
 
@@ -1,9 +1,13 @@
 #include "delegate/TournamentDelegate.hpp"
+#include "persistence/configuration/UnitOfWork.hpp"
+#include "persistence/repository/RepositoryErrors.hpp"
 
 std::expected<std::string, std::string>
 TournamentDelegate::CreateTournament(std::shared_ptr<domain::Tournament> tournament) {
     try {
         return tournamentRepository->Create(*tournament);
+    } catch (const DuplicateEntityError&) {
+        return std::unexpected(std::string("tournament name already exists"));
     } catch (const std::exception& ex) {
         return std::unexpected(std::string("Failed to create tournament: ") + ex.what());
     }
@@ -18,6 +22,15 @@ TournamentDelegate::ReadAll() {
     }
 }
 
+std::expected<JsonPage, std::string>
+TournamentDelegate::ReadJsonPage(const PageRequest& request) {
+    try {
+        return tournamentRepository->ReadJsonPage(request);
+    } catch (const std::exception& ex) {
+        return std::unexpected(std::string("Failed to read tournaments: ") + ex.what());
+    }
+}
+
 std::expected<std::shared_ptr<domain::Tournament>, std::string>
 TournamentDelegate::ReadById(const std::string& id) {
     try {
@@ -27,9 +40,41 @@ TournamentDelegate::ReadById(const std::string& id) {
     }
 }
 
+std::expected<std::optional<std::string>, std::string>
+TournamentDelegate::ReadVersion(const std::string& id) {
+    try {
+        return tournamentRepository->ReadVersion(id);
+    } catch (const std::exception& ex) {
+        return std::unexpected(std::string("Failed to read tournament version: ") + ex.what());
+    }
+}
+
+std::expected<Versioned<domain::Tournament>, std::string>
+TournamentDelegate::ReadWithVersion(const std::string& id) {
+    try {
+        return tournamentRepository->ReadWithVersion(id);
+    } catch (const std::exception& ex) {
+        return std::unexpected(std::string("Failed to read tournament: ") + ex.what());
+    }
+}
+
+Deferred<std::expected<std::shared_ptr<domain::Tournament>, std::string>>
+TournamentDelegate::DeferReadById(ReadBatch& batch, const std::string& id) {
+    auto read = tournamentRepository->DeferReadById(batch, id);
+    return Deferred<std::expected<std::shared_ptr<domain::Tournament>, std::string>>(
+        [read]() mutable -> std::expected<std::shared_ptr<domain::Tournament>, std::string> {
+            try {
+                return read.get();
+            } catch (const std::exception& ex) {
+                return std::unexpected(std::string("Failed to read tournament: ") + ex.what());
+            }
+        });
+}
+
 std::expected<bool, std::string>
 TournamentDelegate::UpdateTournament(const std::string& id, const domain::Tournament& t) {
     try {
+        UnitOfWork unit;
         if (!tournamentRepository->ReadById(id)) {
             return false; // not found
         }
@@ -37,6 +82,7 @@ TournamentDelegate::UpdateTournament(const std::string& id, const domain::Tourna
         domain::Tournament copy = t;
         copy.Id() = id;
         tournamentRepository->Update(copy);
+        unit.Commit();
         return true;
     } catch (const std::exception& ex) {
         return std::unexpected(std::string("Failed to update tournament: ") + ex.what());
@@ -46,10 +92,12 @@ TournamentDelegate::UpdateTournament(const std::string& id, const domain::Tourna
 std::expected<bool, std::string>
 TournamentDelegate::DeleteTournament(const std::string& id) {
     try {
+        UnitOfWork unit;
         if (!tournamentRepository->ReadById(id)) {
             return false; // not found
         }
         tournamentRepository->Delete(id);
+        unit.Commit();
         return true;
     } catch (const std::exception& ex) {
         return std::unexpected(std::string("Failed to delete tournament: ") + ex.what());
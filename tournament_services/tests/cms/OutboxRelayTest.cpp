@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cms/OutboxRelay.hpp"
+#include "mocks/QueueMessageProducerMock.hpp"
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::StrictMock;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Outbox table in memory, same contract as OutboxRepository.
+class InMemoryOutbox : public IOutboxRepository {
+public:
+    std::mutex mutex;
+    std::vector<OutboxEvent> pending;
+    std::vector<std::int64_t> published;
+    int purges = 0;
+
+    void Enqueue(const std::string& queue, const std::string& payload) override {
+        std::lock_guard lock(mutex);
+        pending.push_back({nextId++, queue, payload});
+    }
+
+    std::size_t PublishPending(std::size_t limit, const std::function<void(const OutboxEvent&)>& publish) override {
+        std::lock_guard lock(mutex);
+        std::size_t count = 0;
+        while (count < limit && !pending.empty()) {
+            publish(pending.front());
+            published.push_back(pending.front().id);
+            pending.erase(pending.begin());
+            ++count;
+        }
+        return count;
+    }
+
+    std::size_t PurgePublished(int) override {
+        std::lock_guard lock(mutex);
+        ++purges;
+        return 0;
+    }
+
+    std::size_t Pending() {
+        std::lock_guard lock(mutex);
+        return pending.size();
+    }
+
+private:
+    std::int64_t nextId = 1;
+};
+
+} // namespace
+
+// Cada evento sale con envío confirmado (no por la cola async) y queda marcado
+TEST(OutboxRelayTest, RunOnce_PublishesConfirmedAndMarks) {
+    auto outbox = std::make_shared<InMemoryOutbox>();
+    auto producer = std::make_shared<StrictMock<QueueMessageProducerMock>>();
+    outbox->Enqueue("tournament.team-add", "a");
+    outbox->Enqueue("tournament.team-add", "b");
+
+    ::testing::InSequence order;
+    EXPECT_CALL(*producer, SendMessageNow(std::string_view{"a"}, std::string_view{"tournament.team-add"}));
+    EXPECT_CALL(*producer, SendMessageNow(std::string_view{"b"}, std::string_view{"tournament.team-add"}));
+
+    OutboxRelay relay{outbox, producer};
+    EXPECT_EQ(relay.RunOnce(), 2u);
+    EXPECT_EQ(outbox->published, (std::vector<std::int64_t>{1, 2}));
+    EXPECT_EQ(relay.Statistics().published, 2u);
+}
+
+// Broker caído: el lote se corta, lo enviado queda marcado y el resto sigue pendiente
+TEST(OutboxRelayTest, RunOnce_SendFails_RestStaysPending) {
+    auto outbox = std::make_shared<InMemoryOutbox>();
+    auto producer = std::make_shared<NiceMock<QueueMessageProducerMock>>();
+    outbox->Enqueue("q", "a");
+    outbox->Enqueue("q", "b");
+    outbox->Enqueue("q", "c");
+
+    EXPECT_CALL(*producer, SendMessageNow(_, _))
+        .WillOnce(::testing::Return())
+        .WillOnce(::testing::Throw(std::runtime_error("broker gone")));
+
+    OutboxRelay relay{outbox, producer};
+    EXPECT_THROW(relay.RunOnce(), std::runtime_error);
+    EXPECT_EQ(outbox->published, (std::vector<std::int64_t>{1}));
+    EXPECT_EQ(outbox->Pending(), 2u);
+}
+
+// Un lote lleno va seguido del siguiente sin esperar el intervalo de sondeo
+TEST(OutboxRelayTest, Start_DrainsFullBatchesWithoutWaiting) {
+    auto outbox = std::make_shared<InMemoryOutbox>();
+    auto producer = std::make_shared<NiceMock<QueueMessageProducerMock>>();
+    for (int i = 0; i < 5; ++i) {
+        outbox->Enqueue("q", std::to_string(i));
+    }
+
+    OutboxRelay relay{outbox, producer};
+    OutboxRelaySettings settings;
+    settings.batchSize = 2;
+    settings.pollInterval = 10s;
+    relay.Configure(settings);
+    relay.Start();
+
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (outbox->Pending() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    relay.Stop();
+
+    EXPECT_EQ(outbox->Pending(), 0u);
+    EXPECT_EQ(relay.Statistics().published, 5u);
+    EXPECT_EQ(outbox->purges, 1);
+}
+
+// "enabled": false deja el outbox sin relay
+TEST(OutboxRelayTest, Disabled_DoesNotStart) {
+    auto outbox = std::make_shared<InMemoryOutbox>();
+    auto producer = std::make_shared<StrictMock<QueueMessageProducerMock>>();
+    outbox->Enqueue("q", "a");
+
+    OutboxRelay relay{outbox, producer};
+    OutboxRelaySettings settings;
+    settings.enabled = false;
+    relay.Configure(settings);
+    relay.Start();
+    relay.Stop();
+
+    EXPECT_EQ(outbox->Pending(), 1u);
+    EXPECT_EQ(relay.Statistics().batches, 0u);
+}
+
+// Con eventos binarios el JSON guardado sale recodificado; lo que no se puede codificar sale como está
+TEST(OutboxRelayTest, BinaryEvents_TranscodesStoredJson) {
+    auto outbox = std::make_shared<InMemoryOutbox>();
+    auto producer = std::make_shared<StrictMock<BinaryEventsProducerMock>>();
+    const TeamAddEvent event{"11111111-2222-3333-4444-555555555555",
+                             "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee",
+                             "0f1e2d3c-4b5a-6978-8796-a5b4c3d2e1f0"};
+    outbox->Enqueue("tournament.team-add",
+                    R"({"type":"tournament.team.added","tournamentId":")" + event.tournamentId +
+                    R"(","groupId":")" + event.groupId + R"(","teamId":")" + event.teamId + R"("})");
+    outbox->Enqueue("tournament.team-add", R"({"type":"tournament.team.added","tournamentId":"T1"})");
+
+    const auto binary = *event_codec::Encode(event);
+    ::testing::InSequence order;
+    EXPECT_CALL(*producer, SendMessageNow(std::string_view{binary}, _));
+    EXPECT_CALL(*producer, SendMessageNow(std::string_view{R"({"type":"tournament.team.added","tournamentId":"T1"})"}, _));
+
+    OutboxRelay relay{outbox, producer};
+    EXPECT_EQ(relay.RunOnce(), 2u);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cms/QueueMessageProducer.hpp"
+
+namespace {
+
+// Records what the producer does with its channels instead of talking to a broker.
+struct Broker {
+    std::mutex mutex;
+    std::vector<std::string> delivered;   // "queue:message", committed only
+    int opened = 0;
+    int commits = 0;
+    std::atomic<int> failuresLeft{0};     // next sends that throw
+};
+
+class FakeChannel : public QueueMessageProducer::Channel {
+    Broker& broker;
+    std::string queue;
+    bool transacted;
+    std::vector<std::string> uncommitted;
+
+public:
+    FakeChannel(Broker& broker, std::string queue, bool transacted)
+        : broker(broker), queue(std::move(queue)), transacted(transacted) {}
+
+    void Send(const std::string& message) override {
+        if (broker.failuresLeft > 0) {
+            --broker.failuresLeft;
+            throw std::runtime_error("broker gone");
+        }
+        if (transacted) {
+            uncommitted.push_back(queue + ":" + message);
+        } else {
+            std::lock_guard lock(broker.mutex);
+            broker.delivered.push_back(queue + ":" + message);
+        }
+    }
+
+    void Commit() override {
+        std::lock_guard lock(broker.mutex);
+        broker.delivered.insert(broker.delivered.end(), uncommitted.begin(), uncommitted.end());
+        uncommitted.clear();
+        ++broker.commits;
+    }
+};
+
+std::unique_ptr<QueueMessageProducer> makeProducer(Broker& broker, ProducerSettings settings) {
+    auto producer = std::make_unique<QueueMessageProducer>(nullptr);
+    producer->UseChannelFactory([&broker](const std::string& queue, bool transacted) {
+        std::lock_guard lock(broker.mutex);
+        ++broker.opened;
+        return std::make_unique<FakeChannel>(broker, queue, transacted);
+    });
+    settings.retryBackoff = std::chrono::milliseconds{1};
+    producer->Configure(settings);
+    return producer;
+}
+
+} // namespace
+
+// Una sesión por cola: los envíos siguientes reutilizan la que quedó en el pool
+TEST(QueueMessageProducerTest, Sync_ReusesChannelPerQueue) {
+    Broker broker;
+    auto producer = makeProducer(broker, {});
+
+    producer->SendMessage("a", "q1");
+    producer->SendMessage("b", "q1");
+    producer->SendMessage("c", "q2");
+
+    EXPECT_EQ(broker.opened, 2);
+    EXPECT_EQ(broker.delivered, (std::vector<std::string>{"q1:a", "q1:b", "q2:c"}));
+    EXPECT_EQ(producer->Statistics().sent, 3u);
+}
+
+// Un canal roto se descarta y el envío se reintenta con uno nuevo
+TEST(QueueMessageProducerTest, Sync_FailedSend_RetriedOnFreshChannel) {
+    Broker broker;
+    auto producer = makeProducer(broker, {});
+    broker.failuresLeft = 1;
+
+    producer->SendMessage("a", "q1");
+
+    EXPECT_EQ(broker.opened, 2);
+    EXPECT_EQ(broker.delivered, (std::vector<std::string>{"q1:a"}));
+    EXPECT_EQ(producer->Statistics().retried, 1u);
+}
+
+// Sin broker después de todos los intentos: el error llega al llamador y se cuenta
+TEST(QueueMessageProducerTest, Sync_AllAttemptsFail_Throws) {
+    Broker broker;
+    ProducerSettings settings;
+    settings.maxAttempts = 2;
+    auto producer = makeProducer(broker, settings);
+    broker.failuresLeft = 2;
+
+    EXPECT_THROW(producer->SendMessage("a", "q1"), std::runtime_error);
+    EXPECT_EQ(producer->Statistics().failed, 1u);
+    EXPECT_TRUE(broker.delivered.empty());
+}
+
+// Async: SendMessage solo encola; el publisher manda en lotes transaccionados y en orden por cola
+TEST(QueueMessageProducerTest, Async_PublishesInBatchesInOrder) {
+    Broker broker;
+    ProducerSettings settings;
+    settings.async = true;
+    settings.batchSize = 4;
+    auto producer = makeProducer(broker, settings);
+
+    for (int i = 0; i < 10; ++i) {
+        producer->SendMessage(std::to_string(i), "q1");
+    }
+    producer->Stop();
+
+    std::vector<std::string> expected;
+    for (int i = 0; i < 10; ++i) {
+        expected.push_back("q1:" + std::to_string(i));
+    }
+    EXPECT_EQ(broker.delivered, expected);
+    EXPECT_GE(broker.commits, 3);
+    EXPECT_LE(broker.commits, 10);
+    EXPECT_EQ(producer->Statistics().sent, 10u);
+    EXPECT_EQ(producer->Statistics().pending, 0u);
+}
+
+// Async: un lote fallido se reintenta completo en una sesión nueva, sin duplicados
+TEST(QueueMessageProducerTest, Async_FailedBatch_RetriedWithoutDuplicates) {
+    Broker broker;
+    ProducerSettings settings;
+    settings.async = true;
+    auto producer = makeProducer(broker, settings);
+    broker.failuresLeft = 1;
+
+    producer->SendMessage("a", "q1");
+    producer->SendMessage("b", "q2");
+    producer->Stop();
+
+    std::sort(broker.delivered.begin(), broker.delivered.end());
+    EXPECT_EQ(broker.delivered, (std::vector<std::string>{"q1:a", "q2:b"}));
+    EXPECT_EQ(producer->Statistics().retried, 1u);
+    EXPECT_EQ(producer->Statistics().failed, 0u);
+}
+
+// Async: lo que falla en todos los intentos queda contado como fallido
+TEST(QueueMessageProducerTest, Async_BatchFailingEveryAttempt_CountedAsFailed) {
+    Broker broker;
+    ProducerSettings settings;
+    settings.async = true;
+    settings.maxAttempts = 2;
+    auto producer = makeProducer(broker, settings);
+    broker.failuresLeft = 2;
+
+    producer->SendMessage("a", "q1");
+    producer->Stop();
+
+    EXPECT_TRUE(broker.delivered.empty());
+    EXPECT_EQ(producer->Statistics().failed, 1u);
+}
+
+// Un evento binario descartado se registra por tamaño y torneo, sin volcar sus bytes
+TEST(QueueMessageProducerTest, Async_DroppedBinaryEvent_LoggedWithoutRawBytes) {
+    Broker broker;
+    ProducerSettings settings;
+    settings.async = true;
+    settings.maxAttempts = 1;
+    auto producer = makeProducer(broker, settings);
+    broker.failuresLeft = 1;
+    const std::string tournamentId = "11111111-2222-3333-4444-555555555555";
+    const auto body = *event_codec::Encode(ScoreUpdateEvent{tournamentId, "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee"});
+
+    testing::internal::CaptureStderr();
+    producer->SendMessage(body, "q1");
+    producer->Stop();
+    const std::string log = testing::internal::GetCapturedStderr();
+
+    EXPECT_NE(log.find("binary event of " + std::to_string(body.size()) + " bytes, tournament " + tournamentId),
+              std::string::npos);
+    EXPECT_EQ(log.find(body), std::string::npos);
+}
+
+// "eventEncoding": "binary" activa los eventos binarios; por defecto siguen en JSON
+TEST(QueueMessageProducerTest, Settings_EventEncoding) {
+    EXPECT_FALSE(nlohmann::json::object().get<ProducerSettings>().binaryEvents);
+    EXPECT_TRUE((nlohmann::json{{"eventEncoding", "binary"}}.get<ProducerSettings>().binaryEvents));
+
+    Broker broker;
+    ProducerSettings settings;
+    settings.binaryEvents = true;
+    auto producer = makeProducer(broker, settings);
+    EXPECT_TRUE(producer->BinaryEvents());
+}
@@ -213,6 +213,18 @@ TEST(GroupControllerTest, GetGroups_Success_200) {
     EXPECT_THAT(res.body, ::testing::HasSubstr("\"teams\""));
 }
 
+// Forma pública de la lista: id, name y teams por grupo, sin tournamentId
+TEST(GroupControllerTest, GetGroups_ResponseShape) {
+    auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
+    auto g1 = mkGroup("G1","A"); g1->TournamentId() = "T1"; g1->Teams().push_back(domain::Team{"T1","One"});
+    EXPECT_CALL(*mock, GetGroups("T1"sv))
+        .WillOnce(Return(std::vector<std::shared_ptr<domain::Group>>{g1}));
+
+    GroupController ctl{mock};
+    auto res = ctl.GetGroups("T1");
+    EXPECT_EQ(res.body, R"([{"id":"G1","name":"A","teams":[{"id":"T1","name":"One"}]}])");
+}
+
 TEST(GroupControllerTest, GetGroups_DelegateError_404) {
     auto mock = std::make_shared<StrictMock<GroupDelegateMock>>();
     EXPECT_CALL(*mock, GetGroups("T1"sv))
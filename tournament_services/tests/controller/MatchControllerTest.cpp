@@ -1,6 +1,5 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
-#include <cstdlib>
 #include <expected>
 #include <memory>
 #include <string>
@@ -13,8 +12,10 @@
 
 #include "controller/MatchController.hpp"
 #include "domain/Match.hpp"
+#include "event/EventCodec.hpp"
 
 #include "mocks/MatchDelegateMock.hpp"
+#include "mocks/QueueMessageProducerMock.hpp"
 
 using ::testing::_;
 using ::testing::Invoke;
@@ -44,12 +45,14 @@ static std::shared_ptr<domain::Match> makeMatch(
     return m;
 }
 
-    struct Fixture {
-    Fixture() {
-        // Disable score publish for all MatchController tests
-        ::setenv("DISABLE_SCORE_PUBLISH", "1", 1);
-    }
+// What the database renders for a page of matches (same shape as the domain JSON).
+static std::string renderedArray(const std::vector<std::shared_ptr<domain::Match>>& matches) {
+    nlohmann::json arr = nlohmann::json::array();
+    for (const auto& m : matches) arr.push_back(*m);
+    return arr.dump();
+}
 
+    struct Fixture {
     std::shared_ptr<StrictMock<MatchDelegateMock>> mock =
         std::make_shared<StrictMock<MatchDelegateMock>>();
     MatchController controller{mock};
@@ -72,8 +75,9 @@ TEST(MatchControllerTest, ReadAll_Success_200_Array) {
     auto m1 = makeMatch("m1", kValidTid, "qf", "h1","H1","v1","V1");
     auto m2 = makeMatch("m2", kValidTid, "sf", "h2","H2","v2","V2","played");
 
-    EXPECT_CALL(*fx.mock, ReadAll(kValidTid, _))
-        .WillOnce(Return(std::vector<std::shared_ptr<domain::Match>>{m1, m2}));
+    EXPECT_CALL(*fx.mock, ReadVersion(kValidTid)).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*fx.mock, ReadJsonPage(kValidTid, _, _))
+        .WillOnce(Return(JsonPage{renderedArray({m1, m2}), std::nullopt}));
 
     crow::request req;
     auto res = fx.controller.ReadAll(req, kValidTid);
@@ -89,13 +93,32 @@ TEST(MatchControllerTest, ReadAll_Success_200_Array) {
     EXPECT_EQ(ct, "application/json");
 }
 
+TEST(MatchControllerTest, ReadAll_NextPage_KeepsFilterInLink) {
+    Fixture fx;
+    auto m1 = makeMatch("m1", kValidTid, "qf", "h1","H1","v1","V1","played");
+    const PageCursor next{"2025-10-02 08:30:00", kValidMid};
+
+    EXPECT_CALL(*fx.mock, ReadVersion(kValidTid)).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*fx.mock, ReadJsonPage(kValidTid, std::optional<std::string_view>{"played"}, _))
+        .WillOnce(Return(JsonPage{renderedArray({m1}), next}));
+
+    crow::request req;
+    req.url_params = crow::query_string("/x?showMatches=played&limit=1");
+    auto res = fx.controller.ReadAll(req, kValidTid);
+    EXPECT_EQ(res.code, crow::OK);
+    EXPECT_EQ(res.get_header_value("Link"),
+              std::string("</tournaments/") + kValidTid + "/matches?limit=1&after="
+              + page_cursor::Encode(next) + "&showMatches=played>; rel=\"next\"");
+}
+
 TEST(MatchControllerTest, ReadAll_DelegateNotFound_404) {
     Fixture fx;
     crow::request req;
 
-    EXPECT_CALL(*fx.mock, ReadAll(kValidTid, _))
+    EXPECT_CALL(*fx.mock, ReadVersion(kValidTid)).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*fx.mock, ReadJsonPage(kValidTid, _, _))
         .WillOnce(Invoke([](const std::string&,
-                            std::optional<std::string_view>) -> std::vector<std::shared_ptr<domain::Match>> {
+                            std::optional<std::string_view>, const PageRequest&) -> JsonPage {
             throw std::runtime_error("not_found");
         }));
 
@@ -108,9 +131,10 @@ TEST(MatchControllerTest, ReadAll_DelegateRuntimeOther_500) {
     Fixture fx;
     crow::request req;
 
-    EXPECT_CALL(*fx.mock, ReadAll(kValidTid, _))
+    EXPECT_CALL(*fx.mock, ReadVersion(kValidTid)).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*fx.mock, ReadJsonPage(kValidTid, _, _))
         .WillOnce(Invoke([](const std::string&,
-                            std::optional<std::string_view>) -> std::vector<std::shared_ptr<domain::Match>> {
+                            std::optional<std::string_view>, const PageRequest&) -> JsonPage {
             throw std::runtime_error("db_error");
         }));
 
@@ -123,9 +147,10 @@ TEST(MatchControllerTest, ReadAll_DelegateUnknownException_500) {
     Fixture fx;
     crow::request req;
 
-    EXPECT_CALL(*fx.mock, ReadAll(kValidTid, _))
+    EXPECT_CALL(*fx.mock, ReadVersion(kValidTid)).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*fx.mock, ReadJsonPage(kValidTid, _, _))
         .WillOnce(Invoke([](const std::string&,
-                            std::optional<std::string_view>) -> std::vector<std::shared_ptr<domain::Match>> {
+                            std::optional<std::string_view>, const PageRequest&) -> JsonPage {
             throw std::logic_error("logic");
         }));
 
@@ -134,6 +159,59 @@ TEST(MatchControllerTest, ReadAll_DelegateUnknownException_500) {
     EXPECT_EQ(res.body, "read matches failed");
 }
 
+TEST(MatchControllerTest, ReadAll_Versioned_200_CarriesETag) {
+    Fixture fx;
+    EXPECT_CALL(*fx.mock, ReadVersion(kValidTid)).WillOnce(Return(std::optional<std::string>{"4.1700"}));
+    EXPECT_CALL(*fx.mock, ReadJsonPage(kValidTid, _, _))
+        .WillOnce(Return(JsonPage{"[]", std::nullopt}));
+
+    crow::request req;
+    auto res = fx.controller.ReadAll(req, kValidTid);
+    EXPECT_EQ(res.code, crow::OK);
+    EXPECT_TRUE(res.get_header_value("ETag").starts_with("\"4.1700-"));
+    EXPECT_EQ(res.get_header_value("Cache-Control"), "no-cache");
+}
+
+TEST(MatchControllerTest, ReadAll_IfNoneMatch_304_WithoutReadingMatches) {
+    Fixture fx;
+    EXPECT_CALL(*fx.mock, ReadVersion(kValidTid))
+        .Times(2).WillRepeatedly(Return(std::optional<std::string>{"4.1700"}));
+    EXPECT_CALL(*fx.mock, ReadJsonPage(kValidTid, _, _))
+        .WillOnce(Return(JsonPage{"[]", std::nullopt}));
+
+    crow::request first;
+    first.url_params = crow::query_string("/x?showMatches=played");
+    const auto etag = fx.controller.ReadAll(first, kValidTid).get_header_value("ETag");
+
+    // Same version and filter: no ReadJsonPage the second time.
+    crow::request again;
+    again.url_params = crow::query_string("/x?showMatches=played");
+    again.headers.emplace("If-None-Match", "\"other\", " + etag);
+    auto res = fx.controller.ReadAll(again, kValidTid);
+    EXPECT_EQ(res.code, crow::NOT_MODIFIED);
+    EXPECT_TRUE(res.body.empty());
+    EXPECT_EQ(res.get_header_value("ETag"), etag);
+}
+
+TEST(MatchControllerTest, ReadAll_IfNoneMatch_OtherFilter_200) {
+    Fixture fx;
+    EXPECT_CALL(*fx.mock, ReadVersion(kValidTid))
+        .Times(2).WillRepeatedly(Return(std::optional<std::string>{"4.1700"}));
+    EXPECT_CALL(*fx.mock, ReadJsonPage(kValidTid, _, _))
+        .Times(2).WillRepeatedly(Return(JsonPage{"[]", std::nullopt}));
+
+    crow::request played;
+    played.url_params = crow::query_string("/x?showMatches=played");
+    const auto etag = fx.controller.ReadAll(played, kValidTid).get_header_value("ETag");
+
+    crow::request pending;
+    pending.url_params = crow::query_string("/x?showMatches=pending");
+    pending.headers.emplace("If-None-Match", etag);
+    auto res = fx.controller.ReadAll(pending, kValidTid);
+    EXPECT_EQ(res.code, crow::OK);
+    EXPECT_NE(res.get_header_value("ETag"), etag);
+}
+
 // ---------- ReadById ----------
 
 TEST(MatchControllerTest, ReadById_BadIds_400) {
@@ -144,8 +222,8 @@ TEST(MatchControllerTest, ReadById_BadIds_400) {
 
 TEST(MatchControllerTest, ReadById_NotFound_404) {
     Fixture fx;
-    EXPECT_CALL(*fx.mock, ReadById(kValidTid, kValidMid))
-        .WillOnce(Return(nullptr));
+    EXPECT_CALL(*fx.mock, ReadJsonById(kValidTid, kValidMid))
+        .WillOnce(Return(std::nullopt));
 
     auto res = fx.controller.ReadById(kValidTid, kValidMid);
     EXPECT_EQ(res.code, crow::NOT_FOUND);
@@ -158,11 +236,13 @@ TEST(MatchControllerTest, ReadById_Success_200) {
     m->SetWinnerTeamId("H");
     m->SetDecidedBy("regularTime");
 
-    EXPECT_CALL(*fx.mock, ReadById(kValidTid, kValidMid))
-        .WillOnce(Return(m));
+    const std::string stored = nlohmann::json(*m).dump();
+    EXPECT_CALL(*fx.mock, ReadJsonById(kValidTid, kValidMid))
+        .WillOnce(Return(stored));
 
     auto res = fx.controller.ReadById(kValidTid, kValidMid);
     EXPECT_EQ(res.code, crow::OK);
+    EXPECT_EQ(res.body, stored);
 
     auto j = nlohmann::json::parse(res.body);
     EXPECT_EQ(j["id"], kValidMid);
@@ -176,9 +256,9 @@ TEST(MatchControllerTest, ReadById_Success_200) {
 TEST(MatchControllerTest, ReadById_DelegateThrows_500) {
     Fixture fx;
 
-    EXPECT_CALL(*fx.mock, ReadById(kValidTid, kValidMid))
+    EXPECT_CALL(*fx.mock, ReadJsonById(kValidTid, kValidMid))
         .WillOnce(Invoke([](const std::string&, const std::string&)
-                         -> std::shared_ptr<domain::Match> {
+                         -> std::optional<std::string> {
             throw std::runtime_error("boom");
         }));
 
@@ -288,6 +368,79 @@ TEST(MatchControllerTest, PatchScore_Success_204) {
     EXPECT_EQ(res.code, crow::NO_CONTENT);
 }
 
+TEST(MatchControllerTest, PatchScore_Success_PublishesScoreRecorded) {
+    auto mock = std::make_shared<StrictMock<MatchDelegateMock>>();
+    auto producer = std::make_shared<StrictMock<QueueMessageProducerMock>>();
+    MatchController controller{mock, producer};
+    crow::request req;
+    req.body = R"({"score":{"home":2,"visitor":1}})";
+
+    EXPECT_CALL(*mock, UpdateScore(kValidTid, kValidMid, 2, 1))
+        .WillOnce(Return(std::expected<void, std::string>{}));
+    EXPECT_CALL(*producer, SendMessage(_, std::string_view{"match.score-recorded"}))
+        .WillOnce(Invoke([](const std::string_view& message, const std::string_view&) {
+            const auto evt = nlohmann::json::parse(message);
+            EXPECT_EQ(evt["type"], "match.score-recorded");
+            EXPECT_EQ(evt["tournamentId"], kValidTid);
+            EXPECT_EQ(evt["matchId"], kValidMid);
+        }));
+
+    auto res = controller.PatchScore(req, kValidTid, kValidMid);
+    EXPECT_EQ(res.code, crow::NO_CONTENT);
+}
+
+// Con la codificación binaria activa el evento sale en el formato compacto
+TEST(MatchControllerTest, PatchScore_BinaryEvents_PublishesBinaryScoreEvent) {
+    auto mock = std::make_shared<StrictMock<MatchDelegateMock>>();
+    auto producer = std::make_shared<StrictMock<BinaryEventsProducerMock>>();
+    MatchController controller{mock, producer};
+    crow::request req;
+    req.body = R"({"score":{"home":2,"visitor":1}})";
+
+    EXPECT_CALL(*mock, UpdateScore(kValidTid, kValidMid, 2, 1))
+        .WillOnce(Return(std::expected<void, std::string>{}));
+    EXPECT_CALL(*producer, SendMessage(_, std::string_view{"match.score-recorded"}))
+        .WillOnce(Invoke([](const std::string_view& message, const std::string_view&) {
+            event_codec::ScoreUpdateView view;
+            ASSERT_TRUE(event_codec::Decode(message, view));
+            const auto evt = event_codec::ToEvent(view);
+            EXPECT_EQ(evt.tournamentId, kValidTid);
+            EXPECT_EQ(evt.matchId, kValidMid);
+        }));
+
+    auto res = controller.PatchScore(req, kValidTid, kValidMid);
+    EXPECT_EQ(res.code, crow::NO_CONTENT);
+}
+
+TEST(MatchControllerTest, PatchScore_PublishFails_Still204) {
+    auto mock = std::make_shared<StrictMock<MatchDelegateMock>>();
+    auto producer = std::make_shared<StrictMock<QueueMessageProducerMock>>();
+    MatchController controller{mock, producer};
+    crow::request req;
+    req.body = R"({"score":{"home":0,"visitor":3}})";
+
+    EXPECT_CALL(*mock, UpdateScore(kValidTid, kValidMid, 0, 3))
+        .WillOnce(Return(std::expected<void, std::string>{}));
+    EXPECT_CALL(*producer, SendMessage(_, _))
+        .WillOnce(::testing::Throw(std::runtime_error("broker down")));
+
+    auto res = controller.PatchScore(req, kValidTid, kValidMid);
+    EXPECT_EQ(res.code, crow::NO_CONTENT);
+}
+
+TEST(MatchControllerTest, PatchScore_Rejected_DoesNotPublish) {
+    auto mock = std::make_shared<StrictMock<MatchDelegateMock>>();
+    auto producer = std::make_shared<StrictMock<QueueMessageProducerMock>>();
+    MatchController controller{mock, producer};
+    crow::request req;
+    req.body = R"({"score":{"home":11,"visitor":0}})";
+
+    EXPECT_CALL(*mock, UpdateScore(kValidTid, kValidMid, 11, 0))
+        .WillOnce(Return(std::unexpected(std::string("validation:score_out_of_range"))));
+
+    auto res = controller.PatchScore(req, kValidTid, kValidMid);
+    EXPECT_EQ(res.code, 422);
+}
 
 // ---------- Create ----------
 
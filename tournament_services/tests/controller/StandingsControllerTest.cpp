@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <stdexcept>
+
+#include "controller/StandingsController.hpp"
+#include "mocks/StandingsDelegateMock.hpp"
+
+using ::testing::StrictMock;
+using ::testing::Return;
+using ::testing::Throw;
+
+namespace {
+const std::string kTid = "550e8400-e29b-41d4-a716-446655440000";
+const std::string kGid = "6f9619ff-8b86-d011-b42d-00cf4fc964ff";
+}
+
+/*
+   Tabla del torneo: el JSON viene armado desde la base y se devuelve tal cual, con HTTP 200
+*/
+TEST(StandingsControllerTest, ReadByTournament_Found_200) {
+    auto mock = std::make_shared<StrictMock<StandingsDelegateMock>>();
+    const std::string body = R"([{"groupId":"g","rank":1,"teamId":"t","points":3}])";
+    EXPECT_CALL(*mock, ReadTournamentStandingsJson(kTid)).WillOnce(Return(body));
+
+    StandingsController ctl{mock};
+    auto res = ctl.ReadByTournament(kTid);
+    EXPECT_EQ(res.code, crow::OK);
+    EXPECT_EQ(res.body, body);
+    EXPECT_EQ(res.get_header_value("content-type"), "application/json");
+}
+
+/*
+   Torneo inexistente: HTTP 404
+*/
+TEST(StandingsControllerTest, ReadByTournament_NotFound_404) {
+    auto mock = std::make_shared<StrictMock<StandingsDelegateMock>>();
+    EXPECT_CALL(*mock, ReadTournamentStandingsJson(kTid)).WillOnce(Return(std::nullopt));
+
+    StandingsController ctl{mock};
+    EXPECT_EQ(ctl.ReadByTournament(kTid).code, crow::NOT_FOUND);
+}
+
+/*
+   ID con formato inválido: HTTP 400 sin llamar al delegate
+*/
+TEST(StandingsControllerTest, InvalidIds_400) {
+    auto mock = std::make_shared<StrictMock<StandingsDelegateMock>>();
+
+    StandingsController ctl{mock};
+    EXPECT_EQ(ctl.ReadByTournament("not-a-uuid").code, crow::BAD_REQUEST);
+    EXPECT_EQ(ctl.ReadByGroup(kTid, "not-a-uuid").code, crow::BAD_REQUEST);
+}
+
+/*
+   Tabla de un grupo: HTTP 200, y 404 cuando el grupo no es del torneo
+*/
+TEST(StandingsControllerTest, ReadByGroup_Found_200_Missing_404) {
+    auto mock = std::make_shared<StrictMock<StandingsDelegateMock>>();
+    const std::string body = R"([{"groupId":"g","rank":1,"teamId":"t","points":0}])";
+    EXPECT_CALL(*mock, ReadGroupStandingsJson(kTid, kGid))
+        .WillOnce(Return(body))
+        .WillOnce(Return(std::nullopt));
+
+    StandingsController ctl{mock};
+    auto found = ctl.ReadByGroup(kTid, kGid);
+    EXPECT_EQ(found.code, crow::OK);
+    EXPECT_EQ(found.body, body);
+    EXPECT_EQ(ctl.ReadByGroup(kTid, kGid).code, crow::NOT_FOUND);
+}
+
+/*
+   Error de base de datos: HTTP 500
+*/
+TEST(StandingsControllerTest, ReadByTournament_DbError_500) {
+    auto mock = std::make_shared<StrictMock<StandingsDelegateMock>>();
+    EXPECT_CALL(*mock, ReadTournamentStandingsJson(kTid)).WillOnce(Throw(std::runtime_error("db down")));
+
+    StandingsController ctl{mock};
+    EXPECT_EQ(ctl.ReadByTournament(kTid).code, crow::INTERNAL_SERVER_ERROR);
+}
@@ -4,6 +4,7 @@
 
 #include "controller/TeamController.hpp"
 #include "mocks/TeamDelegateMock.hpp"
+#include "persistence/repository/RepositoryErrors.hpp"
 
 using ::testing::Invoke;
 using ::testing::NiceMock;
@@ -29,11 +30,9 @@ TEST(TeamControllerTest, SaveTeam_NameDuplicate_Returns409) {
   auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
   TeamController ctl{mock};
 
-  // Simula que el repositorio ya contiene un equipo con el mismo nombre
-  EXPECT_CALL(*mock, GetAllTeams())
-      .WillOnce(Return(std::vector{
-         std::make_shared<domain::Team>(domain::Team{"A1","Eagles"})
-      }));
+  // Simula que el índice único rechaza el nombre (INSERT ... ON CONFLICT); no se listan los equipos
+  EXPECT_CALL(*mock, SaveTeam(::testing::_))
+      .WillOnce(::testing::Throw(DuplicateEntityError("team name already exists", "Eagles")));
 
   crow::request req;
   req.body = R"({"name":"Eagles"})";
@@ -50,7 +49,6 @@ TEST(TeamControllerTest, SaveTeam_ClientIdInvalid_Returns400) {
   auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
   TeamController ctl{mock};
 
-  EXPECT_CALL(*mock, GetAllTeams()).WillOnce(Return(std::vector<std::shared_ptr<domain::Team>>{}));
 
   crow::request req;
   req.body = R"({"id":"bad id con espacios", "name":"Jets"})";
@@ -67,7 +65,6 @@ TEST(TeamControllerTest, SaveTeam_Success_NoClientId_SetsLocationAndJson) {
   auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
   TeamController ctl{mock};
 
-  EXPECT_CALL(*mock, GetAllTeams()).WillOnce(Return(std::vector<std::shared_ptr<domain::Team>>{}));
   EXPECT_CALL(*mock, SaveTeam(::testing::_)).WillOnce(Return(std::string_view{"GEN-123"}));
 
   crow::request req;
@@ -119,7 +116,7 @@ TEST(TeamControllerTest, DeleteTeam_Exception_Returns500) {
     */
 TEST(TeamControllerTest, GetTeam_NotFound_404) {
   auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
-  EXPECT_CALL(*mock, GetTeam("A1"sv)).WillOnce(Return(nullptr));
+  EXPECT_CALL(*mock, GetTeamJson("A1"sv)).WillOnce(Return(std::nullopt));
   TeamController c{mock};
   auto res = c.getTeam("A1");
   EXPECT_EQ(res.code, crow::NOT_FOUND);
@@ -132,10 +129,12 @@ TEST(TeamControllerTest, GetTeam_NotFound_404) {
     */
 TEST(TeamControllerTest, GetTeam_Ok_200_WithJsonAndCT) {
   auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
-  EXPECT_CALL(*mock, GetTeam("T01"sv)).WillOnce(Return(mkTeam("T01","One")));
+  const std::string stored = R"({"id":"T01","name":"One"})";
+  EXPECT_CALL(*mock, GetTeamJson("T01"sv)).WillOnce(Return(stored));
   TeamController c{mock};
   auto res = c.getTeam("T01");
   EXPECT_EQ(res.code, crow::OK);
+  EXPECT_EQ(res.body, stored);  // el JSON de la base se escribe tal cual
   auto it = res.headers.find("content-type");
   ASSERT_NE(it, res.headers.end());
   EXPECT_NE(it->second.find("application/json"), std::string::npos);
@@ -150,9 +149,10 @@ TEST(TeamControllerTest, GetTeam_Ok_200_WithJsonAndCT) {
     */
 TEST(TeamControllerTest, GetAllTeams_Empty_200_Array) {
   auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
-  EXPECT_CALL(*mock, GetAllTeams()).WillOnce(Return(std::vector<std::shared_ptr<domain::Team>>{}));
+  EXPECT_CALL(*mock, GetTeamsJsonPage(::testing::_)).WillOnce(Return(JsonPage{}));
   TeamController c{mock};
-  auto res = c.getAllTeams();
+  crow::request req;
+  auto res = c.getAllTeams(req);
   EXPECT_EQ(res.code, crow::OK);
   auto it = res.headers.find("content-type");
   ASSERT_NE(it, res.headers.end());
@@ -166,10 +166,11 @@ TEST(TeamControllerTest, GetAllTeams_Empty_200_Array) {
     */
 TEST(TeamControllerTest, GetAllTeams_TwoItems_200_Array) {
   auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
-  std::vector<std::shared_ptr<domain::Team>> v{ mkTeam("A","Alpha"), mkTeam("B","Beta") };
-  EXPECT_CALL(*mock, GetAllTeams()).WillOnce(Return(v));
+  const std::string stored = R"([{"id":"A","name":"Alpha"},{"id":"B","name":"Beta"}])";
+  EXPECT_CALL(*mock, GetTeamsJsonPage(::testing::_)).WillOnce(Return(JsonPage{stored, std::nullopt}));
   TeamController c{mock};
-  auto res = c.getAllTeams();
+  crow::request req;
+  auto res = c.getAllTeams(req);
   EXPECT_EQ(res.code, crow::OK);
   json arr = json::parse(res.body);
   ASSERT_EQ(arr.size(), 2u);
@@ -177,6 +178,36 @@ TEST(TeamControllerTest, GetAllTeams_TwoItems_200_Array) {
   EXPECT_EQ(arr[0].at("name"), "Alpha");
 }
 
+/*
+   Paginación: sin parámetros se pide la página por defecto; si hay más filas
+   la respuesta trae el Link a la siguiente página.
+    */
+TEST(TeamControllerTest, GetAllTeams_DefaultPage_SetsNextLink) {
+  auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
+  const PageCursor next{"2025-10-02 08:30:00.123456", "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee"};
+  EXPECT_CALL(*mock, GetTeamsJsonPage(::testing::_))
+      .WillOnce(Invoke([&](const PageRequest& request) {
+          EXPECT_EQ(request.limit, PageRequest::DefaultLimit);
+          EXPECT_FALSE(request.after.has_value());
+          return JsonPage{R"([{"id":"A","name":"Alpha"}])", next};
+      }));
+  TeamController c{mock};
+  crow::request req;
+  auto res = c.getAllTeams(req);
+  EXPECT_EQ(res.code, crow::OK);
+  EXPECT_EQ(res.get_header_value("Link"),
+            "</teams?limit=50&after=" + page_cursor::Encode(next) + ">; rel=\"next\"");
+}
+
+TEST(TeamControllerTest, GetAllTeams_LimitTooLarge_400) {
+  auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
+  TeamController c{mock};
+  crow::request req;
+  req.url_params = crow::query_string("/teams?limit=100000");
+  auto res = c.getAllTeams(req);
+  EXPECT_EQ(res.code, crow::BAD_REQUEST);
+}
+
 /* 
    Al método que procesa la actualización de un equipo, validar la 
    transformación de JSON al objeto de dominio Team y validar que el 
@@ -222,8 +253,6 @@ TEST(TeamControllerTest, SaveTeam_ClientIdAlreadyExists_409) {
   auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
   TeamController ctl{mock};
 
-  EXPECT_CALL(*mock, GetAllTeams())
-      .WillOnce(Return(std::vector<std::shared_ptr<domain::Team>>{}));
   EXPECT_CALL(*mock, GetTeam("A1"sv))
       .WillOnce(Return(mkTeam("A1","Whoever")));
 
@@ -236,8 +265,6 @@ TEST(TeamControllerTest, SaveTeam_ClientIdProvided_Success_201_LocationClientId)
   auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
   TeamController ctl{mock};
 
-  EXPECT_CALL(*mock, GetAllTeams())
-      .WillOnce(Return(std::vector<std::shared_ptr<domain::Team>>{}));
   EXPECT_CALL(*mock, GetTeam("T55"sv))
       .WillOnce(Return(nullptr));
   EXPECT_CALL(*mock, SaveTeam(::testing::_))
@@ -254,8 +281,6 @@ TEST(TeamControllerTest, SaveTeam_SaveThrows_500) {
   auto mock = std::make_shared<StrictMock<TeamDelegateMock>>();
   TeamController ctl{mock};
 
-  EXPECT_CALL(*mock, GetAllTeams())
-      .WillOnce(Return(std::vector<std::shared_ptr<domain::Team>>{}));
   EXPECT_CALL(*mock, SaveTeam(::testing::_))
       .WillOnce(::testing::Invoke([](const domain::Team&) -> std::string_view {
         throw std::runtime_error("boom");
@@ -10,6 +10,7 @@ using namespace std::literals;
 using ::testing::NiceMock;
 using ::testing::StrictMock;
 using ::testing::Return;
+using ::testing::Invoke;
 using nlohmann::json;
 
 /*
@@ -37,10 +38,9 @@ TEST(TournamentControllerTest, Create_NameDuplicate_Returns409) {
     auto grepo = std::make_shared<NiceMock<GroupRepositoryMock>>();
     TournamentController ctl{del, grepo};
 
-    auto t = std::make_shared<domain::Tournament>(
-        domain::Tournament{"NFL 2025", domain::TournamentFormat{2,4,domain::TournamentType::NFL}});
-    t->Id() = "T1";
-    EXPECT_CALL(*del, ReadAll()).WillOnce(Return(std::vector{t}));
+    // El índice único rechaza el nombre; el delegate lo reporta sin listar los torneos
+    EXPECT_CALL(*del, CreateTournament(::testing::_))
+        .WillOnce(Return(std::unexpected(std::string{"tournament name already exists"})));
 
     crow::request req;
     req.body = R"({"name":"NFL 2025","format":{"numberOfGroups":2,"maxTeamsPerGroup":4,"type":"NFL"}})";
@@ -62,7 +62,9 @@ TEST(TournamentControllerTest, ReadById_EmbedsGroups) {
         domain::Tournament{"Copa", domain::TournamentFormat{1,3,domain::TournamentType::ROUND_ROBIN}});
     t->Id() = "T9";
 
-    EXPECT_CALL(*del, ReadById("T9")).WillOnce(Return(t));
+    // Sin If-None-Match no hay consulta de versión aparte: la trae la misma lectura del torneo
+    EXPECT_CALL(*del, ReadWithVersion("T9"))
+        .WillOnce(Return(Versioned<domain::Tournament>{t, "1700.1.1699"}));
 
     auto g = std::make_shared<domain::Group>(domain::Group{"A", "G1"});
     g->TournamentId() = "T9";
@@ -70,10 +72,74 @@ TEST(TournamentControllerTest, ReadById_EmbedsGroups) {
     EXPECT_CALL(*grepo, FindByTournamentId("T9"sv))
         .WillOnce(Return(std::vector{ g }));
 
-    auto res = ctl.ReadById("T9");
+    auto res = ctl.ReadById(crow::request{}, "T9");
     EXPECT_EQ(res.code, crow::OK);
     EXPECT_EQ(res.get_header_value("content-type"), "application/json");
     EXPECT_THAT(std::string(res.body), ::testing::HasSubstr(R"("groups")"));
+    EXPECT_EQ(res.get_header_value("ETag"), R"("1700.1.1699")");
+    EXPECT_EQ(res.get_header_value("Cache-Control"), "no-cache");
+}
+
+/*
+   Con If-None-Match igual a la versión actual: 304 sin leer el torneo ni sus grupos.
+    */
+TEST(TournamentControllerTest, ReadById_IfNoneMatch_304) {
+    auto del = std::make_shared<StrictMock<TournamentDelegateMock>>();
+    auto grepo = std::make_shared<StrictMock<GroupRepositoryMock>>();
+    TournamentController ctl{del, grepo};
+
+    EXPECT_CALL(*del, ReadVersion("T9"))
+        .WillOnce(Return(std::optional<std::string>{"1700.1.1699"}));
+
+    crow::request r;
+    r.headers.emplace("If-None-Match", R"(W/"1700.1.1699")");
+    auto res = ctl.ReadById(r, "T9");
+    EXPECT_EQ(res.code, crow::NOT_MODIFIED);
+    EXPECT_TRUE(res.body.empty());
+    EXPECT_EQ(res.get_header_value("ETag"), R"("1700.1.1699")");
+}
+
+/*
+   Versión vieja en If-None-Match: 200 con el cuerpo y la ETag nueva.
+    */
+TEST(TournamentControllerTest, ReadById_StaleIfNoneMatch_200) {
+    auto del = std::make_shared<StrictMock<TournamentDelegateMock>>();
+    auto grepo = std::make_shared<NiceMock<GroupRepositoryMock>>();
+    TournamentController ctl{del, grepo};
+
+    EXPECT_CALL(*del, ReadVersion("T9"))
+        .WillOnce(Return(std::optional<std::string>{"1800.1.1699"}));
+    EXPECT_CALL(*del, ReadWithVersion("T9"))
+        .WillOnce(Return(Versioned<domain::Tournament>{mkT("T9", "Copa", 1, 3, domain::TournamentType::ROUND_ROBIN),
+                                                       "1800.1.1699"}));
+
+    crow::request r;
+    r.headers.emplace("If-None-Match", R"("1700.1.1699")");
+    auto res = ctl.ReadById(r, "T9");
+    EXPECT_EQ(res.code, crow::OK);
+    EXPECT_EQ(res.get_header_value("ETag"), R"("1800.1.1699")");
+}
+
+/*
+   La ETag es la versión leída junto con el torneo, no la de la comprobación del 304:
+   si el torneo cambió entre ambas lecturas, la ETag nombra el cuerpo que se envía.
+    */
+TEST(TournamentControllerTest, ReadById_EtagIsTheVersionReadWithTheBody) {
+    auto del = std::make_shared<StrictMock<TournamentDelegateMock>>();
+    auto grepo = std::make_shared<NiceMock<GroupRepositoryMock>>();
+    TournamentController ctl{del, grepo};
+
+    EXPECT_CALL(*del, ReadVersion("T9"))
+        .WillOnce(Return(std::optional<std::string>{"1800.1.1699"}));
+    EXPECT_CALL(*del, ReadWithVersion("T9"))
+        .WillOnce(Return(Versioned<domain::Tournament>{mkT("T9", "Copa", 1, 3, domain::TournamentType::ROUND_ROBIN),
+                                                       "1900.1.1699"}));
+
+    crow::request r;
+    r.headers.emplace("If-None-Match", R"("1700.1.1699")");
+    auto res = ctl.ReadById(r, "T9");
+    EXPECT_EQ(res.code, crow::OK);
+    EXPECT_EQ(res.get_header_value("ETag"), R"("1900.1.1699")");
 }
 
 /*
@@ -105,7 +171,6 @@ TEST(TournamentControllerTest, Create_MissingName_400) {
     */
 TEST(TournamentControllerTest, Create_Success_201_LocationBodyCT) {
   auto mock = std::make_shared<StrictMock<TournamentDelegateMock>>();
-  EXPECT_CALL(*mock, ReadAll()).WillOnce(Return(std::vector<std::shared_ptr<domain::Tournament>>{}));
   EXPECT_CALL(*mock, CreateTournament(::testing::_)).WillOnce(Return(std::string{"t-001"}));
 
   TournamentController c{mock, {}};
@@ -127,9 +192,10 @@ TEST(TournamentControllerTest, Create_Success_201_LocationBodyCT) {
     */
 TEST(TournamentControllerTest, ReadAll_Empty_200_Array) {
   auto mock = std::make_shared<StrictMock<TournamentDelegateMock>>();
-  EXPECT_CALL(*mock, ReadAll()).WillOnce(Return(std::vector<std::shared_ptr<domain::Tournament>>{}));
+  EXPECT_CALL(*mock, ReadJsonPage(::testing::_)).WillOnce(Return(JsonPage{}));
   TournamentController c{mock, {}};
-  auto res = c.ReadAll();
+  crow::request req;
+  auto res = c.ReadAll(req);
   EXPECT_EQ(res.code, crow::OK);
   auto ct = res.headers.find("content-type");
   ASSERT_NE(ct, res.headers.end());
@@ -143,18 +209,58 @@ TEST(TournamentControllerTest, ReadAll_Empty_200_Array) {
     */
 TEST(TournamentControllerTest, ReadAll_Two_200_Array) {
   auto mock = std::make_shared<StrictMock<TournamentDelegateMock>>();
-  std::vector<std::shared_ptr<domain::Tournament>> v {
-    mkT("a1","Alpha",2,4,domain::TournamentType::ROUND_ROBIN),
-    mkT("b2","Beta",3,5,domain::TournamentType::NFL)
-  };
-  EXPECT_CALL(*mock, ReadAll()).WillOnce(Return(v));
+  const std::string stored =
+    R"([{"id":"a1","name":"Alpha","format":{"numberOfGroups":2,"maxTeamsPerGroup":4,"type":"ROUND_ROBIN"}},)"
+    R"({"id":"b2","name":"Beta","format":{"numberOfGroups":3,"maxTeamsPerGroup":5,"type":"NFL"}}])";
+  EXPECT_CALL(*mock, ReadJsonPage(::testing::_)).WillOnce(Return(JsonPage{stored, std::nullopt}));
   TournamentController c{mock, {}};
-  auto res = c.ReadAll();
+  crow::request req;
+  auto res = c.ReadAll(req);
   EXPECT_EQ(res.code, crow::OK);
+  EXPECT_EQ(res.body, stored);
   json arr = json::parse(res.body);
   ASSERT_EQ(arr.size(), 2u);
   EXPECT_EQ(arr[1].at("id"), "b2");
   EXPECT_EQ(arr[1].at("format").at("type"), "NFL");
+  EXPECT_EQ(res.get_header_value("Link"), "");
+}
+
+/*
+   Paginación: limit y after llegan al delegate y la respuesta enlaza la página siguiente.
+    */
+TEST(TournamentControllerTest, ReadAll_MorePages_PassesCursorAndSetsNextLink) {
+  auto mock = std::make_shared<StrictMock<TournamentDelegateMock>>();
+  const PageCursor after{"2025-10-01 10:00:00.5", "11111111-2222-3333-4444-555555555555"};
+  const PageCursor next{"2025-10-02 08:30:00", "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee"};
+
+  EXPECT_CALL(*mock, ReadJsonPage(::testing::_))
+      .WillOnce(Invoke([&](const PageRequest& request) -> std::expected<JsonPage, std::string> {
+          EXPECT_EQ(request.limit, 1u);
+          EXPECT_TRUE(request.after.has_value());
+          EXPECT_EQ(request.after->id, after.id);
+          EXPECT_EQ(request.after->createdAt, after.createdAt);
+          return JsonPage{R"([{"id":"a1","name":"Alpha"}])", next};
+      }));
+  TournamentController c{mock, {}};
+  crow::request req;
+  req.url_params = crow::query_string("/tournaments?limit=1&after=" + page_cursor::Encode(after));
+  auto res = c.ReadAll(req);
+  EXPECT_EQ(res.code, crow::OK);
+  EXPECT_EQ(res.get_header_value("Link"),
+            "</tournaments?limit=1&after=" + page_cursor::Encode(next) + ">; rel=\"next\"");
+}
+
+TEST(TournamentControllerTest, ReadAll_InvalidPageParams_400) {
+  auto mock = std::make_shared<StrictMock<TournamentDelegateMock>>();
+  TournamentController c{mock, {}};
+
+  crow::request badLimit;
+  badLimit.url_params = crow::query_string("/tournaments?limit=0");
+  EXPECT_EQ(c.ReadAll(badLimit).code, crow::BAD_REQUEST);
+
+  crow::request badCursor;
+  badCursor.url_params = crow::query_string("/tournaments?after=not-a-cursor");
+  EXPECT_EQ(c.ReadAll(badCursor).code, crow::BAD_REQUEST);
 }
 
 /*
@@ -165,9 +271,9 @@ TEST(TournamentControllerTest, ReadAll_Two_200_Array) {
 TEST(TournamentControllerTest, ReadById_NotFound_404) {
   auto del = std::make_shared<StrictMock<TournamentDelegateMock>>();
   auto grepo = std::make_shared<NiceMock<GroupRepositoryMock>>();
-  EXPECT_CALL(*del, ReadById("X9")).WillOnce(Return(nullptr));
+  EXPECT_CALL(*del, ReadWithVersion("X9")).WillOnce(Return(Versioned<domain::Tournament>{}));
   TournamentController ctl{del, grepo};
-  auto res = ctl.ReadById("X9");
+  auto res = ctl.ReadById(crow::request{}, "X9");
   EXPECT_EQ(res.code, crow::NOT_FOUND);
 }
 
@@ -238,22 +344,8 @@ TEST(TournamentControllerTest, Delete_Success_204) {
 }
 // === Extra coverage for TournamentController error branches and esc(id) ===
 
-TEST(TournamentControllerTest, Create_ReadAllUnexpected_500) {
-  auto mock = std::make_shared<StrictMock<TournamentDelegateMock>>();
-  TournamentController c{mock, {}};
-
-  EXPECT_CALL(*mock, ReadAll())
-      .WillOnce(Return(std::unexpected(std::string{"db list error"})));
-
-  auto res = c.CreateTournament(req(R"({"name":"X","format":{"numberOfGroups":1,"maxTeamsPerGroup":4,"type":"NFL"}})"));
-  EXPECT_EQ(res.code, crow::INTERNAL_SERVER_ERROR);
-  EXPECT_THAT(std::string(res.body), ::testing::HasSubstr("db list error"));
-}
-
 TEST(TournamentControllerTest, Create_DelegateCreateUnexpected_500) {
   auto mock = std::make_shared<StrictMock<TournamentDelegateMock>>();
-  EXPECT_CALL(*mock, ReadAll())
-      .WillOnce(Return(std::vector<std::shared_ptr<domain::Tournament>>{}));
   EXPECT_CALL(*mock, CreateTournament(::testing::_))
       .WillOnce(Return(std::unexpected(std::string{"insert fail"})));
 
@@ -265,8 +357,6 @@ TEST(TournamentControllerTest, Create_DelegateCreateUnexpected_500) {
 
 TEST(TournamentControllerTest, Create_Success_EscapesIdInBody) {
   auto mock = std::make_shared<StrictMock<TournamentDelegateMock>>();
-  EXPECT_CALL(*mock, ReadAll())
-      .WillOnce(Return(std::vector<std::shared_ptr<domain::Tournament>>{}));
   // id with quotes, backslash and newline to hit esc() branches
   std::string specialId = "t-\"q\\n";
   EXPECT_CALL(*mock, CreateTournament(::testing::_))
@@ -284,10 +374,11 @@ TEST(TournamentControllerTest, Create_Success_EscapesIdInBody) {
 
 TEST(TournamentControllerTest, ReadAll_Unexpected_500) {
   auto mock = std::make_shared<StrictMock<TournamentDelegateMock>>();
-  EXPECT_CALL(*mock, ReadAll())
+  EXPECT_CALL(*mock, ReadJsonPage(::testing::_))
       .WillOnce(Return(std::unexpected(std::string{"boom"})));
   TournamentController c{mock, {}};
-  auto res = c.ReadAll();
+  crow::request req;
+  auto res = c.ReadAll(req);
   EXPECT_EQ(res.code, crow::INTERNAL_SERVER_ERROR);
   EXPECT_THAT(std::string(res.body), ::testing::HasSubstr("boom"));
 }
@@ -295,10 +386,10 @@ TEST(TournamentControllerTest, ReadAll_Unexpected_500) {
 TEST(TournamentControllerTest, ReadById_Unexpected_500) {
   auto del = std::make_shared<StrictMock<TournamentDelegateMock>>();
   auto grepo = std::make_shared<NiceMock<GroupRepositoryMock>>();
-  EXPECT_CALL(*del, ReadById("E1"))
+  EXPECT_CALL(*del, ReadWithVersion("E1"))
       .WillOnce(Return(std::unexpected(std::string{"err"})));
   TournamentController ctl{del, grepo};
-  auto res = ctl.ReadById("E1");
+  auto res = ctl.ReadById(crow::request{}, "E1");
   EXPECT_EQ(res.code, crow::INTERNAL_SERVER_ERROR);
   EXPECT_THAT(std::string(res.body), ::testing::HasSubstr("err"));
 }
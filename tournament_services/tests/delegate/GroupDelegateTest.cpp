@@ -5,17 +5,18 @@
 #include <string>
 #include <string_view>
 #include <vector>
+#include <nlohmann/json.hpp>
 
 #include "delegate/GroupDelegate.hpp"
 #include "mocks/GroupRepositoryMock.hpp"
 #include "mocks/TournamentRepositoryMock.h"
 #include "mocks/TeamRepositoryMock.h"
 #include "mocks/QueueMessageProducerMock.hpp"
+#include "mocks/OutboxRepositoryMock.hpp"
 
 #include "domain/Group.hpp"
 #include "domain/Team.hpp"
 #include "domain/Tournament.hpp"
-#include "domain/Utilities.hpp"
 
 using ::testing::StrictMock;
 using ::testing::NiceMock;
@@ -262,7 +263,6 @@ TEST(GroupDelegateTest, AddTeamToGroup_Success) {
   auto g = mkG("G5","Alpha","T5");
   EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T5"sv,"G5"sv)).WillOnce(Return(g));
   EXPECT_CALL(*teamr, ReadById("E2"sv)).WillOnce(Return(mkTeam("E2","N2")));
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T5"sv,"E2"sv)).WillOnce(Return(nullptr));
   EXPECT_CALL(*grepo, UpdateGroupAddTeam("G5"sv, ::testing::_)).Times(1);
 
   auto r = sut.AddTeamToGroup("T5","G5","E2");
@@ -311,7 +311,6 @@ TEST(GroupDelegateTest, AddTeamToGroup_GroupFull_ReturnsError) {
   g->Teams().push_back(domain::Team{"E0","A"}); // grupo lleno
   EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T4"sv,"G4"sv)).WillOnce(Return(g));
   EXPECT_CALL(*teamr, ReadById("E2"sv)).WillOnce(Return(mkTeam("E2","N2")));
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T4"sv,"E2"sv)).WillOnce(Return(nullptr));
 
   auto r = sut.AddTeamToGroup("T4","G4","E2");
   ASSERT_FALSE(r.has_value());
@@ -346,9 +345,9 @@ TEST(GroupDelegateTest, CreateGroup_TeamAlreadyInTournament_ReturnsError) {
   auto t = mkT("T1","Tour",2,4,domain::TournamentType::NFL);
   EXPECT_CALL(*trepo, ReadById("T1")).WillOnce(Return(t));
   EXPECT_CALL(*teamr, ReadById("E1"sv)).WillOnce(Return(mkTeam("E1","X")));
-  // already present in tournament
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T1"sv,"E1"sv))
-      .WillOnce(Return(mkG("GZ","Z","T1")));
+  // already present in tournament: the membership unique index rejects the insert
+  EXPECT_CALL(*grepo, Create(::testing::_))
+      .WillOnce(::testing::Throw(DuplicateEntityError("duplicate", "E1")));
 
   GroupDelegate sut{trepo, grepo, teamr, qprod};
   domain::Group g; g.Name()="G"; g.Teams()={{"E1","X"}};
@@ -531,8 +530,9 @@ TEST(GroupDelegateTest, UpdateTeams_DuplicateInTournament_ReturnsError) {
   EXPECT_CALL(*trepo, ReadById("T1")).WillOnce(Return(t));
   auto g = mkG("G1","A","T1"); // current = 0
   EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T1"sv,"G1"sv)).WillOnce(Return(g));
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T1"sv,"E1"sv))
-      .WillOnce(Return(mkG("Gx","x","T1"))); // duplicate found
+  EXPECT_CALL(*teamr, ReadById("E1"sv)).WillOnce(Return(mkTeam("E1","A")));
+  EXPECT_CALL(*grepo, UpdateGroupAddTeam("G1"sv, ::testing::_))
+      .WillOnce(::testing::Throw(DuplicateEntityError("duplicate", "E1"))); // duplicate found
 
   GroupDelegate sut{trepo, grepo, teamr, qprod};
   auto r = sut.UpdateTeams("T1","G1", std::vector<domain::Team>{{"E1","A"}});
@@ -550,8 +550,6 @@ TEST(GroupDelegateTest, UpdateTeams_TeamMissing_ReturnsError) {
   EXPECT_CALL(*trepo, ReadById("T1")).WillOnce(Return(t));
   auto g = mkG("G1","A","T1");
   EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T1"sv,"G1"sv)).WillOnce(Return(g));
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T1"sv,"E404"sv))
-      .WillOnce(Return(nullptr));
   EXPECT_CALL(*teamr, ReadById("E404"sv))
       .WillOnce(Return(nullptr)); // missing
 
@@ -572,11 +570,6 @@ TEST(GroupDelegateTest, UpdateTeams_Success_AddsAllTeams) {
   auto g = mkG("G1","A","T1");
   EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T1"sv,"G1"sv))
       .WillOnce(Return(g));
-  // no duplicates
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T1"sv,"E1"sv))
-      .WillOnce(Return(nullptr));
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T1"sv,"E2"sv))
-      .WillOnce(Return(nullptr));
   // both teams exist
   EXPECT_CALL(*teamr, ReadById("E1"sv)).WillOnce(Return(mkTeam("E1","A")));
   EXPECT_CALL(*teamr, ReadById("E2"sv)).WillOnce(Return(mkTeam("E2","B")));
@@ -629,12 +622,62 @@ TEST(GroupDelegateTest, AddTeamToGroup_AlreadyExists_ReturnsError) {
   EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T1"sv,"G1"sv))
       .WillOnce(Return(mkG("G1","A","T1")));
   EXPECT_CALL(*teamr, ReadById("E1"sv)).WillOnce(Return(mkTeam("E1","A")));
-  // duplicate in tournament
-  EXPECT_CALL(*grepo, FindByTournamentIdAndTeamId("T1"sv,"E1"sv))
-      .WillOnce(Return(mkG("GZ","Z","T1")));
+  // duplicate in tournament: rejected on write
+  EXPECT_CALL(*grepo, UpdateGroupAddTeam("G1"sv, ::testing::_))
+      .WillOnce(::testing::Throw(DuplicateEntityError("duplicate", "E1")));
 
   GroupDelegate sut{trepo, grepo, teamr, qprod};
   auto r = sut.AddTeamToGroup("T1","G1","E1");
   ASSERT_FALSE(r.has_value());
   EXPECT_THAT(r.error(), ::testing::HasSubstr("Team E1 already exists in tournament T1"));
 }
+
+// ---- AddTeamToGroup with the outbox ----
+// El evento se escribe en el outbox (misma transacción) y no se publica directo
+TEST(GroupDelegateTest, AddTeamToGroup_WithOutbox_EnqueuesEventInsteadOfPublishing) {
+  auto trepo = std::make_shared<StrictMock<TournamentRepositoryMock>>();
+  auto grepo = std::make_shared<StrictMock<GroupRepositoryMock>>();
+  auto teamr = std::make_shared<StrictMock<TeamRepositoryMock>>();
+  auto qprod = std::make_shared<StrictMock<QueueMessageProducerMock>>();
+  auto outbox = std::make_shared<StrictMock<OutboxRepositoryMock>>();
+
+  EXPECT_CALL(*trepo, ReadById("T5")).WillOnce(Return(mkT("T5","Tour",1,2,domain::TournamentType::NFL)));
+  EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T5"sv,"G5"sv)).WillOnce(Return(mkG("G5","Alpha","T5")));
+  EXPECT_CALL(*teamr, ReadById("E2"sv)).WillOnce(Return(mkTeam("E2","N2")));
+  ::testing::InSequence order;
+  EXPECT_CALL(*grepo, UpdateGroupAddTeam("G5"sv, ::testing::_)).Times(1);
+  std::string payload;
+  EXPECT_CALL(*outbox, Enqueue("tournament.team-add", ::testing::_))
+      .WillOnce(::testing::SaveArg<1>(&payload));
+
+  GroupDelegate sut{trepo, grepo, teamr, qprod};
+  sut.UseOutbox(outbox);
+  auto r = sut.AddTeamToGroup("T5","G5","E2");
+
+  ASSERT_TRUE(r.has_value());
+  const auto evt = nlohmann::json::parse(payload);
+  EXPECT_EQ(evt["type"], "tournament.team.added");
+  EXPECT_EQ(evt["tournamentId"], "T5");
+  EXPECT_EQ(evt["groupId"], "G5");
+  EXPECT_EQ(evt["teamId"], "E2");
+}
+
+// Equipo repetido: no hay cambio, así que tampoco evento
+TEST(GroupDelegateTest, AddTeamToGroup_WithOutbox_AlreadyExists_NoEvent) {
+  auto trepo = std::make_shared<StrictMock<TournamentRepositoryMock>>();
+  auto grepo = std::make_shared<StrictMock<GroupRepositoryMock>>();
+  auto teamr = std::make_shared<StrictMock<TeamRepositoryMock>>();
+  auto qprod = std::make_shared<StrictMock<QueueMessageProducerMock>>();
+  auto outbox = std::make_shared<StrictMock<OutboxRepositoryMock>>();
+
+  EXPECT_CALL(*trepo, ReadById("T1")).WillOnce(Return(mkT("T1","T",1,3,domain::TournamentType::NFL)));
+  EXPECT_CALL(*grepo, FindByTournamentIdAndGroupId("T1"sv,"G1"sv)).WillOnce(Return(mkG("G1","A","T1")));
+  EXPECT_CALL(*teamr, ReadById("E1"sv)).WillOnce(Return(mkTeam("E1","A")));
+  EXPECT_CALL(*grepo, UpdateGroupAddTeam("G1"sv, ::testing::_))
+      .WillOnce(::testing::Throw(DuplicateEntityError("duplicate", "E1")));
+
+  GroupDelegate sut{trepo, grepo, teamr, qprod};
+  sut.UseOutbox(outbox);
+  auto r = sut.AddTeamToGroup("T1","G1","E1");
+  ASSERT_FALSE(r.has_value());
+}
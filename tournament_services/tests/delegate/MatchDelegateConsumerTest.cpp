@@ -21,6 +21,7 @@
 #include "mocks/MatchRepositoryMock.hpp"
 #include "mocks/GroupRepositoryMock.hpp"
 #include "mocks/TournamentRepositoryMock.h"
+#include "mocks/StandingsRepositoryMock.hpp"
 
 using ::testing::NiceMock;
 
@@ -47,6 +48,7 @@ struct Fixture {
     NiceMock<MatchRepositoryMock>      matchRepoMock;
     NiceMock<GroupRepositoryMock>      groupRepoMock;
     NiceMock<TournamentRepositoryMock> tournamentRepoMock;
+    NiceMock<StandingsRepositoryMock>  standingsRepoMock;
 
     // Non-owning shared_ptr wrappers (no delete)
     std::shared_ptr<IMatchRepository> matchRepo{
@@ -59,7 +61,11 @@ struct Fixture {
         &tournamentRepoMock, [](TournamentRepository*){}
     };
 
-    MatchDelegate delegate{matchRepo, groupRepo, tournamentRepo};
+    std::shared_ptr<IStandingsRepository> standingsRepo{
+        &standingsRepoMock, [](IStandingsRepository*){}
+    };
+
+    MatchDelegate delegate{matchRepo, groupRepo, tournamentRepo, standingsRepo};
 };
 
 } // namespace
@@ -148,3 +154,115 @@ TEST(MatchDelegateWorldCupTest,
 
     fx.delegate.ProcessScoreUpdate(evt);
 }
+
+// ---------------------------------------------------------------------
+// ProcessTeamAddition: ready tournament inserts the whole fixture in one batch
+// ---------------------------------------------------------------------
+TEST(MatchDelegateWorldCupTest,
+     ProcessTeamAddition_TournamentReady_CreatesGroupMatchesInOneBatch) {
+    Fixture fx;
+
+    TeamAddEvent evt{};
+    evt.tournamentId = "TID-5";
+    evt.groupId      = "G1";
+    evt.teamId       = "A1";
+
+    auto tour = std::make_shared<domain::Tournament>(
+        "World Cup", domain::TournamentFormat{2, 3});
+    tour->Id() = "TID-5";
+    auto g1 = makeGroup("G1", "Group 1", {"A1", "A2", "A3"});
+    auto g2 = makeGroup("G2", "Group 2", {"B1", "B2", "B3"});
+
+    ON_CALL(fx.tournamentRepoMock, ReadById(::testing::_)).WillByDefault(::testing::Return(tour));
+    ON_CALL(fx.groupRepoMock, FindByTournamentIdAndGroupId(::testing::_, ::testing::_)).WillByDefault(::testing::Return(g1));
+    ON_CALL(fx.groupRepoMock, FindByTournamentId(::testing::_))
+        .WillByDefault(::testing::Return(std::vector<std::shared_ptr<domain::Group>>{g1, g2}));
+
+    EXPECT_CALL(fx.matchRepoMock, Create(::testing::_)).Times(0);
+    EXPECT_CALL(fx.matchRepoMock, CreateBatch(::testing::SizeIs(6)))
+        .WillOnce(::testing::Return(std::vector<std::string>(6, "M")));
+
+    fx.delegate.ProcessTeamAddition(evt);
+}
+
+// ---------------------------------------------------------------------
+// ProcessScoreUpdate: qualified teams come from the standings table
+// ---------------------------------------------------------------------
+TEST(MatchDelegateWorldCupTest,
+     ProcessScoreUpdate_AllGroupMatchesPlayed_BracketFromStandings) {
+    Fixture fx;
+
+    ScoreUpdateEvent evt{};
+    evt.tournamentId = "TID-6";
+
+    auto tour = std::make_shared<domain::Tournament>("World Cup", domain::TournamentFormat{2, 2});
+    tour->Id() = "TID-6";
+    auto g1 = makeGroup("G1", "Group 1", {"A1", "A2"});
+    auto g2 = makeGroup("G2", "Group 2", {"B1", "B2"});
+
+    auto played = std::make_shared<domain::Match>();
+    played->Round() = rounds::GROUP;
+    played->SetScore(1, 0);
+
+    auto row = [](std::string group, std::string team, int points) {
+        domain::Standing s;
+        s.groupId = std::move(group);
+        s.teamId = team;
+        s.teamName = std::move(team);
+        s.played = 1;
+        s.points = points;
+        return s;
+    };
+
+    ON_CALL(fx.matchRepoMock, FindByTournamentId(::testing::_))
+        .WillByDefault(::testing::Return(std::vector<std::shared_ptr<domain::Match>>{played}));
+    ON_CALL(fx.tournamentRepoMock, ReadById(::testing::_)).WillByDefault(::testing::Return(tour));
+    ON_CALL(fx.groupRepoMock, FindByTournamentId(::testing::_))
+        .WillByDefault(::testing::Return(std::vector<std::shared_ptr<domain::Group>>{g1, g2}));
+    // A2 and B2 lead their groups
+    EXPECT_CALL(fx.standingsRepoMock, FindByTournamentId("TID-6"))
+        .WillOnce(::testing::Return(std::vector<domain::Standing>{
+            row("G1", "A2", 3), row("G1", "A1", 0), row("G2", "B2", 3), row("G2", "B1", 0)}));
+
+    EXPECT_CALL(fx.matchRepoMock, CreateBatch(::testing::_))
+        .WillOnce(::testing::Invoke([](const std::vector<domain::Match>& created) {
+            EXPECT_EQ(created.size(), 2u);
+            if (created.size() == 2) {
+                EXPECT_EQ(created[0].Home().Id(), "A2");
+                EXPECT_EQ(created[0].Visitor().Id(), "B1");
+                EXPECT_EQ(created[1].Home().Id(), "B2");
+                EXPECT_EQ(created[1].Visitor().Id(), "A1");
+            }
+            return std::vector<std::string>(created.size(), "M");
+        }));
+
+    fx.delegate.ProcessScoreUpdate(evt);
+}
+
+// ---------------------------------------------------------------------
+// ProcessTeamAddition: a failed insert reaches the listener, which rolls the event back
+// ---------------------------------------------------------------------
+TEST(MatchDelegateWorldCupTest,
+     ProcessTeamAddition_CreateBatchFails_Throws) {
+    Fixture fx;
+
+    TeamAddEvent evt{};
+    evt.tournamentId = "TID-7";
+    evt.groupId      = "G1";
+    evt.teamId       = "A1";
+
+    auto tour = std::make_shared<domain::Tournament>(
+        "World Cup", domain::TournamentFormat{2, 3});
+    tour->Id() = "TID-7";
+    auto g1 = makeGroup("G1", "Group 1", {"A1", "A2", "A3"});
+    auto g2 = makeGroup("G2", "Group 2", {"B1", "B2", "B3"});
+
+    ON_CALL(fx.tournamentRepoMock, ReadById(::testing::_)).WillByDefault(::testing::Return(tour));
+    ON_CALL(fx.groupRepoMock, FindByTournamentIdAndGroupId(::testing::_, ::testing::_)).WillByDefault(::testing::Return(g1));
+    ON_CALL(fx.groupRepoMock, FindByTournamentId(::testing::_))
+        .WillByDefault(::testing::Return(std::vector<std::shared_ptr<domain::Group>>{g1, g2}));
+    EXPECT_CALL(fx.matchRepoMock, CreateBatch(::testing::_))
+        .WillOnce(::testing::Throw(std::runtime_error("connection lost")));
+
+    EXPECT_THROW(fx.delegate.ProcessTeamAddition(evt), std::runtime_error);
+}
@@ -13,6 +13,7 @@
 
 #include "mocks/MatchRepositoryMock.hpp"
 #include "mocks/TournamentDelegateMock.hpp"
+#include "mocks/StandingsRepositoryMock.hpp"
 
 using ::testing::_;
 using ::testing::Invoke;
@@ -54,7 +55,9 @@ struct Fixture {
         std::make_shared<StrictMock<MatchRepositoryMock>>();
     std::shared_ptr<StrictMock<TournamentDelegateMock>> tdel =
         std::make_shared<StrictMock<TournamentDelegateMock>>();
-    MatchDelegate delegate{repo, tdel};
+    std::shared_ptr<StrictMock<StandingsRepositoryMock>> standings =
+        std::make_shared<StrictMock<StandingsRepositoryMock>>();
+    MatchDelegate delegate{repo, tdel, standings};
 };
 
 } // namespace
@@ -102,6 +105,57 @@ TEST(MatchDelegateTest, ReadAll_NoFilter_ReturnsAll) {
     EXPECT_EQ(out[1]->Id(), "m2");
 }
 
+TEST(MatchDelegateTest, ReadJsonPage_PassesFilterAndCursorToRepository) {
+    Fixture fx;
+    EXPECT_CALL(*fx.tdel, ReadById(kTid))
+        .WillOnce(Return(std::expected<std::shared_ptr<domain::Tournament>, std::string>{AnyTournamentPtr()}));
+
+    PageRequest request;
+    request.limit = 2;
+    request.after = PageCursor{"2025-10-01 10:00:00", kMid};
+
+    EXPECT_CALL(*fx.repo, FindJsonPageByTournamentId(kTid, "played", _))
+        .WillOnce(Invoke([](const std::string&, const std::string&, const PageRequest& r) {
+            EXPECT_EQ(r.limit, 2u);
+            EXPECT_EQ(r.after->id, kMid);
+            return JsonPage{R"([{"id":"m1"}])", std::nullopt};
+        }));
+
+    auto page = fx.delegate.ReadJsonPage(kTid, std::optional<std::string_view>{"played"}, request);
+    EXPECT_EQ(page.body, R"([{"id":"m1"}])");
+    EXPECT_FALSE(page.next.has_value());
+}
+
+TEST(MatchDelegateTest, ReadJsonPage_UnknownFilter_ReadsAll) {
+    Fixture fx;
+    EXPECT_CALL(*fx.tdel, ReadById(kTid))
+        .WillOnce(Return(std::expected<std::shared_ptr<domain::Tournament>, std::string>{AnyTournamentPtr()}));
+    EXPECT_CALL(*fx.repo, FindJsonPageByTournamentId(kTid, "", _))
+        .WillOnce(Return(JsonPage{}));
+
+    auto page = fx.delegate.ReadJsonPage(kTid, std::optional<std::string_view>{"whatever"}, PageRequest{});
+    EXPECT_EQ(page.body, "[]");
+}
+
+TEST(MatchDelegateTest, ReadJsonPage_ReturnsRenderedBodyWithSameFilter) {
+    Fixture fx;
+    EXPECT_CALL(*fx.tdel, ReadById(kTid))
+        .WillOnce(Return(std::expected<std::shared_ptr<domain::Tournament>, std::string>{AnyTournamentPtr()}));
+    EXPECT_CALL(*fx.repo, FindJsonPageByTournamentId(kTid, "pending", _))
+        .WillOnce(Return(JsonPage{R"([{"id":"m1"}])", std::nullopt}));
+
+    auto page = fx.delegate.ReadJsonPage(kTid, std::optional<std::string_view>{"pending"}, PageRequest{});
+    EXPECT_EQ(page.body, R"([{"id":"m1"}])");
+}
+
+TEST(MatchDelegateTest, ReadJsonPage_TournamentMissing_ThrowsNotFound) {
+    Fixture fx;
+    EXPECT_CALL(*fx.tdel, ReadById(kTid))
+        .WillOnce(Return(std::unexpected(std::string{"not_found"})));
+
+    EXPECT_THROW({ (void)fx.delegate.ReadJsonPage(kTid, std::nullopt, PageRequest{}); }, std::runtime_error);
+}
+
 TEST(MatchDelegateTest, ReadAll_FilterPending) {
     Fixture fx;
     EXPECT_CALL(*fx.tdel, ReadById(kTid))
@@ -246,6 +300,83 @@ TEST(MatchDelegateTest, UpdateScore_UpdateThrows_ReturnsUnexpectedTag) {
     EXPECT_EQ(r.error(), "unexpected:db_down");
 }
 
+// ---------- UpdateScore keeps the group tables ----------
+
+TEST(MatchDelegateTest, UpdateScore_GroupMatch_AddsResultToStandings) {
+    Fixture fx;
+    auto m = makeMatch(kMid, kTid, "group", "HID","Home","VID","Visitor","pending");
+    EXPECT_CALL(*fx.repo, FindByTournamentIdAndMatchId(kTid, kMid)).WillOnce(Return(m));
+    EXPECT_CALL(*fx.repo, Update(_)).WillOnce(Return(std::string(kMid)));
+
+    EXPECT_CALL(*fx.standings, Apply(kTid, _))
+        .WillOnce(Invoke([](const std::string&, const std::vector<domain::Standing>& deltas) {
+            ASSERT_EQ(deltas.size(), 2u);
+            EXPECT_EQ(deltas[0].teamId, "HID");
+            EXPECT_EQ(deltas[0].played, 1);
+            EXPECT_EQ(deltas[0].won, 1);
+            EXPECT_EQ(deltas[0].points, 3);
+            EXPECT_EQ(deltas[0].goalsFor, 2);
+            EXPECT_EQ(deltas[0].goalsAgainst, 1);
+            EXPECT_EQ(deltas[1].teamId, "VID");
+            EXPECT_EQ(deltas[1].played, 1);
+            EXPECT_EQ(deltas[1].lost, 1);
+            EXPECT_EQ(deltas[1].points, 0);
+        }));
+
+    EXPECT_TRUE(fx.delegate.UpdateScore(kTid, kMid, 2, 1).has_value());
+}
+
+TEST(MatchDelegateTest, UpdateScore_CorrectedGroupResult_AppliesOnlyTheDifference) {
+    Fixture fx;
+    auto m = makeMatch(kMid, kTid, "group", "HID","Home","VID","Visitor","played");
+    m->SetScore(2, 1);
+    EXPECT_CALL(*fx.repo, FindByTournamentIdAndMatchId(kTid, kMid)).WillOnce(Return(m));
+    EXPECT_CALL(*fx.repo, Update(_)).WillOnce(Return(std::string(kMid)));
+
+    // 2-1 -> 1-3: home gives back the win, visitor takes it; played doesn't change.
+    EXPECT_CALL(*fx.standings, Apply(kTid, _))
+        .WillOnce(Invoke([](const std::string&, const std::vector<domain::Standing>& deltas) {
+            ASSERT_EQ(deltas.size(), 2u);
+            EXPECT_EQ(deltas[0].played, 0);
+            EXPECT_EQ(deltas[0].won, -1);
+            EXPECT_EQ(deltas[0].lost, 1);
+            EXPECT_EQ(deltas[0].points, -3);
+            EXPECT_EQ(deltas[0].goalsFor, -1);
+            EXPECT_EQ(deltas[0].goalsAgainst, 2);
+            EXPECT_EQ(deltas[1].won, 1);
+            EXPECT_EQ(deltas[1].lost, -1);
+            EXPECT_EQ(deltas[1].points, 3);
+        }));
+
+    EXPECT_TRUE(fx.delegate.UpdateScore(kTid, kMid, 1, 3).has_value());
+}
+
+TEST(MatchDelegateTest, UpdateScore_SameGroupResultAgain_LeavesStandings) {
+    Fixture fx;
+    auto m = makeMatch(kMid, kTid, "group", "HID","Home","VID","Visitor","played");
+    m->SetScore(2, 1);
+    EXPECT_CALL(*fx.repo, FindByTournamentIdAndMatchId(kTid, kMid)).WillOnce(Return(m));
+    EXPECT_CALL(*fx.repo, Update(_)).WillOnce(Return(std::string(kMid)));
+    EXPECT_CALL(*fx.standings, Apply(_, _)).Times(0);
+
+    EXPECT_TRUE(fx.delegate.UpdateScore(kTid, kMid, 2, 1).has_value());
+}
+
+TEST(MatchDelegateTest, UpdateScore_StandingsFail_ReturnsUnexpectedTag) {
+    Fixture fx;
+    auto m = makeMatch(kMid, kTid, "group", "HID","Home","VID","Visitor","pending");
+    EXPECT_CALL(*fx.repo, FindByTournamentIdAndMatchId(kTid, kMid)).WillOnce(Return(m));
+    EXPECT_CALL(*fx.repo, Update(_)).WillOnce(Return(std::string(kMid)));
+    EXPECT_CALL(*fx.standings, Apply(kTid, _))
+        .WillOnce(Invoke([](const std::string&, const std::vector<domain::Standing>&) {
+            throw std::runtime_error("db_down");
+        }));
+
+    auto r = fx.delegate.UpdateScore(kTid, kMid, 1, 0);
+    ASSERT_FALSE(r.has_value());
+    EXPECT_EQ(r.error(), "unexpected:db_down");
+}
+
 // ---------- Create basic / not-found ----------
 
 TEST(MatchDelegateTest, Create_NotFoundTournament) {
@@ -177,6 +177,20 @@ TEST(TeamDelegateTest, GetAllTeams_ReturnsRepoVector) {
   EXPECT_EQ(v[0]->Id, "A");
 }
 
+// GetTeamsJsonPage: pass-through (cursor included)
+TEST(TeamDelegateTest, GetTeamsJsonPage_ReturnsRepoPage) {
+  auto repo = std::make_shared<StrictMock<TeamRepositoryMock>>();
+  const PageCursor next{"2025-10-01 10:00:00", "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee"};
+  EXPECT_CALL(*repo, ReadJsonPage(::testing::_))
+      .WillOnce(Return(JsonPage{R"([{"id":"A","name":"Alpha"}])", next}));
+
+  TeamDelegate sut{repo};
+  auto page = sut.GetTeamsJsonPage(PageRequest{});
+  EXPECT_EQ(page.body, R"([{"id":"A","name":"Alpha"}])");
+  ASSERT_TRUE(page.next.has_value());
+  EXPECT_EQ(page.next->id, next.id);
+}
+
 // GetTeam: found and null
 TEST(TeamDelegateTest, GetTeam_FoundAndNull) {
   auto repo = std::make_shared<StrictMock<TeamRepositoryMock>>();
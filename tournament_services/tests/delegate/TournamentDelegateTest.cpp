@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <memory>
 #include "delegate/TournamentDelegate.hpp"
+#include "persistence/repository/RepositoryErrors.hpp"
 #include "../mocks/TournamentRepositoryMock.h"
 
 using namespace testing;
@@ -29,6 +30,16 @@ TEST(TournamentDelegateTest, CreateTournament_RepoThrows_ReturnsUnexpected) {
     EXPECT_THAT(res.error(), HasSubstr("db error"));
 }
 
+TEST(TournamentDelegateTest, CreateTournament_DuplicateName_ReturnsAlreadyExists) {
+    auto repo = std::make_shared<StrictMock<MockTournamentRepository>>();
+    EXPECT_CALL(*repo, Create(::testing::_))
+        .WillOnce(::testing::Throw(DuplicateEntityError("duplicate key value", "Liga")));
+    TournamentDelegate sut{repo};
+    auto res = sut.CreateTournament(std::make_shared<domain::Tournament>("Liga", domain::TournamentFormat{1,4,domain::TournamentType::NFL}));
+    ASSERT_FALSE(res.has_value());
+    EXPECT_THAT(res.error(), HasSubstr("already exists"));
+}
+
 TEST(TournamentDelegateTest, ReadById_Found_ReturnsTournament) {
     auto repo = std::make_shared<StrictMock<MockTournamentRepository>>();
     auto t = std::make_shared<domain::Tournament>("X", domain::TournamentFormat{1,2,domain::TournamentType::NFL});
@@ -51,6 +62,26 @@ TEST(TournamentDelegateTest, ReadById_Throws_ReturnsUnexpected) {
     EXPECT_THAT(result.error(), HasSubstr("boom"));
 }
 
+// ReadWithVersion: torneo y versión vienen juntos del repositorio; un error se reporta como unexpected
+TEST(TournamentDelegateTest, ReadWithVersion_PassesTournamentAndVersion) {
+    auto repo = std::make_shared<StrictMock<MockTournamentRepository>>();
+    auto t = std::make_shared<domain::Tournament>("Copa", domain::TournamentFormat{1,4,domain::TournamentType::NFL});
+    EXPECT_CALL(*repo, ReadWithVersion("T1"))
+        .WillOnce(Return(Versioned<domain::Tournament>{t, "1700.1.1699"}));
+    EXPECT_CALL(*repo, ReadWithVersion("T2"))
+        .WillOnce(::testing::Throw(std::runtime_error("db error")));
+    TournamentDelegate sut{repo};
+
+    auto found = sut.ReadWithVersion("T1");
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->entity, t);
+    EXPECT_EQ(found->version, "1700.1.1699");
+
+    auto failed = sut.ReadWithVersion("T2");
+    ASSERT_FALSE(failed.has_value());
+    EXPECT_THAT(failed.error(), HasSubstr("db error"));
+}
+
 TEST(TournamentDelegateTest, ReadAll_Empty_ReturnsOkEmptyVector) {
     auto repo = std::make_shared<StrictMock<MockTournamentRepository>>();
     EXPECT_CALL(*repo, ReadAll())
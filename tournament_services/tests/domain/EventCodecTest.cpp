@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "event/EventCodec.hpp"
+
+namespace {
+const std::string kTournament = "11111111-2222-3333-4444-555555555555";
+const std::string kGroup      = "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee";
+const std::string kTeam       = "0f1e2d3c-4b5a-6978-8796-a5b4c3d2e1f0";
+}
+
+TEST(EventCodecTest, TeamAdd_RoundTrip) {
+    const auto body = event_codec::Encode(TeamAddEvent{kTournament, kGroup, kTeam});
+    ASSERT_TRUE(body.has_value());
+    EXPECT_EQ(body->size(), 52u);
+    EXPECT_TRUE(event_codec::IsBinary(*body));
+
+    event_codec::TeamAddView view;
+    ASSERT_TRUE(event_codec::Decode(*body, view));
+    const auto event = event_codec::ToEvent(view);
+    EXPECT_EQ(event.tournamentId, kTournament);
+    EXPECT_EQ(event.groupId, kGroup);
+    EXPECT_EQ(event.teamId, kTeam);
+}
+
+TEST(EventCodecTest, ScoreUpdate_RoundTrip) {
+    const auto body = event_codec::Encode(ScoreUpdateEvent{kTournament, kTeam});
+    ASSERT_TRUE(body.has_value());
+    EXPECT_EQ(body->size(), 36u);
+
+    event_codec::ScoreUpdateView view;
+    ASSERT_TRUE(event_codec::Decode(*body, view));
+    const auto event = event_codec::ToEvent(view);
+    EXPECT_EQ(event.tournamentId, kTournament);
+    EXPECT_EQ(event.matchId, kTeam);
+}
+
+// Ids que no son UUID no caben en 16 bytes: el evento se manda como JSON
+TEST(EventCodecTest, Encode_NonUuidId_Nullopt) {
+    EXPECT_FALSE(event_codec::Encode(ScoreUpdateEvent{"T1", kTeam}).has_value());
+    EXPECT_FALSE(event_codec::Encode(TeamAddEvent{kTournament, kGroup, "11111111-2222-3333-4444-55555555555x"}).has_value());
+}
+
+// Las mayúsculas se aceptan y vuelven en la forma canónica (minúsculas)
+TEST(EventCodecTest, UppercaseUuid_DecodesLowercase) {
+    const auto body = event_codec::Encode(ScoreUpdateEvent{"AAAAAAAA-BBBB-CCCC-DDDD-EEEEEEEEEEEE", kTeam});
+    ASSERT_TRUE(body.has_value());
+    event_codec::ScoreUpdateView view;
+    ASSERT_TRUE(event_codec::Decode(*body, view));
+    EXPECT_EQ(event_codec::ToEvent(view).tournamentId, kGroup);
+}
+
+// Otro tipo, otra versión o un cuerpo truncado no se decodifican
+TEST(EventCodecTest, Decode_WrongKindVersionOrLength_False) {
+    const auto score = *event_codec::Encode(ScoreUpdateEvent{kTournament, kTeam});
+    event_codec::TeamAddView teamAdd;
+    EXPECT_FALSE(event_codec::Decode(score, teamAdd));
+
+    auto otherVersion = score;
+    otherVersion[1] = 2;
+    event_codec::ScoreUpdateView view;
+    EXPECT_FALSE(event_codec::Decode(otherVersion, view));
+    EXPECT_FALSE(event_codec::Decode(score.substr(0, 20), view));
+    EXPECT_FALSE(event_codec::IsBinary(R"({"tournamentId":"x"})"));
+}
+
+TEST(EventCodecTest, TournamentIdOf_AnyKind) {
+    const auto teamAdd = *event_codec::Encode(TeamAddEvent{kTournament, kGroup, kTeam});
+    const auto tournament = event_codec::TournamentIdOf(teamAdd);
+    ASSERT_TRUE(tournament.has_value());
+    EXPECT_EQ(event_codec::FormatUuid(*tournament), kTournament);
+    EXPECT_FALSE(event_codec::TournamentIdOf("{}").has_value());
+}
+
+// Eventos guardados como JSON (outbox) pasados al formato binario
+TEST(EventCodecTest, FromJson_KnownTypes) {
+    const auto teamAdd = event_codec::FromJson(
+        R"({"type":"tournament.team.added","tournamentId":")" + kTournament + R"(","groupId":")" + kGroup +
+        R"(","teamId":")" + kTeam + R"(","occurredAt":1})");
+    ASSERT_TRUE(teamAdd.has_value());
+    EXPECT_EQ(*teamAdd, *event_codec::Encode(TeamAddEvent{kTournament, kGroup, kTeam}));
+
+    EXPECT_FALSE(event_codec::FromJson(R"({"type":"other","tournamentId":"x"})").has_value());
+    EXPECT_FALSE(event_codec::FromJson("not json").has_value());
+}
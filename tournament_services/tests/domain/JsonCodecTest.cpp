@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "domain/DomainJson.hpp"
+
+namespace {
+    domain::Match playedMatch() {
+        domain::Match m;
+        m.Id() = "m1";
+        m.TournamentId() = "t1";
+        m.Round() = "final";
+        m.Home() = domain::TeamRef{"h1", "Home"};
+        m.Visitor() = domain::TeamRef{"v1", "Visitor"};
+        m.SetStatus("played");
+        m.SetScore(2, 1);
+        m.SetWinnerTeamId("h1");
+        m.SetDecidedBy("regularTime");
+        return m;
+    }
+}
+
+TEST(JsonCodecTest, MatchWriterMatchesDomMapping) {
+    const domain::Match m = playedMatch();
+    // Same document as the nlohmann mapping in Match.hpp (member order aside).
+    EXPECT_EQ(nlohmann::json::parse(json_codec::Write(m)), nlohmann::json(m));
+
+    domain::Match pending;
+    pending.Id() = "m2";
+    EXPECT_EQ(nlohmann::json::parse(json_codec::Write(pending)), nlohmann::json(pending));
+}
+
+TEST(JsonCodecTest, EscapesEveryControlCharacterAndRoundTrips) {
+    std::string name = "q\"b\\s/";
+    for (char c = 0; c < 0x20; ++c) name += c;
+
+    domain::Team team{"t1", name};
+    const std::string text = json_codec::Write(team);
+    EXPECT_NE(text.find(R"(\"b\\s/)"), std::string::npos);
+    EXPECT_NE(text.find(R"(\u0000\u0001)"), std::string::npos);
+    EXPECT_NE(text.find(R"(\b\t\n\u000b\f\r)"), std::string::npos);
+
+    // Any JSON parser reads back the original bytes, and so does ours.
+    EXPECT_EQ(nlohmann::json::parse(text).at("name").get<std::string>(), name);
+    auto back = json_codec::Read<domain::Team>(text);
+    ASSERT_TRUE(back.has_value());
+    EXPECT_EQ(back->Name, name);
+}
+
+TEST(JsonCodecTest, ReadsUnicodeEscapesAndSurrogatePairs) {
+    auto team = json_codec::Read<domain::Team>(R"({"name":"España 😀 \/"})");
+    ASSERT_TRUE(team.has_value());
+    EXPECT_EQ(team->Name, "España \xF0\x9F\x98\x80 /");
+
+    EXPECT_FALSE(json_codec::Read<domain::Team>(R"({"name":"\ud83d"})").has_value());
+    EXPECT_FALSE(json_codec::Read<domain::Team>(R"({"name":"\ude00x"})").has_value());
+}
+
+TEST(JsonCodecTest, TournamentRoundTripKeepsFormat) {
+    domain::Tournament t{"Copa", domain::TournamentFormat{3, 5, domain::TournamentType::NFL}};
+    t.Id() = "t-9";
+
+    auto back = json_codec::Read<domain::Tournament>(json_codec::Write(t));
+    ASSERT_TRUE(back.has_value());
+    EXPECT_EQ(back->Id(), "t-9");
+    EXPECT_EQ(back->Name(), "Copa");
+    EXPECT_EQ(back->Format().NumberOfGroups(), 3);
+    EXPECT_EQ(back->Format().MaxTeamsPerGroup(), 5);
+    EXPECT_EQ(back->Format().Type(), domain::TournamentType::NFL);
+
+    // Ids not assigned yet are left out, like the old to_json.
+    EXPECT_EQ(nlohmann::json::parse(json_codec::Write(domain::Tournament{"Nueva"})).count("id"), 0u);
+}
+
+TEST(JsonCodecTest, LenientReadIgnoresUnknownAndMistypedMembers) {
+    auto m = json_codec::Read<domain::Match>(
+        R"({"round":7,"extra":{"a":[1,2,{"b":null}]},"home":{"id":"h","name":"H"},)"
+        R"("score":{"home":1.5,"visitor":2},"status":"played"})");
+    ASSERT_TRUE(m.has_value());
+    EXPECT_EQ(m->Round(), "");
+    EXPECT_EQ(m->Home().Name(), "H");
+    EXPECT_FALSE(m->HasScore());
+    EXPECT_EQ(m->Status(), "played");
+
+    auto defaults = json_codec::Read<domain::Match>("{}");
+    ASSERT_TRUE(defaults.has_value());
+    EXPECT_EQ(defaults->Status(), "pending");
+}
+
+TEST(JsonCodecTest, ReportsSyntaxAndFieldErrorsSeparately) {
+    using Kind = json_codec::ReadError::Kind;
+
+    for (const char* bad : {"", "{", R"({"name":"a",})", R"({"name":"a"} x)", R"({"name":"a\q"})", "{\"name\":\"a\nb\"}"}) {
+        auto r = json_codec::Read<domain::Team>(bad);
+        ASSERT_FALSE(r.has_value()) << bad;
+        EXPECT_EQ(r.error().kind, Kind::Syntax) << bad;
+    }
+
+    auto missing = json_codec::Read<domain::Tournament>(R"({"format":{}})");
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().kind, Kind::Field);
+    EXPECT_EQ(missing.error().message, "missing 'name'");
+
+    auto mistyped = json_codec::Read<domain::Team>(R"({"name":3})");
+    ASSERT_FALSE(mistyped.has_value());
+    EXPECT_EQ(mistyped.error().message, "invalid 'name'");
+}
+
+TEST(JsonCodecTest, GroupsWithTeamsAndNullEntries) {
+    auto group = std::make_shared<domain::Group>("A");
+    group->TournamentId() = "t1";
+    group->Teams().push_back(domain::Team{"x", "X"});
+    const std::vector<std::shared_ptr<domain::Group>> groups{group, nullptr};
+
+    const auto parsed = nlohmann::json::parse(json_codec::Write(groups));
+    ASSERT_EQ(parsed.size(), 2u);
+    EXPECT_EQ(parsed[0].at("teams")[0].at("name"), "X");
+    EXPECT_TRUE(parsed[1].is_null());
+
+    auto back = json_codec::Read<domain::Group>(json_codec::Write(*group));
+    ASSERT_TRUE(back.has_value());
+    ASSERT_EQ(back->Teams().size(), 1u);
+    EXPECT_EQ(back->Teams()[0].Id, "x");
+}
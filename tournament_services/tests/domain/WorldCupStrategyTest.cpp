@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <map>
+#include <optional>
 
 #include "domain/WorldCupStrategy.hpp"
 #include "domain/Tournament.hpp"
@@ -351,3 +353,69 @@ TEST(WorldCupStrategyTest, Table_SortingUsesPointsGoalDiffGoalsAndName) {
     EXPECT_GT(rowAOut->gd(), rowCOut->gd());
 }
 
+
+// ============ Standings (materialized table) ============
+
+TEST(WorldCupStrategyTest, StandingDeltas_DrawCountsOnlyMatchAndGoals) {
+    auto deltas = domain::StandingDeltas("H", "V", std::nullopt, {1, 1});
+    ASSERT_EQ(deltas.size(), 2u);
+    for (const auto& d : deltas) {
+        EXPECT_EQ(d.played, 1);
+        EXPECT_EQ(d.won, 0);
+        EXPECT_EQ(d.lost, 0);
+        EXPECT_EQ(d.points, 0);
+        EXPECT_EQ(d.goalsFor, 1);
+    }
+    EXPECT_TRUE(domain::StandingDeltas("H", "V", domain::Score{1, 1}, {1, 1}).empty());
+}
+
+TEST(WorldCupStrategyTest, Playoff_FromStandings_SameBracketAsFromMatches) {
+    WorldCupStrategy strategy;
+    domain::Tournament t{"World Cup"};
+    t.Id() = "TID";
+
+    vector<shared_ptr<domain::Group>> groups;
+    groups.push_back(makeGroup("G1", "Group 1", {"A1", "A2", "A3"}));
+    groups.push_back(makeGroup("G2", "Group 2", {"B1", "B2", "B3"}));
+
+    auto played = [](const string& home, const string& visitor, int sh, int sv) {
+        auto m = makePlayedMatch("TID", rounds::GROUP, home, home, visitor, visitor, sh, sv);
+        m->SetScore(sh, sv);
+        return m;
+    };
+    vector<shared_ptr<domain::Match>> allMatches{
+        played("A1", "A2", 0, 2), played("A1", "A3", 1, 0), played("A2", "A3", 3, 1),
+        played("B1", "B2", 1, 1), played("B1", "B3", 0, 1), played("B2", "B3", 4, 0),
+    };
+
+    // What STANDINGS holds after those scores were applied one by one.
+    std::map<string, domain::Standing> rows;
+    for (const auto& m : allMatches) {
+        for (const auto& d : domain::StandingDeltas(m->Home().Id(), m->Visitor().Id(), std::nullopt,
+                                                    {*m->ScoreHome(), *m->ScoreVisitor()})) {
+            auto& row = rows[d.teamId];
+            row.teamId = d.teamId;
+            row.teamName = d.teamId;
+            row.groupId = d.teamId[0] == 'A' ? "G1" : "G2";
+            row += d;
+        }
+    }
+    vector<domain::Standing> standings;
+    for (const auto& [id, row] : rows) standings.push_back(row);
+
+    auto fromMatches   = strategy.CreatePlayoffMatches(t, allMatches, groups);
+    auto fromStandings = strategy.CreatePlayoffMatches(t, allMatches, groups, standings);
+    ASSERT_TRUE(fromMatches.has_value());
+    ASSERT_TRUE(fromStandings.has_value());
+    ASSERT_EQ(fromStandings->size(), 2u);
+    ASSERT_EQ(fromMatches->size(), fromStandings->size());
+    for (size_t i = 0; i < fromMatches->size(); ++i) {
+        EXPECT_EQ((*fromMatches)[i].Home().Id(), (*fromStandings)[i].Home().Id());
+        EXPECT_EQ((*fromMatches)[i].Visitor().Id(), (*fromStandings)[i].Visitor().Id());
+    }
+    // G1: A2 6 pts, A1 3. G2: B2 and B3 3 pts each, B2 ahead on goal difference (B1 only drew).
+    EXPECT_EQ((*fromStandings)[0].Home().Id(), "A2");
+    EXPECT_EQ((*fromStandings)[0].Visitor().Id(), "B3");
+    EXPECT_EQ((*fromStandings)[1].Home().Id(), "B2");
+    EXPECT_EQ((*fromStandings)[1].Visitor().Id(), "A1");
+}
@@ -1,10 +1,13 @@
 // GroupAddTeamListenerTest.cpp
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <chrono>
+#include <future>
 #include <memory>
 #include <string>
 
 #include "cms/GroupAddTeamListener.hpp"
+#include "mocks/CmsClientFake.hpp"
 #include "mocks/MatchDelegateMock.hpp"
 
 using ::testing::_;
@@ -88,7 +91,8 @@ TEST(GroupAddTeamListenerTest, MissingFieldsAreCaughtAndDoNotThrow) {
     });
 }
 
-TEST(GroupAddTeamListenerTest, DelegateExceptionIsCaughtAndDoesNotPropagate) {
+// Un fallo del delegate sale del listener para que el mensaje se deshaga y se reentregue
+TEST(GroupAddTeamListenerTest, DelegateExceptionPropagates) {
     std::shared_ptr<ConnectionManager> connMgr = nullptr;
     auto matchDelegate = std::make_shared<StrictMock<MatchDelegateMock>>();
 
@@ -105,7 +109,57 @@ TEST(GroupAddTeamListenerTest, DelegateExceptionIsCaughtAndDoesNotPropagate) {
             throw std::runtime_error("delegate boom");
         }));
 
-    EXPECT_NO_THROW({
-        sut.processMessage(message);
-    });
+    EXPECT_THROW(sut.processMessage(message), std::runtime_error);
+}
+
+// Recepción real: el error del delegate deshace la transacción (rollback) y no confirma nada
+TEST(GroupAddTeamListenerTest, DelegateExceptionRollsTheMessageBack) {
+    using namespace std::chrono_literals;
+    FakeClient client;
+    client.inbox.push_back(R"({"tournamentId":"TID-ERR","groupId":"GID-ERR","teamId":"TEAM-ERR"})");
+    auto matchDelegate = std::make_shared<StrictMock<MatchDelegateMock>>();
+    GroupAddTeamListener sut(connectionTo(client), matchDelegate);
+
+    EXPECT_CALL(*matchDelegate, ProcessTeamAddition(_))
+        .WillOnce(::testing::Invoke([](const TeamAddEvent&) {
+            throw std::runtime_error("database down");
+        }));
+
+    auto started = std::async(std::launch::async, [&] { sut.Start(GroupAddTeamListener::Queue); });
+    {
+        std::unique_lock lock(client.mutex);
+        EXPECT_TRUE(client.changed.wait_for(lock, 2s, [&] { return client.rollbacks == 1; }));
+        EXPECT_EQ(client.commits, 0);
+    }
+    sut.Stop();
+    EXPECT_EQ(started.wait_for(1s), std::future_status::ready);
+}
+
+// Evento binario (BytesMessage): se decodifica sin JSON y llega igual al delegate
+TEST(GroupAddTeamListenerTest, BinaryMessageCallsProcessTeamAddition) {
+    std::shared_ptr<ConnectionManager> connMgr = nullptr;
+    auto matchDelegate = std::make_shared<StrictMock<MatchDelegateMock>>();
+    GroupAddTeamListenerTestable sut(connMgr, matchDelegate);
+
+    const TeamAddEvent sent{"11111111-2222-3333-4444-555555555555",
+                            "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee",
+                            "0f1e2d3c-4b5a-6978-8796-a5b4c3d2e1f0"};
+    EXPECT_CALL(*matchDelegate, ProcessTeamAddition(_))
+        .WillOnce(::testing::Invoke([&](const TeamAddEvent& evt) {
+            EXPECT_EQ(evt.tournamentId, sent.tournamentId);
+            EXPECT_EQ(evt.groupId,      sent.groupId);
+            EXPECT_EQ(evt.teamId,       sent.teamId);
+        }));
+
+    sut.processMessage(*event_codec::Encode(sent));
+}
+
+// Un cuerpo binario de otro tipo no llega al delegate
+TEST(GroupAddTeamListenerTest, BinaryMessageOfOtherKindIsIgnored) {
+    std::shared_ptr<ConnectionManager> connMgr = nullptr;
+    auto matchDelegate = std::make_shared<StrictMock<MatchDelegateMock>>();
+    GroupAddTeamListenerTestable sut(connMgr, matchDelegate);
+
+    sut.processMessage(*event_codec::Encode(ScoreUpdateEvent{"11111111-2222-3333-4444-555555555555",
+                                                             "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee"}));
 }
@@ -1,16 +1,27 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <cms/Session.h>
 #include "cms/ConnectionManager.hpp"
 #include "cms/QueueMessageListener.hpp"
 #include "mocks/ConnectionManagerMock.hpp"
+#include "mocks/CmsClientFake.hpp"
+#include "cms/ShardedDispatcher.hpp"
 
 using ::testing::NiceMock;
 using ::testing::Return;
+using namespace std::chrono_literals;
 class TestQueueMessageListener : public QueueMessageListener {
 public:
     explicit TestQueueMessageListener(const std::shared_ptr<ConnectionManager>& cm)
@@ -57,3 +68,220 @@ TEST(QueueMessageListenerTest, ProcessMessageCanBeOverriddenInSubclass) {
     EXPECT_EQ(listener.processedCount, 1);
     EXPECT_EQ(listener.lastMessage, payload);
 }
+
+// Batch processing: messages keyed by tournament go to the dispatcher
+class BatchTestListener : public QueueMessageListener {
+public:
+    using QueueMessageListener::QueueMessageListener;
+    using QueueMessageListener::processBatch;
+
+    void processMessage(const std::string& message) override {
+        if (message == "fail") throw std::runtime_error("processing failed");
+        ++processed;
+    }
+    std::string shardKey(const std::string& message) override { return message == "inline" ? "" : message; }
+
+    std::atomic<int> processed{0};
+};
+
+TEST(QueueMessageListenerTest, ReceiveSettings_FromJson) {
+    const auto defaults = nlohmann::json::object().get<ReceiveSettings>();
+    EXPECT_EQ(defaults.batchSize, 1u);
+    EXPECT_EQ(defaults.prefetch, 0);
+
+    const auto settings = nlohmann::json{{"batchSize", 0}, {"batchTimeMs", 20}, {"prefetch", 64}}.get<ReceiveSettings>();
+    EXPECT_EQ(settings.batchSize, 1u);
+    EXPECT_EQ(settings.batchTime.count(), 20);
+    EXPECT_EQ(settings.prefetch, 64);
+}
+
+// El lote se confirma solo cuando todos sus mensajes terminaron, también los despachados a los workers
+TEST(QueueMessageListenerTest, ProcessBatch_ReturnsWhenEveryMessageIsDone) {
+    auto cm = std::make_shared<NiceMock<ConnectionManagerMock>>();
+    auto dispatcher = std::make_shared<ShardedDispatcher>(ShardedDispatcherSettings{4, 8});
+    BatchTestListener listener{cm};
+    listener.UseDispatcher(dispatcher);
+
+    std::vector<std::string> batch;
+    for (int i = 0; i < 40; ++i) batch.push_back("T" + std::to_string(i % 7));
+    batch.push_back("inline");
+
+    EXPECT_NO_THROW(listener.processBatch(batch));
+    EXPECT_EQ(listener.processed.load(), 41);
+    dispatcher->Stop();
+}
+
+// Un mensaje que falla hace fallar el lote (rollback y reentrega), después de esperar al resto
+TEST(QueueMessageListenerTest, ProcessBatch_FailedMessage_Throws) {
+    auto cm = std::make_shared<NiceMock<ConnectionManagerMock>>();
+    auto dispatcher = std::make_shared<ShardedDispatcher>(ShardedDispatcherSettings{2, 8});
+    BatchTestListener listener{cm};
+    listener.UseDispatcher(dispatcher);
+
+    EXPECT_THROW(listener.processBatch({"T1", "fail", "T2"}), std::runtime_error);
+    EXPECT_EQ(listener.processed.load(), 2);
+    dispatcher->Stop();
+}
+
+// ---- Push mode and Stop() ----
+namespace {
+// Blocks processMessage until released, to look at the session while a message is still running.
+class GateListener : public QueueMessageListener {
+public:
+    using QueueMessageListener::QueueMessageListener;
+
+    void processMessage(const std::string&) override {
+        std::unique_lock lock(mutex);
+        started = true;
+        changed.notify_all();
+        changed.wait(lock, [this] { return released; });
+    }
+    std::string shardKey(const std::string& message) override { return message; }
+
+    void Release() {
+        std::lock_guard lock(mutex);
+        released = true;
+        changed.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool started = false;
+    bool released = false;
+};
+}
+
+TEST(QueueMessageListenerTest, ReceiveSettings_ModePush_FromJson) {
+    EXPECT_FALSE(nlohmann::json::object().get<ReceiveSettings>().push);
+    EXPECT_TRUE((nlohmann::json{{"mode", "push"}}.get<ReceiveSettings>().push));
+    EXPECT_FALSE((nlohmann::json{{"mode", "poll"}}.get<ReceiveSettings>().push));
+}
+
+// Modo push: el cliente entrega por onMessage, sin receive(); Stop() libera Start() de inmediato
+TEST(QueueMessageListenerTest, Push_DeliversThroughOnMessage_StopReturnsAtOnce) {
+    FakeClient client;
+    TestQueueMessageListener listener{connectionTo(client)};
+    ReceiveSettings settings;
+    settings.push = true;
+    listener.UseReceiveSettings(settings);
+
+    auto started = std::async(std::launch::async, [&] { listener.Start("q"); });
+    cms::MessageListener* registered = nullptr;
+    {
+        std::unique_lock lock(client.mutex);
+        ASSERT_TRUE(client.changed.wait_for(lock, 2s, [&] { return client.listener != nullptr; }));
+        registered = client.listener;
+    }
+
+    FakeText message{R"({"tournamentId":"T1"})"};
+    registered->onMessage(&message);
+    EXPECT_EQ(listener.processedCount, 1);
+    EXPECT_EQ(listener.lastMessage, R"({"tournamentId":"T1"})");
+    EXPECT_EQ(client.commits, 1);
+
+    listener.Stop();
+    EXPECT_EQ(started.wait_for(1s), std::future_status::ready);
+    EXPECT_TRUE(client.closed);
+    EXPECT_EQ(client.receives, 0);
+}
+
+// Un error al procesar no sale hacia el hilo del cliente: el mensaje se deshace (rollback) para reentregarlo
+TEST(QueueMessageListenerTest, Push_ProcessingError_StaysInsideOnMessageAndRollsBack) {
+    FakeClient client;
+    BatchTestListener listener{connectionTo(client)};
+    ReceiveSettings settings;
+    settings.push = true;
+    listener.UseReceiveSettings(settings);
+
+    auto started = std::async(std::launch::async, [&] { listener.Start("q"); });
+    {
+        std::unique_lock lock(client.mutex);
+        ASSERT_TRUE(client.changed.wait_for(lock, 2s, [&] { return client.listener != nullptr; }));
+    }
+
+    FakeText message{"fail"};
+    EXPECT_NO_THROW(client.listener->onMessage(&message));
+    EXPECT_EQ(client.rollbacks, 1);
+    EXPECT_EQ(client.commits, 0);
+    listener.Stop();
+    EXPECT_EQ(started.wait_for(1s), std::future_status::ready);
+}
+
+// Modo poll: Stop() cierra el consumer y despierta el receive() bloqueado en vez de esperar su timeout
+TEST(QueueMessageListenerTest, Poll_StopWakesBlockedReceive) {
+    FakeClient client;
+    TestQueueMessageListener listener{connectionTo(client)};
+
+    auto started = std::async(std::launch::async, [&] { listener.Start("q"); });
+    {
+        std::unique_lock lock(client.mutex);
+        ASSERT_TRUE(client.changed.wait_for(lock, 2s, [&] { return client.receives > 0; }));
+    }
+
+    listener.Stop();
+    EXPECT_EQ(started.wait_for(1s), std::future_status::ready);
+}
+
+// Modo poll, de uno en uno: el mensaje despachado a un worker se confirma solo cuando el worker terminó
+TEST(QueueMessageListenerTest, Poll_CommitsOnlyAfterTheWorkerProcessedTheMessage) {
+    FakeClient client;
+    client.inbox.push_back("T1");
+    auto dispatcher = std::make_shared<ShardedDispatcher>(ShardedDispatcherSettings{2, 8});
+    GateListener listener{connectionTo(client)};
+    listener.UseDispatcher(dispatcher);
+
+    auto started = std::async(std::launch::async, [&] { listener.Start("q"); });
+    {
+        std::unique_lock lock(listener.mutex);
+        ASSERT_TRUE(listener.changed.wait_for(lock, 2s, [&] { return listener.started; }));
+    }
+    {
+        std::lock_guard lock(client.mutex);
+        EXPECT_EQ(client.commits, 0);
+    }
+
+    listener.Release();
+    {
+        std::unique_lock lock(client.mutex);
+        EXPECT_TRUE(client.changed.wait_for(lock, 2s, [&] { return client.commits == 1; }));
+    }
+    listener.Stop();
+    EXPECT_EQ(started.wait_for(1s), std::future_status::ready);
+    dispatcher->Stop();
+}
+
+// ---- Message bodies ----
+namespace {
+class FakeBytes : public cms::BytesMessage {
+    std::string body;
+    std::string encoding;
+public:
+    FakeBytes(std::string body, std::string encoding) : body(std::move(body)), encoding(std::move(encoding)) {}
+    unsigned char* getBodyBytes() const override {
+        auto* copy = new unsigned char[body.size()];
+        std::copy(body.begin(), body.end(), copy);
+        return copy;
+    }
+    int getBodyLength() const override { return static_cast<int>(body.size()); }
+    bool propertyExists(const std::string& name) const override { return name == "eventEncoding" && !encoding.empty(); }
+    std::string getStringProperty(const std::string&) const override { return encoding; }
+};
+
+struct BodyOfListener : TestQueueMessageListener {
+    using TestQueueMessageListener::TestQueueMessageListener;
+    using QueueMessageListener::BodyOf;
+};
+}
+
+// BytesMessage con la codificación binaria: el cuerpo pasa tal cual; sin la propiedad se descarta
+TEST(QueueMessageListenerTest, BodyOf_BinaryBytesMessageNeedsEncodingProperty) {
+    const auto body = *event_codec::Encode(ScoreUpdateEvent{"11111111-2222-3333-4444-555555555555",
+                                                            "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee"});
+    FakeBytes tagged{body, "binary-v1"};
+    FakeBytes untagged{body, ""};
+    FakeText text{"{}"};
+
+    EXPECT_EQ(BodyOfListener::BodyOf(&tagged), body);
+    EXPECT_FALSE(BodyOfListener::BodyOf(&untagged).has_value());
+    EXPECT_EQ(BodyOfListener::BodyOf(&text), "{}");
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "cms/ScoreEventCoalescer.hpp"
+#include "cms/ShardedDispatcher.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+// Runs the evaluations on the coalescer's own thread.
+bool runInline(const std::string&, ScoreEventCoalescer::Task task) {
+    task();
+    return true;
+}
+
+template <class Predicate>
+bool eventually(Predicate predicate) {
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+}
+
+// 48 resultados del mismo torneo dentro de la ventana: una sola evaluación
+TEST(ScoreEventCoalescerTest, BurstWithinWindow_OneEvaluation) {
+    std::atomic<int> runs{0};
+    ScoreEventCoalescer coalescer{100ms, runInline};
+
+    for (int i = 0; i < 48; ++i) {
+        coalescer.Submit("T1", [&] { ++runs; });
+    }
+
+    ASSERT_TRUE(eventually([&] { return runs == 1; }));
+    coalescer.Stop();
+    EXPECT_EQ(runs.load(), 1);
+    const auto stats = coalescer.Statistics();
+    EXPECT_EQ(stats.received, 48u);
+    EXPECT_EQ(stats.evaluations, 1u);
+    EXPECT_EQ(stats.coalesced, 47u);
+}
+
+// Cada torneo tiene su propia evaluación
+TEST(ScoreEventCoalescerTest, DifferentTournaments_EvaluatedSeparately) {
+    std::atomic<int> t1{0}, t2{0};
+    ScoreEventCoalescer coalescer{10ms, runInline};
+
+    coalescer.Submit("T1", [&] { ++t1; });
+    coalescer.Submit("T2", [&] { ++t2; });
+    coalescer.Submit("T1", [&] { ++t1; });
+
+    ASSERT_TRUE(eventually([&] { return t1 == 1 && t2 == 1; }));
+    coalescer.Stop();
+    EXPECT_EQ(coalescer.Statistics().evaluations, 2u);
+}
+
+// Eventos que llegan mientras una evaluación corre: exactamente una evaluación más
+TEST(ScoreEventCoalescerTest, EventsDuringEvaluation_OneFollowUp) {
+    ShardedDispatcher dispatcher{{2, 16}};
+    ScoreEventCoalescer coalescer{0ms, [&](const std::string& key, ScoreEventCoalescer::Task task) {
+        return dispatcher.Dispatch(key, std::move(task));
+    }};
+
+    std::promise<void> started;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<int> runs{0};
+
+    coalescer.Submit("T1", [&, released] {
+        ++runs;
+        started.set_value();
+        released.wait();
+    });
+    started.get_future().wait();
+    for (int i = 0; i < 5; ++i) {
+        coalescer.Submit("T1", [&] { ++runs; });
+    }
+    release.set_value();
+
+    ASSERT_TRUE(eventually([&] { return runs == 2; }));
+    coalescer.Stop();
+    dispatcher.Stop();
+    EXPECT_EQ(runs.load(), 2);
+    EXPECT_EQ(coalescer.Statistics().coalesced, 4u);
+}
+
+// Stop no espera la ventana: lo pendiente se evalúa enseguida
+TEST(ScoreEventCoalescerTest, Stop_EvaluatesWhatIsWaiting) {
+    std::atomic<int> runs{0};
+    ScoreEventCoalescer coalescer{10s, runInline};
+
+    coalescer.Submit("T1", [&] { ++runs; });
+    coalescer.Stop();
+
+    EXPECT_EQ(runs.load(), 1);
+}
+
+// Los eventos absorbidos comparten el futuro de su evaluación, que termina cuando ésta corrió
+TEST(ScoreEventCoalescerTest, Submit_FutureCompletesWithTheEvaluation) {
+    std::atomic<int> runs{0};
+    ScoreEventCoalescer coalescer{20ms, runInline};
+
+    auto first = coalescer.Submit("T1", [&] { ++runs; });
+    auto second = coalescer.Submit("T1", [&] { ++runs; });
+
+    ASSERT_EQ(second.wait_for(2s), std::future_status::ready);
+    EXPECT_EQ(first.wait_for(0s), std::future_status::ready);
+    EXPECT_EQ(runs.load(), 1);
+    coalescer.Stop();
+}
+
+// Una evaluación que falla entrega su excepción a quien espera el futuro
+TEST(ScoreEventCoalescerTest, Submit_FailedEvaluation_FutureRethrows) {
+    ScoreEventCoalescer coalescer{0ms, runInline};
+
+    auto finished = coalescer.Submit("T1", [] { throw std::runtime_error("database down"); });
+
+    ASSERT_EQ(finished.wait_for(2s), std::future_status::ready);
+    EXPECT_THROW(finished.get(), std::runtime_error);
+    coalescer.Stop();
+}
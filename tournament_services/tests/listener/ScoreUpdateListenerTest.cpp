@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <atomic>
 #include <memory>
+#include <stdexcept>
 #include <string>
 
 #define private public
@@ -94,3 +96,76 @@ TEST(ScoreUpdateListenerTest, NullDelegate_DoesNotCrashAndDoesNotCall) {
     // Solo verificamos que no truene; no hay EXPECT_CALL porque no hay mock
     listener.processMessage(payload);
 }
+
+// La clave de shard es el torneo: sus eventos se procesan en orden en el dispatcher
+TEST(ScoreUpdateListenerTest, ShardKey_IsTournamentId) {
+    Fixture fx;
+
+    EXPECT_EQ(fx.listener.shardKey(R"({"tournamentId":"TID-123","matchId":"MID-456"})"), "TID-123");
+    EXPECT_EQ(fx.listener.shardKey(R"({"matchId":"MID-456"})"), "");
+    EXPECT_EQ(fx.listener.shardKey("not json"), "");
+}
+
+// Evento binario: mismo evento para el delegate y misma clave de shard que su JSON
+TEST(ScoreUpdateListenerTest, BinaryEvent_CallsDelegateAndShardsByTournament) {
+    Fixture fx;
+    const std::string tid = "11111111-2222-3333-4444-555555555555";
+    const std::string mid = "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee";
+    const auto body = *event_codec::Encode(ScoreUpdateEvent{tid, mid});
+
+    EXPECT_EQ(fx.listener.shardKey(body), tid);
+    EXPECT_CALL(*fx.delegateMock, ProcessScoreUpdate(_))
+        .WillOnce(::testing::Invoke([&](const ScoreUpdateEvent& evt) {
+            EXPECT_EQ(evt.tournamentId, tid);
+            EXPECT_EQ(evt.matchId, mid);
+        }));
+
+    fx.listener.processMessage(body);
+}
+
+// Error del delegate -> sale del listener para que el lote haga rollback
+TEST(ScoreUpdateListenerTest, DelegateException_Propagates) {
+    Fixture fx;
+
+    EXPECT_CALL(*fx.delegateMock, ProcessScoreUpdate(_))
+        .WillOnce(::testing::Throw(std::runtime_error("database down")));
+
+    EXPECT_THROW(fx.listener.processMessage(R"({"tournamentId":"TID-123","matchId":"MID-456"})"),
+                 std::runtime_error);
+}
+
+// Con coalescer, el lote termina (y se confirma) solo después de la evaluación
+TEST(ScoreUpdateListenerTest, Coalescer_BatchWaitsForTheEvaluation) {
+    Fixture fx;
+    ScoreEventCoalescer coalescer{std::chrono::milliseconds{20}, [](const std::string&, ScoreEventCoalescer::Task task) {
+        task();
+        return true;
+    }};
+    fx.listener.UseCoalescer(std::shared_ptr<ScoreEventCoalescer>(&coalescer, [](ScoreEventCoalescer*) {}));
+
+    std::atomic<bool> evaluated{false};
+    EXPECT_CALL(*fx.delegateMock, ProcessScoreUpdate(_))
+        .WillOnce(::testing::Invoke([&](const ScoreUpdateEvent&) { evaluated = true; }));
+
+    fx.listener.processBatch({R"({"tournamentId":"TID-123","matchId":"MID-1"})",
+                              R"({"tournamentId":"TID-123","matchId":"MID-2"})"});
+    EXPECT_TRUE(evaluated.load());
+    coalescer.Stop();
+}
+
+// Con coalescer, una evaluación que falla hace fallar el lote (rollback)
+TEST(ScoreUpdateListenerTest, Coalescer_FailedEvaluation_FailsTheBatch) {
+    Fixture fx;
+    ScoreEventCoalescer coalescer{std::chrono::milliseconds{0}, [](const std::string&, ScoreEventCoalescer::Task task) {
+        task();
+        return true;
+    }};
+    fx.listener.UseCoalescer(std::shared_ptr<ScoreEventCoalescer>(&coalescer, [](ScoreEventCoalescer*) {}));
+
+    EXPECT_CALL(*fx.delegateMock, ProcessScoreUpdate(_))
+        .WillOnce(::testing::Throw(std::runtime_error("database down")));
+
+    EXPECT_THROW(fx.listener.processBatch({R"({"tournamentId":"TID-123","matchId":"MID-1"})"}),
+                 std::runtime_error);
+    coalescer.Stop();
+}
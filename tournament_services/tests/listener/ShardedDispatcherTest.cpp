@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cms/ShardedDispatcher.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+// Two keys that land on different shards of dispatcher.
+std::pair<std::string, std::string> keysOnDifferentShards(const ShardedDispatcher& dispatcher) {
+    const std::string first = "T-0";
+    for (int i = 1; i < 1000; ++i) {
+        auto other = "T-" + std::to_string(i);
+        if (dispatcher.ShardOf(other) != dispatcher.ShardOf(first)) {
+            return {first, other};
+        }
+    }
+    return {first, first};
+}
+}
+
+// Los eventos de un mismo torneo se procesan en el orden en que llegaron
+TEST(ShardedDispatcherTest, SameKey_KeepsArrivalOrder) {
+    ShardedDispatcher dispatcher{{4, 8}};
+    std::mutex mutex;
+    std::vector<int> seen;
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(dispatcher.Dispatch("TID-1", [&, i] {
+            std::lock_guard lock(mutex);
+            seen.push_back(i);
+        }));
+    }
+    dispatcher.Stop();
+
+    ASSERT_EQ(seen.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(seen[i], i);
+    }
+}
+
+// Un torneo lento no bloquea a los demás
+TEST(ShardedDispatcherTest, SlowKey_DoesNotBlockOtherShards) {
+    ShardedDispatcher dispatcher{{2, 8}};
+    const auto [slow, fast] = keysOnDifferentShards(dispatcher);
+    ASSERT_NE(slow, fast);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::promise<void> fastDone;
+
+    dispatcher.Dispatch(slow, [released] { released.wait(); });
+    dispatcher.Dispatch(fast, [&] { fastDone.set_value(); });
+
+    EXPECT_EQ(fastDone.get_future().wait_for(2s), std::future_status::ready);
+    release.set_value();
+}
+
+// Con la cola del shard llena, Dispatch espera hasta que el worker libera un lugar
+TEST(ShardedDispatcherTest, FullShard_DispatchWaits) {
+    ShardedDispatcher dispatcher{{1, 1}};
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    dispatcher.Dispatch("T", [released] { released.wait(); }); // running
+    dispatcher.Dispatch("T", [] {});                           // queued: shard full
+
+    std::atomic<bool> accepted{false};
+    auto producer = std::async(std::launch::async, [&] {
+        accepted = dispatcher.Dispatch("T", [] {});
+    });
+    EXPECT_EQ(producer.wait_for(100ms), std::future_status::timeout);
+    EXPECT_FALSE(accepted);
+
+    release.set_value();
+    EXPECT_EQ(producer.wait_for(2s), std::future_status::ready);
+    EXPECT_TRUE(accepted);
+}
+
+// Stop termina lo encolado y después rechaza tareas nuevas; una tarea que lanza no mata al worker
+TEST(ShardedDispatcherTest, Stop_DrainsQueueThenRejects) {
+    ShardedDispatcher dispatcher{{2, 16}};
+    std::atomic<int> done{0};
+
+    dispatcher.Dispatch("A", [] { throw std::runtime_error("boom"); });
+    for (int i = 0; i < 10; ++i) {
+        dispatcher.Dispatch(i % 2 ? "A" : "B", [&] { ++done; });
+    }
+    dispatcher.Stop();
+
+    EXPECT_EQ(done.load(), 10);
+    EXPECT_FALSE(dispatcher.Dispatch("A", [&] { ++done; }));
+    EXPECT_NO_THROW(dispatcher.Stop());
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <cms/MessageConsumer.h>
+#include <cms/MessageListener.h>
+#include <cms/Queue.h>
+#include <cms/Session.h>
+#include <cms/TextMessage.h>
+
+#include "mocks/ConnectionManagerMock.hpp"
+
+// In-memory broker client for the listener tests.
+class FakeText : public cms::TextMessage {
+    std::string text;
+public:
+    explicit FakeText(std::string text) : text(std::move(text)) {}
+    std::string getText() const override { return text; }
+};
+
+// Client side of one consumer: hands out the registered listener and the queued messages, blocks
+// receive() until there is one or close(), and counts the session's commits and rollbacks.
+struct FakeClient {
+    std::mutex mutex;
+    std::condition_variable changed;
+    cms::MessageListener* listener = nullptr;
+    std::deque<std::string> inbox;
+    bool closed = false;
+    int receives = 0;
+    int commits = 0;
+    int rollbacks = 0;
+};
+
+class FakeConsumer : public cms::MessageConsumer {
+    FakeClient& client;
+public:
+    explicit FakeConsumer(FakeClient& client) : client(client) {}
+    cms::Message* receive(int) override {
+        std::unique_lock lock(client.mutex);
+        ++client.receives;
+        client.changed.notify_all();
+        client.changed.wait(lock, [this] { return client.closed || !client.inbox.empty(); });
+        if (client.closed) return nullptr;
+        auto* message = new FakeText(std::move(client.inbox.front()));
+        client.inbox.pop_front();
+        return message;
+    }
+    void setMessageListener(cms::MessageListener* listener) override {
+        std::lock_guard lock(client.mutex);
+        client.listener = listener;
+        client.changed.notify_all();
+    }
+    void close() override {
+        std::lock_guard lock(client.mutex);
+        client.closed = true;
+        client.changed.notify_all();
+    }
+};
+
+class FakeSession : public cms::Session {
+    FakeClient& client;
+public:
+    explicit FakeSession(FakeClient& client) : client(client) {}
+    cms::Queue* createQueue(const std::string&) override { return new cms::Queue(); }
+    cms::MessageConsumer* createConsumer(const cms::Destination*) override { return new FakeConsumer(client); }
+    void commit() override {
+        std::lock_guard lock(client.mutex);
+        ++client.commits;
+        client.changed.notify_all();
+    }
+    void rollback() override {
+        std::lock_guard lock(client.mutex);
+        ++client.rollbacks;
+        client.changed.notify_all();
+    }
+};
+
+// The listener only opens transacted sessions.
+inline std::shared_ptr<testing::NiceMock<ConnectionManagerMock>> connectionTo(FakeClient& client) {
+    auto cm = std::make_shared<testing::NiceMock<ConnectionManagerMock>>();
+    ON_CALL(*cm, CreateSession(cms::Session::SESSION_TRANSACTED))
+        .WillByDefault([&client](auto) { return std::make_shared<FakeSession>(client); });
+    return cm;
+}
@@ -30,4 +30,9 @@ public:
                 CreateSession,
                 (),
                 (const));
+
+    MOCK_METHOD(std::shared_ptr<cms::Session>,
+                CreateSession,
+                (cms::Session::AcknowledgeMode mode),
+                (const));
 };
@@ -15,9 +15,9 @@
 
 class MatchDelegateMock : public MatchDelegate {
 public:
-    // Base ctor expects two shared_ptrs; for tests we can pass nullptr.
+    // Base ctor expects three shared_ptrs; for tests we can pass nullptr.
     MatchDelegateMock()
-        : MatchDelegate(nullptr, nullptr) {}
+        : MatchDelegate(nullptr, nullptr, nullptr) {}
 
     MOCK_METHOD((std::vector<std::shared_ptr<domain::Match>>),
                 ReadAll,
@@ -25,11 +25,28 @@ public:
                  const std::optional<std::string_view>& filter),
                 (override));
 
+    MOCK_METHOD(JsonPage,
+                ReadJsonPage,
+                (const std::string& tournamentId,
+                 const std::optional<std::string_view>& filter,
+                 const PageRequest& request),
+                (override));
+
+    MOCK_METHOD(std::optional<std::string>,
+                ReadVersion,
+                (const std::string& tournamentId),
+                (override));
+
     MOCK_METHOD(std::shared_ptr<domain::Match>,
                 ReadById,
                 (const std::string& tournamentId, const std::string& matchId),
                 (override));
 
+    MOCK_METHOD(std::optional<std::string>,
+                ReadJsonById,
+                (const std::string& tournamentId, const std::string& matchId),
+                (override));
+
     MOCK_METHOD((std::expected<void, std::string>),
                 UpdateScore,
                 (const std::string& tournamentId, const std::string& matchId,
@@ -1,6 +1,7 @@
 #pragma once
 #include <gmock/gmock.h>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -14,6 +15,16 @@ public:
                 (const std::string&),
                 (override));
 
+    MOCK_METHOD(JsonPage,
+                FindJsonPageByTournamentId,
+                (const std::string&, const std::string&, const PageRequest&),
+                (override));
+
+    MOCK_METHOD(std::optional<std::string>,
+                FindJsonByTournamentIdAndMatchId,
+                (const std::string&, const std::string&),
+                (override));
+
     MOCK_METHOD(std::shared_ptr<domain::Match>,
                 FindByTournamentIdAndMatchId,
                 (const std::string&, const std::string&),
@@ -33,4 +44,9 @@ public:
                 CreateIfNotExists,
                 (const domain::Match&),
                 (override));
+
+    MOCK_METHOD(std::vector<std::string>,
+                CreateBatch,
+                (const std::vector<domain::Match>&),
+                (override));
 };
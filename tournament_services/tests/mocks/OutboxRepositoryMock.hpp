@@ -0,0 +1,25 @@
+#pragma once
+#include <gmock/gmock.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "persistence/repository/IOutboxRepository.hpp"
+
+class OutboxRepositoryMock : public IOutboxRepository {
+public:
+    MOCK_METHOD(void,
+                Enqueue,
+                (const std::string&, const std::string&),
+                (override));
+
+    MOCK_METHOD(std::size_t,
+                PublishPending,
+                (std::size_t, const std::function<void(const OutboxEvent&)>&),
+                (override));
+
+    MOCK_METHOD(std::size_t,
+                PurgePublished,
+                (int),
+                (override));
+};
@@ -8,4 +8,15 @@ public:
                 SendMessage,
                 (const std::string_view& message, const std::string_view& queue),
                 (override));
+
+    MOCK_METHOD(void,
+                SendMessageNow,
+                (const std::string_view& message, const std::string_view& queue),
+                (override));
+};
+
+// Same mock with the binary event encoding switched on.
+class BinaryEventsProducerMock : public QueueMessageProducerMock {
+public:
+    bool BinaryEvents() const override { return true; }
 };
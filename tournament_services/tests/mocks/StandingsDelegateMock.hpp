@@ -0,0 +1,19 @@
+#pragma once
+#include <gmock/gmock.h>
+#include <optional>
+#include <string>
+
+#include "delegate/IStandingsDelegate.hpp"
+
+class StandingsDelegateMock : public IStandingsDelegate {
+public:
+    MOCK_METHOD(std::optional<std::string>,
+                ReadTournamentStandingsJson,
+                (const std::string&),
+                (override));
+
+    MOCK_METHOD(std::optional<std::string>,
+                ReadGroupStandingsJson,
+                (const std::string&, const std::string&),
+                (override));
+};
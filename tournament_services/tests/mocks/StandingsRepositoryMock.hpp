@@ -0,0 +1,31 @@
+#pragma once
+#include <gmock/gmock.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "persistence/repository/IStandingsRepository.hpp"
+#include "domain/Standing.hpp"
+
+class StandingsRepositoryMock : public IStandingsRepository {
+public:
+    MOCK_METHOD(void,
+                Apply,
+                (const std::string&, const std::vector<domain::Standing>&),
+                (override));
+
+    MOCK_METHOD(std::vector<domain::Standing>,
+                FindByTournamentId,
+                (const std::string&),
+                (override));
+
+    MOCK_METHOD(std::optional<std::string>,
+                FindJsonByTournamentId,
+                (const std::string&),
+                (override));
+
+    MOCK_METHOD(std::optional<std::string>,
+                FindJsonByTournamentIdAndGroupId,
+                (const std::string&, const std::string&),
+                (override));
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include <gmock/gmock.h>
 #include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -11,6 +13,8 @@ class TeamDelegateMock : public ITeamDelegate {
 public:
 
     MOCK_METHOD(std::vector<std::shared_ptr<domain::Team>>, GetAllTeams, (), (override));
+    MOCK_METHOD(std::optional<std::string>, GetTeamJson, (std::string_view), (override));
+    MOCK_METHOD(JsonPage, GetTeamsJsonPage, (const PageRequest&), (override));
     MOCK_METHOD(std::string_view, SaveTeam, (const domain::Team&), (override));
     MOCK_METHOD(std::shared_ptr<domain::Team>, GetTeam, (std::string_view), (override));
     MOCK_METHOD(bool, UpdateTeam, (std::string_view, const domain::Team&), (override));
@@ -17,9 +17,16 @@ public:
     // Firmas EXACTAS del repo real (usa std::string_view)
     MOCK_METHOD(std::string_view, Create, (const domain::Team&), (override));
     MOCK_METHOD(std::vector<std::shared_ptr<domain::Team>>, ReadAll, (), (override));
+    MOCK_METHOD(JsonPage, ReadJsonPage, (const PageRequest&), (override));
+    MOCK_METHOD(std::optional<std::string>, ReadJsonById, (std::string_view), (override));
     MOCK_METHOD(std::shared_ptr<domain::Team>, ReadById, (std::string_view), (override));
     MOCK_METHOD(std::string_view, Update, (const domain::Team&), (override));
     MOCK_METHOD(void, Delete, (std::string_view), (override));
+
+    // Sin conexión real: las lecturas diferidas caen en ReadById (mockeado)
+    Deferred<std::shared_ptr<domain::Team>> DeferReadById(ReadBatch& batch, std::string_view id) override {
+        return IRepository<domain::Team, std::string_view>::DeferReadById(batch, id);
+    }
 };
 
 // Alias para compatibilidad con el nombre viejo
@@ -2,6 +2,7 @@
 #include <gmock/gmock.h>
 #include <expected>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -20,11 +21,26 @@ public:
                 (),
                 (override));
 
+    MOCK_METHOD((std::expected<JsonPage, std::string>),
+                ReadJsonPage,
+                (const PageRequest&),
+                (override));
+
     MOCK_METHOD((std::expected<std::shared_ptr<domain::Tournament>, std::string>),
                 ReadById,
                 (const std::string&),
                 (override));
 
+    MOCK_METHOD((std::expected<std::optional<std::string>, std::string>),
+                ReadVersion,
+                (const std::string&),
+                (override));
+
+    MOCK_METHOD((std::expected<Versioned<domain::Tournament>, std::string>),
+                ReadWithVersion,
+                (const std::string&),
+                (override));
+
     MOCK_METHOD((std::expected<bool, std::string>),
                 UpdateTournament,
                 (const std::string&, const domain::Tournament&),
@@ -15,9 +15,16 @@ public:
 
     MOCK_METHOD(std::string, Create, (const domain::Tournament&), (override));
     MOCK_METHOD(std::vector<std::shared_ptr<domain::Tournament>>, ReadAll, (), (override));
+    MOCK_METHOD(JsonPage, ReadJsonPage, (const PageRequest&), (override));
     MOCK_METHOD(std::shared_ptr<domain::Tournament>, ReadById, (std::string), (override));
+    MOCK_METHOD(Versioned<domain::Tournament>, ReadWithVersion, (std::string), (override));
     MOCK_METHOD(std::string, Update, (const domain::Tournament&), (override));
     MOCK_METHOD(void, Delete, (std::string), (override));
+
+    // Sin conexión real: las lecturas diferidas caen en ReadById (mockeado)
+    Deferred<std::shared_ptr<domain::Tournament>> DeferReadById(ReadBatch& batch, std::string id) override {
+        return IRepository<domain::Tournament, std::string>::DeferReadById(batch, std::move(id));
+    }
 };
 
 // Alias para compatibilidad con el nombre viejo usado en algunos tests
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "persistence/configuration/ConnectionPool.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Conexión falsa: solo sabe si sigue "abierta".
+struct FakeConnection final : IDbConnection {
+    std::shared_ptr<std::atomic<bool>> open = std::make_shared<std::atomic<bool>>(true);
+    std::atomic<bool> busy{false};
+    [[nodiscard]] bool IsOpen() const override { return open->load(); }
+};
+
+struct Counters {
+    std::atomic<int> opened{0};
+    std::atomic<int> validated{0};
+};
+
+ConnectionPool::Factory fakeFactory(Counters& counters) {
+    return [&counters] {
+        ++counters.opened;
+        return std::unique_ptr<IDbConnection>(std::make_unique<FakeConnection>());
+    };
+}
+
+ConnectionPool::Validator fakeValidator(Counters& counters) {
+    return [&counters](IDbConnection& c) {
+        ++counters.validated;
+        return c.IsOpen();
+    };
+}
+
+ConnectionPoolSettings settings(std::size_t min, std::size_t max) {
+    ConnectionPoolSettings s;
+    s.minSize = min;
+    s.maxSize = max;
+    s.acquireTimeout = 50ms;
+    s.idleTimeout = 10min;
+    s.validationInterval = 10min;
+    return s;
+}
+
+}
+
+TEST(ConnectionPoolTest, OpensMinEagerlyAndGrowsUpToMax) {
+    Counters counters;
+    ConnectionPool pool(settings(1, 3), fakeFactory(counters), fakeValidator(counters));
+    EXPECT_EQ(counters.opened, 1);
+    EXPECT_EQ(pool.OpenConnections(), 1u);
+
+    auto a = pool.Acquire();
+    auto b = pool.Acquire();
+    auto c = pool.Acquire();
+    EXPECT_EQ(counters.opened, 3);
+    EXPECT_EQ(pool.OpenConnections(), 3u);
+    EXPECT_EQ(pool.IdleConnections(), 0u);
+}
+
+TEST(ConnectionPoolTest, ReusesReleasedConnection) {
+    Counters counters;
+    ConnectionPool pool(settings(1, 2), fakeFactory(counters), fakeValidator(counters));
+    IDbConnection* first = nullptr;
+    {
+        auto a = pool.Acquire();
+        first = &*a;
+    }
+    auto b = pool.Acquire();
+    EXPECT_EQ(&*b, first);
+    EXPECT_EQ(counters.opened, 1);
+}
+
+TEST(ConnectionPoolTest, AcquireTimesOutWhenExhausted) {
+    Counters counters;
+    ConnectionPool pool(settings(1, 1), fakeFactory(counters), fakeValidator(counters));
+    auto held = pool.Acquire();
+    EXPECT_THROW(pool.Acquire(), ConnectionAcquireTimeout);
+}
+
+TEST(ConnectionPoolTest, WaiterGetsConnectionOnRelease) {
+    Counters counters;
+    auto s = settings(1, 1);
+    s.acquireTimeout = 2s;
+    ConnectionPool pool(s, fakeFactory(counters), fakeValidator(counters));
+
+    auto held = std::make_unique<PooledConnection>(pool.Acquire());
+    auto waiter = std::async(std::launch::async, [&pool] { return pool.Acquire()->IsOpen(); });
+    std::this_thread::sleep_for(20ms);
+    held.reset();
+    EXPECT_TRUE(waiter.get());
+    EXPECT_EQ(counters.opened, 1);
+}
+
+TEST(ConnectionPoolTest, DeadConnectionIsDroppedOnRelease) {
+    Counters counters;
+    ConnectionPool pool(settings(1, 2), fakeFactory(counters), fakeValidator(counters));
+    {
+        auto a = pool.Acquire();
+        static_cast<FakeConnection&>(*a).open->store(false);
+    }
+    EXPECT_EQ(pool.OpenConnections(), 0u);
+    auto b = pool.Acquire();
+    EXPECT_TRUE(b->IsOpen());
+    EXPECT_EQ(counters.opened, 2);
+}
+
+TEST(ConnectionPoolTest, BrokenIdleConnectionIsReplacedAfterValidation) {
+    Counters counters;
+    auto s = settings(1, 1);
+    s.validationInterval = 0ms;
+    ConnectionPool pool(s, fakeFactory(counters), [&counters](IDbConnection&) {
+        ++counters.validated;
+        return false;   // p.ej. el servidor se reinició
+    });
+
+    auto a = pool.Acquire();
+    EXPECT_EQ(counters.validated, 1);
+    EXPECT_EQ(counters.opened, 2);
+    EXPECT_EQ(pool.OpenConnections(), 1u);
+}
+
+TEST(ConnectionPoolTest, ValidatorExceptionCountsAsBroken) {
+    Counters counters;
+    auto s = settings(1, 1);
+    s.validationInterval = 0ms;
+    ConnectionPool pool(s, fakeFactory(counters), [](IDbConnection&) -> bool {
+        throw std::runtime_error("connection reset");
+    });
+
+    auto a = pool.Acquire();
+    EXPECT_EQ(counters.opened, 2);
+}
+
+TEST(ConnectionPoolTest, ReapIdleClosesDownToMin) {
+    Counters counters;
+    auto s = settings(1, 3);
+    // Un timeout largo deja fuera al reaper de fondo; el reloj se adelanta a mano
+    s.idleTimeout = std::chrono::hours(1);
+    ConnectionPool pool(s, fakeFactory(counters), fakeValidator(counters));
+    {
+        auto a = pool.Acquire();
+        auto b = pool.Acquire();
+        auto c = pool.Acquire();
+    }
+    pool.ReapIdle();
+    EXPECT_EQ(pool.OpenConnections(), 3u);
+    pool.ReapIdle(ConnectionPool::Clock::now() + std::chrono::hours(2));
+    EXPECT_EQ(pool.OpenConnections(), 1u);
+    EXPECT_EQ(pool.IdleConnections(), 1u);
+}
+
+TEST(ConnectionPoolTest, FactoryFailureDoesNotLeakCapacity) {
+    std::atomic<int> calls{0};
+    ConnectionPool pool(settings(0, 1), [&calls]() -> std::unique_ptr<IDbConnection> {
+        if (calls++ == 0) throw std::runtime_error("db down");
+        return std::make_unique<FakeConnection>();
+    }, [](IDbConnection&) { return true; });
+
+    EXPECT_THROW(pool.Acquire(), std::runtime_error);
+    EXPECT_EQ(pool.OpenConnections(), 0u);
+    auto a = pool.Acquire();
+    EXPECT_EQ(pool.OpenConnections(), 1u);
+}
+
+TEST(ConnectionPoolTest, AffinityThreadKeepsItsHomeConnection) {
+    Counters counters;
+    auto s = settings(2, 2);
+    s.mode = PoolMode::Affinity;
+    ConnectionPool pool(s, fakeFactory(counters), fakeValidator(counters));
+
+    auto homeOf = [&pool] {
+        IDbConnection* home = &*pool.Acquire();
+        for (int i = 0; i < 10; ++i) {
+            if (&*pool.Acquire() != home) return static_cast<IDbConnection*>(nullptr);
+        }
+        return home;
+    };
+    IDbConnection* first = std::async(std::launch::async, homeOf).get();
+    IDbConnection* second = std::async(std::launch::async, homeOf).get();
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(counters.opened, 2);
+}
+
+TEST(ConnectionPoolTest, AffinityFallsBackWhenHomeIsBusy) {
+    Counters counters;
+    auto s = settings(1, 2);
+    s.mode = PoolMode::Affinity;
+    ConnectionPool pool(s, fakeFactory(counters), fakeValidator(counters));
+
+    auto a = pool.Acquire();
+    auto b = pool.Acquire();    // mismo hilo, su slot está ocupado -> overflow
+    EXPECT_NE(&*a, &*b);
+    EXPECT_EQ(pool.OpenConnections(), 2u);
+}
+
+TEST(ConnectionPoolTest, MovedHandleReleasesOnce) {
+    Counters counters;
+    ConnectionPool pool(settings(1, 1), fakeFactory(counters), fakeValidator(counters));
+    {
+        auto a = pool.Acquire();
+        PooledConnection b = std::move(a);
+        EXPECT_FALSE(a);
+        EXPECT_TRUE(b);
+        EXPECT_EQ(pool.IdleConnections(), 0u);
+    }
+    EXPECT_EQ(pool.IdleConnections(), 1u);
+    EXPECT_TRUE(pool.Acquire().As<FakeConnection>().IsOpen());
+}
+
+TEST(ConnectionPoolTest, ConcurrentAcquireNeverSharesAConnection) {
+    for (auto mode : {PoolMode::Shared, PoolMode::Affinity}) {
+        Counters counters;
+        auto s = settings(1, 4);
+        s.mode = mode;
+        s.acquireTimeout = 5s;
+        ConnectionPool pool(s, fakeFactory(counters), fakeValidator(counters));
+        std::atomic<bool> overlap{false};
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 2000; ++i) {
+                    auto c = pool.Acquire();
+                    auto& fake = c.As<FakeConnection>();
+                    if (fake.busy.exchange(true)) overlap = true;
+                    fake.busy = false;
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        EXPECT_FALSE(overlap);
+        EXPECT_LE(pool.OpenConnections(), 4u);
+        EXPECT_LE(counters.opened, 4);
+    }
+}
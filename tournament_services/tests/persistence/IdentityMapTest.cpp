@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "domain/Team.hpp"
+#include "persistence/repository/IdentityMap.hpp"
+
+namespace {
+    using LoadedTeam = std::shared_ptr<domain::Team>;
+
+    // Stands in for a repository read: counts how often the "database" is hit.
+    struct CountingLoad {
+        int calls = 0;
+        LoadedTeam operator()(const std::string& id) {
+            ++calls;
+            return id == "missing" ? nullptr : std::make_shared<domain::Team>(domain::Team{id, "Team " + id});
+        }
+        LoadedTeam Read(const std::string& id) {
+            return IdentityMap::Through<LoadedTeam>(id, [&] { return (*this)(id); });
+        }
+    };
+}
+
+TEST(IdentityMapTest, WithoutScopeEveryReadLoads) {
+    CountingLoad db;
+    db.Read("a");
+    db.Read("a");
+    EXPECT_EQ(db.calls, 2);
+}
+
+TEST(IdentityMapTest, RepeatedLookupReturnsSameObject) {
+    IdentityMap map;
+    CountingLoad db;
+
+    const auto first = db.Read("a");
+    const auto second = db.Read("a");
+    db.Read("b");
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(db.calls, 2);
+    EXPECT_EQ(map.Statistics().loads, 2u);
+    EXPECT_EQ(map.Statistics().hits, 1u);
+}
+
+TEST(IdentityMapTest, NotFoundIsRememberedToo) {
+    IdentityMap map;
+    CountingLoad db;
+
+    EXPECT_EQ(db.Read("missing"), nullptr);
+    EXPECT_EQ(db.Read("missing"), nullptr);
+    EXPECT_EQ(db.calls, 1);
+}
+
+TEST(IdentityMapTest, EvictedEntriesLoadAgain) {
+    IdentityMap map;
+    CountingLoad db;
+
+    db.Read("a");
+    IdentityMap::Evict<LoadedTeam>("a");
+    db.Read("a");
+    IdentityMap::EvictAll<LoadedTeam>();
+    db.Read("a");
+    EXPECT_EQ(db.calls, 3);
+    EXPECT_EQ(map.Statistics().hits, 0u);
+}
+
+TEST(IdentityMapTest, ValueTypesDoNotShareKeys) {
+    IdentityMap map;
+    IdentityMap::Put<LoadedTeam>("t1", std::make_shared<domain::Team>(domain::Team{"t1", "A"}));
+
+    EXPECT_FALSE(IdentityMap::Find<std::vector<LoadedTeam>>("t1").has_value());
+    const auto found = IdentityMap::Find<LoadedTeam>("t1");
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ((*found)->Name, "A");
+}
+
+TEST(IdentityMapTest, NestedScopeSharesEntriesAndCounters) {
+    IdentityMap outer;
+    CountingLoad db;
+    db.Read("a");
+    {
+        IdentityMap inner;
+        db.Read("a");
+        EXPECT_EQ(inner.Statistics().hits, 1u);
+    }
+    db.Read("a");
+    EXPECT_EQ(db.calls, 1);
+    EXPECT_EQ(outer.Statistics().hits, 2u);
+}
+
+TEST(IdentityMapTest, ScopeEndsWithItsLifetimeAndThread) {
+    CountingLoad db;
+    {
+        IdentityMap map;
+        db.Read("a");
+        std::thread([&] { db.Read("a"); }).join();
+        EXPECT_EQ(db.calls, 2);
+    }
+    EXPECT_FALSE(IdentityMap::Find<LoadedTeam>("a").has_value());
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "persistence/repository/MatchRowDecoder.hpp"
+
+namespace {
+    struct FakeField {
+        std::optional<std::string> value;
+        bool is_null() const { return !value.has_value(); }
+        const char* c_str() const { return value ? value->c_str() : ""; }
+        template<typename T> T as() const { return static_cast<T>(std::stol(*value)); }
+    };
+
+    struct FakeRow {
+        std::vector<FakeField> fields;
+        const FakeField& operator[](std::size_t i) const { return fields[i]; }
+    };
+}
+
+TEST(MatchRowDecoderTest, DecodesPlayedMatch) {
+    const FakeRow row{{
+        {"M1"}, {"T1"}, {"qf"}, {"played"},
+        {"H1"}, {"Home"}, {"V1"}, {"Visitor"},
+        {"3"}, {"3"}, {"V1"}, {"randomTieBreak"},
+        {"M9"}, {"visitor"},
+    }};
+
+    const auto m = match_columns::Decode(row);
+
+    EXPECT_EQ(m.Id(), "M1");
+    EXPECT_EQ(m.TournamentId(), "T1");
+    EXPECT_EQ(m.Round(), "qf");
+    EXPECT_EQ(m.Status(), "played");
+    EXPECT_EQ(m.Home().Id(), "H1");
+    EXPECT_EQ(m.Visitor().Name(), "Visitor");
+    ASSERT_TRUE(m.HasScore());
+    EXPECT_EQ(*m.ScoreHome(), 3);
+    EXPECT_EQ(*m.ScoreVisitor(), 3);
+    EXPECT_EQ(m.WinnerTeamId(), std::optional<std::string>("V1"));
+    EXPECT_EQ(m.DecidedBy(), std::optional<std::string>("randomTieBreak"));
+    EXPECT_EQ(m.NextMatchId(), std::optional<std::string>("M9"));
+    EXPECT_EQ(m.NextMatchWinnerSlot(), std::optional<std::string>("visitor"));
+}
+
+TEST(MatchRowDecoderTest, NullColumnsLeaveOptionalsEmpty) {
+    const FakeRow row{{
+        {"M2"}, {"T1"}, {"sf"}, {std::nullopt},
+        {std::nullopt}, {std::nullopt}, {std::nullopt}, {std::nullopt},
+        {std::nullopt}, {std::nullopt}, {std::nullopt}, {std::nullopt},
+        {std::nullopt}, {std::nullopt},
+    }};
+
+    const auto m = match_columns::Decode(row);
+
+    EXPECT_EQ(m.Status(), "pending");
+    EXPECT_TRUE(m.Home().Id().empty());
+    EXPECT_FALSE(m.HasScore());
+    EXPECT_FALSE(m.WinnerTeamId().has_value());
+    EXPECT_FALSE(m.NextMatchId().has_value());
+}
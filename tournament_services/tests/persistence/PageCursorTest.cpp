@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "persistence/repository/Page.hpp"
+
+TEST(PageCursorTest, EncodeDecodeRoundTrip) {
+    const PageCursor cursor{"2025-10-01 10:00:00.123456", "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee"};
+    const std::string token = page_cursor::Encode(cursor);
+
+    // URL safe: no padding, no '+', '/' or '='
+    EXPECT_EQ(token.find_first_of("+/="), std::string::npos);
+
+    auto decoded = page_cursor::Decode(token);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->createdAt, cursor.createdAt);
+    EXPECT_EQ(decoded->id, cursor.id);
+}
+
+TEST(PageCursorTest, DecodeRejectsForeignTokens) {
+    EXPECT_FALSE(page_cursor::Decode("").has_value());
+    EXPECT_FALSE(page_cursor::Decode("not a cursor").has_value());
+    // well-formed base64 but not "created_at|uuid"
+    EXPECT_FALSE(page_cursor::Decode(page_cursor::Encode({"2025-10-01", "not-a-uuid"})).has_value());
+    EXPECT_FALSE(page_cursor::Decode(page_cursor::Encode({"1'; DROP TABLE teams;--", "aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee"})).has_value());
+}
+
+namespace {
+    // Minimal stand-in for a pqxx row/result: row["column"].c_str()
+    struct FakeField {
+        std::string value;
+        const char* c_str() const { return value.c_str(); }
+        std::size_t size() const { return value.size(); }
+    };
+    struct FakeRow {
+        std::string id, createdAt, body;
+        FakeField operator[](const char* column) const {
+            const std::string name{column};
+            return FakeField{name == "id" ? id : name == "body" ? body : createdAt};
+        }
+    };
+}
+
+TEST(PageCursorTest, JsonArrayFromRowsUsesExtraRowOnlyAsMoreMarker) {
+    const std::vector<FakeRow> rows{
+        {"00000000-0000-0000-0000-000000000001", "2025-01-01 00:00:01", "1"},
+        {"00000000-0000-0000-0000-000000000002", "2025-01-01 00:00:02", "2"},
+        {"00000000-0000-0000-0000-000000000003", "2025-01-01 00:00:03", "3"},
+    };
+    PageRequest request;
+    request.limit = 2;
+
+    auto page = page_cursor::JsonArrayFromRows(rows, request);
+    EXPECT_EQ(page.body, "[1,2]");
+    ASSERT_TRUE(page.next.has_value());
+    EXPECT_EQ(page.next->id, rows[1].id);
+    EXPECT_EQ(page.next->createdAt, rows[1].createdAt);
+
+    request.limit = 3;
+    auto last = page_cursor::JsonArrayFromRows(rows, request);
+    EXPECT_EQ(last.body, "[1,2,3]");
+    EXPECT_FALSE(last.next.has_value());
+}
+
+TEST(PageCursorTest, JsonArrayFromRowsJoinsBodiesVerbatim) {
+    const std::vector<FakeRow> rows{
+        {"00000000-0000-0000-0000-000000000001", "2025-01-01 00:00:01", R"({"id":"1","name":"A"})"},
+        {"00000000-0000-0000-0000-000000000002", "2025-01-01 00:00:02", R"({"id":"2","name":"B"})"},
+        {"00000000-0000-0000-0000-000000000003", "2025-01-01 00:00:03", R"({"id":"3","name":"C"})"},
+    };
+    PageRequest request;
+    request.limit = 2;
+
+    auto page = page_cursor::JsonArrayFromRows(rows, request);
+    EXPECT_EQ(page.body, R"([{"id":"1","name":"A"},{"id":"2","name":"B"}])");
+    ASSERT_TRUE(page.next.has_value());
+    EXPECT_EQ(page.next->id, rows[1].id);
+
+    auto empty = page_cursor::JsonArrayFromRows(std::vector<FakeRow>{}, request);
+    EXPECT_EQ(empty.body, "[]");
+    EXPECT_FALSE(empty.next.has_value());
+}
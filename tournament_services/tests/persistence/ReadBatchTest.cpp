@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "persistence/repository/ReadBatch.hpp"
+
+TEST(ReadBatchTest, DeferredResolvesLazilyAndOnlyOnce) {
+    int calls = 0;
+    Deferred<std::string> value([&calls] { ++calls; return std::string("done"); });
+    EXPECT_EQ(calls, 0);
+
+    EXPECT_EQ(value.get(), "done");
+    EXPECT_EQ(value.get(), "done");
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(ReadBatchTest, ReadyNeverCallsAResolver) {
+    auto value = Deferred<int>::Ready(7);
+    EXPECT_EQ(value.get(), 7);
+}
+
+TEST(ReadBatchTest, SessionIsSharedPerKey) {
+    struct CountingSession : ReadBatch::Session {};
+    int created = 0;
+    auto make = [&created] { ++created; return std::make_shared<CountingSession>(); };
+    int keyA = 0, keyB = 0;
+
+    ReadBatch batch;
+    auto first  = batch.SessionFor<CountingSession>(&keyA, make);
+    auto second = batch.SessionFor<CountingSession>(&keyA, make);
+    auto other  = batch.SessionFor<CountingSession>(&keyB, make);
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, other);
+    EXPECT_EQ(created, 2);
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "persistence/configuration/ReadRouting.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(ReadRoutingTest, ReadsGoToReplicaUntilThreadWrites) {
+    read_routing::Reset();
+    EXPECT_FALSE(read_routing::PreferPrimary(2000ms));
+
+    read_routing::MarkWrite();
+    EXPECT_TRUE(read_routing::PreferPrimary(2000ms));
+    read_routing::Reset();
+}
+
+TEST(ReadRoutingTest, WriteWindowExpires) {
+    read_routing::Reset();
+    read_routing::MarkWrite();
+    std::this_thread::sleep_for(5ms);
+    EXPECT_FALSE(read_routing::PreferPrimary(1ms));
+    read_routing::Reset();
+}
+
+TEST(ReadRoutingTest, WritesOnOtherThreadsDoNotPinThisOne) {
+    read_routing::Reset();
+    std::thread([] { read_routing::MarkWrite(); }).join();
+    EXPECT_FALSE(read_routing::PreferPrimary(2000ms));
+}
+
+TEST(ReadRoutingTest, PrimaryScopeForcesPrimaryWhileAlive) {
+    read_routing::Reset();
+    {
+        read_routing::PrimaryScope scope;
+        EXPECT_TRUE(read_routing::PreferPrimary(0ms));
+    }
+    EXPECT_FALSE(read_routing::PreferPrimary(0ms));
+}
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "persistence/configuration/StatementCatalog.hpp"
+
+using statements::StatementId;
+
+TEST(StatementCatalogTest, LookupByIdReturnsMatchingEntry) {
+    for (std::size_t i = 0; i < statements::StatementCount; ++i) {
+        const auto id = static_cast<StatementId>(i);
+        EXPECT_EQ(statements::Get(id).id, id);
+    }
+    EXPECT_EQ(statements::Get(StatementId::InsertGroup).name, "insert_group");
+}
+
+TEST(StatementCatalogTest, PlaceholderCheckCountsHighestParameter) {
+    static_assert(statements::detail::maxPlaceholder("select 1") == 0);
+    static_assert(statements::detail::maxPlaceholder("where a = $2 and b = $1") == 2);
+    static_assert(statements::detail::maxPlaceholder("values ($10)") == 10);
+    static_assert(statements::detail::typeCount("uuid, jsonb") == 2);
+    SUCCEED();
+}
+
+TEST(StatementCatalogTest, DumpListsEveryStatement) {
+    std::ostringstream out;
+    statements::Dump(out);
+    const auto text = out.str();
+    for (const auto& statement : statements::Catalog) {
+        EXPECT_NE(text.find(std::string{statement.name}), std::string::npos) << statement.name;
+    }
+}
+
+TEST(StatementCatalogTest, InlineSubstitutesQuotedLiterals) {
+    const auto sql = statements::Inline(StatementId::SelectGroupByTournamentIdGroupId, {"'t-1'", "'g-2'"});
+    EXPECT_EQ(sql, "SELECT id, document FROM groups WHERE tournament_id = 't-1'::uuid AND id = 'g-2'::uuid");
+}
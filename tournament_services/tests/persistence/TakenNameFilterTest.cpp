@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "persistence/repository/TakenNameFilter.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(TakenNameFilterTest, DisabledByDefault) {
+    TakenNameFilter filter;
+    filter.Remember("Eagles");
+
+    EXPECT_FALSE(filter.Enabled());
+    EXPECT_FALSE(filter.Taken("Eagles"));
+}
+
+TEST(TakenNameFilterTest, RemembersNamesUntilTheyExpire) {
+    TakenNameFilter filter(TakenNameFilterSettings{50ms, 16});
+    filter.Remember("Eagles");
+
+    EXPECT_TRUE(filter.Taken("Eagles"));
+    EXPECT_FALSE(filter.Taken("Bears"));
+
+    std::this_thread::sleep_for(80ms);
+    EXPECT_FALSE(filter.Taken("Eagles"));
+}
+
+TEST(TakenNameFilterTest, ClearForgetsEverything) {
+    TakenNameFilter filter(TakenNameFilterSettings{60s, 16});
+    filter.Remember("Eagles");
+    filter.Clear();
+
+    EXPECT_FALSE(filter.Taken("Eagles"));
+}
+
+TEST(TakenNameFilterTest, StaysWithinMaxEntries) {
+    TakenNameFilter filter(TakenNameFilterSettings{60s, 2});
+    filter.Remember("a");
+    filter.Remember("b");
+    filter.Remember("c");
+
+    // Full of live names: the filter starts over instead of growing.
+    EXPECT_TRUE(filter.Taken("c"));
+    EXPECT_FALSE(filter.Taken("a"));
+    EXPECT_FALSE(filter.Taken("b"));
+}
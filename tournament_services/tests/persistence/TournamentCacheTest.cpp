@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "domain/Tournament.hpp"
+#include "persistence/configuration/TournamentChangeListener.hpp"
+#include "persistence/repository/TournamentCache.hpp"
+
+namespace {
+    domain::Tournament tournament(const std::string& id, const std::string& name = "Mundial") {
+        domain::Tournament t(name);
+        t.Id() = id;
+        return t;
+    }
+
+    void load(TournamentCache& cache, const domain::Tournament& t) {
+        cache.Put(t, cache.StampFor(t.Id()));
+    }
+}
+
+TEST(TournamentCacheTest, MissThenHit) {
+    TournamentCache cache;
+
+    EXPECT_EQ(cache.Find("t1"), nullptr);
+    load(cache, tournament("t1"));
+    const auto found = cache.Find("t1");
+
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->Name(), "Mundial");
+    const auto stats = cache.Statistics();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.size, 1u);
+}
+
+TEST(TournamentCacheTest, HitIsACopyTheCallerMayChange) {
+    TournamentCache cache;
+    load(cache, tournament("t1"));
+
+    cache.Find("t1")->Name() = "changed";
+
+    EXPECT_EQ(cache.Find("t1")->Name(), "Mundial");
+}
+
+TEST(TournamentCacheTest, InvalidateDropsTheEntry) {
+    TournamentCache cache;
+    load(cache, tournament("t1"));
+    load(cache, tournament("t2"));
+
+    cache.Invalidate("t1");
+
+    EXPECT_EQ(cache.Find("t1"), nullptr);
+    EXPECT_NE(cache.Find("t2"), nullptr);
+    EXPECT_EQ(cache.Statistics().invalidations, 1u);
+}
+
+TEST(TournamentCacheTest, ReadRacingAnInvalidationIsNotCached) {
+    TournamentCache cache;
+    const auto stamp = cache.StampFor("t1");   // read starts
+    cache.Invalidate("t1");                    // a write commits meanwhile
+    cache.Put(tournament("t1", "old"), stamp); // the read ends with the old row
+
+    EXPECT_EQ(cache.Find("t1"), nullptr);
+}
+
+TEST(TournamentCacheTest, SizeBoundEvictsTheOldestEntry) {
+    TournamentCache cache(TournamentCacheSettings{2, 1});
+    load(cache, tournament("t1"));
+    load(cache, tournament("t2"));
+    load(cache, tournament("t3"));
+
+    EXPECT_EQ(cache.Find("t1"), nullptr);
+    EXPECT_NE(cache.Find("t2"), nullptr);
+    EXPECT_NE(cache.Find("t3"), nullptr);
+    EXPECT_EQ(cache.Statistics().evictions, 1u);
+    EXPECT_EQ(cache.Statistics().size, 2u);
+}
+
+TEST(TournamentCacheTest, ZeroEntriesDisablesTheCache) {
+    TournamentCache cache(TournamentCacheSettings{0, 4});
+    load(cache, tournament("t1"));
+
+    EXPECT_FALSE(cache.Enabled());
+    EXPECT_EQ(cache.Find("t1"), nullptr);
+    EXPECT_EQ(cache.Statistics().size, 0u);
+}
+
+TEST(TournamentCacheTest, NotificationPayloadInvalidatesOrClears) {
+    TournamentCache cache;
+    load(cache, tournament("t1"));
+    load(cache, tournament("t2"));
+
+    TournamentChangeListener::Apply(cache, "t1");
+    EXPECT_EQ(cache.Find("t1"), nullptr);
+    EXPECT_NE(cache.Find("t2"), nullptr);
+
+    TournamentChangeListener::Apply(cache, "");
+    EXPECT_EQ(cache.Statistics().size, 0u);
+}
+
+TEST(TournamentCacheTest, ConcurrentReadersAndWriters) {
+    TournamentCache cache(TournamentCacheSettings{64, 8});
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 4; ++w) {
+        threads.emplace_back([&cache, w] {
+            for (int i = 0; i < 2000; ++i) {
+                const std::string id = "t" + std::to_string((i + w) % 100);
+                if (i % 7 == 0) {
+                    cache.Invalidate(id);
+                } else if (!cache.Find(id)) {
+                    load(cache, tournament(id));
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    const auto stats = cache.Statistics();
+    EXPECT_EQ(stats.hits + stats.misses, 4u * 2000u - 4u * (2000u / 7u + 1u));
+    EXPECT_LE(stats.size, 64u);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "persistence/configuration/UnitOfWork.hpp"
+
+namespace {
+    // Counts checkouts; the tests below never reach the point where a unit opens its transaction.
+    class CountingProvider : public IDbConnectionProvider {
+    public:
+        int connections = 0;
+        int reads = 0;
+        PooledConnection Connection() override { ++connections; return {}; }
+        PooledConnection ReadConnection() override { ++reads; return {}; }
+    };
+}
+
+TEST(UnitOfWorkTest, NoUnitMeansRepositoriesRunOnTheirOwn) {
+    CountingProvider provider;
+    EXPECT_FALSE(UnitOfWork::Open());
+    EXPECT_EQ(UnitOfWork::For(provider), nullptr);
+    EXPECT_EQ(provider.connections, 0);
+}
+
+TEST(UnitOfWorkTest, ScopeEndsTheUnit) {
+    {
+        UnitOfWork unit;
+        EXPECT_TRUE(UnitOfWork::Open());
+    }
+    EXPECT_FALSE(UnitOfWork::Open());
+}
+
+TEST(UnitOfWorkTest, CommittedUnitHandsOutNothing) {
+    CountingProvider provider;
+    UnitOfWork unit;
+    unit.Commit();
+    EXPECT_FALSE(UnitOfWork::Open());
+    EXPECT_EQ(UnitOfWork::For(provider), nullptr);
+    EXPECT_EQ(provider.connections, 0);
+}
+
+TEST(UnitOfWorkTest, CurrentIsTheOpenUnit) {
+    EXPECT_EQ(UnitOfWork::Current(), nullptr);
+    {
+        UnitOfWork unit;
+        EXPECT_EQ(UnitOfWork::Current(), &unit);
+        {
+            UnitOfWork inner;
+            EXPECT_EQ(UnitOfWork::Current(), &unit);
+        }
+        unit.Commit();
+        EXPECT_EQ(UnitOfWork::Current(), nullptr);
+    }
+}
+
+TEST(UnitOfWorkTest, NestedUnitJoinsAndOnlyOuterCommits) {
+    UnitOfWork outer;
+    {
+        UnitOfWork inner;
+        inner.Commit();
+        EXPECT_TRUE(UnitOfWork::Open());
+    }
+    EXPECT_TRUE(UnitOfWork::Open());
+    outer.Commit();
+    EXPECT_FALSE(UnitOfWork::Open());
+}
+
+TEST(UnitOfWorkTest, UnitIsPerThread) {
+    UnitOfWork unit;
+    bool openElsewhere = true;
+    std::thread([&] { openElsewhere = UnitOfWork::Open(); }).join();
+    EXPECT_FALSE(openElsewhere);
+}